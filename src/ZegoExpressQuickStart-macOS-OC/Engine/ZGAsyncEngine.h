@@ -0,0 +1,88 @@
+//
+//  ZGAsyncEngine.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <ZegoExpressEngine/ZegoExpressEngine.h>
+#import "ZGEngineCommandProxy.h"
+#import "ZGFuture.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Errors reported by the SDK, the code is the SDK error code
+FOUNDATION_EXPORT NSString * const ZGExpressErrorDomain;
+
+/// Future-returning versions of the callback and event driven engine calls
+///
+/// Every call is issued through the command proxy and returns at once, so independent operations run
+/// concurrently; combine them with +[ZGFuture whenAll:] / +[ZGFuture whenAny:] and chain dependent ones with
+/// -[ZGFuture thenOnQueue:block:]. Cancelling a future, or letting its -withTimeout: pass, undoes what the call
+/// started: a login is logged out, a publish or play is stopped, a mixer task is stopped.
+///
+/// Login, publish and play only finish with an engine event, so the state events have to reach this object,
+/// either by installing it as the event handler or by forwarding them from yours. It passes them on to the
+/// command proxy.
+@interface ZGAsyncEngine : NSObject <ZegoEventHandler>
+
+- (instancetype)initWithCommandProxy:(ZGEngineCommandProxy *)commandProxy;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+#pragma mark Room
+
+/// Fulfilled once the room is connected
+- (ZGFuture *)loginRoom:(NSString *)roomID user:(ZegoUser *)user config:(nullable ZegoRoomConfig *)config;
+
+#pragma mark Publisher
+
+/// Fulfilled once the stream is being published
+- (ZGFuture *)startPublishing:(NSString *)streamID channel:(ZegoPublishChannel)channel;
+
+- (ZGFuture *)setStreamExtraInfo:(NSString *)extraInfo;
+
+- (ZGFuture *)addPublishCDNURL:(NSString *)targetURL streamID:(NSString *)streamID;
+
+- (ZGFuture *)removePublishCDNURL:(NSString *)targetURL streamID:(NSString *)streamID;
+
+#pragma mark Player
+
+/// Fulfilled once the stream is playing
+- (ZGFuture *)startPlayingStream:(NSString *)streamID canvas:(nullable ZegoCanvas *)canvas;
+
+#pragma mark IM
+
+/// Fulfilled with the message ID
+- (ZGFuture<NSNumber *> *)sendBroadcastMessage:(NSString *)message roomID:(NSString *)roomID;
+
+/// Fulfilled with the message ID
+- (ZGFuture<NSString *> *)sendBarrageMessage:(NSString *)message roomID:(NSString *)roomID;
+
+- (ZGFuture *)sendCustomCommand:(NSString *)command toUserList:(nullable NSArray<ZegoUser *> *)toUserList roomID:(NSString *)roomID;
+
+#pragma mark Mixer
+
+/// Fulfilled with the extended data of the mixer
+- (ZGFuture<NSDictionary *> *)startMixerTask:(ZegoMixerTask *)task;
+
+- (ZGFuture *)stopMixerTask:(ZegoMixerTask *)task;
+
+#pragma mark Media Player
+
+- (ZGFuture *)loadResource:(NSString *)path mediaPlayer:(ZegoMediaPlayer *)mediaPlayer;
+
+/// Times out after 10 s if the media player never calls back
+- (ZGFuture *)seekTo:(unsigned long long)millisecond mediaPlayer:(ZegoMediaPlayer *)mediaPlayer;
+
+#pragma mark Lifecycle
+
+/// Run a call that returns the engine to its initial state, e.g. destroyEngine, through the command proxy, and
+/// forget every state the engine reported
+- (ZGFuture<NSNumber *> *)submitResetCommand:(NSString *)name block:(void (^)(id<ZGExpressEngine> _Nullable engine))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,324 @@
+//
+//  ZGAsyncEngine.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGAsyncEngine.h"
+
+NSString * const ZGExpressErrorDomain = @"im.zego.express";
+
+/// A seek only completes with the media player's callback, which is not guaranteed to come
+static const NSTimeInterval ZGAsyncEngineSeekTimeout = 10.0;
+
+@interface ZGAsyncEngine ()
+
+@property (nonatomic, strong) ZGEngineCommandProxy *commandProxy;
+
+/// Futures waiting for a room or stream to reach its running state, by target key
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableArray<ZGFuture *> *> *waiters;
+/// Last reported state, by target key, forgotten when the room is left or the engine destroyed
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *states;
+
+@end
+
+@implementation ZGAsyncEngine
+
+- (instancetype)initWithCommandProxy:(ZGEngineCommandProxy *)commandProxy {
+    self = [super init];
+    if (self) {
+        _commandProxy = commandProxy;
+        _waiters = [NSMutableDictionary dictionary];
+        _states = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+#pragma mark - Room
+
+- (ZGFuture *)loginRoom:(NSString *)roomID user:(ZegoUser *)user config:(ZegoRoomConfig *)config {
+    NSString *key = [@"room:" stringByAppendingString:roomID];
+    ZGFuture *connected = [self waiterForKey:key];
+    [self bindWaiter:connected key:key runningState:ZegoRoomStateConnected toCommand:[self.commandProxy loginRoom:roomID user:user config:config]];
+    __weak typeof(self) weakSelf = self;
+    [connected onCancel:^{
+        [weakSelf.commandProxy logoutRoom:roomID];
+    }];
+    return connected;
+}
+
+#pragma mark - Publisher
+
+- (ZGFuture *)startPublishing:(NSString *)streamID channel:(ZegoPublishChannel)channel {
+    NSString *key = [@"publish:" stringByAppendingString:streamID];
+    ZGFuture *publishing = [self waiterForKey:key];
+    [self bindWaiter:publishing key:key runningState:ZegoPublisherStatePublishing toCommand:[self.commandProxy startPublishing:streamID channel:channel]];
+    __weak typeof(self) weakSelf = self;
+    [publishing onCancel:^{
+        [weakSelf.commandProxy stopPublishing:channel];
+    }];
+    return publishing;
+}
+
+- (ZGFuture *)setStreamExtraInfo:(NSString *)extraInfo {
+    return [self submitCallbackCommand:@"setStreamExtraInfo" block:^(id<ZGExpressEngine> engine, ZGFuture *future) {
+        [engine setStreamExtraInfo:extraInfo callback:^(int errorCode) {
+            [ZGAsyncEngine completeFuture:future errorCode:errorCode value:nil];
+        }];
+    }];
+}
+
+- (ZGFuture *)addPublishCDNURL:(NSString *)targetURL streamID:(NSString *)streamID {
+    return [self submitCallbackCommand:@"addPublishCDNURL" block:^(id<ZGExpressEngine> engine, ZGFuture *future) {
+        [engine addPublishCDNURL:targetURL streamID:streamID callback:^(int errorCode) {
+            [ZGAsyncEngine completeFuture:future errorCode:errorCode value:nil];
+        }];
+    }];
+}
+
+- (ZGFuture *)removePublishCDNURL:(NSString *)targetURL streamID:(NSString *)streamID {
+    return [self submitCallbackCommand:@"removePublishCDNURL" block:^(id<ZGExpressEngine> engine, ZGFuture *future) {
+        [engine removePublishCDNURL:targetURL streamID:streamID callback:^(int errorCode) {
+            [ZGAsyncEngine completeFuture:future errorCode:errorCode value:nil];
+        }];
+    }];
+}
+
+#pragma mark - Player
+
+- (ZGFuture *)startPlayingStream:(NSString *)streamID canvas:(ZegoCanvas *)canvas {
+    NSString *key = [@"play:" stringByAppendingString:streamID];
+    ZGFuture *playing = [self waiterForKey:key];
+    [self bindWaiter:playing key:key runningState:ZegoPlayerStatePlaying toCommand:[self.commandProxy startPlayingStream:streamID canvas:canvas]];
+    __weak typeof(self) weakSelf = self;
+    [playing onCancel:^{
+        [weakSelf.commandProxy stopPlayingStream:streamID];
+    }];
+    return playing;
+}
+
+#pragma mark - IM
+
+- (ZGFuture<NSNumber *> *)sendBroadcastMessage:(NSString *)message roomID:(NSString *)roomID {
+    return [self submitCallbackCommand:@"sendBroadcastMessage" block:^(id<ZGExpressEngine> engine, ZGFuture *future) {
+        [engine sendBroadcastMessage:message roomID:roomID callback:^(int errorCode, unsigned long long messageID) {
+            [ZGAsyncEngine completeFuture:future errorCode:errorCode value:@(messageID)];
+        }];
+    }];
+}
+
+- (ZGFuture<NSString *> *)sendBarrageMessage:(NSString *)message roomID:(NSString *)roomID {
+    return [self submitCallbackCommand:@"sendBarrageMessage" block:^(id<ZGExpressEngine> engine, ZGFuture *future) {
+        [engine sendBarrageMessage:message roomID:roomID callback:^(int errorCode, NSString *messageID) {
+            [ZGAsyncEngine completeFuture:future errorCode:errorCode value:messageID];
+        }];
+    }];
+}
+
+- (ZGFuture *)sendCustomCommand:(NSString *)command toUserList:(NSArray<ZegoUser *> *)toUserList roomID:(NSString *)roomID {
+    return [self submitCallbackCommand:@"sendCustomCommand" block:^(id<ZGExpressEngine> engine, ZGFuture *future) {
+        [engine sendCustomCommand:command toUserList:toUserList roomID:roomID callback:^(int errorCode) {
+            [ZGAsyncEngine completeFuture:future errorCode:errorCode value:nil];
+        }];
+    }];
+}
+
+#pragma mark - Mixer
+
+- (ZGFuture<NSDictionary *> *)startMixerTask:(ZegoMixerTask *)task {
+    ZGFuture *started = [self submitCallbackCommand:@"startMixerTask" block:^(id<ZGExpressEngine> engine, ZGFuture *future) {
+        [engine startMixerTask:task callback:^(int errorCode, NSDictionary *extendedData) {
+            [ZGAsyncEngine completeFuture:future errorCode:errorCode value:extendedData];
+        }];
+    }];
+    // The server may still start the task after we gave up on it
+    __weak typeof(self) weakSelf = self;
+    [started onCancel:^{
+        [weakSelf stopMixerTask:task];
+    }];
+    return started;
+}
+
+- (ZGFuture *)stopMixerTask:(ZegoMixerTask *)task {
+    return [self submitCallbackCommand:@"stopMixerTask" block:^(id<ZGExpressEngine> engine, ZGFuture *future) {
+        [engine stopMixerTask:task callback:^(int errorCode) {
+            [ZGAsyncEngine completeFuture:future errorCode:errorCode value:nil];
+        }];
+    }];
+}
+
+#pragma mark - Media Player
+
+- (ZGFuture *)loadResource:(NSString *)path mediaPlayer:(ZegoMediaPlayer *)mediaPlayer {
+    return [self.commandProxy submitAsyncCommand:@"loadResource" block:^(id<ZGExpressEngine> engine, ZGFuture *future) {
+        if (future.completed) {
+            return;
+        }
+        [mediaPlayer loadResource:path callback:^(int errorCode) {
+            [ZGAsyncEngine completeFuture:future errorCode:errorCode value:nil];
+        }];
+    }];
+}
+
+- (ZGFuture *)seekTo:(unsigned long long)millisecond mediaPlayer:(ZegoMediaPlayer *)mediaPlayer {
+    ZGFuture *seeked = [self.commandProxy submitAsyncCommand:@"seekTo" block:^(id<ZGExpressEngine> engine, ZGFuture *future) {
+        if (future.completed) {
+            return;
+        }
+        [mediaPlayer seekTo:millisecond callback:^(int errorCode) {
+            [ZGAsyncEngine completeFuture:future errorCode:errorCode value:nil];
+        }];
+    }];
+    return [seeked withTimeout:ZGAsyncEngineSeekTimeout];
+}
+
+#pragma mark - Lifecycle
+
+- (ZGFuture<NSNumber *> *)submitResetCommand:(NSString *)name block:(void (^)(id<ZGExpressEngine> _Nullable))block {
+    ZGFuture<NSNumber *> *reset = [self.commandProxy submitResetCommand:name block:block];
+    __weak typeof(self) weakSelf = self;
+    [reset whenCompleteOnQueue:dispatch_get_global_queue(QOS_CLASS_UTILITY, 0) block:^(id value, NSError *error) {
+        typeof(self) strongSelf = weakSelf;
+        if (!strongSelf) {
+            return;
+        }
+        @synchronized (strongSelf) {
+            [strongSelf.states removeAllObjects];
+        }
+    }];
+    return reset;
+}
+
+#pragma mark - ZegoEventHandler
+
+- (void)onRoomStateUpdate:(ZegoRoomState)state errorCode:(int)errorCode extendedData:(NSDictionary *)extendedData roomID:(NSString *)roomID {
+    [self.commandProxy onRoomStateUpdate:state errorCode:errorCode extendedData:extendedData roomID:roomID];
+    [self updateKey:[@"room:" stringByAppendingString:roomID] state:state running:state == ZegoRoomStateConnected errorCode:errorCode];
+    if (state == ZegoRoomStateDisconnected) {
+        // Leaving the room stops its streams too, without an event for each
+        @synchronized (self) {
+            [self.states removeAllObjects];
+        }
+    }
+}
+
+- (void)onPublisherStateUpdate:(ZegoPublisherState)state errorCode:(int)errorCode extendedData:(NSDictionary *)extendedData streamID:(NSString *)streamID {
+    [self.commandProxy onPublisherStateUpdate:state errorCode:errorCode extendedData:extendedData streamID:streamID];
+    [self updateKey:[@"publish:" stringByAppendingString:streamID] state:state running:state == ZegoPublisherStatePublishing errorCode:errorCode];
+}
+
+- (void)onPlayerStateUpdate:(ZegoPlayerState)state errorCode:(int)errorCode extendedData:(NSDictionary *)extendedData streamID:(NSString *)streamID {
+    [self.commandProxy onPlayerStateUpdate:state errorCode:errorCode extendedData:extendedData streamID:streamID];
+    [self updateKey:[@"play:" stringByAppendingString:streamID] state:state running:state == ZegoPlayerStatePlaying errorCode:errorCode];
+}
+
+#pragma mark - Helper Methods
+
+/// A future fulfilled by the next event that reports the target running, or rejected by one reporting it failed
+- (ZGFuture *)waiterForKey:(NSString *)key {
+    ZGFuture *future = [ZGFuture future];
+    @synchronized (self) {
+        NSMutableArray<ZGFuture *> *waiters = self.waiters[key];
+        if (!waiters) {
+            waiters = [NSMutableArray array];
+            self.waiters[key] = waiters;
+        }
+        [waiters addObject:future];
+    }
+    __weak typeof(self) weakSelf = self;
+    __weak ZGFuture *weakFuture = future;
+    [future onCancel:^{
+        [weakSelf removeWaiter:weakFuture forKey:key];
+    }];
+    return future;
+}
+
+- (void)removeWaiter:(ZGFuture *)future forKey:(NSString *)key {
+    if (!future) {
+        return;
+    }
+    @synchronized (self) {
+        [self.waiters[key] removeObjectIdenticalTo:future];
+        if (self.waiters[key].count == 0) {
+            [self.waiters removeObjectForKey:key];
+        }
+    }
+}
+
+- (void)updateKey:(NSString *)key state:(NSUInteger)state running:(BOOL)running errorCode:(int)errorCode {
+    NSArray<ZGFuture *> *waiters = nil;
+    @synchronized (self) {
+        self.states[key] = @(state);
+        // Failures while requesting are retried by the SDK, only a failure back in the idle state is final
+        BOOL failed = errorCode != 0 && state == 0;
+        if ((running && errorCode == 0) || failed) {
+            waiters = self.waiters[key];
+            [self.waiters removeObjectForKey:key];
+        }
+    }
+    for (ZGFuture *future in waiters) {
+        [ZGAsyncEngine completeFuture:future errorCode:errorCode value:nil];
+    }
+}
+
+/// Reject the waiter when the command fails or was coalesced into a later one; when the proxy skipped it, the
+/// target already was in the requested state and no event will come, so a running state reported before is
+/// taken as the answer
+- (void)bindWaiter:(ZGFuture *)waiter key:(NSString *)key runningState:(NSUInteger)runningState toCommand:(ZGFuture<NSNumber *> *)command {
+    __weak typeof(self) weakSelf = self;
+    [command whenCompleteOnQueue:dispatch_get_global_queue(QOS_CLASS_UTILITY, 0) block:^(NSNumber *outcome, NSError *error) {
+        if (error) {
+            [waiter rejectWithError:error];
+            return;
+        }
+        ZGEngineCommandOutcome result = outcome.integerValue;
+        if (result == ZGEngineCommandOutcomeExecuted) {
+            return;
+        }
+        typeof(self) strongSelf = weakSelf;
+        if (!strongSelf) {
+            return;
+        }
+        if (result == ZGEngineCommandOutcomeCoalesced) {
+            // Rejected rather than cancelled: the cancel handler would stop what the later command asked for
+            [strongSelf removeWaiter:waiter forKey:key];
+            [waiter rejectWithError:[NSError errorWithDomain:ZGFutureErrorDomain code:ZGFutureErrorCodeCancelled userInfo:@{NSLocalizedDescriptionKey: @"Superseded by a later command for the same target"}]];
+            return;
+        }
+        BOOL running = NO;
+        @synchronized (strongSelf) {
+            running = [strongSelf.states[key] isEqual:@(runningState)];
+        }
+        if (running) {
+            [strongSelf removeWaiter:waiter forKey:key];
+            [waiter fulfillWithValue:nil];
+        }
+    }];
+}
+
+/// Issue an engine call with a completion callback on the command thread
+- (ZGFuture *)submitCallbackCommand:(NSString *)name block:(void (^)(id<ZGExpressEngine> engine, ZGFuture *future))block {
+    return [self.commandProxy submitAsyncCommand:name block:^(id<ZGExpressEngine> engine, ZGFuture *future) {
+        // Cancelled while queued
+        if (future.completed) {
+            return;
+        }
+        if (!engine) {
+            [future rejectWithError:[NSError errorWithDomain:ZGEngineCommandErrorDomain code:ZGEngineCommandErrorCodeNoEngine userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"%@ needs an engine, create it first", name]}]];
+            return;
+        }
+        block(engine, future);
+    }];
+}
+
++ (void)completeFuture:(ZGFuture *)future errorCode:(int)errorCode value:(id)value {
+    if (errorCode != 0) {
+        [future rejectWithError:[NSError errorWithDomain:ZGExpressErrorDomain code:errorCode userInfo:nil]];
+    } else {
+        [future fulfillWithValue:value];
+    }
+}
+
+@end
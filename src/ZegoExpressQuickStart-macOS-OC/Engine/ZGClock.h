@@ -0,0 +1,28 @@
+//
+//  ZGClock.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#ifndef ZGClock_h
+#define ZGClock_h
+
+#include <mach/mach_time.h>
+
+/// Monotonic time in seconds, unaffected by wall clock changes
+static inline double ZGClockNow(void) {
+    static mach_timebase_info_data_t timebase;
+    if (timebase.denom == 0) {
+        mach_timebase_info(&timebase);
+    }
+    return (double)mach_absolute_time() * timebase.numer / timebase.denom / 1e9;
+}
+
+/// Monotonic time in milliseconds
+static inline double ZGClockNowMs(void) {
+    return ZGClockNow() * 1000.0;
+}
+
+#endif /* ZGClock_h */
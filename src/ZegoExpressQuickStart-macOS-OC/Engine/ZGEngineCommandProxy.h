@@ -0,0 +1,133 @@
+//
+//  ZGEngineCommandProxy.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ZGExpressEngine.h"
+#import "ZGFuture.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// What happened to a command, the value of the command futures
+typedef NS_ENUM(NSInteger, ZGEngineCommandOutcome) {
+    /// The command ran on the engine
+    ZGEngineCommandOutcomeExecuted = 0,
+    /// The next queued command was for the same target, only that one ran
+    ZGEngineCommandOutcomeCoalesced = 1,
+    /// A start found the engine already in the requested state, nothing ran; stops always run
+    ZGEngineCommandOutcomeSkipped = 2
+};
+
+FOUNDATION_EXPORT NSString * const ZGEngineCommandErrorDomain;
+
+typedef NS_ENUM(NSInteger, ZGEngineCommandErrorCode) {
+    /// The command needs an engine and none was created
+    ZGEngineCommandErrorCodeNoEngine = 1,
+    /// The proxy was shut down before the command ran
+    ZGEngineCommandErrorCodeShutdown = 2
+};
+
+/// Latency figures of one command name
+@interface ZGEngineCommandStatistics : NSObject
+
+@property (nonatomic, copy, readonly) NSString *name;
+@property (nonatomic, assign, readonly) NSUInteger executedCount;
+@property (nonatomic, assign, readonly) NSUInteger coalescedCount;
+@property (nonatomic, assign, readonly) NSUInteger skippedCount;
+/// From submission until the command thread picked the command up
+@property (nonatomic, assign, readonly) double meanQueueMs;
+@property (nonatomic, assign, readonly) double maxQueueMs;
+/// Time spent inside the SDK call
+@property (nonatomic, assign, readonly) double meanExecuteMs;
+@property (nonatomic, assign, readonly) double maxExecuteMs;
+
+@end
+
+/// Runs every engine control call on one dedicated thread
+///
+/// Callers on any thread, the UI thread in particular, only push a command onto a lock-free queue and get a
+/// future back; they never wait for the SDK. Commands run in submission order. State commands (login/logout,
+/// preview, publish, play) are coalesced: of consecutive queued commands for the same target only the last one
+/// runs, and a start is skipped when the engine is already in the requested state, so start, stop, start costs
+/// a single start. The proxy's idea of the engine state is updated by its own commands and by the state events
+/// forwarded to it: a room or stream the engine dropped by itself with an error (a failed login, a kick-out, a
+/// publish or play failure) is forgotten, so starting it again reaches the SDK, unless a command changed the
+/// target since the event arrived.
+@interface ZGEngineCommandProxy : NSObject <ZegoEventHandler>
+
+/// @param engineProvider Returns the engine at the time a command runs, e.g. [ZegoExpressEngine sharedEngine]
+- (instancetype)initWithEngineProvider:(id<ZGExpressEngine> _Nullable (^)(void))engineProvider;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+#pragma mark Room
+
+- (ZGFuture<NSNumber *> *)loginRoom:(NSString *)roomID user:(ZegoUser *)user config:(nullable ZegoRoomConfig *)config;
+
+- (ZGFuture<NSNumber *> *)logoutRoom:(NSString *)roomID;
+
+#pragma mark Publisher
+
+- (ZGFuture<NSNumber *> *)startPreview:(nullable ZegoCanvas *)canvas;
+
+- (ZGFuture<NSNumber *> *)stopPreview;
+
+- (ZGFuture<NSNumber *> *)startPublishing:(NSString *)streamID channel:(ZegoPublishChannel)channel;
+
+- (ZGFuture<NSNumber *> *)stopPublishing:(ZegoPublishChannel)channel;
+
+#pragma mark Player
+
+- (ZGFuture<NSNumber *> *)startPlayingStream:(NSString *)streamID canvas:(nullable ZegoCanvas *)canvas;
+
+/// Play with a config; a different video layer than the one playing restarts the stream, a new canvas does not
+- (ZGFuture<NSNumber *> *)startPlayingStream:(NSString *)streamID canvas:(nullable ZegoCanvas *)canvas config:(nullable ZegoPlayerConfig *)config;
+
+- (ZGFuture<NSNumber *> *)stopPlayingStream:(NSString *)streamID;
+
+/// Stop and start the stream again, e.g. to change its video layer; never skipped, and not coalesced into a
+/// following start, so it reaches the SDK even when the proxy lost track of the stream
+- (ZGFuture<NSNumber *> *)restartPlayingStream:(NSString *)streamID canvas:(nullable ZegoCanvas *)canvas config:(ZegoPlayerConfig *)config;
+
+#pragma mark Generic commands
+
+/// Run any call on the command thread, the future is fulfilled once the block returns
+///
+/// @param name Name the latency statistics are kept under
+/// @param block Receives the current engine, nil when none exists (e.g. to create it)
+- (ZGFuture<NSNumber *> *)submitCommand:(NSString *)name block:(void (^)(id<ZGExpressEngine> _Nullable engine))block;
+
+/// Run a call whose result arrives later, e.g. through an SDK callback
+///
+/// @param block Must eventually fulfill or reject the future it is given
+- (ZGFuture *)submitAsyncCommand:(NSString *)name block:(void (^)(id<ZGExpressEngine> _Nullable engine, ZGFuture *future))block;
+
+/// Run a call that returns the engine to its initial state, e.g. destroyEngine, and forget every tracked state
+- (ZGFuture<NSNumber *> *)submitResetCommand:(NSString *)name block:(void (^)(id<ZGExpressEngine> _Nullable engine))block;
+
+#pragma mark Engine events
+
+/// Forget the room once it is back in Disconnected with an error
+- (void)onRoomStateUpdate:(ZegoRoomState)state errorCode:(int)errorCode extendedData:(nullable NSDictionary *)extendedData roomID:(NSString *)roomID;
+
+/// Forget the stream's channel once it is back in NoPublish with an error
+- (void)onPublisherStateUpdate:(ZegoPublisherState)state errorCode:(int)errorCode extendedData:(nullable NSDictionary *)extendedData streamID:(NSString *)streamID;
+
+/// Forget the stream once it is back in NoPlay with an error
+- (void)onPlayerStateUpdate:(ZegoPlayerState)state errorCode:(int)errorCode extendedData:(nullable NSDictionary *)extendedData streamID:(NSString *)streamID;
+
+#pragma mark Lifecycle
+
+/// Run the queued commands, then stop the thread; later commands are rejected
+- (void)shutdown;
+
+/// Snapshot of the latency figures by command name
+- (NSDictionary<NSString *, ZGEngineCommandStatistics *> *)statistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
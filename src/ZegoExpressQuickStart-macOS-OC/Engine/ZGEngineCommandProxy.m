@@ -0,0 +1,527 @@
+//
+//  ZGEngineCommandProxy.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGEngineCommandProxy.h"
+#import "ZGMPSCQueue.h"
+#import "ZGClock.h"
+#import <pthread.h>
+#import <sched.h>
+
+NSString * const ZGEngineCommandErrorDomain = @"im.zego.engine.command";
+
+#pragma mark - Command
+
+typedef void (^ZGEngineCommandBlock)(id<ZGExpressEngine> engine, id fromState, ZGFuture *future);
+
+/// A queued control call
+@interface ZGEngineCommand : NSObject
+
+@property (nonatomic, copy) NSString *name;
+/// Target of a state command, nil for commands that are never coalesced
+@property (nonatomic, copy, nullable) NSString *key;
+/// Requested state of the target, nil for "off"
+@property (nonatomic, strong, nullable) id state;
+@property (nonatomic, assign) BOOL requiresEngine;
+/// The block completes the future itself
+@property (nonatomic, assign) BOOL async;
+@property (nonatomic, assign) BOOL resetsStates;
+/// Runs even when the target already is in the requested state, and is not coalesced into the next command
+@property (nonatomic, assign) BOOL forced;
+/// Instead of running, drops the applied states it matches, for targets the engine left by itself
+@property (nonatomic, copy, nullable) BOOL (^forgets)(NSString *key, id state);
+/// Generations of the targets when the event behind `forgets` arrived
+@property (nonatomic, copy, nullable) NSDictionary<NSString *, NSNumber *> *generations;
+@property (nonatomic, copy) ZGEngineCommandBlock block;
+@property (nonatomic, strong) ZGFuture *future;
+@property (nonatomic, assign) double submitTime;
+
+@end
+
+@implementation ZGEngineCommand
+
+@end
+
+#pragma mark - Statistics
+
+@interface ZGEngineCommandStatistics ()
+
+@property (nonatomic, copy, readwrite) NSString *name;
+@property (nonatomic, assign, readwrite) NSUInteger executedCount;
+@property (nonatomic, assign, readwrite) NSUInteger coalescedCount;
+@property (nonatomic, assign, readwrite) NSUInteger skippedCount;
+@property (nonatomic, assign, readwrite) double maxQueueMs;
+@property (nonatomic, assign, readwrite) double maxExecuteMs;
+@property (nonatomic, assign) double queueMsSum;
+@property (nonatomic, assign) double executeMsSum;
+
+@end
+
+@implementation ZGEngineCommandStatistics
+
+- (double)meanQueueMs {
+    NSUInteger count = self.executedCount + self.coalescedCount + self.skippedCount;
+    return count > 0 ? self.queueMsSum / count : 0;
+}
+
+- (double)meanExecuteMs {
+    return self.executedCount > 0 ? self.executeMsSum / self.executedCount : 0;
+}
+
+- (instancetype)snapshot {
+    ZGEngineCommandStatistics *snapshot = [[ZGEngineCommandStatistics alloc] init];
+    snapshot.name = self.name;
+    snapshot.executedCount = self.executedCount;
+    snapshot.coalescedCount = self.coalescedCount;
+    snapshot.skippedCount = self.skippedCount;
+    snapshot.maxQueueMs = self.maxQueueMs;
+    snapshot.maxExecuteMs = self.maxExecuteMs;
+    snapshot.queueMsSum = self.queueMsSum;
+    snapshot.executeMsSum = self.executeMsSum;
+    return snapshot;
+}
+
+@end
+
+#pragma mark - Worker
+
+/// Owns the queue and runs on the command thread, kept apart from the proxy so the thread does not retain it
+@interface ZGEngineCommandWorker : NSObject
+
+@property (nonatomic, copy) id<ZGExpressEngine> (^engineProvider)(void);
+/// Command thread only
+@property (nonatomic, strong) NSMutableDictionary<NSString *, id> *appliedStates;
+/// Bumped each time a command changes a target, written on the command thread under the generation lock
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *generations;
+/// Guarded by the statistics lock
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZGEngineCommandStatistics *> *statistics;
+
+@end
+
+@implementation ZGEngineCommandWorker {
+    ZGMPSCQueue _queue;
+    dispatch_semaphore_t _signal;
+    atomic_bool _stopping;
+    atomic_int _producers;
+    pthread_mutex_t _statisticsLock;
+    pthread_mutex_t _generationLock;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        ZGMPSCQueueInit(&_queue);
+        _signal = dispatch_semaphore_create(0);
+        atomic_init(&_stopping, false);
+        atomic_init(&_producers, 0);
+        pthread_mutex_init(&_statisticsLock, NULL);
+        pthread_mutex_init(&_generationLock, NULL);
+        _appliedStates = [NSMutableDictionary dictionary];
+        _generations = [NSMutableDictionary dictionary];
+        _statistics = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    pthread_mutex_destroy(&_statisticsLock);
+    pthread_mutex_destroy(&_generationLock);
+}
+
+#pragma mark Producer side
+
+- (void)enqueue:(ZGEngineCommand *)command {
+    // Counted before the stop check: once run sees no submitter left after the stop, every command that got
+    // past the check is in the queue and still runs, none is dropped without its future being completed
+    atomic_fetch_add(&_producers, 1);
+    if (atomic_load(&_stopping)) {
+        atomic_fetch_sub(&_producers, 1);
+        [command.future rejectWithError:[NSError errorWithDomain:ZGEngineCommandErrorDomain code:ZGEngineCommandErrorCodeShutdown userInfo:@{NSLocalizedDescriptionKey: @"The engine command proxy is shut down"}]];
+        return;
+    }
+    command.submitTime = ZGClockNow();
+    ZGMPSCNode *node = malloc(sizeof(ZGMPSCNode));
+    node->value = (__bridge_retained void *)command;
+    ZGMPSCQueuePush(&_queue, node);
+    atomic_fetch_sub(&_producers, 1);
+    dispatch_semaphore_signal(_signal);
+}
+
+- (void)stop {
+    atomic_store(&_stopping, true);
+    dispatch_semaphore_signal(_signal);
+}
+
+#pragma mark Consumer side
+
+- (void)run {
+    while (YES) {
+        dispatch_semaphore_wait(_signal, DISPATCH_TIME_FOREVER);
+        [self executeBatch:[self drain]];
+        if (atomic_load(&_stopping)) {
+            break;
+        }
+    }
+    // Whatever was submitted before the stop still runs
+    while (atomic_load(&_producers) > 0) {
+        sched_yield();
+    }
+    NSArray<ZGEngineCommand *> *batch = nil;
+    while ((batch = [self drain]).count > 0) {
+        [self executeBatch:batch];
+    }
+}
+
+- (NSArray<ZGEngineCommand *> *)drain {
+    NSMutableArray<ZGEngineCommand *> *batch = [NSMutableArray array];
+    ZGMPSCNode *node = NULL;
+    while ((node = ZGMPSCQueuePop(&_queue))) {
+        [batch addObject:(__bridge_transfer ZGEngineCommand *)node->value];
+        free(node);
+    }
+    return batch;
+}
+
+- (void)executeBatch:(NSArray<ZGEngineCommand *> *)batch {
+    [batch enumerateObjectsUsingBlock:^(ZGEngineCommand *command, NSUInteger index, BOOL *stop) {
+        @autoreleasepool {
+            if (command.forgets) {
+                NSSet<NSString *> *keys = [self.appliedStates keysOfEntriesPassingTest:^BOOL(NSString *key, id state, BOOL *stopTest) {
+                    // A command changed the target after the event arrived, so the event is about what it replaced
+                    return command.forgets(key, state) && [self.generations[key] isEqual:command.generations[key]];
+                }];
+                [self.appliedStates removeObjectsForKeys:keys.allObjects];
+                return;
+            }
+
+            double startTime = ZGClockNow();
+            double queueMs = (startTime - command.submitTime) * 1000;
+            // Only a run of commands for one target collapses into its last one, so the order across targets holds
+            ZGEngineCommand *next = index + 1 < batch.count ? batch[index + 1] : nil;
+            if (command.key && !command.forced && [next.key isEqualToString:command.key]) {
+                [self recordCommand:command.name outcome:ZGEngineCommandOutcomeCoalesced queueMs:queueMs executeMs:0];
+                [command.future fulfillWithValue:@(ZGEngineCommandOutcomeCoalesced)];
+                return;
+            }
+
+            id<ZGExpressEngine> engine = self.engineProvider ? self.engineProvider() : nil;
+            if (command.requiresEngine && !engine) {
+                [command.future rejectWithError:[NSError errorWithDomain:ZGEngineCommandErrorDomain code:ZGEngineCommandErrorCodeNoEngine userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"%@ needs an engine, create it first", command.name]}]];
+                return;
+            }
+
+            // Only a start is skipped: the applied state may be missing for a target the engine still runs,
+            // and stopping it again does no harm
+            id fromState = command.key ? self.appliedStates[command.key] : nil;
+            if (command.key && command.state && !command.forced && [fromState isEqual:command.state]) {
+                [self recordCommand:command.name outcome:ZGEngineCommandOutcomeSkipped queueMs:queueMs executeMs:0];
+                [command.future fulfillWithValue:@(ZGEngineCommandOutcomeSkipped)];
+                return;
+            }
+
+            command.block(engine, fromState, command.future);
+            double executeMs = (ZGClockNow() - startTime) * 1000;
+
+            if (command.key) {
+                self.appliedStates[command.key] = command.state;
+                [self bumpGenerationOfKey:command.key];
+            }
+            if (command.resetsStates) {
+                [self.appliedStates removeAllObjects];
+            }
+            [self recordCommand:command.name outcome:ZGEngineCommandOutcomeExecuted queueMs:queueMs executeMs:executeMs];
+            if (!command.async) {
+                [command.future fulfillWithValue:@(ZGEngineCommandOutcomeExecuted)];
+            }
+        }
+    }];
+}
+
+- (void)bumpGenerationOfKey:(NSString *)key {
+    pthread_mutex_lock(&_generationLock);
+    self.generations[key] = @(self.generations[key].unsignedIntegerValue + 1);
+    pthread_mutex_unlock(&_generationLock);
+}
+
+- (NSDictionary<NSString *, NSNumber *> *)generationsSnapshot {
+    pthread_mutex_lock(&_generationLock);
+    NSDictionary<NSString *, NSNumber *> *generations = [self.generations copy];
+    pthread_mutex_unlock(&_generationLock);
+    return generations;
+}
+
+#pragma mark Statistics
+
+- (void)recordCommand:(NSString *)name outcome:(ZGEngineCommandOutcome)outcome queueMs:(double)queueMs executeMs:(double)executeMs {
+    pthread_mutex_lock(&_statisticsLock);
+    ZGEngineCommandStatistics *statistics = self.statistics[name];
+    if (!statistics) {
+        statistics = [[ZGEngineCommandStatistics alloc] init];
+        statistics.name = name;
+        self.statistics[name] = statistics;
+    }
+    switch (outcome) {
+        case ZGEngineCommandOutcomeExecuted:
+            statistics.executedCount += 1;
+            statistics.executeMsSum += executeMs;
+            statistics.maxExecuteMs = MAX(statistics.maxExecuteMs, executeMs);
+            break;
+        case ZGEngineCommandOutcomeCoalesced:
+            statistics.coalescedCount += 1;
+            break;
+        case ZGEngineCommandOutcomeSkipped:
+            statistics.skippedCount += 1;
+            break;
+    }
+    statistics.queueMsSum += queueMs;
+    statistics.maxQueueMs = MAX(statistics.maxQueueMs, queueMs);
+    pthread_mutex_unlock(&_statisticsLock);
+}
+
+- (NSDictionary<NSString *, ZGEngineCommandStatistics *> *)statisticsSnapshot {
+    NSMutableDictionary<NSString *, ZGEngineCommandStatistics *> *snapshot = [NSMutableDictionary dictionary];
+    pthread_mutex_lock(&_statisticsLock);
+    [self.statistics enumerateKeysAndObjectsUsingBlock:^(NSString *name, ZGEngineCommandStatistics *statistics, BOOL *stop) {
+        snapshot[name] = [statistics snapshot];
+    }];
+    pthread_mutex_unlock(&_statisticsLock);
+    return snapshot;
+}
+
+@end
+
+#pragma mark - Proxy
+
+@interface ZGEngineCommandProxy ()
+
+@property (nonatomic, strong) ZGEngineCommandWorker *worker;
+@property (nonatomic, strong) NSThread *thread;
+
+@end
+
+@implementation ZGEngineCommandProxy
+
+- (instancetype)initWithEngineProvider:(id<ZGExpressEngine> (^)(void))engineProvider {
+    self = [super init];
+    if (self) {
+        _worker = [[ZGEngineCommandWorker alloc] init];
+        _worker.engineProvider = engineProvider;
+        _thread = [[NSThread alloc] initWithTarget:_worker selector:@selector(run) object:nil];
+        _thread.name = @"im.zego.engine.command";
+        _thread.qualityOfService = NSQualityOfServiceUserInitiated;
+        [_thread start];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_worker stop];
+}
+
+- (void)shutdown {
+    [self.worker stop];
+}
+
+- (NSDictionary<NSString *, ZGEngineCommandStatistics *> *)statistics {
+    return [self.worker statisticsSnapshot];
+}
+
+#pragma mark - Room
+
+- (ZGFuture<NSNumber *> *)loginRoom:(NSString *)roomID user:(ZegoUser *)user config:(ZegoRoomConfig *)config {
+    return [self submitState:roomID forKey:@"room" name:@"loginRoom" block:^(id<ZGExpressEngine> engine, NSString *fromRoomID) {
+        // One room at a time, like the SDK
+        if (fromRoomID) {
+            [engine logoutRoom:fromRoomID];
+        }
+        if (config) {
+            [engine loginRoom:roomID user:user config:config];
+        } else {
+            [engine loginRoom:roomID user:user];
+        }
+    }];
+}
+
+- (ZGFuture<NSNumber *> *)logoutRoom:(NSString *)roomID {
+    return [self submitState:nil forKey:@"room" name:@"logoutRoom" block:^(id<ZGExpressEngine> engine, NSString *fromRoomID) {
+        [engine logoutRoom:fromRoomID ?: roomID];
+    }];
+}
+
+#pragma mark - Publisher
+
+- (ZGFuture<NSNumber *> *)startPreview:(ZegoCanvas *)canvas {
+    return [self submitState:canvas ?: [NSNull null] forKey:@"preview" name:@"startPreview" block:^(id<ZGExpressEngine> engine, id fromState) {
+        [engine startPreview:canvas];
+    }];
+}
+
+- (ZGFuture<NSNumber *> *)stopPreview {
+    return [self submitState:nil forKey:@"preview" name:@"stopPreview" block:^(id<ZGExpressEngine> engine, id fromState) {
+        [engine stopPreview];
+    }];
+}
+
+- (ZGFuture<NSNumber *> *)startPublishing:(NSString *)streamID channel:(ZegoPublishChannel)channel {
+    NSString *key = [NSString stringWithFormat:@"publish:%lu", (unsigned long)channel];
+    return [self submitState:streamID forKey:key name:@"startPublishing" block:^(id<ZGExpressEngine> engine, NSString *fromStreamID) {
+        // The channel is busy with another stream
+        if (fromStreamID) {
+            [engine stopPublishing:channel];
+        }
+        [engine startPublishing:streamID channel:channel];
+    }];
+}
+
+- (ZGFuture<NSNumber *> *)stopPublishing:(ZegoPublishChannel)channel {
+    NSString *key = [NSString stringWithFormat:@"publish:%lu", (unsigned long)channel];
+    return [self submitState:nil forKey:key name:@"stopPublishing" block:^(id<ZGExpressEngine> engine, id fromState) {
+        [engine stopPublishing:channel];
+    }];
+}
+
+#pragma mark - Player
+
+- (ZGFuture<NSNumber *> *)startPlayingStream:(NSString *)streamID canvas:(ZegoCanvas *)canvas {
+    return [self startPlayingStream:streamID canvas:canvas config:nil];
+}
+
+- (ZGFuture<NSNumber *> *)startPlayingStream:(NSString *)streamID canvas:(ZegoCanvas *)canvas config:(ZegoPlayerConfig *)config {
+    NSString *key = [NSString stringWithFormat:@"play:%@", streamID];
+    ZegoPlayerVideoLayer layer = config ? config.videoLayer : ZegoPlayerVideoLayerAuto;
+    NSArray *state = @[canvas ?: [NSNull null], @(layer)];
+    return [self submitState:state forKey:key name:@"startPlayingStream" block:^(id<ZGExpressEngine> engine, NSArray *fromState) {
+        // Calling it again with another canvas only moves the view, like the SDK, but the layer is fixed once playing
+        if (fromState && ![fromState[1] isEqual:@(layer)]) {
+            [engine stopPlayingStream:streamID];
+        }
+        if (config) {
+            [engine startPlayingStream:streamID canvas:canvas config:config];
+        } else {
+            [engine startPlayingStream:streamID canvas:canvas];
+        }
+    }];
+}
+
+- (ZGFuture<NSNumber *> *)stopPlayingStream:(NSString *)streamID {
+    NSString *key = [NSString stringWithFormat:@"play:%@", streamID];
+    return [self submitState:nil forKey:key name:@"stopPlayingStream" block:^(id<ZGExpressEngine> engine, id fromState) {
+        [engine stopPlayingStream:streamID];
+    }];
+}
+
+- (ZGFuture<NSNumber *> *)restartPlayingStream:(NSString *)streamID canvas:(ZegoCanvas *)canvas config:(ZegoPlayerConfig *)config {
+    NSString *key = [NSString stringWithFormat:@"play:%@", streamID];
+    NSArray *state = @[canvas ?: [NSNull null], @(config.videoLayer)];
+    ZGEngineCommand *command = [self stateCommand:state forKey:key name:@"restartPlayingStream" block:^(id<ZGExpressEngine> engine, id fromState) {
+        [engine stopPlayingStream:streamID];
+        [engine startPlayingStream:streamID canvas:canvas config:config];
+    }];
+    command.forced = YES;
+    [self.worker enqueue:command];
+    return command.future;
+}
+
+#pragma mark - Engine events
+
+- (void)onRoomStateUpdate:(ZegoRoomState)state errorCode:(int)errorCode extendedData:(NSDictionary *)extendedData roomID:(NSString *)roomID {
+    // A logout of ours ends without an error, and already cleared the state
+    if (state != ZegoRoomStateDisconnected || errorCode == 0) {
+        return;
+    }
+    [self forgetStatesMatching:^BOOL(NSString *key, id appliedState) {
+        return [key isEqualToString:@"room"] && [appliedState isEqual:roomID];
+    }];
+}
+
+- (void)onPublisherStateUpdate:(ZegoPublisherState)state errorCode:(int)errorCode extendedData:(NSDictionary *)extendedData streamID:(NSString *)streamID {
+    if (state != ZegoPublisherStateNoPublish || errorCode == 0) {
+        return;
+    }
+    // The event names the stream, not the channel it was on
+    [self forgetStatesMatching:^BOOL(NSString *key, id appliedState) {
+        return [key hasPrefix:@"publish:"] && [appliedState isEqual:streamID];
+    }];
+}
+
+- (void)onPlayerStateUpdate:(ZegoPlayerState)state errorCode:(int)errorCode extendedData:(NSDictionary *)extendedData streamID:(NSString *)streamID {
+    // Also the NoPlay of a stop, or of the stop half of a layer restart, carries no error
+    if (state != ZegoPlayerStateNoPlay || errorCode == 0) {
+        return;
+    }
+    NSString *playKey = [NSString stringWithFormat:@"play:%@", streamID];
+    [self forgetStatesMatching:^BOOL(NSString *key, id appliedState) {
+        return [key isEqualToString:playKey];
+    }];
+}
+
+#pragma mark - Generic commands
+
+- (ZGFuture<NSNumber *> *)submitCommand:(NSString *)name block:(void (^)(id<ZGExpressEngine>))block {
+    ZGEngineCommand *command = [self commandWithName:name];
+    command.block = ^(id<ZGExpressEngine> engine, id fromState, ZGFuture *future) {
+        block(engine);
+    };
+    [self.worker enqueue:command];
+    return command.future;
+}
+
+- (ZGFuture *)submitAsyncCommand:(NSString *)name block:(void (^)(id<ZGExpressEngine>, ZGFuture *))block {
+    ZGEngineCommand *command = [self commandWithName:name];
+    command.async = YES;
+    command.block = ^(id<ZGExpressEngine> engine, id fromState, ZGFuture *future) {
+        block(engine, future);
+    };
+    [self.worker enqueue:command];
+    return command.future;
+}
+
+- (ZGFuture<NSNumber *> *)submitResetCommand:(NSString *)name block:(void (^)(id<ZGExpressEngine>))block {
+    ZGEngineCommand *command = [self commandWithName:name];
+    command.resetsStates = YES;
+    command.block = ^(id<ZGExpressEngine> engine, id fromState, ZGFuture *future) {
+        block(engine);
+    };
+    [self.worker enqueue:command];
+    return command.future;
+}
+
+#pragma mark - Helper Methods
+
+- (ZGEngineCommand *)commandWithName:(NSString *)name {
+    ZGEngineCommand *command = [[ZGEngineCommand alloc] init];
+    command.name = name;
+    command.future = [ZGFuture future];
+    return command;
+}
+
+/// The applied states live on the command thread, so they are forgotten there, in order with the commands
+- (void)forgetStatesMatching:(BOOL (^)(NSString *key, id state))forgets {
+    ZGEngineCommand *command = [self commandWithName:@"forgetState"];
+    command.forgets = forgets;
+    command.generations = [self.worker generationsSnapshot];
+    [self.worker enqueue:command];
+}
+
+- (ZGFuture<NSNumber *> *)submitState:(id)state forKey:(NSString *)key name:(NSString *)name block:(void (^)(id<ZGExpressEngine> engine, id fromState))block {
+    ZGEngineCommand *command = [self stateCommand:state forKey:key name:name block:block];
+    [self.worker enqueue:command];
+    return command.future;
+}
+
+- (ZGEngineCommand *)stateCommand:(id)state forKey:(NSString *)key name:(NSString *)name block:(void (^)(id<ZGExpressEngine> engine, id fromState))block {
+    ZGEngineCommand *command = [self commandWithName:name];
+    command.key = key;
+    command.state = state;
+    command.requiresEngine = YES;
+    command.block = ^(id<ZGExpressEngine> engine, id fromState, ZGFuture *future) {
+        block(engine, fromState);
+    };
+    return command;
+}
+
+@end
@@ -0,0 +1,45 @@
+//
+//  ZGEngineProfile.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <ZegoExpressEngine/ZegoExpressEngine.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Engine settings for launch, read from a compiled profile (see ZGEngineProfileFormat.h)
+///
+/// Opening a profile maps the file and checks its header and section table, nothing else is read. The engine
+/// config is built on first use; video presets and feature flags are looked up in the mapped records each time,
+/// by binary search on their names. Compile a profile from JSON with ZGEngineProfileCompiler.
+@interface ZGEngineProfile : NSObject
+
+/// The profile bundled with the app as EngineProfile.zgprofile, nil when there is none or it does not load
++ (nullable instancetype)bundledProfile;
+
++ (nullable instancetype)profileWithContentsOfFile:(NSString *)path error:(NSError **)error;
+
+/// @param data Kept for the life of the profile, e.g. a mapped file
++ (nullable instancetype)profileWithData:(NSData *)data error:(NSError **)error;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// For setEngineConfig: before the engine is created, nil when the profile has no engine section
+@property (nonatomic, strong, readonly, nullable) ZegoEngineConfig *engineConfig;
+
+/// Sorted names of the video presets
+@property (nonatomic, copy, readonly) NSArray<NSString *> *videoPresetNames;
+
+/// A new config for the preset, nil when there is no such preset
+- (nullable ZegoVideoConfig *)videoConfigNamed:(NSString *)name;
+
+/// @return `defaultValue` for a feature the profile does not name
+- (BOOL)isFeatureEnabled:(NSString *)name defaultValue:(BOOL)defaultValue;
+
+@end
+
+NS_ASSUME_NONNULL_END
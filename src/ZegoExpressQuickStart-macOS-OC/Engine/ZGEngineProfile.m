@@ -0,0 +1,272 @@
+//
+//  ZGEngineProfile.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGEngineProfile.h"
+#import "ZGEngineProfileFormat.h"
+
+static NSString * const ZGEngineProfileErrorDomain = @"im.zego.engineprofile";
+
+@interface ZGEngineProfile ()
+
+@property (nonatomic, strong) NSData *data;
+@property (nonatomic, strong, nullable) ZegoEngineConfig *decodedEngineConfig;
+@property (nonatomic, assign) BOOL engineConfigDecoded;
+
+@end
+
+@implementation ZGEngineProfile {
+    const char *_strings;
+    uint32_t _stringsLength;
+    const ZGEngineProfileEngineRecord *_engine;
+    const ZGEngineProfileStringPair *_advanced;
+    uint32_t _advancedCount;
+    const ZGEngineProfileVideoPresetRecord *_presets;
+    uint32_t _presetCount;
+    const ZGEngineProfileFeatureRecord *_features;
+    uint32_t _featureCount;
+}
+
++ (instancetype)bundledProfile {
+    NSString *path = [[NSBundle mainBundle] pathForResource:@"EngineProfile" ofType:@"zgprofile"];
+    return path ? [self profileWithContentsOfFile:path error:nil] : nil;
+}
+
++ (instancetype)profileWithContentsOfFile:(NSString *)path error:(NSError **)error {
+    // Mapped, so only the pages actually looked at are ever read
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedAlways error:error];
+    if (!data) {
+        return nil;
+    }
+    return [self profileWithData:data error:error];
+}
+
++ (instancetype)profileWithData:(NSData *)data error:(NSError **)error {
+    ZGEngineProfile *profile = [[self alloc] initWithData:data];
+    return [profile validate:error] ? profile : nil;
+}
+
+- (instancetype)initWithData:(NSData *)data {
+    self = [super init];
+    if (self) {
+        _data = data;
+    }
+    return self;
+}
+
+/// Check the header and the section table and note where the sections are, the records are read on use
+- (BOOL)validate:(NSError **)error {
+    const uint8_t *bytes = self.data.bytes;
+    size_t length = self.data.length;
+    if (length < sizeof(ZGEngineProfileHeader)) {
+        [self.class fillError:error message:@"Engine profile is truncated"];
+        return NO;
+    }
+    const ZGEngineProfileHeader *header = (const ZGEngineProfileHeader *)bytes;
+    if (header->magic != ZGEngineProfileMagic) {
+        [self.class fillError:error message:@"Not a compiled engine profile"];
+        return NO;
+    }
+    if (header->version != ZGEngineProfileVersion) {
+        [self.class fillError:error message:[NSString stringWithFormat:@"Engine profile version %u is not supported, compile it again", header->version]];
+        return NO;
+    }
+    size_t tableEnd = sizeof(ZGEngineProfileHeader) + (size_t)header->sectionCount * sizeof(ZGEngineProfileSection);
+    if (header->fileSize != length || tableEnd > length) {
+        [self.class fillError:error message:@"Engine profile is truncated"];
+        return NO;
+    }
+
+    const ZGEngineProfileSection *sections = (const ZGEngineProfileSection *)(bytes + sizeof(ZGEngineProfileHeader));
+    for (uint16_t i = 0; i < header->sectionCount; i++) {
+        const ZGEngineProfileSection *section = &sections[i];
+        if (section->offset % 8 != 0 || section->offset < tableEnd || section->offset > length || section->length > length - section->offset) {
+            [self.class fillError:error message:[NSString stringWithFormat:@"Engine profile section %u is out of bounds", i]];
+            return NO;
+        }
+        const void *start = bytes + section->offset;
+        size_t recordSize = 0;
+        switch (section->kind) {
+            case ZGEngineProfileSectionStrings:
+                // Every string is NUL terminated, so the section has to be
+                if (section->length == 0 || ((const char *)start)[section->length - 1] != '\0') {
+                    [self.class fillError:error message:@"Engine profile strings are not terminated"];
+                    return NO;
+                }
+                _strings = start;
+                _stringsLength = section->length;
+                continue;
+            case ZGEngineProfileSectionEngine:
+                recordSize = sizeof(ZGEngineProfileEngineRecord);
+                _engine = section->count == 1 ? start : NULL;
+                break;
+            case ZGEngineProfileSectionAdvanced:
+                recordSize = sizeof(ZGEngineProfileStringPair);
+                _advanced = start;
+                _advancedCount = section->count;
+                break;
+            case ZGEngineProfileSectionVideoPresets:
+                recordSize = sizeof(ZGEngineProfileVideoPresetRecord);
+                _presets = start;
+                _presetCount = section->count;
+                break;
+            case ZGEngineProfileSectionFeatures:
+                recordSize = sizeof(ZGEngineProfileFeatureRecord);
+                _features = start;
+                _featureCount = section->count;
+                break;
+            default:
+                // Written by a newer compiler, nothing this reader needs
+                continue;
+        }
+        if ((uint64_t)section->count * recordSize > section->length) {
+            [self.class fillError:error message:[NSString stringWithFormat:@"Engine profile section %u is truncated", i]];
+            return NO;
+        }
+    }
+    return YES;
+}
+
+#pragma mark - Engine Config
+
+- (ZegoEngineConfig *)engineConfig {
+    @synchronized (self) {
+        if (!self.engineConfigDecoded) {
+            self.decodedEngineConfig = [self decodeEngineConfig];
+            self.engineConfigDecoded = YES;
+        }
+        return self.decodedEngineConfig;
+    }
+}
+
+- (nullable ZegoEngineConfig *)decodeEngineConfig {
+    if (!_engine) {
+        return nil;
+    }
+    ZegoEngineConfig *config = [[ZegoEngineConfig alloc] init];
+    if (_engine->flags & ZGEngineProfileEngineHasLog) {
+        ZegoLogConfig *logConfig = [[ZegoLogConfig alloc] init];
+        NSString *logPath = [self stringFor:_engine->logPath];
+        if (logPath.length > 0) {
+            logConfig.logPath = logPath;
+        }
+        if (_engine->logSize > 0) {
+            logConfig.logSize = _engine->logSize;
+        }
+        config.logConfig = logConfig;
+    }
+    if (_engine->flags & ZGEngineProfileEngineHasCaptureMain) {
+        config.customVideoCaptureMainConfig = [[ZegoCustomVideoCaptureConfig alloc] init];
+        config.customVideoCaptureMainConfig.bufferType = _engine->captureMainBufferType;
+    }
+    if (_engine->flags & ZGEngineProfileEngineHasCaptureAux) {
+        config.customVideoCaptureAuxConfig = [[ZegoCustomVideoCaptureConfig alloc] init];
+        config.customVideoCaptureAuxConfig.bufferType = _engine->captureAuxBufferType;
+    }
+    if (_engine->flags & ZGEngineProfileEngineHasRender) {
+        ZegoCustomVideoRenderConfig *renderConfig = [[ZegoCustomVideoRenderConfig alloc] init];
+        renderConfig.bufferType = _engine->renderBufferType;
+        renderConfig.frameFormatSeries = _engine->renderFrameFormatSeries;
+        renderConfig.enableEngineRender = (_engine->flags & ZGEngineProfileEngineRenderAlsoByEngine) != 0;
+        config.customVideoRenderConfig = renderConfig;
+    }
+    if (_advancedCount > 0) {
+        NSMutableDictionary<NSString *, NSString *> *advanced = [NSMutableDictionary dictionaryWithCapacity:_advancedCount];
+        for (uint32_t i = 0; i < _advancedCount; i++) {
+            NSString *key = [self stringFor:_advanced[i].key];
+            NSString *value = [self stringFor:_advanced[i].value];
+            if (key && value) {
+                advanced[key] = value;
+            }
+        }
+        config.advancedConfig = advanced;
+    }
+    return config;
+}
+
+#pragma mark - Video Presets
+
+- (NSArray<NSString *> *)videoPresetNames {
+    NSMutableArray<NSString *> *names = [NSMutableArray arrayWithCapacity:_presetCount];
+    for (uint32_t i = 0; i < _presetCount; i++) {
+        NSString *name = [self stringFor:_presets[i].name];
+        if (name) {
+            [names addObject:name];
+        }
+    }
+    return names;
+}
+
+- (ZegoVideoConfig *)videoConfigNamed:(NSString *)name {
+    NSUInteger index = [self indexOfName:name inRecords:_presets stride:sizeof(ZGEngineProfileVideoPresetRecord) count:_presetCount];
+    if (index == NSNotFound) {
+        return nil;
+    }
+    const ZGEngineProfileVideoPresetRecord *preset = &_presets[index];
+    ZegoVideoConfig *config = [ZegoVideoConfig defaultConfig];
+    config.captureResolution = CGSizeMake(preset->captureWidth, preset->captureHeight);
+    config.encodeResolution = CGSizeMake(preset->encodeWidth, preset->encodeHeight);
+    config.fps = preset->fps;
+    config.bitrate = preset->bitrate;
+    config.codecID = preset->codecID;
+    return config;
+}
+
+#pragma mark - Features
+
+- (BOOL)isFeatureEnabled:(NSString *)name defaultValue:(BOOL)defaultValue {
+    NSUInteger index = [self indexOfName:name inRecords:_features stride:sizeof(ZGEngineProfileFeatureRecord) count:_featureCount];
+    return index == NSNotFound ? defaultValue : _features[index].enabled != 0;
+}
+
+#pragma mark - Helper Methods
+
+/// Binary search of records starting with their ZGEngineProfileString name
+- (NSUInteger)indexOfName:(NSString *)name inRecords:(const void *)records stride:(size_t)stride count:(uint32_t)count {
+    const char *key = name.UTF8String;
+    size_t keyLength = strlen(key);
+    NSUInteger low = 0, high = count;
+    while (low < high) {
+        NSUInteger middle = (low + high) / 2;
+        ZGEngineProfileString reference = *(const ZGEngineProfileString *)((const uint8_t *)records + middle * stride);
+        const char *bytes = [self bytesFor:reference];
+        if (!bytes) {
+            return NSNotFound;
+        }
+        int order = ZGEngineProfileCompareNames(bytes, reference.length, key, keyLength);
+        if (order == 0) {
+            return middle;
+        }
+        if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return NSNotFound;
+}
+
+/// The bytes of a string, NULL when the reference points outside the string section
+- (nullable const char *)bytesFor:(ZGEngineProfileString)reference {
+    if (!_strings || reference.offset >= _stringsLength || reference.length >= _stringsLength - reference.offset) {
+        return NULL;
+    }
+    return _strings + reference.offset;
+}
+
+- (nullable NSString *)stringFor:(ZGEngineProfileString)reference {
+    const char *bytes = [self bytesFor:reference];
+    return bytes ? [[NSString alloc] initWithBytes:bytes length:reference.length encoding:NSUTF8StringEncoding] : nil;
+}
+
++ (void)fillError:(NSError **)error message:(NSString *)message {
+    if (error) {
+        *error = [NSError errorWithDomain:ZGEngineProfileErrorDomain code:-1 userInfo:@{NSLocalizedDescriptionKey: message}];
+    }
+}
+
+@end
@@ -0,0 +1,46 @@
+//
+//  ZGEngineProfileCompiler.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Process argument that compiles a profile instead of launching the app: --compile-profile <in.json> <out.zgprofile>
+FOUNDATION_EXPORT NSString * const ZGEngineProfileCompileArgument;
+
+/// Turns an engine profile JSON file into the binary form ZGEngineProfile maps, e.g.
+/// {
+///     "engine": {
+///         "log": { "path": "/tmp/zego", "size": 5242880 },
+///         "customVideoCaptureMain": { "bufferType": "CVPixelBuffer" },
+///         "customVideoRender": { "bufferType": "RawData", "frameFormatSeries": "YUV", "enableEngineRender": false },
+///         "advanced": { "video_max_bitrate_ratio": "1.2" }
+///     },
+///     "videoPresets": {
+///         "720p": { "captureWidth": 1280, "captureHeight": 720, "encodeWidth": 1280, "encodeHeight": 720, "fps": 15, "bitrate": 1130 }
+///     },
+///     "features": { "replayBuffer": true }
+/// }
+///
+/// Buffer types are RawData, GLTexture2D or CVPixelBuffer, format series RGB or YUV, and a preset's optional
+/// "codec" is Default, MultiLayer or VP8. Every part is optional.
+@interface ZGEngineProfileCompiler : NSObject
+
++ (nullable NSData *)compileJSONData:(NSData *)json error:(NSError **)error;
+
++ (BOOL)compileJSONFile:(NSString *)inputPath toFile:(NSString *)outputPath error:(NSError **)error;
+
+/// Run from main() without starting the app
+///
+/// @param arguments Process arguments containing ZGEngineProfileCompileArgument followed by both paths
+/// @return The process exit code
++ (int)runWithArguments:(NSArray<NSString *> *)arguments;
+
+@end
+
+NS_ASSUME_NONNULL_END
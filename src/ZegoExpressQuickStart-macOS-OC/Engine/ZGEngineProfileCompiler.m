@@ -0,0 +1,287 @@
+//
+//  ZGEngineProfileCompiler.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGEngineProfileCompiler.h"
+#import "ZGEngineProfileFormat.h"
+#import <ZegoExpressEngine/ZegoExpressEngine.h>
+
+NSString * const ZGEngineProfileCompileArgument = @"--compile-profile";
+
+static NSString * const ZGEngineProfileCompilerErrorDomain = @"im.zego.engineprofile.compiler";
+
+/// The string section being built, each distinct string stored once
+@interface ZGEngineProfileStringTable : NSObject
+
+@property (nonatomic, strong) NSMutableData *data;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *offsets;
+
+@end
+
+@implementation ZGEngineProfileStringTable
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _data = [NSMutableData data];
+        _offsets = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (ZGEngineProfileString)referenceTo:(NSString *)string {
+    NSData *bytes = [string dataUsingEncoding:NSUTF8StringEncoding];
+    NSNumber *offset = self.offsets[string];
+    if (!offset) {
+        offset = @(self.data.length);
+        self.offsets[string] = offset;
+        [self.data appendData:bytes];
+        [self.data appendBytes:"" length:1];
+    }
+    ZGEngineProfileString reference = { offset.unsignedIntValue, (uint32_t)bytes.length };
+    return reference;
+}
+
+@end
+
+@implementation ZGEngineProfileCompiler
+
++ (BOOL)compileJSONFile:(NSString *)inputPath toFile:(NSString *)outputPath error:(NSError **)error {
+    NSData *json = [NSData dataWithContentsOfFile:inputPath options:0 error:error];
+    if (!json) {
+        return NO;
+    }
+    NSData *profile = [self compileJSONData:json error:error];
+    return profile && [profile writeToFile:outputPath options:NSDataWritingAtomic error:error];
+}
+
++ (NSData *)compileJSONData:(NSData *)json error:(NSError **)error {
+    id object = [NSJSONSerialization JSONObjectWithData:json options:0 error:error];
+    if (!object) {
+        return nil;
+    }
+    if (![object isKindOfClass:[NSDictionary class]]) {
+        [self fillError:error message:@"The engine profile must be a JSON object"];
+        return nil;
+    }
+
+    ZGEngineProfileStringTable *strings = [[ZGEngineProfileStringTable alloc] init];
+    NSMutableArray<NSArray *> *sections = [NSMutableArray array];
+
+    NSDictionary *engine = [self dictionaryIn:object key:@"engine"];
+    if (engine) {
+        NSMutableData *record = [NSMutableData dataWithLength:sizeof(ZGEngineProfileEngineRecord)];
+        if (![self fillEngineRecord:record.mutableBytes from:engine strings:strings error:error]) {
+            return nil;
+        }
+        [sections addObject:@[@(ZGEngineProfileSectionEngine), record, @1]];
+
+        NSDictionary *advanced = [self dictionaryIn:engine key:@"advanced"];
+        if (advanced.count > 0) {
+            NSMutableData *pairs = [NSMutableData data];
+            for (NSString *key in [advanced.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+                if (![advanced[key] isKindOfClass:[NSString class]]) {
+                    [self fillError:error message:[NSString stringWithFormat:@"Advanced config %@ must be a string", key]];
+                    return nil;
+                }
+                ZGEngineProfileStringPair pair = { [strings referenceTo:key], [strings referenceTo:advanced[key]] };
+                [pairs appendBytes:&pair length:sizeof(pair)];
+            }
+            [sections addObject:@[@(ZGEngineProfileSectionAdvanced), pairs, @(advanced.count)]];
+        }
+    }
+
+    NSDictionary *presets = [self dictionaryIn:object key:@"videoPresets"];
+    if (presets.count > 0) {
+        NSMutableData *records = [NSMutableData data];
+        for (NSString *name in [self sortedNames:presets]) {
+            NSDictionary *preset = [self dictionaryIn:presets key:name];
+            if (!preset) {
+                [self fillError:error message:[NSString stringWithFormat:@"Video preset %@ must be a JSON object", name]];
+                return nil;
+            }
+            ZGEngineProfileVideoPresetRecord record = {{0}};
+            if (![self fillPresetRecord:&record from:preset name:name error:error]) {
+                return nil;
+            }
+            record.name = [strings referenceTo:name];
+            [records appendBytes:&record length:sizeof(record)];
+        }
+        [sections addObject:@[@(ZGEngineProfileSectionVideoPresets), records, @(presets.count)]];
+    }
+
+    NSDictionary *features = [self dictionaryIn:object key:@"features"];
+    if (features.count > 0) {
+        NSMutableData *records = [NSMutableData data];
+        for (NSString *name in [self sortedNames:features]) {
+            NSNumber *enabled = [self numberIn:features key:name];
+            if (!enabled) {
+                [self fillError:error message:[NSString stringWithFormat:@"Feature %@ must be true or false", name]];
+                return nil;
+            }
+            ZGEngineProfileFeatureRecord record = { [strings referenceTo:name], enabled.boolValue ? 1 : 0, 0 };
+            [records appendBytes:&record length:sizeof(record)];
+        }
+        [sections addObject:@[@(ZGEngineProfileSectionFeatures), records, @(features.count)]];
+    }
+
+    // First in the file, but built last, once every string is in
+    if (strings.data.length > 0) {
+        [sections insertObject:@[@(ZGEngineProfileSectionStrings), strings.data, @(strings.offsets.count)] atIndex:0];
+    }
+    return [self assembleSections:sections];
+}
+
+/// Header, section table and the sections, each 8 byte aligned
++ (NSData *)assembleSections:(NSArray<NSArray *> *)sections {
+    NSMutableData *file = [NSMutableData dataWithLength:sizeof(ZGEngineProfileHeader) + sections.count * sizeof(ZGEngineProfileSection)];
+    NSMutableData *table = [NSMutableData data];
+    for (NSArray *section in sections) {
+        [file increaseLengthBy:(8 - file.length % 8) % 8];
+        NSData *payload = section[1];
+        ZGEngineProfileSection entry = { [section[0] unsignedIntValue], (uint32_t)file.length, (uint32_t)payload.length, [section[2] unsignedIntValue] };
+        [table appendBytes:&entry length:sizeof(entry)];
+        [file appendData:payload];
+    }
+    ZGEngineProfileHeader header = { ZGEngineProfileMagic, ZGEngineProfileVersion, (uint16_t)sections.count, (uint32_t)file.length, 0 };
+    [file replaceBytesInRange:NSMakeRange(0, sizeof(header)) withBytes:&header];
+    [file replaceBytesInRange:NSMakeRange(sizeof(header), table.length) withBytes:table.bytes];
+    return file;
+}
+
+#pragma mark - Records
+
++ (BOOL)fillEngineRecord:(ZGEngineProfileEngineRecord *)record from:(NSDictionary *)engine strings:(ZGEngineProfileStringTable *)strings error:(NSError **)error {
+    NSDictionary *log = [self dictionaryIn:engine key:@"log"];
+    if (log) {
+        record->flags |= ZGEngineProfileEngineHasLog;
+        NSString *path = [self stringIn:log key:@"path"];
+        if (path) {
+            record->logPath = [strings referenceTo:path];
+        }
+        record->logSize = [[self numberIn:log key:@"size"] unsignedLongLongValue];
+    }
+
+    NSDictionary *bufferTypes = @{@"RawData": @(ZegoVideoBufferTypeRawData), @"GLTexture2D": @(ZegoVideoBufferTypeGLTexture2D), @"CVPixelBuffer": @(ZegoVideoBufferTypeCVPixelBuffer)};
+    NSDictionary *captureMain = [self dictionaryIn:engine key:@"customVideoCaptureMain"];
+    if (captureMain) {
+        NSNumber *bufferType = [self valueIn:captureMain key:@"bufferType" of:bufferTypes error:error];
+        if (!bufferType) {
+            return NO;
+        }
+        record->flags |= ZGEngineProfileEngineHasCaptureMain;
+        record->captureMainBufferType = bufferType.unsignedIntValue;
+    }
+    NSDictionary *captureAux = [self dictionaryIn:engine key:@"customVideoCaptureAux"];
+    if (captureAux) {
+        NSNumber *bufferType = [self valueIn:captureAux key:@"bufferType" of:bufferTypes error:error];
+        if (!bufferType) {
+            return NO;
+        }
+        record->flags |= ZGEngineProfileEngineHasCaptureAux;
+        record->captureAuxBufferType = bufferType.unsignedIntValue;
+    }
+    NSDictionary *render = [self dictionaryIn:engine key:@"customVideoRender"];
+    if (render) {
+        NSNumber *bufferType = [self valueIn:render key:@"bufferType" of:bufferTypes error:error];
+        NSNumber *series = bufferType ? [self valueIn:render key:@"frameFormatSeries" of:@{@"RGB": @(ZegoVideoFrameFormatSeriesRGB), @"YUV": @(ZegoVideoFrameFormatSeriesYUV)} error:error] : nil;
+        if (!series) {
+            return NO;
+        }
+        record->flags |= ZGEngineProfileEngineHasRender;
+        if ([[self numberIn:render key:@"enableEngineRender"] boolValue]) {
+            record->flags |= ZGEngineProfileEngineRenderAlsoByEngine;
+        }
+        record->renderBufferType = bufferType.unsignedIntValue;
+        record->renderFrameFormatSeries = series.unsignedIntValue;
+    }
+    return YES;
+}
+
++ (BOOL)fillPresetRecord:(ZGEngineProfileVideoPresetRecord *)record from:(NSDictionary *)preset name:(NSString *)name error:(NSError **)error {
+    NSArray<NSString *> *required = @[@"captureWidth", @"captureHeight", @"encodeWidth", @"encodeHeight", @"fps", @"bitrate"];
+    for (NSString *key in required) {
+        if ([[self numberIn:preset key:key] intValue] <= 0) {
+            [self fillError:error message:[NSString stringWithFormat:@"Video preset %@ needs a positive %@", name, key]];
+            return NO;
+        }
+    }
+    record->captureWidth = [[self numberIn:preset key:@"captureWidth"] unsignedIntValue];
+    record->captureHeight = [[self numberIn:preset key:@"captureHeight"] unsignedIntValue];
+    record->encodeWidth = [[self numberIn:preset key:@"encodeWidth"] unsignedIntValue];
+    record->encodeHeight = [[self numberIn:preset key:@"encodeHeight"] unsignedIntValue];
+    record->fps = [[self numberIn:preset key:@"fps"] intValue];
+    record->bitrate = [[self numberIn:preset key:@"bitrate"] intValue];
+    if (preset[@"codec"]) {
+        NSNumber *codec = [self valueIn:preset key:@"codec" of:@{@"Default": @(ZegoVideoCodecIDDefault), @"MultiLayer": @(ZegoVideoCodecIDMultiLayer), @"VP8": @(ZegoVideoCodecIDVP8)} error:error];
+        if (!codec) {
+            return NO;
+        }
+        record->codecID = codec.unsignedIntValue;
+    }
+    return YES;
+}
+
+#pragma mark - Command Line
+
++ (int)runWithArguments:(NSArray<NSString *> *)arguments {
+    NSUInteger index = [arguments indexOfObject:ZGEngineProfileCompileArgument];
+    if (index == NSNotFound || index + 2 >= arguments.count) {
+        fprintf(stderr, "usage: %s %s <profile.json> <profile.zgprofile>\n", arguments.firstObject.UTF8String, ZGEngineProfileCompileArgument.UTF8String);
+        return 2;
+    }
+    NSError *error = nil;
+    if (![self compileJSONFile:arguments[index + 1] toFile:arguments[index + 2] error:&error]) {
+        fprintf(stderr, "Cannot compile engine profile: %s\n", error.localizedDescription.UTF8String);
+        return 1;
+    }
+    return 0;
+}
+
+#pragma mark - Helper Methods
+
+/// In the order ZGEngineProfile searches them
++ (NSArray<NSString *> *)sortedNames:(NSDictionary *)dictionary {
+    return [dictionary.allKeys sortedArrayUsingComparator:^NSComparisonResult(NSString *a, NSString *b) {
+        int order = ZGEngineProfileCompareNames(a.UTF8String, strlen(a.UTF8String), b.UTF8String, strlen(b.UTF8String));
+        return order < 0 ? NSOrderedAscending : (order > 0 ? NSOrderedDescending : NSOrderedSame);
+    }];
+}
+
+/// A named enum value, with an error naming the choices when it is missing or unknown
++ (nullable NSNumber *)valueIn:(NSDictionary *)dictionary key:(NSString *)key of:(NSDictionary<NSString *, NSNumber *> *)choices error:(NSError **)error {
+    NSString *name = [self stringIn:dictionary key:key];
+    NSNumber *value = name ? choices[name] : nil;
+    if (!value) {
+        NSString *names = [[choices.allKeys sortedArrayUsingSelector:@selector(compare:)] componentsJoinedByString:@", "];
+        [self fillError:error message:[NSString stringWithFormat:@"%@ must be one of %@", key, names]];
+    }
+    return value;
+}
+
++ (NSDictionary *)dictionaryIn:(NSDictionary *)dictionary key:(NSString *)key {
+    id value = dictionary[key];
+    return [value isKindOfClass:[NSDictionary class]] ? value : nil;
+}
+
++ (NSString *)stringIn:(NSDictionary *)dictionary key:(NSString *)key {
+    id value = dictionary[key];
+    return [value isKindOfClass:[NSString class]] ? value : nil;
+}
+
++ (NSNumber *)numberIn:(NSDictionary *)dictionary key:(NSString *)key {
+    id value = dictionary[key];
+    return [value isKindOfClass:[NSNumber class]] ? value : nil;
+}
+
++ (void)fillError:(NSError **)error message:(NSString *)message {
+    if (error) {
+        *error = [NSError errorWithDomain:ZGEngineProfileCompilerErrorDomain code:-1 userInfo:@{NSLocalizedDescriptionKey: message}];
+    }
+}
+
+@end
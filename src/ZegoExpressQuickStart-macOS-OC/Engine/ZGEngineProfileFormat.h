@@ -0,0 +1,115 @@
+//
+//  ZGEngineProfileFormat.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#ifndef ZGEngineProfileFormat_h
+#define ZGEngineProfileFormat_h
+
+#include <stdint.h>
+#include <string.h>
+
+/// Layout of a compiled engine profile, read in place from a mapped file
+///
+/// A header, a table of sections, then the sections, each 8 byte aligned. All integers are little endian, as
+/// both Mac architectures are. Strings live in the string section and are referred to by offset and length
+/// (they are also NUL terminated); preset and feature names are sorted by their bytes so lookups are binary
+/// searches over the mapped records. A reader skips sections of kinds it does not know, so adding a section
+/// keeps the version; changing a record layout bumps it.
+
+#define ZGEngineProfileMagic 0x5047455Au
+#define ZGEngineProfileVersion 1
+
+typedef enum : uint32_t {
+    ZGEngineProfileSectionStrings = 1,
+    /// One ZGEngineProfileEngineRecord
+    ZGEngineProfileSectionEngine = 2,
+    /// ZGEngineProfileStringPair records, the advanced config of the engine
+    ZGEngineProfileSectionAdvanced = 3,
+    /// ZGEngineProfileVideoPresetRecord records, sorted by name
+    ZGEngineProfileSectionVideoPresets = 4,
+    /// ZGEngineProfileFeatureRecord records, sorted by name
+    ZGEngineProfileSectionFeatures = 5,
+} ZGEngineProfileSectionKind;
+
+typedef enum : uint32_t {
+    ZGEngineProfileEngineHasLog = 1 << 0,
+    ZGEngineProfileEngineHasCaptureMain = 1 << 1,
+    ZGEngineProfileEngineHasCaptureAux = 1 << 2,
+    ZGEngineProfileEngineHasRender = 1 << 3,
+    ZGEngineProfileEngineRenderAlsoByEngine = 1 << 4,
+} ZGEngineProfileEngineFlags;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t sectionCount;
+    uint32_t fileSize;
+    uint32_t reserved;
+} ZGEngineProfileHeader;
+
+typedef struct {
+    uint32_t kind;
+    uint32_t offset;
+    uint32_t length;
+    /// Records in the section
+    uint32_t count;
+} ZGEngineProfileSection;
+
+typedef struct {
+    /// From the start of the string section
+    uint32_t offset;
+    uint32_t length;
+} ZGEngineProfileString;
+
+typedef struct {
+    ZGEngineProfileString key;
+    ZGEngineProfileString value;
+} ZGEngineProfileStringPair;
+
+typedef struct {
+    uint32_t flags;
+    /// ZegoVideoBufferType values
+    uint32_t captureMainBufferType;
+    uint32_t captureAuxBufferType;
+    uint32_t renderBufferType;
+    /// A ZegoVideoFrameFormatSeries
+    uint32_t renderFrameFormatSeries;
+    uint32_t reserved;
+    ZGEngineProfileString logPath;
+    uint64_t logSize;
+} ZGEngineProfileEngineRecord;
+
+typedef struct {
+    ZGEngineProfileString name;
+    uint32_t captureWidth;
+    uint32_t captureHeight;
+    uint32_t encodeWidth;
+    uint32_t encodeHeight;
+    int32_t fps;
+    /// kbps
+    int32_t bitrate;
+    /// A ZegoVideoCodecID
+    uint32_t codecID;
+    uint32_t reserved;
+} ZGEngineProfileVideoPresetRecord;
+
+typedef struct {
+    ZGEngineProfileString name;
+    uint32_t enabled;
+    uint32_t reserved;
+} ZGEngineProfileFeatureRecord;
+
+/// Order of names in the sorted sections: bytewise, a prefix before the longer name
+static inline int ZGEngineProfileCompareNames(const char *a, size_t aLength, const char *b, size_t bLength) {
+    int order = memcmp(a, b, aLength < bLength ? aLength : bLength);
+    if (order != 0) {
+        return order;
+    }
+    return aLength < bLength ? -1 : (aLength > bLength ? 1 : 0);
+}
+
+#endif /* ZGEngineProfileFormat_h */
@@ -0,0 +1,104 @@
+//
+//  ZGExpressEngine.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <ZegoExpressEngine/ZegoExpressEngine.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// The control surface of ZegoExpressEngine that the app-side logic depends on
+///
+/// Helpers take an `id<ZGExpressEngine>` instead of calling [ZegoExpressEngine sharedEngine] directly,
+/// so the same code can drive the real SDK or the local stand-in engine (ZGStandInEngine).
+@protocol ZGExpressEngine <NSObject>
+
+#pragma mark Handler
+
+- (void)setEventHandler:(nullable id<ZegoEventHandler>)eventHandler;
+
+- (void)setCustomVideoRenderHandler:(nullable id<ZegoCustomVideoRenderHandler>)handler;
+
+#pragma mark Room
+
+- (void)loginRoom:(NSString *)roomID user:(ZegoUser *)user;
+
+- (void)loginRoom:(NSString *)roomID user:(ZegoUser *)user config:(ZegoRoomConfig *)config;
+
+- (void)logoutRoom:(NSString *)roomID;
+
+#pragma mark Publisher
+
+- (void)startPreview:(nullable ZegoCanvas *)canvas;
+
+- (void)stopPreview;
+
+- (void)startPublishing:(NSString *)streamID;
+
+- (void)startPublishing:(NSString *)streamID channel:(ZegoPublishChannel)channel;
+
+- (void)stopPublishing;
+
+- (void)stopPublishing:(ZegoPublishChannel)channel;
+
+- (void)setStreamExtraInfo:(NSString *)extraInfo callback:(nullable ZegoPublisherSetStreamExtraInfoCallback)callback;
+
+- (void)addPublishCDNURL:(NSString *)targetURL streamID:(NSString *)streamID callback:(nullable ZegoPublisherUpdateCDNURLCallback)callback;
+
+- (void)removePublishCDNURL:(NSString *)targetURL streamID:(NSString *)streamID callback:(nullable ZegoPublisherUpdateCDNURLCallback)callback;
+
+- (void)mutePublishStreamAudio:(BOOL)mute;
+
+- (void)mutePublishStreamVideo:(BOOL)mute;
+
+- (void)sendCustomVideoCapturePixelBuffer:(CVPixelBufferRef)buffer timeStamp:(CMTime)timeStamp;
+
+- (void)sendCustomVideoCapturePixelBuffer:(CVPixelBufferRef)buffer timeStamp:(CMTime)timeStamp channel:(ZegoPublishChannel)channel;
+
+#pragma mark Player
+
+- (void)startPlayingStream:(NSString *)streamID canvas:(nullable ZegoCanvas *)canvas;
+
+- (void)startPlayingStream:(NSString *)streamID canvas:(nullable ZegoCanvas *)canvas config:(ZegoPlayerConfig *)config;
+
+- (void)stopPlayingStream:(NSString *)streamID;
+
+- (void)setPlayVolume:(int)volume streamID:(NSString *)streamID;
+
+- (void)mutePlayStreamAudio:(BOOL)mute streamID:(NSString *)streamID;
+
+- (void)mutePlayStreamVideo:(BOOL)mute streamID:(NSString *)streamID;
+
+#pragma mark IM
+
+- (void)sendBroadcastMessage:(NSString *)message roomID:(NSString *)roomID callback:(nullable ZegoIMSendBroadcastMessageCallback)callback;
+
+- (void)sendBarrageMessage:(NSString *)message roomID:(NSString *)roomID callback:(nullable ZegoIMSendBarrageMessageCallback)callback;
+
+- (void)sendCustomCommand:(NSString *)command toUserList:(nullable NSArray<ZegoUser *> *)toUserList roomID:(NSString *)roomID callback:(nullable ZegoIMSendCustomCommandCallback)callback;
+
+#pragma mark Mixer
+
+- (void)startMixerTask:(ZegoMixerTask *)task callback:(nullable ZegoMixerStartCallback)callback;
+
+- (void)stopMixerTask:(ZegoMixerTask *)task callback:(nullable ZegoMixerStopCallback)callback;
+
+#pragma mark Device
+
+- (void)startSoundLevelMonitor;
+
+- (void)stopSoundLevelMonitor;
+
+@end
+
+
+/// The real SDK already implements every method of the protocol
+@interface ZegoExpressEngine (ZGExpressEngine) <ZGExpressEngine>
+
+@end
+
+NS_ASSUME_NONNULL_END
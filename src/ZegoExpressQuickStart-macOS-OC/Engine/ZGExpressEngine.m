@@ -0,0 +1,13 @@
+//
+//  ZGExpressEngine.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGExpressEngine.h"
+
+@implementation ZegoExpressEngine (ZGExpressEngine)
+
+@end
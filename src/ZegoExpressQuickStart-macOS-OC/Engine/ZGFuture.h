@@ -0,0 +1,104 @@
+//
+//  ZGFuture.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+FOUNDATION_EXPORT NSString * const ZGFutureErrorDomain;
+
+typedef NS_ENUM(NSInteger, ZGFutureErrorCode) {
+    /// The future was cancelled before it completed
+    ZGFutureErrorCodeCancelled = 1,
+    /// The timeout passed before the future completed
+    ZGFutureErrorCodeTimedOut = 2
+};
+
+/// The eventual result of an asynchronous operation
+///
+/// A future is completed once, either fulfilled with a value or rejected with an error; later attempts are
+/// ignored. Completion blocks run on the queue they were registered with, also when the future has already
+/// completed, so nobody ever has to block waiting for one. Thread safe.
+@interface ZGFuture<__covariant ValueType> : NSObject
+
+/// A pending future, completed by the producer of the result
++ (instancetype)future;
+
++ (instancetype)futureWithValue:(nullable ValueType)value;
+
++ (instancetype)futureWithError:(NSError *)error;
+
+@property (atomic, assign, readonly, getter=isCompleted) BOOL completed;
+
+/// The value once fulfilled, nil otherwise
+@property (atomic, strong, readonly, nullable) ValueType value;
+
+/// The error once rejected, nil otherwise
+@property (atomic, strong, readonly, nullable) NSError *error;
+
+/// Cancelled or timed out, the error tells which
+@property (atomic, assign, readonly, getter=isCancelled) BOOL cancelled;
+
+/// Fulfill the future
+///
+/// @return NO if the future was already completed
+- (BOOL)fulfillWithValue:(nullable ValueType)value;
+
+/// Reject the future
+///
+/// @return NO if the future was already completed
+- (BOOL)rejectWithError:(NSError *)error;
+
+/// Run a block once the future completes
+///
+/// @param queue The queue to run the block on
+/// @param block Receives the value or the error, exactly one of them is meaningful
+- (void)whenCompleteOnQueue:(dispatch_queue_t)queue block:(void (^)(ValueType _Nullable value, NSError * _Nullable error))block;
+
+#pragma mark Cancellation
+
+/// Reject the future with ZGFutureErrorCodeCancelled and run its cancellation handlers
+///
+/// @return NO if the future was already completed
+- (BOOL)cancel;
+
+/// Register how the producer stops the work behind the future, e.g. stop a mixer task
+///
+/// The handler runs synchronously on the cancelling thread, right away if the future is already cancelled, and
+/// never if the future completes normally.
+- (void)onCancel:(dispatch_block_t)handler;
+
+/// Cancel the future with ZGFutureErrorCodeTimedOut unless it completes within the timeout
+///
+/// @return The receiver, so a deadline can be put on a call inline
+- (instancetype)withTimeout:(NSTimeInterval)timeout;
+
+#pragma mark Composition
+
+/// Continue with another operation once this one succeeds
+///
+/// Errors skip the block and pass on to the returned future. Cancelling the returned future cancels whichever
+/// step is running, so a login -> publish -> mix flow reads top to bottom and stops as a whole.
+///
+/// @param block Receives the value and returns the next step's future, or nil to finish with a nil value
+- (ZGFuture *)thenOnQueue:(dispatch_queue_t)queue block:(ZGFuture * _Nullable (^)(ValueType _Nullable value))block;
+
+/// Fulfilled with every value in order (NSNull for nil) once all futures succeed
+///
+/// Rejected with the first error, the other futures are then cancelled. Cancelling the result cancels all of them.
+/// Start the operations first and combine them afterwards, they then run concurrently.
++ (ZGFuture<NSArray *> *)whenAll:(NSArray<ZGFuture *> *)futures;
+
+/// Completed like the first of the futures to complete, the others are then cancelled
+///
+/// Cancelling the result cancels all of them. An empty array gives a future that never completes by itself.
++ (ZGFuture *)whenAny:(NSArray<ZGFuture *> *)futures;
+
+@end
+
+NS_ASSUME_NONNULL_END
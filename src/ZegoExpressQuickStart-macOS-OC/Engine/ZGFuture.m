@@ -0,0 +1,250 @@
+//
+//  ZGFuture.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGFuture.h"
+
+NSString * const ZGFutureErrorDomain = @"im.zego.future";
+
+/// Serializes the bookkeeping of the combinators, their blocks only count and forward
+static dispatch_queue_t ZGFutureCombineQueue(void) {
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        queue = dispatch_queue_create("im.zego.future.combine", DISPATCH_QUEUE_SERIAL);
+    });
+    return queue;
+}
+
+/// A completion block and the queue to run it on
+@interface ZGFutureCallback : NSObject
+
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, copy) void (^block)(id value, NSError *error);
+
+@end
+
+@implementation ZGFutureCallback
+
+@end
+
+@interface ZGFuture ()
+
+@property (atomic, assign, readwrite, getter=isCompleted) BOOL completed;
+@property (atomic, strong, readwrite, nullable) id value;
+@property (atomic, strong, readwrite, nullable) NSError *error;
+@property (atomic, assign, readwrite, getter=isCancelled) BOOL cancelled;
+@property (nonatomic, strong) NSMutableArray<ZGFutureCallback *> *callbacks;
+@property (nonatomic, strong) NSMutableArray<dispatch_block_t> *cancelHandlers;
+
+@end
+
+@implementation ZGFuture
+
++ (instancetype)future {
+    return [[self alloc] init];
+}
+
++ (instancetype)futureWithValue:(id)value {
+    ZGFuture *future = [self future];
+    [future fulfillWithValue:value];
+    return future;
+}
+
++ (instancetype)futureWithError:(NSError *)error {
+    ZGFuture *future = [self future];
+    [future rejectWithError:error];
+    return future;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _callbacks = [NSMutableArray array];
+        _cancelHandlers = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (BOOL)fulfillWithValue:(id)value {
+    return [self completeWithValue:value error:nil cancelled:NO];
+}
+
+- (BOOL)rejectWithError:(NSError *)error {
+    return [self completeWithValue:nil error:error cancelled:NO];
+}
+
+- (BOOL)completeWithValue:(id)value error:(NSError *)error cancelled:(BOOL)cancelled {
+    NSArray<ZGFutureCallback *> *callbacks = nil;
+    NSArray<dispatch_block_t> *cancelHandlers = nil;
+    @synchronized (self) {
+        if (self.completed) {
+            return NO;
+        }
+        self.value = value;
+        self.error = error;
+        self.cancelled = cancelled;
+        self.completed = YES;
+        callbacks = [self.callbacks copy];
+        [self.callbacks removeAllObjects];
+        cancelHandlers = cancelled ? [self.cancelHandlers copy] : nil;
+        [self.cancelHandlers removeAllObjects];
+    }
+    // Run the handlers and callbacks outside the lock, they may well complete other futures
+    for (dispatch_block_t handler in cancelHandlers) {
+        handler();
+    }
+    for (ZGFutureCallback *callback in callbacks) {
+        void (^block)(id, NSError *) = callback.block;
+        dispatch_async(callback.queue, ^{
+            block(value, error);
+        });
+    }
+    return YES;
+}
+
+- (void)whenCompleteOnQueue:(dispatch_queue_t)queue block:(void (^)(id, NSError *))block {
+    @synchronized (self) {
+        if (!self.completed) {
+            ZGFutureCallback *callback = [[ZGFutureCallback alloc] init];
+            callback.queue = queue;
+            callback.block = block;
+            [self.callbacks addObject:callback];
+            return;
+        }
+    }
+    id value = self.value;
+    NSError *error = self.error;
+    dispatch_async(queue, ^{
+        block(value, error);
+    });
+}
+
+#pragma mark - Cancellation
+
+- (BOOL)cancel {
+    NSError *error = [NSError errorWithDomain:ZGFutureErrorDomain code:ZGFutureErrorCodeCancelled userInfo:@{NSLocalizedDescriptionKey: @"Cancelled"}];
+    return [self completeWithValue:nil error:error cancelled:YES];
+}
+
+- (void)onCancel:(dispatch_block_t)handler {
+    @synchronized (self) {
+        if (!self.completed) {
+            [self.cancelHandlers addObject:[handler copy]];
+            return;
+        }
+        if (!self.cancelled) {
+            return;
+        }
+    }
+    handler();
+}
+
+- (instancetype)withTimeout:(NSTimeInterval)timeout {
+    // Weak, the timer alone should not keep a future nobody waits for alive
+    __weak typeof(self) weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(timeout * NSEC_PER_SEC)), dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        NSError *error = [NSError errorWithDomain:ZGFutureErrorDomain code:ZGFutureErrorCodeTimedOut userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"Timed out after %.1fs", timeout]}];
+        [weakSelf completeWithValue:nil error:error cancelled:YES];
+    });
+    return self;
+}
+
+#pragma mark - Composition
+
+- (ZGFuture *)thenOnQueue:(dispatch_queue_t)queue block:(ZGFuture * _Nullable (^)(id _Nullable))block {
+    ZGFuture *result = [ZGFuture future];
+    [self whenCompleteOnQueue:queue block:^(id value, NSError *error) {
+        if (error) {
+            [result rejectWithError:error];
+            return;
+        }
+        // Cancelled in the meantime, do not start the next step
+        if (result.completed) {
+            return;
+        }
+        ZGFuture *next = block(value);
+        if (!next) {
+            [result fulfillWithValue:nil];
+            return;
+        }
+        [result onCancel:^{
+            [next cancel];
+        }];
+        [next whenCompleteOnQueue:ZGFutureCombineQueue() block:^(id nextValue, NSError *nextError) {
+            if (nextError) {
+                [result rejectWithError:nextError];
+            } else {
+                [result fulfillWithValue:nextValue];
+            }
+        }];
+    }];
+    [result onCancel:^{
+        [self cancel];
+    }];
+    return result;
+}
+
++ (ZGFuture<NSArray *> *)whenAll:(NSArray<ZGFuture *> *)futures {
+    ZGFuture<NSArray *> *result = [ZGFuture future];
+    if (futures.count == 0) {
+        [result fulfillWithValue:@[]];
+        return result;
+    }
+
+    // Only touched on the combine queue
+    NSMutableArray *values = [NSMutableArray arrayWithCapacity:futures.count];
+    for (NSUInteger i = 0; i < futures.count; i++) {
+        [values addObject:[NSNull null]];
+    }
+    __block NSUInteger remaining = futures.count;
+
+    [futures enumerateObjectsUsingBlock:^(ZGFuture *future, NSUInteger index, BOOL *stop) {
+        [future whenCompleteOnQueue:ZGFutureCombineQueue() block:^(id value, NSError *error) {
+            if (error) {
+                // One failure fails the group, nobody waits for the rest
+                if ([result rejectWithError:error]) {
+                    [self cancelFutures:futures];
+                }
+                return;
+            }
+            values[index] = value ?: [NSNull null];
+            remaining -= 1;
+            if (remaining == 0) {
+                [result fulfillWithValue:[values copy]];
+            }
+        }];
+    }];
+    [result onCancel:^{
+        [self cancelFutures:futures];
+    }];
+    return result;
+}
+
++ (ZGFuture *)whenAny:(NSArray<ZGFuture *> *)futures {
+    ZGFuture *result = [ZGFuture future];
+    for (ZGFuture *future in futures) {
+        [future whenCompleteOnQueue:ZGFutureCombineQueue() block:^(id value, NSError *error) {
+            BOOL first = error ? [result rejectWithError:error] : [result fulfillWithValue:value];
+            if (first) {
+                [self cancelFutures:futures];
+            }
+        }];
+    }
+    [result onCancel:^{
+        [self cancelFutures:futures];
+    }];
+    return result;
+}
+
++ (void)cancelFutures:(NSArray<ZGFuture *> *)futures {
+    for (ZGFuture *future in futures) {
+        [future cancel];
+    }
+}
+
+@end
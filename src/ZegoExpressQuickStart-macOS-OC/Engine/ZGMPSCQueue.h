@@ -0,0 +1,80 @@
+//
+//  ZGMPSCQueue.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#ifndef ZGMPSCQueue_h
+#define ZGMPSCQueue_h
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+/// Intrusive lock-free multi-producer single-consumer queue (Vyukov)
+///
+/// Any thread may push, only one thread may pop. A push is one atomic exchange and never blocks; a pop may
+/// briefly report empty while a concurrent push is half done, the pushing thread wakes the consumer anyway.
+/// Nodes are owned by the caller, embed ZGMPSCNode in your own struct or allocate it next to the payload.
+
+typedef struct ZGMPSCNode {
+    _Atomic(struct ZGMPSCNode *) next;
+    void *value;
+} ZGMPSCNode;
+
+typedef struct ZGMPSCQueue {
+    /// Producers append here
+    _Atomic(ZGMPSCNode *) head;
+    /// Consumer side
+    ZGMPSCNode *tail;
+    ZGMPSCNode stub;
+} ZGMPSCQueue;
+
+static inline void ZGMPSCQueueInit(ZGMPSCQueue *queue) {
+    atomic_init(&queue->stub.next, NULL);
+    queue->stub.value = NULL;
+    atomic_init(&queue->head, &queue->stub);
+    queue->tail = &queue->stub;
+}
+
+/// Append a node, safe from any thread
+static inline void ZGMPSCQueuePush(ZGMPSCQueue *queue, ZGMPSCNode *node) {
+    atomic_store_explicit(&node->next, NULL, memory_order_relaxed);
+    ZGMPSCNode *previous = atomic_exchange_explicit(&queue->head, node, memory_order_acq_rel);
+    atomic_store_explicit(&previous->next, node, memory_order_release);
+}
+
+/// Take the oldest node, consumer thread only
+///
+/// @return The node, or NULL when the queue is empty or a push is still in progress
+static inline ZGMPSCNode *ZGMPSCQueuePop(ZGMPSCQueue *queue) {
+    ZGMPSCNode *tail = queue->tail;
+    ZGMPSCNode *next = atomic_load_explicit(&tail->next, memory_order_acquire);
+    if (tail == &queue->stub) {
+        if (!next) {
+            return NULL;
+        }
+        queue->tail = next;
+        tail = next;
+        next = atomic_load_explicit(&tail->next, memory_order_acquire);
+    }
+    if (next) {
+        queue->tail = next;
+        return tail;
+    }
+    if (tail != atomic_load_explicit(&queue->head, memory_order_acquire)) {
+        // A producer swapped the head but has not linked its node yet
+        return NULL;
+    }
+    // `tail` is the last node, put the stub behind it so it can be handed out
+    ZGMPSCQueuePush(queue, &queue->stub);
+    next = atomic_load_explicit(&tail->next, memory_order_acquire);
+    if (next) {
+        queue->tail = next;
+        return tail;
+    }
+    return NULL;
+}
+
+#endif /* ZGMPSCQueue_h */
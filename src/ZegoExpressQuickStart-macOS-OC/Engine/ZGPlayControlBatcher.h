@@ -0,0 +1,74 @@
+//
+//  ZGPlayControlBatcher.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ZGEngineCommandProxy.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface ZGPlayControlBatcherStatistics : NSObject
+
+/// Setter calls received
+@property (nonatomic, assign) NSUInteger requestedUpdates;
+/// SDK calls actually made
+@property (nonatomic, assign) NSUInteger issuedCalls;
+/// Ticks that made at least one SDK call
+@property (nonatomic, assign) NSUInteger activeTicks;
+/// Most SDK calls still owed after a tick, i.e. how far the rate limit pushed work out
+@property (nonatomic, assign) NSUInteger maxBacklog;
+
+@end
+
+/// Collects the intended mute and volume state of played streams and applies only the difference, once per tick
+///
+/// Layout and policy code just states what each stream should look like, as often as it likes. Every tick the
+/// batcher compares the intended state with what it last applied, and makes the minimal set of
+/// mutePlayStreamVideo / mutePlayStreamAudio / setPlayVolume calls, at most `maxCallsPerTick` of them, in a
+/// single command on the engine command thread. A change that is undone within the tick costs nothing, and a
+/// burst of 30 mutes is spread over several ticks. Streams are served round robin so none starves. A change
+/// only counts as applied once its batch ran on an engine; without one it is tried again on a later tick.
+@interface ZGPlayControlBatcher : NSObject
+
+- (instancetype)initWithCommandProxy:(ZGEngineCommandProxy *)commandProxy;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Default 0.05 s, takes effect on the next `start`
+@property (nonatomic, assign) NSTimeInterval tickInterval;
+
+/// Default 8, i.e. 160 calls per second at the default tick
+@property (nonatomic, assign) NSUInteger maxCallsPerTick;
+
+- (void)start;
+
+/// Stop ticking, changes that were not applied yet stay pending for the next `start`
+- (void)stop;
+
+#pragma mark Intended state, any thread
+
+- (void)setVideoMuted:(BOOL)muted streamID:(NSString *)streamID;
+
+- (void)setAudioMuted:(BOOL)muted streamID:(NSString *)streamID;
+
+/// @param volume 0 ~ 100
+- (void)setVolume:(int)volume streamID:(NSString *)streamID;
+
+/// Forget a stream that stopped playing, it starts from the SDK defaults (unmuted, volume 100) when played again
+- (void)removeStream:(NSString *)streamID;
+
+/// Keep the intended state but forget what was applied, for a stream whose playback was restarted
+///
+/// stopPlayingStream resets the SDK's mute and volume of the stream, so the intended state is applied again
+/// from the defaults on the next tick. Call it after submitting the restart.
+- (void)invalidateStream:(NSString *)streamID;
+
+- (ZGPlayControlBatcherStatistics *)statistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
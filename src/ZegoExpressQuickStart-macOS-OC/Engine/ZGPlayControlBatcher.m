@@ -0,0 +1,287 @@
+//
+//  ZGPlayControlBatcher.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGPlayControlBatcher.h"
+
+#pragma mark - State
+
+/// The controls of one played stream, starts at the SDK defaults
+@interface ZGPlayControlState : NSObject <NSCopying>
+
+@property (nonatomic, assign) BOOL videoMuted;
+@property (nonatomic, assign) BOOL audioMuted;
+@property (nonatomic, assign) int volume;
+
+/// Number of SDK calls needed to get from this state to `other`
+- (NSUInteger)differenceTo:(ZGPlayControlState *)other;
+
+@end
+
+@implementation ZGPlayControlState
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _volume = 100;
+    }
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    ZGPlayControlState *copy = [[ZGPlayControlState alloc] init];
+    copy.videoMuted = self.videoMuted;
+    copy.audioMuted = self.audioMuted;
+    copy.volume = self.volume;
+    return copy;
+}
+
+- (NSUInteger)differenceTo:(ZGPlayControlState *)other {
+    return (self.videoMuted != other.videoMuted) + (self.audioMuted != other.audioMuted) + (self.volume != other.volume);
+}
+
+@end
+
+@implementation ZGPlayControlBatcherStatistics
+
+@end
+
+#pragma mark - Batcher
+
+@interface ZGPlayControlBatcher ()
+
+@property (nonatomic, strong) ZGEngineCommandProxy *commandProxy;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) dispatch_source_t timer;
+
+// Everything below is only touched on `queue`
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZGPlayControlState *> *intendedStates;
+/// What the engine is known to have, recorded once a batch ran on an engine
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZGPlayControlState *> *appliedStates;
+/// What a batch still on its way to the command thread will leave the engine with
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZGPlayControlState *> *pendingStates;
+/// Streams whose intended state may differ from the applied one
+@property (nonatomic, strong) NSMutableSet<NSString *> *dirtyStreamIDs;
+/// Where the next tick starts in the sorted dirty streams
+@property (nonatomic, assign) NSUInteger cursor;
+@property (nonatomic, strong) ZGPlayControlBatcherStatistics *counters;
+
+@end
+
+@implementation ZGPlayControlBatcher
+
+- (instancetype)initWithCommandProxy:(ZGEngineCommandProxy *)commandProxy {
+    self = [super init];
+    if (self) {
+        _commandProxy = commandProxy;
+        _tickInterval = 0.05;
+        _maxCallsPerTick = 8;
+        _queue = dispatch_queue_create("im.zego.control.batcher", DISPATCH_QUEUE_SERIAL);
+        _intendedStates = [NSMutableDictionary dictionary];
+        _appliedStates = [NSMutableDictionary dictionary];
+        _pendingStates = [NSMutableDictionary dictionary];
+        _dirtyStreamIDs = [NSMutableSet set];
+        _counters = [[ZGPlayControlBatcherStatistics alloc] init];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_timer) {
+        dispatch_source_cancel(_timer);
+    }
+}
+
+#pragma mark - Lifecycle
+
+- (void)start {
+    if (self.timer) {
+        return;
+    }
+    __weak typeof(self) weakSelf = self;
+    uint64_t interval = (uint64_t)(self.tickInterval * NSEC_PER_SEC);
+    self.timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.queue);
+    dispatch_source_set_timer(self.timer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)interval), interval, interval / 10);
+    dispatch_source_set_event_handler(self.timer, ^{
+        [weakSelf tick];
+    });
+    dispatch_resume(self.timer);
+}
+
+- (void)stop {
+    if (self.timer) {
+        dispatch_source_cancel(self.timer);
+        self.timer = nil;
+    }
+}
+
+- (ZGPlayControlBatcherStatistics *)statistics {
+    ZGPlayControlBatcherStatistics *snapshot = [[ZGPlayControlBatcherStatistics alloc] init];
+    dispatch_sync(self.queue, ^{
+        snapshot.requestedUpdates = self.counters.requestedUpdates;
+        snapshot.issuedCalls = self.counters.issuedCalls;
+        snapshot.activeTicks = self.counters.activeTicks;
+        snapshot.maxBacklog = self.counters.maxBacklog;
+    });
+    return snapshot;
+}
+
+#pragma mark - Intended state
+
+- (void)setVideoMuted:(BOOL)muted streamID:(NSString *)streamID {
+    [self updateStream:streamID block:^(ZGPlayControlState *state) {
+        state.videoMuted = muted;
+    }];
+}
+
+- (void)setAudioMuted:(BOOL)muted streamID:(NSString *)streamID {
+    [self updateStream:streamID block:^(ZGPlayControlState *state) {
+        state.audioMuted = muted;
+    }];
+}
+
+- (void)setVolume:(int)volume streamID:(NSString *)streamID {
+    int clamped = MAX(0, MIN(100, volume));
+    [self updateStream:streamID block:^(ZGPlayControlState *state) {
+        state.volume = clamped;
+    }];
+}
+
+- (void)removeStream:(NSString *)streamID {
+    dispatch_async(self.queue, ^{
+        [self.intendedStates removeObjectForKey:streamID];
+        [self.appliedStates removeObjectForKey:streamID];
+        [self.pendingStates removeObjectForKey:streamID];
+        [self.dirtyStreamIDs removeObject:streamID];
+    });
+}
+
+- (void)invalidateStream:(NSString *)streamID {
+    dispatch_async(self.queue, ^{
+        [self.appliedStates removeObjectForKey:streamID];
+        // A batch already queued may still run before the restart, it must not count as applied after it
+        [self.pendingStates removeObjectForKey:streamID];
+        if (self.intendedStates[streamID]) {
+            [self.dirtyStreamIDs addObject:streamID];
+        }
+    });
+}
+
+- (void)updateStream:(NSString *)streamID block:(void (^)(ZGPlayControlState *state))block {
+    dispatch_async(self.queue, ^{
+        ZGPlayControlState *state = self.intendedStates[streamID];
+        if (!state) {
+            state = [[ZGPlayControlState alloc] init];
+            self.intendedStates[streamID] = state;
+        }
+        block(state);
+        [self.dirtyStreamIDs addObject:streamID];
+        self.counters.requestedUpdates += 1;
+    });
+}
+
+#pragma mark - Tick
+
+- (void)tick {
+    if (self.dirtyStreamIDs.count == 0) {
+        return;
+    }
+
+    // Sorted so the round robin cursor means the same thing from tick to tick
+    NSArray<NSString *> *streamIDs = [self.dirtyStreamIDs.allObjects sortedArrayUsingSelector:@selector(compare:)];
+    NSUInteger start = self.cursor % streamIDs.count;
+    NSUInteger budget = self.maxCallsPerTick;
+    NSMutableArray<void (^)(id<ZGExpressEngine>)> *calls = [NSMutableArray array];
+    NSMutableDictionary<NSString *, ZGPlayControlState *> *targets = [NSMutableDictionary dictionary];
+
+    for (NSUInteger i = 0; i < streamIDs.count && calls.count < budget; i++) {
+        NSString *streamID = streamIDs[(start + i) % streamIDs.count];
+        ZGPlayControlState *intended = self.intendedStates[streamID];
+        ZGPlayControlState *target = [[self currentStateOf:streamID] copy];
+        NSUInteger callCount = calls.count;
+
+        if (intended.videoMuted != target.videoMuted && calls.count < budget) {
+            BOOL muted = intended.videoMuted;
+            [calls addObject:^(id<ZGExpressEngine> engine) {
+                [engine mutePlayStreamVideo:muted streamID:streamID];
+            }];
+            target.videoMuted = muted;
+        }
+        if (intended.audioMuted != target.audioMuted && calls.count < budget) {
+            BOOL muted = intended.audioMuted;
+            [calls addObject:^(id<ZGExpressEngine> engine) {
+                [engine mutePlayStreamAudio:muted streamID:streamID];
+            }];
+            target.audioMuted = muted;
+        }
+        if (intended.volume != target.volume && calls.count < budget) {
+            int volume = intended.volume;
+            [calls addObject:^(id<ZGExpressEngine> engine) {
+                [engine setPlayVolume:volume streamID:streamID];
+            }];
+            target.volume = volume;
+        }
+
+        if (calls.count > callCount) {
+            self.pendingStates[streamID] = target;
+            targets[streamID] = target;
+        }
+        if ([target differenceTo:intended] == 0) {
+            [self.dirtyStreamIDs removeObject:streamID];
+        }
+        self.cursor = start + i + 1;
+    }
+
+    NSUInteger backlog = 0;
+    for (NSString *streamID in self.dirtyStreamIDs) {
+        backlog += [[self currentStateOf:streamID] differenceTo:self.intendedStates[streamID]];
+    }
+    self.counters.maxBacklog = MAX(self.counters.maxBacklog, backlog);
+
+    if (calls.count == 0) {
+        return;
+    }
+    self.counters.issuedCalls += calls.count;
+    self.counters.activeTicks += 1;
+
+    // One hop to the command thread per tick, however many streams changed
+    __weak typeof(self) weakSelf = self;
+    [self.commandProxy submitCommand:@"playControlBatch" block:^(id<ZGExpressEngine> engine) {
+        if (engine) {
+            for (void (^call)(id<ZGExpressEngine>) in calls) {
+                call(engine);
+            }
+        }
+        [weakSelf confirmTargets:targets applied:engine != nil];
+    }];
+}
+
+/// Called from the command thread once a batch ran, or found no engine to run on
+- (void)confirmTargets:(NSDictionary<NSString *, ZGPlayControlState *> *)targets applied:(BOOL)applied {
+    dispatch_async(self.queue, ^{
+        [targets enumerateKeysAndObjectsUsingBlock:^(NSString *streamID, ZGPlayControlState *target, BOOL *stop) {
+            // Invalidated or removed meanwhile, or a later batch is on its way and will confirm its own state
+            if (self.pendingStates[streamID] != target) {
+                return;
+            }
+            [self.pendingStates removeObjectForKey:streamID];
+            if (applied) {
+                self.appliedStates[streamID] = target;
+            } else if (self.intendedStates[streamID]) {
+                // Nothing ran, try again on a later tick
+                [self.dirtyStreamIDs addObject:streamID];
+            }
+        }];
+    });
+}
+
+/// The state the engine has, or will have once the queued batches ran
+- (ZGPlayControlState *)currentStateOf:(NSString *)streamID {
+    return self.pendingStates[streamID] ?: self.appliedStates[streamID] ?: [[ZGPlayControlState alloc] init];
+}
+
+@end
@@ -0,0 +1,98 @@
+//
+//  ZGRoomTokenManager.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <ZegoExpressEngine/ZegoExpressEngine.h>
+#import "ZGFuture.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+FOUNDATION_EXPORT NSString * const ZGRoomTokenErrorDomain;
+
+typedef NS_ENUM(NSInteger, ZGRoomTokenErrorCode) {
+    /// The provider succeeded without a token
+    ZGRoomTokenErrorCodeEmptyToken = 1
+};
+
+/// A room token as issued by the business server
+@interface ZGRoomToken : NSObject
+
+@property (nonatomic, copy) NSString *token;
+/// Validity counted from the moment the token was requested
+@property (nonatomic, assign) NSTimeInterval expiresIn;
+
++ (instancetype)tokenWithString:(NSString *)token expiresIn:(NSTimeInterval)expiresIn;
+
+@end
+
+/// Issues room tokens, usually a request to the business server
+@protocol ZGRoomTokenProvider <NSObject>
+
+- (ZGFuture<ZGRoomToken *> *)fetchTokenForRoomID:(NSString *)roomID userID:(NSString *)userID;
+
+@end
+
+@interface ZGRoomTokenStatistics : NSObject
+
+/// Token requests answered from the cache
+@property (nonatomic, assign) NSUInteger hits;
+/// Token requests that had to wait for a fetch
+@property (nonatomic, assign) NSUInteger misses;
+@property (nonatomic, assign) NSUInteger fetches;
+@property (nonatomic, assign) NSUInteger failedFetches;
+/// Failed fetches covered by a cached token that was still valid
+@property (nonatomic, assign) NSUInteger fallbacks;
+
+@end
+
+/// Keeps room tokens ready before they are needed, so loginRoom does not wait for the business server
+///
+/// Tell it which rooms are likely next with `prefetchRoomIDs:`; it fetches their tokens in the background and
+/// keeps every token it holds fresh by refetching it `refreshLeadTime` before it expires. When a refetch
+/// fails, the still valid token keeps being served while retries back off. Rooms that were neither
+/// prefetched nor asked for within `retention` are forgotten, and at most `capacity` rooms are kept.
+@interface ZGRoomTokenManager : NSObject
+
+- (instancetype)initWithProvider:(id<ZGRoomTokenProvider>)provider userID:(NSString *)userID;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Default 60 s, at most half of a token's lifetime
+@property (nonatomic, assign) NSTimeInterval refreshLeadTime;
+
+/// A token closer to expiry than this is not handed out, default 5 s
+@property (nonatomic, assign) NSTimeInterval minimumValidity;
+
+/// Default 600 s
+@property (nonatomic, assign) NSTimeInterval retention;
+
+/// Default 8 rooms
+@property (nonatomic, assign) NSUInteger capacity;
+
+/// Start refreshing in the background
+- (void)start;
+
+- (void)stop;
+
+/// Fetch tokens for these rooms now unless a fresh one is cached
+- (void)prefetchRoomIDs:(NSArray<NSString *> *)roomIDs;
+
+/// The token for a room, right away when cached
+- (ZGFuture<NSString *> *)tokenForRoomID:(NSString *)roomID;
+
+/// A room config carrying the token, for loginRoom:user:config:
+- (ZGFuture<ZegoRoomConfig *> *)roomConfigForRoomID:(NSString *)roomID;
+
+/// Drop a token the server rejected, the next request fetches a new one
+- (void)invalidateTokenForRoomID:(NSString *)roomID;
+
+- (ZGRoomTokenStatistics *)statistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,292 @@
+//
+//  ZGRoomTokenManager.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGRoomTokenManager.h"
+#import "ZGClock.h"
+
+NSString * const ZGRoomTokenErrorDomain = @"im.zego.room.token";
+
+/// How often the cache looks for tokens to refresh
+static const NSTimeInterval ZGRoomTokenRefreshCheckInterval = 1.0;
+
+/// Upper bound of the retry back-off after failed fetches
+static const NSTimeInterval ZGRoomTokenMaxRetryDelay = 30.0;
+
+@implementation ZGRoomToken
+
++ (instancetype)tokenWithString:(NSString *)token expiresIn:(NSTimeInterval)expiresIn {
+    ZGRoomToken *roomToken = [[ZGRoomToken alloc] init];
+    roomToken.token = token;
+    roomToken.expiresIn = expiresIn;
+    return roomToken;
+}
+
+@end
+
+@implementation ZGRoomTokenStatistics
+
+@end
+
+#pragma mark - Entry
+
+/// The cached token of one room
+@interface ZGRoomTokenEntry : NSObject
+
+@property (nonatomic, copy) NSString *roomID;
+@property (nonatomic, copy, nullable) NSString *token;
+/// ZGClockNow() time the token stops being valid
+@property (nonatomic, assign) double expiryTime;
+/// How long the token was valid for when it was fetched
+@property (nonatomic, assign) NSTimeInterval lifetime;
+/// The fetch in flight, shared by everyone asking meanwhile
+@property (nonatomic, strong, nullable) ZGFuture<NSString *> *fetch;
+@property (nonatomic, assign) NSUInteger failures;
+@property (nonatomic, assign) double nextRetryTime;
+@property (nonatomic, assign) double lastWantedTime;
+
+@end
+
+@implementation ZGRoomTokenEntry
+
+@end
+
+#pragma mark - Manager
+
+@interface ZGRoomTokenManager ()
+
+@property (nonatomic, strong) id<ZGRoomTokenProvider> provider;
+@property (nonatomic, copy) NSString *userID;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) dispatch_source_t timer;
+
+// Only touched on `queue`
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZGRoomTokenEntry *> *entries;
+@property (nonatomic, strong) ZGRoomTokenStatistics *counters;
+
+@end
+
+@implementation ZGRoomTokenManager
+
+- (instancetype)initWithProvider:(id<ZGRoomTokenProvider>)provider userID:(NSString *)userID {
+    self = [super init];
+    if (self) {
+        _provider = provider;
+        _userID = [userID copy];
+        _refreshLeadTime = 60;
+        _minimumValidity = 5;
+        _retention = 600;
+        _capacity = 8;
+        _queue = dispatch_queue_create("im.zego.room.token", DISPATCH_QUEUE_SERIAL);
+        _entries = [NSMutableDictionary dictionary];
+        _counters = [[ZGRoomTokenStatistics alloc] init];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_timer) {
+        dispatch_source_cancel(_timer);
+    }
+}
+
+#pragma mark - Lifecycle
+
+- (void)start {
+    if (self.timer) {
+        return;
+    }
+    __weak typeof(self) weakSelf = self;
+    uint64_t interval = (uint64_t)(ZGRoomTokenRefreshCheckInterval * NSEC_PER_SEC);
+    self.timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.queue);
+    dispatch_source_set_timer(self.timer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)interval), interval, interval / 5);
+    dispatch_source_set_event_handler(self.timer, ^{
+        [weakSelf refreshEntries];
+    });
+    dispatch_resume(self.timer);
+}
+
+- (void)stop {
+    if (self.timer) {
+        dispatch_source_cancel(self.timer);
+        self.timer = nil;
+    }
+}
+
+- (ZGRoomTokenStatistics *)statistics {
+    ZGRoomTokenStatistics *snapshot = [[ZGRoomTokenStatistics alloc] init];
+    dispatch_sync(self.queue, ^{
+        snapshot.hits = self.counters.hits;
+        snapshot.misses = self.counters.misses;
+        snapshot.fetches = self.counters.fetches;
+        snapshot.failedFetches = self.counters.failedFetches;
+        snapshot.fallbacks = self.counters.fallbacks;
+    });
+    return snapshot;
+}
+
+#pragma mark - Tokens
+
+- (void)prefetchRoomIDs:(NSArray<NSString *> *)roomIDs {
+    dispatch_async(self.queue, ^{
+        double now = ZGClockNow();
+        for (NSString *roomID in roomIDs) {
+            ZGRoomTokenEntry *entry = [self entryForRoomID:roomID];
+            entry.lastWantedTime = now;
+            [self renewEntryIfDue:entry now:now];
+        }
+        [self trimEntries];
+    });
+}
+
+- (ZGFuture<NSString *> *)tokenForRoomID:(NSString *)roomID {
+    ZGFuture<NSString *> *result = [ZGFuture future];
+    dispatch_async(self.queue, ^{
+        double now = ZGClockNow();
+        ZGRoomTokenEntry *entry = [self entryForRoomID:roomID];
+        entry.lastWantedTime = now;
+        if (entry.token && entry.expiryTime - now > self.minimumValidity) {
+            self.counters.hits += 1;
+            [result fulfillWithValue:entry.token];
+            // Served from the cache, but renew it early if it is getting old
+            [self renewEntryIfDue:entry now:now];
+            return;
+        }
+        self.counters.misses += 1;
+        [[self fetchEntry:entry] whenCompleteOnQueue:self.queue block:^(NSString *token, NSError *error) {
+            if (error) {
+                [result rejectWithError:error];
+            } else {
+                [result fulfillWithValue:token];
+            }
+        }];
+        [self trimEntries];
+    });
+    return result;
+}
+
+- (ZGFuture<ZegoRoomConfig *> *)roomConfigForRoomID:(NSString *)roomID {
+    ZGFuture<ZegoRoomConfig *> *result = [ZGFuture future];
+    [[self tokenForRoomID:roomID] whenCompleteOnQueue:self.queue block:^(NSString *token, NSError *error) {
+        if (error) {
+            [result rejectWithError:error];
+            return;
+        }
+        ZegoRoomConfig *config = [ZegoRoomConfig defaultConfig];
+        config.token = token;
+        [result fulfillWithValue:config];
+    }];
+    return result;
+}
+
+- (void)invalidateTokenForRoomID:(NSString *)roomID {
+    dispatch_async(self.queue, ^{
+        ZGRoomTokenEntry *entry = self.entries[roomID];
+        entry.token = nil;
+        entry.expiryTime = 0;
+        entry.nextRetryTime = 0;
+    });
+}
+
+#pragma mark - Helper Methods
+
+- (ZGRoomTokenEntry *)entryForRoomID:(NSString *)roomID {
+    ZGRoomTokenEntry *entry = self.entries[roomID];
+    if (!entry) {
+        entry = [[ZGRoomTokenEntry alloc] init];
+        entry.roomID = roomID;
+        self.entries[roomID] = entry;
+    }
+    return entry;
+}
+
+/// Valid for longer than the refresh lead, nothing to do
+- (BOOL)isFresh:(ZGRoomTokenEntry *)entry now:(double)now {
+    // A lead as long as the token's life would refetch it on every tick
+    NSTimeInterval lead = MIN(self.refreshLeadTime, 0.5 * entry.lifetime);
+    return entry.token && entry.expiryTime - now > lead;
+}
+
+- (ZGFuture<NSString *> *)fetchEntry:(ZGRoomTokenEntry *)entry {
+    if (entry.fetch) {
+        return entry.fetch;
+    }
+    ZGFuture<NSString *> *fetch = [ZGFuture future];
+    entry.fetch = fetch;
+    self.counters.fetches += 1;
+
+    // Expiry counts from the request, the token may have been issued at any point of the round trip
+    double requestTime = ZGClockNow();
+    [[self.provider fetchTokenForRoomID:entry.roomID userID:self.userID] whenCompleteOnQueue:self.queue block:^(ZGRoomToken *roomToken, NSError *error) {
+        entry.fetch = nil;
+        double now = ZGClockNow();
+        if (!error && roomToken.token.length > 0) {
+            entry.token = roomToken.token;
+            entry.expiryTime = requestTime + roomToken.expiresIn;
+            entry.lifetime = roomToken.expiresIn;
+            entry.failures = 0;
+            entry.nextRetryTime = 0;
+            [fetch fulfillWithValue:roomToken.token];
+            return;
+        }
+
+        self.counters.failedFetches += 1;
+        entry.failures += 1;
+        entry.nextRetryTime = now + MIN(ZGRoomTokenMaxRetryDelay, pow(2, entry.failures));
+        if (entry.token && entry.expiryTime - now > self.minimumValidity) {
+            self.counters.fallbacks += 1;
+            [fetch fulfillWithValue:entry.token];
+            return;
+        }
+        [fetch rejectWithError:error ?: [NSError errorWithDomain:ZGRoomTokenErrorDomain code:ZGRoomTokenErrorCodeEmptyToken userInfo:@{NSLocalizedDescriptionKey: @"The token provider returned an empty token"}]];
+    }];
+    return fetch;
+}
+
+- (void)refreshEntries {
+    double now = ZGClockNow();
+    for (ZGRoomTokenEntry *entry in self.entries.allValues) {
+        if (entry.fetch || now < entry.nextRetryTime) {
+            continue;
+        }
+        if (now - entry.lastWantedTime > self.retention) {
+            [self.entries removeObjectForKey:entry.roomID];
+            continue;
+        }
+        [self renewEntryIfDue:entry now:now];
+    }
+}
+
+/// Fetch a token that is getting old, unless a fetch is running or a failed one is still backing off
+- (void)renewEntryIfDue:(ZGRoomTokenEntry *)entry now:(double)now {
+    if (entry.fetch || now < entry.nextRetryTime || [self isFresh:entry now:now]) {
+        return;
+    }
+    [self fetchEntry:entry];
+}
+
+/// Drop the least recently wanted rooms beyond the capacity
+///
+/// Rooms with a fetch in flight stay, the next lookup would start the same fetch again.
+- (void)trimEntries {
+    if (self.entries.count <= self.capacity) {
+        return;
+    }
+    NSArray<ZGRoomTokenEntry *> *entries = [self.entries.allValues sortedArrayUsingComparator:^NSComparisonResult(ZGRoomTokenEntry *a, ZGRoomTokenEntry *b) {
+        return [@(a.lastWantedTime) compare:@(b.lastWantedTime)];
+    }];
+    for (ZGRoomTokenEntry *entry in entries) {
+        if (self.entries.count <= self.capacity) {
+            break;
+        }
+        if (!entry.fetch) {
+            [self.entries removeObjectForKey:entry.roomID];
+        }
+    }
+}
+
+@end
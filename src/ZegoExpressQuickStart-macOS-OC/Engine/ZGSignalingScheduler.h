@@ -0,0 +1,110 @@
+//
+//  ZGSignalingScheduler.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ZGAsyncEngine.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Priority classes of outbound signaling, a lower value is served first
+typedef NS_ENUM(NSUInteger, ZGSignalingClass) {
+    /// Stream extra info, mixer tasks, CDN URLs
+    ZGSignalingClassControl = 0,
+    /// Custom commands between users
+    ZGSignalingClassCommand = 1,
+    /// Broadcast and barrage messages
+    ZGSignalingClassChat = 2
+};
+
+static const NSUInteger ZGSignalingClassCount = 3;
+
+FOUNDATION_EXPORT NSString * const ZGSignalingSchedulerErrorDomain;
+
+typedef NS_ENUM(NSInteger, ZGSignalingSchedulerErrorCode) {
+    /// The deadline passed while the message was still queued, it was never sent
+    ZGSignalingSchedulerErrorCodeExpired = 1
+};
+
+@interface ZGSignalingClassMetrics : NSObject
+
+@property (nonatomic, assign) ZGSignalingClass signalingClass;
+@property (nonatomic, assign) NSUInteger submittedCount;
+@property (nonatomic, assign) NSUInteger sentCount;
+@property (nonatomic, assign) NSUInteger expiredCount;
+/// Waiting right now
+@property (nonatomic, assign) NSUInteger queuedCount;
+/// Time from submission until sent, over the last 512 sent messages
+@property (nonatomic, assign) double meanDelayMs;
+@property (nonatomic, assign) double p95DelayMs;
+@property (nonatomic, assign) double maxDelayMs;
+
+@end
+
+/// Orders all outbound signaling so that control traffic keeps a bounded latency under a chat flood
+///
+/// Messages wait in one queue per class, ordered by deadline. A message is sent when both its class bucket
+/// and the shared bucket (the signaling path itself) have a token; classes are served strictly by priority, so
+/// chat only gets what control and commands leave over, and a class can never take more than its own rate.
+/// Messages whose deadline passes in the queue are dropped and their future is rejected with
+/// ZGSignalingSchedulerErrorCodeExpired rather than being sent stale.
+@interface ZGSignalingScheduler : NSObject
+
+- (instancetype)initWithAsyncEngine:(ZGAsyncEngine *)asyncEngine;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// The shared signaling path, default 20 messages per second with a burst of 20
+@property (nonatomic, assign) double globalRatePerSecond;
+@property (nonatomic, assign) double globalBurst;
+
+/// Defaults: control 20/s burst 10, command 10/s burst 10, chat 5/s burst 10
+- (void)setRatePerSecond:(double)rate burst:(double)burst forClass:(ZGSignalingClass)signalingClass;
+
+/// How long a message of the class may wait by default: control 1 s, command 2 s, chat 5 s
+- (void)setDefaultTimeout:(NSTimeInterval)timeout forClass:(ZGSignalingClass)signalingClass;
+
+- (void)start;
+
+- (void)stop;
+
+/// Queue any signaling operation
+///
+/// @param timeout How long the message may wait in the queue, 0 for the class default
+/// @param operation Sends the message, called on the scheduler queue and must not block
+/// @return Completed like the operation's future; cancelling it unqueues the message or cancels the operation
+- (ZGFuture *)submitClass:(ZGSignalingClass)signalingClass timeout:(NSTimeInterval)timeout operation:(ZGFuture * (^)(void))operation;
+
+#pragma mark Control
+
+- (ZGFuture *)setStreamExtraInfo:(NSString *)extraInfo;
+
+- (ZGFuture<NSDictionary *> *)startMixerTask:(ZegoMixerTask *)task;
+
+- (ZGFuture *)stopMixerTask:(ZegoMixerTask *)task;
+
+- (ZGFuture *)addPublishCDNURL:(NSString *)targetURL streamID:(NSString *)streamID;
+
+- (ZGFuture *)removePublishCDNURL:(NSString *)targetURL streamID:(NSString *)streamID;
+
+#pragma mark Command
+
+- (ZGFuture *)sendCustomCommand:(NSString *)command toUserList:(nullable NSArray<ZegoUser *> *)toUserList roomID:(NSString *)roomID;
+
+#pragma mark Chat
+
+- (ZGFuture<NSNumber *> *)sendBroadcastMessage:(NSString *)message roomID:(NSString *)roomID;
+
+- (ZGFuture<NSString *> *)sendBarrageMessage:(NSString *)message roomID:(NSString *)roomID;
+
+#pragma mark Metrics
+
+- (ZGSignalingClassMetrics *)metricsForClass:(ZGSignalingClass)signalingClass;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,399 @@
+//
+//  ZGSignalingScheduler.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGSignalingScheduler.h"
+#import "ZGClock.h"
+
+NSString * const ZGSignalingSchedulerErrorDomain = @"im.zego.signaling.scheduler";
+
+/// Queue delays kept per class for the percentiles
+static const NSUInteger ZGSignalingDelaySampleCount = 512;
+
+/// Queued messages are looked at this often when no submission wakes the scheduler
+static const NSTimeInterval ZGSignalingPumpInterval = 0.01;
+
+typedef struct ZGTokenBucket {
+    double ratePerSecond;
+    double burst;
+    double tokens;
+    double lastRefillTime;
+} ZGTokenBucket;
+
+static void ZGTokenBucketRefill(ZGTokenBucket *bucket, double now) {
+    bucket->tokens = MIN(bucket->burst, bucket->tokens + (now - bucket->lastRefillTime) * bucket->ratePerSecond);
+    bucket->lastRefillTime = now;
+}
+
+#pragma mark - Item
+
+@interface ZGSignalingItem : NSObject
+
+@property (nonatomic, copy) ZGFuture * (^operation)(void);
+@property (nonatomic, strong) ZGFuture *future;
+@property (nonatomic, assign) double submitTime;
+@property (nonatomic, assign) double deadline;
+
+@end
+
+@implementation ZGSignalingItem
+
+@end
+
+#pragma mark - Lane
+
+/// The queue and figures of one class
+@interface ZGSignalingLane : NSObject {
+@public
+    ZGTokenBucket _bucket;
+    double _delays[ZGSignalingDelaySampleCount];
+}
+
+/// Ordered by deadline
+@property (nonatomic, strong) NSMutableArray<ZGSignalingItem *> *items;
+@property (nonatomic, assign) NSTimeInterval defaultTimeout;
+@property (nonatomic, assign) NSUInteger submittedCount;
+@property (nonatomic, assign) NSUInteger sentCount;
+@property (nonatomic, assign) NSUInteger expiredCount;
+@property (nonatomic, assign) NSUInteger delayCount;
+@property (nonatomic, assign) double maxDelayMs;
+
+@end
+
+@implementation ZGSignalingLane
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _items = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)insertItem:(ZGSignalingItem *)item {
+    // Deadlines mostly arrive in order, search from the back
+    NSUInteger index = self.items.count;
+    while (index > 0 && self.items[index - 1].deadline > item.deadline) {
+        index--;
+    }
+    [self.items insertObject:item atIndex:index];
+}
+
+- (void)recordDelayMs:(double)delayMs {
+    _delays[self.delayCount % ZGSignalingDelaySampleCount] = delayMs;
+    self.delayCount += 1;
+    self.maxDelayMs = MAX(self.maxDelayMs, delayMs);
+}
+
+@end
+
+@implementation ZGSignalingClassMetrics
+
+@end
+
+#pragma mark - Scheduler
+
+@interface ZGSignalingScheduler () {
+    ZGTokenBucket _globalBucket;
+}
+
+@property (nonatomic, strong) ZGAsyncEngine *asyncEngine;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) dispatch_source_t timer;
+/// Indexed by ZGSignalingClass, only touched on `queue`
+@property (nonatomic, strong) NSArray<ZGSignalingLane *> *lanes;
+
+@end
+
+@implementation ZGSignalingScheduler
+
+- (instancetype)initWithAsyncEngine:(ZGAsyncEngine *)asyncEngine {
+    self = [super init];
+    if (self) {
+        _asyncEngine = asyncEngine;
+        _queue = dispatch_queue_create("im.zego.signaling.scheduler", DISPATCH_QUEUE_SERIAL);
+
+        double now = ZGClockNow();
+        _globalBucket = (ZGTokenBucket){20, 20, 20, now};
+
+        NSMutableArray<ZGSignalingLane *> *lanes = [NSMutableArray array];
+        const double rates[ZGSignalingClassCount] = {20, 10, 5};
+        const NSTimeInterval timeouts[ZGSignalingClassCount] = {1, 2, 5};
+        for (NSUInteger i = 0; i < ZGSignalingClassCount; i++) {
+            ZGSignalingLane *lane = [[ZGSignalingLane alloc] init];
+            lane->_bucket = (ZGTokenBucket){rates[i], 10, 10, now};
+            lane.defaultTimeout = timeouts[i];
+            [lanes addObject:lane];
+        }
+        _lanes = lanes;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_timer) {
+        dispatch_source_cancel(_timer);
+    }
+}
+
+#pragma mark - Configuration
+
+- (double)globalRatePerSecond {
+    __block double rate = 0;
+    dispatch_sync(self.queue, ^{
+        rate = self->_globalBucket.ratePerSecond;
+    });
+    return rate;
+}
+
+- (void)setGlobalRatePerSecond:(double)globalRatePerSecond {
+    dispatch_async(self.queue, ^{
+        ZGTokenBucketRefill(&self->_globalBucket, ZGClockNow());
+        self->_globalBucket.ratePerSecond = globalRatePerSecond;
+    });
+}
+
+- (double)globalBurst {
+    __block double burst = 0;
+    dispatch_sync(self.queue, ^{
+        burst = self->_globalBucket.burst;
+    });
+    return burst;
+}
+
+- (void)setGlobalBurst:(double)globalBurst {
+    dispatch_async(self.queue, ^{
+        self->_globalBucket.burst = globalBurst;
+        self->_globalBucket.tokens = MIN(self->_globalBucket.tokens, globalBurst);
+    });
+}
+
+- (void)setRatePerSecond:(double)rate burst:(double)burst forClass:(ZGSignalingClass)signalingClass {
+    dispatch_async(self.queue, ^{
+        ZGSignalingLane *lane = self.lanes[signalingClass];
+        ZGTokenBucketRefill(&lane->_bucket, ZGClockNow());
+        lane->_bucket.ratePerSecond = rate;
+        lane->_bucket.burst = burst;
+        lane->_bucket.tokens = MIN(lane->_bucket.tokens, burst);
+    });
+}
+
+- (void)setDefaultTimeout:(NSTimeInterval)timeout forClass:(ZGSignalingClass)signalingClass {
+    dispatch_async(self.queue, ^{
+        self.lanes[signalingClass].defaultTimeout = timeout;
+    });
+}
+
+#pragma mark - Lifecycle
+
+- (void)start {
+    if (self.timer) {
+        return;
+    }
+    __weak typeof(self) weakSelf = self;
+    uint64_t interval = (uint64_t)(ZGSignalingPumpInterval * NSEC_PER_SEC);
+    self.timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.queue);
+    dispatch_source_set_timer(self.timer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)interval), interval, interval / 10);
+    dispatch_source_set_event_handler(self.timer, ^{
+        [weakSelf pump];
+    });
+    dispatch_resume(self.timer);
+}
+
+- (void)stop {
+    if (self.timer) {
+        dispatch_source_cancel(self.timer);
+        self.timer = nil;
+    }
+}
+
+#pragma mark - Submission
+
+- (ZGFuture *)submitClass:(ZGSignalingClass)signalingClass timeout:(NSTimeInterval)timeout operation:(ZGFuture * (^)(void))operation {
+    ZGSignalingItem *item = [[ZGSignalingItem alloc] init];
+    item.operation = operation;
+    item.future = [ZGFuture future];
+    item.submitTime = ZGClockNow();
+
+    __weak typeof(self) weakSelf = self;
+    __weak ZGSignalingItem *weakItem = item;
+    [item.future onCancel:^{
+        [weakSelf unqueueItem:weakItem signalingClass:signalingClass];
+    }];
+
+    dispatch_async(self.queue, ^{
+        ZGSignalingLane *lane = self.lanes[signalingClass];
+        item.deadline = item.submitTime + (timeout > 0 ? timeout : lane.defaultTimeout);
+        lane.submittedCount += 1;
+        if (item.future.completed) {
+            return;
+        }
+        [lane insertItem:item];
+        [self pump];
+    });
+    return item.future;
+}
+
+- (void)unqueueItem:(ZGSignalingItem *)item signalingClass:(ZGSignalingClass)signalingClass {
+    if (!item) {
+        return;
+    }
+    dispatch_async(self.queue, ^{
+        [self.lanes[signalingClass].items removeObjectIdenticalTo:item];
+    });
+}
+
+#pragma mark - Pump
+
+- (void)pump {
+    double now = ZGClockNow();
+    ZGTokenBucketRefill(&_globalBucket, now);
+
+    for (ZGSignalingLane *lane in self.lanes) {
+        ZGTokenBucketRefill(&lane->_bucket, now);
+        // Items are ordered by deadline, the expired ones are at the front
+        while (lane.items.count > 0 && lane.items.firstObject.deadline < now) {
+            ZGSignalingItem *item = lane.items.firstObject;
+            [lane.items removeObjectAtIndex:0];
+            lane.expiredCount += 1;
+            [item.future rejectWithError:[NSError errorWithDomain:ZGSignalingSchedulerErrorDomain code:ZGSignalingSchedulerErrorCodeExpired userInfo:@{NSLocalizedDescriptionKey: @"Expired in the signaling queue"}]];
+        }
+    }
+
+    while (_globalBucket.tokens >= 1) {
+        ZGSignalingLane *chosen = nil;
+        for (ZGSignalingLane *lane in self.lanes) {
+            if (lane.items.count > 0 && lane->_bucket.tokens >= 1) {
+                chosen = lane;
+                break;
+            }
+        }
+        if (!chosen) {
+            break;
+        }
+        _globalBucket.tokens -= 1;
+        chosen->_bucket.tokens -= 1;
+
+        ZGSignalingItem *item = chosen.items.firstObject;
+        [chosen.items removeObjectAtIndex:0];
+        chosen.sentCount += 1;
+        [chosen recordDelayMs:(now - item.submitTime) * 1000];
+        [self sendItem:item];
+    }
+}
+
+- (void)sendItem:(ZGSignalingItem *)item {
+    ZGFuture *future = item.future;
+    ZGFuture *sent = item.operation();
+    [future onCancel:^{
+        [sent cancel];
+    }];
+    [sent whenCompleteOnQueue:self.queue block:^(id value, NSError *error) {
+        if (error) {
+            [future rejectWithError:error];
+        } else {
+            [future fulfillWithValue:value];
+        }
+    }];
+}
+
+#pragma mark - Control
+
+- (ZGFuture *)setStreamExtraInfo:(NSString *)extraInfo {
+    ZGAsyncEngine *asyncEngine = self.asyncEngine;
+    return [self submitClass:ZGSignalingClassControl timeout:0 operation:^ZGFuture *{
+        return [asyncEngine setStreamExtraInfo:extraInfo];
+    }];
+}
+
+- (ZGFuture<NSDictionary *> *)startMixerTask:(ZegoMixerTask *)task {
+    ZGAsyncEngine *asyncEngine = self.asyncEngine;
+    return [self submitClass:ZGSignalingClassControl timeout:0 operation:^ZGFuture *{
+        return [asyncEngine startMixerTask:task];
+    }];
+}
+
+- (ZGFuture *)stopMixerTask:(ZegoMixerTask *)task {
+    ZGAsyncEngine *asyncEngine = self.asyncEngine;
+    return [self submitClass:ZGSignalingClassControl timeout:0 operation:^ZGFuture *{
+        return [asyncEngine stopMixerTask:task];
+    }];
+}
+
+- (ZGFuture *)addPublishCDNURL:(NSString *)targetURL streamID:(NSString *)streamID {
+    ZGAsyncEngine *asyncEngine = self.asyncEngine;
+    return [self submitClass:ZGSignalingClassControl timeout:0 operation:^ZGFuture *{
+        return [asyncEngine addPublishCDNURL:targetURL streamID:streamID];
+    }];
+}
+
+- (ZGFuture *)removePublishCDNURL:(NSString *)targetURL streamID:(NSString *)streamID {
+    ZGAsyncEngine *asyncEngine = self.asyncEngine;
+    return [self submitClass:ZGSignalingClassControl timeout:0 operation:^ZGFuture *{
+        return [asyncEngine removePublishCDNURL:targetURL streamID:streamID];
+    }];
+}
+
+#pragma mark - Command
+
+- (ZGFuture *)sendCustomCommand:(NSString *)command toUserList:(NSArray<ZegoUser *> *)toUserList roomID:(NSString *)roomID {
+    ZGAsyncEngine *asyncEngine = self.asyncEngine;
+    return [self submitClass:ZGSignalingClassCommand timeout:0 operation:^ZGFuture *{
+        return [asyncEngine sendCustomCommand:command toUserList:toUserList roomID:roomID];
+    }];
+}
+
+#pragma mark - Chat
+
+- (ZGFuture<NSNumber *> *)sendBroadcastMessage:(NSString *)message roomID:(NSString *)roomID {
+    ZGAsyncEngine *asyncEngine = self.asyncEngine;
+    return [self submitClass:ZGSignalingClassChat timeout:0 operation:^ZGFuture *{
+        return [asyncEngine sendBroadcastMessage:message roomID:roomID];
+    }];
+}
+
+- (ZGFuture<NSString *> *)sendBarrageMessage:(NSString *)message roomID:(NSString *)roomID {
+    ZGAsyncEngine *asyncEngine = self.asyncEngine;
+    return [self submitClass:ZGSignalingClassChat timeout:0 operation:^ZGFuture *{
+        return [asyncEngine sendBarrageMessage:message roomID:roomID];
+    }];
+}
+
+#pragma mark - Metrics
+
+- (ZGSignalingClassMetrics *)metricsForClass:(ZGSignalingClass)signalingClass {
+    ZGSignalingClassMetrics *metrics = [[ZGSignalingClassMetrics alloc] init];
+    metrics.signalingClass = signalingClass;
+    dispatch_sync(self.queue, ^{
+        ZGSignalingLane *lane = self.lanes[signalingClass];
+        metrics.submittedCount = lane.submittedCount;
+        metrics.sentCount = lane.sentCount;
+        metrics.expiredCount = lane.expiredCount;
+        metrics.queuedCount = lane.items.count;
+        metrics.maxDelayMs = lane.maxDelayMs;
+
+        NSUInteger count = MIN(lane.delayCount, ZGSignalingDelaySampleCount);
+        if (count == 0) {
+            return;
+        }
+        double samples[ZGSignalingDelaySampleCount];
+        double sum = 0;
+        for (NSUInteger i = 0; i < count; i++) {
+            samples[i] = lane->_delays[i];
+            sum += samples[i];
+        }
+        qsort_b(samples, count, sizeof(double), ^int(const void *a, const void *b) {
+            double x = *(const double *)a, y = *(const double *)b;
+            return x < y ? -1 : (x > y ? 1 : 0);
+        });
+        metrics.meanDelayMs = sum / count;
+        metrics.p95DelayMs = samples[MIN(count - 1, (NSUInteger)(count * 0.95))];
+    });
+    return metrics;
+}
+
+@end
@@ -0,0 +1,56 @@
+//
+//  ZGAsyncFileWriter.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ZGByteSink.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface ZGAsyncFileWriterStatistics : NSObject
+
+@property (nonatomic, assign) uint64_t bytesWritten;
+@property (nonatomic, assign) NSUInteger writes;
+/// Appends that had to wait for a buffer because every one was still being written
+@property (nonatomic, assign) NSUInteger stalls;
+@property (nonatomic, assign) double averageWriteMs;
+/// NO when the file system would not bypass the page cache and writes go through it
+@property (nonatomic, assign) BOOL uncached;
+
+@end
+
+/// Writes a file asynchronously from a pool of page aligned buffers
+///
+/// Appends are copied into the current buffer; a full buffer is handed to a random-access dispatch I/O channel at
+/// its offset in the file, so several writes are in flight at once and the appending thread never waits for the
+/// disk. A buffer goes back to the pool when the channel lets go of it. Only when all `bufferCount` buffers are
+/// in flight, because the disk is slower than the input, does an append wait for one.
+///
+/// The file is opened with F_NOCACHE so recordings do not push everything else out of the page cache, and every
+/// full buffer is written at a multiple of `bufferSize`; where the file system does not support that the writes
+/// simply go through the cache. A flush writes the part filled so far from a copy, and the whole buffer is
+/// written again once it is full. Buffers are accounted to ZGMemorySubsystemIO. Safe to call from any thread.
+@interface ZGAsyncFileWriter : NSObject <ZGByteSink>
+
+/// 8 buffers of 1 MB
++ (nullable instancetype)writerWithURL:(NSURL *)url error:(NSError **)error;
+
+/// Create or truncate the file at `url`
+///
+/// @param bufferSize Rounded up to whole pages
+/// @param bufferCount At least 2
++ (nullable instancetype)writerWithURL:(NSURL *)url bufferSize:(size_t)bufferSize bufferCount:(NSUInteger)bufferCount error:(NSError **)error;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, copy, readonly) NSURL *url;
+
+- (ZGAsyncFileWriterStatistics *)statistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,341 @@
+//
+//  ZGAsyncFileWriter.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGAsyncFileWriter.h"
+#import "ZGMemoryAccountant.h"
+#import "ZGClock.h"
+#import <pthread.h>
+#import <fcntl.h>
+#import <unistd.h>
+
+static NSString * const ZGAsyncFileWriterErrorDomain = @"im.zego.asyncwriter";
+
+@implementation ZGAsyncFileWriterStatistics
+
+- (instancetype)snapshot {
+    ZGAsyncFileWriterStatistics *snapshot = [[ZGAsyncFileWriterStatistics alloc] init];
+    snapshot.bytesWritten = self.bytesWritten;
+    snapshot.writes = self.writes;
+    snapshot.stalls = self.stalls;
+    snapshot.averageWriteMs = self.averageWriteMs;
+    snapshot.uncached = self.uncached;
+    return snapshot;
+}
+
+@end
+
+@interface ZGAsyncFileWriter ()
+
+@property (nonatomic, copy, readwrite) NSURL *url;
+/// Guarded by the statistics lock, as is `firstError`
+@property (nonatomic, strong) ZGAsyncFileWriterStatistics *counters;
+@property (nonatomic, strong, nullable) NSError *firstError;
+@property (nonatomic, strong) ZGMemoryAllocation *allocation;
+
+@end
+
+@implementation ZGAsyncFileWriter {
+    dispatch_io_t _channel;
+    dispatch_queue_t _ioQueue;
+    dispatch_group_t _inFlight;
+    size_t _bufferSize;
+    NSUInteger _bufferCount;
+
+    /// The pool, buffers come back from the channel's queue
+    pthread_mutex_t _poolLock;
+    dispatch_semaphore_t _freeBuffers;
+    void **_pool;
+    NSUInteger _pooled;
+
+    /// Append state
+    pthread_mutex_t _lock;
+    void *_current;
+    uint64_t _currentOffset;
+    size_t _filled;
+    uint64_t _length;
+    BOOL _closed;
+
+    pthread_mutex_t _statisticsLock;
+}
+
++ (instancetype)writerWithURL:(NSURL *)url error:(NSError **)error {
+    return [self writerWithURL:url bufferSize:1024 * 1024 bufferCount:8 error:error];
+}
+
++ (instancetype)writerWithURL:(NSURL *)url bufferSize:(size_t)bufferSize bufferCount:(NSUInteger)bufferCount error:(NSError **)error {
+    if (!url.isFileURL || bufferSize == 0 || bufferCount < 2) {
+        [self fillError:error message:@"The async file writer needs a file URL and at least 2 buffers"];
+        return nil;
+    }
+    int fd = open(url.fileSystemRepresentation, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        [self fillError:error message:[NSString stringWithFormat:@"Cannot open %@: %s", url.path, strerror(errno)]];
+        return nil;
+    }
+    return [[self alloc] initWithURL:url fileDescriptor:fd bufferSize:bufferSize bufferCount:bufferCount];
+}
+
+- (instancetype)initWithURL:(NSURL *)url fileDescriptor:(int)fd bufferSize:(size_t)bufferSize bufferCount:(NSUInteger)bufferCount {
+    self = [super init];
+    if (self) {
+        _url = [url copy];
+        _counters = [[ZGAsyncFileWriterStatistics alloc] init];
+        // Bypassing the cache is an optimisation, a file system without it still gets cached writes
+        _counters.uncached = fcntl(fd, F_NOCACHE, 1) == 0;
+
+        size_t pageSize = (size_t)getpagesize();
+        _bufferSize = (bufferSize + pageSize - 1) / pageSize * pageSize;
+        _bufferCount = bufferCount;
+        _pool = calloc(bufferCount, sizeof(void *));
+        for (NSUInteger i = 0; i < bufferCount; i++) {
+            posix_memalign(&_pool[i], pageSize, _bufferSize);
+        }
+        _pooled = bufferCount;
+        _freeBuffers = dispatch_semaphore_create((long)bufferCount);
+        _allocation = [[ZGMemoryAccountant sharedAccountant] trackBytes:_bufferSize * bufferCount streamID:nil subsystem:ZGMemorySubsystemIO label:@"async file writer"];
+
+        pthread_mutex_init(&_poolLock, NULL);
+        pthread_mutex_init(&_lock, NULL);
+        pthread_mutex_init(&_statisticsLock, NULL);
+        _ioQueue = dispatch_queue_create("im.zego.asyncwriter", DISPATCH_QUEUE_SERIAL);
+        _inFlight = dispatch_group_create();
+        _channel = dispatch_io_create(DISPATCH_IO_RANDOM, fd, _ioQueue, ^(int error) {
+            close(fd);
+        });
+    }
+    return self;
+}
+
+- (void)dealloc {
+    // Every write in flight holds the writer, so nothing is in flight any more; what was never flushed still goes
+    if (!_closed) {
+        if (_filled > 0) {
+            dispatch_data_t data = dispatch_data_create(_current, _filled, _ioQueue, DISPATCH_DATA_DESTRUCTOR_DEFAULT);
+            dispatch_io_write(_channel, (off_t)_currentOffset, data, _ioQueue, ^(bool done, dispatch_data_t remaining, int error) {
+            });
+        }
+        dispatch_io_close(_channel, 0);
+    }
+    free(_current);
+    for (NSUInteger i = 0; i < _pooled; i++) {
+        free(_pool[i]);
+    }
+    free(_pool);
+    [[ZGMemoryAccountant sharedAccountant] releaseAllocation:_allocation];
+    pthread_mutex_destroy(&_poolLock);
+    pthread_mutex_destroy(&_lock);
+    pthread_mutex_destroy(&_statisticsLock);
+}
+
+#pragma mark - ZGByteSink
+
+- (uint64_t)length {
+    pthread_mutex_lock(&_lock);
+    uint64_t length = _length;
+    pthread_mutex_unlock(&_lock);
+    return length;
+}
+
+- (BOOL)appendData:(NSData *)data {
+    __block BOOL appended = YES;
+    // Dispatch data and the like come in several pieces
+    [data enumerateByteRangesUsingBlock:^(const void *bytes, NSRange byteRange, BOOL *stop) {
+        appended = [self appendBytes:bytes length:byteRange.length];
+        *stop = !appended;
+    }];
+    return appended;
+}
+
+- (BOOL)appendBytes:(const void *)bytes length:(size_t)length {
+    pthread_mutex_lock(&_lock);
+    if (_closed || [self hasFailed]) {
+        pthread_mutex_unlock(&_lock);
+        return NO;
+    }
+    const uint8_t *source = bytes;
+    while (length > 0) {
+        if (!_current) {
+            _current = [self takeBuffer];
+        }
+        size_t count = MIN(length, _bufferSize - _filled);
+        memcpy((uint8_t *)_current + _filled, source, count);
+        _filled += count;
+        _length += count;
+        source += count;
+        length -= count;
+        if (_filled == _bufferSize) {
+            [self writeBuffer:_current length:_bufferSize atOffset:_currentOffset];
+            _current = NULL;
+            _currentOffset += _bufferSize;
+            _filled = 0;
+        }
+    }
+    pthread_mutex_unlock(&_lock);
+    return YES;
+}
+
+- (BOOL)replaceBytesAtOffset:(uint64_t)offset withBytes:(const void *)bytes length:(size_t)length {
+    pthread_mutex_lock(&_lock);
+    if (_closed || offset > _length || length > _length - offset) {
+        pthread_mutex_unlock(&_lock);
+        return NO;
+    }
+    // The part still in the current buffer is simply changed there
+    uint64_t end = offset + length;
+    if (end > _currentOffset) {
+        uint64_t start = MAX(offset, _currentOffset);
+        memcpy((uint8_t *)_current + (start - _currentOffset), (const uint8_t *)bytes + (start - offset), (size_t)(end - start));
+        end = start;
+    }
+    // The part already handed over is written again, after what is in flight for it
+    if (end > offset) {
+        dispatch_io_barrier(_channel, ^{
+        });
+        [self writeCopyOfBytes:bytes length:(size_t)(end - offset) atOffset:offset];
+        dispatch_io_barrier(_channel, ^{
+        });
+    }
+    pthread_mutex_unlock(&_lock);
+    return YES;
+}
+
+- (void)flushWithCompletion:(ZGByteSinkCompletion)completion {
+    pthread_mutex_lock(&_lock);
+    [self writeCurrentPart];
+    pthread_mutex_unlock(&_lock);
+    dispatch_group_notify(_inFlight, dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        if (completion) {
+            completion([self errorSoFar]);
+        }
+    });
+}
+
+- (void)closeWithCompletion:(ZGByteSinkCompletion)completion {
+    pthread_mutex_lock(&_lock);
+    if (_closed) {
+        pthread_mutex_unlock(&_lock);
+        if (completion) {
+            dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+                completion([self errorSoFar]);
+            });
+        }
+        return;
+    }
+    _closed = YES;
+    [self writeCurrentPart];
+    void *current = _current;
+    _current = NULL;
+    _filled = 0;
+    pthread_mutex_unlock(&_lock);
+
+    dispatch_group_notify(_inFlight, dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        if (current) {
+            [self returnBuffer:current];
+        }
+        dispatch_io_close(self->_channel, 0);
+        if (completion) {
+            completion([self errorSoFar]);
+        }
+    });
+}
+
+- (ZGAsyncFileWriterStatistics *)statistics {
+    pthread_mutex_lock(&_statisticsLock);
+    ZGAsyncFileWriterStatistics *snapshot = [self.counters snapshot];
+    pthread_mutex_unlock(&_statisticsLock);
+    return snapshot;
+}
+
+#pragma mark - Helper Methods
+
+/// A free buffer, waiting for one when all are being written. Called with the append lock held
+- (void *)takeBuffer {
+    if (dispatch_semaphore_wait(_freeBuffers, DISPATCH_TIME_NOW) != 0) {
+        pthread_mutex_lock(&_statisticsLock);
+        self.counters.stalls += 1;
+        pthread_mutex_unlock(&_statisticsLock);
+        dispatch_semaphore_wait(_freeBuffers, DISPATCH_TIME_FOREVER);
+    }
+    pthread_mutex_lock(&_poolLock);
+    void *buffer = _pool[--_pooled];
+    pthread_mutex_unlock(&_poolLock);
+    return buffer;
+}
+
+- (void)returnBuffer:(void *)buffer {
+    pthread_mutex_lock(&_poolLock);
+    _pool[_pooled++] = buffer;
+    pthread_mutex_unlock(&_poolLock);
+    dispatch_semaphore_signal(_freeBuffers);
+}
+
+/// Hand a pool buffer to the channel, it comes back to the pool once the channel is done with it
+- (void)writeBuffer:(void *)buffer length:(size_t)length atOffset:(uint64_t)offset {
+    dispatch_data_t data = dispatch_data_create(buffer, length, _ioQueue, ^{
+        [self returnBuffer:buffer];
+    });
+    [self writeData:data atOffset:offset];
+}
+
+- (void)writeCopyOfBytes:(const void *)bytes length:(size_t)length atOffset:(uint64_t)offset {
+    [self writeData:dispatch_data_create(bytes, length, _ioQueue, DISPATCH_DATA_DESTRUCTOR_DEFAULT) atOffset:offset];
+}
+
+/// Write the filled part of the current buffer from a copy, the buffer itself stays to be filled up
+///
+/// The barrier keeps the full write of the buffer from overtaking this one. Called with the append lock held.
+- (void)writeCurrentPart {
+    if (_filled == 0) {
+        return;
+    }
+    [self writeCopyOfBytes:_current length:_filled atOffset:_currentOffset];
+    dispatch_io_barrier(_channel, ^{
+    });
+}
+
+- (void)writeData:(dispatch_data_t)data atOffset:(uint64_t)offset {
+    size_t length = dispatch_data_get_size(data);
+    double startTime = ZGClockNow();
+    dispatch_group_enter(_inFlight);
+    dispatch_io_write(_channel, (off_t)offset, data, _ioQueue, ^(bool done, dispatch_data_t remaining, int error) {
+        if (!done) {
+            return;
+        }
+        size_t written = length - (remaining ? dispatch_data_get_size(remaining) : 0);
+        double writeMs = (ZGClockNow() - startTime) * 1000;
+        pthread_mutex_lock(&self->_statisticsLock);
+        self.counters.bytesWritten += written;
+        self.counters.writes += 1;
+        self.counters.averageWriteMs += (writeMs - self.counters.averageWriteMs) / MIN(self.counters.writes, 100);
+        if ((error != 0 || written < length) && !self.firstError) {
+            int code = error != 0 ? error : EIO;
+            self.firstError = [NSError errorWithDomain:NSPOSIXErrorDomain code:code userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"Writing %@ failed: %s", self.url.lastPathComponent, strerror(code)]}];
+        }
+        pthread_mutex_unlock(&self->_statisticsLock);
+        dispatch_group_leave(self->_inFlight);
+    });
+}
+
+- (BOOL)hasFailed {
+    return [self errorSoFar] != nil;
+}
+
+- (nullable NSError *)errorSoFar {
+    pthread_mutex_lock(&_statisticsLock);
+    NSError *error = self.firstError;
+    pthread_mutex_unlock(&_statisticsLock);
+    return error;
+}
+
++ (void)fillError:(NSError **)error message:(NSString *)message {
+    if (error) {
+        *error = [NSError errorWithDomain:ZGAsyncFileWriterErrorDomain code:-1 userInfo:@{NSLocalizedDescriptionKey: message}];
+    }
+}
+
+@end
@@ -0,0 +1,41 @@
+//
+//  ZGByteSink.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef void(^ZGByteSinkCompletion)(NSError * _Nullable error);
+
+/// Where recorders and loggers put their bytes, so they never deal with files or blocking writes themselves
+///
+/// Bytes go out in the order they are appended. Errors of the underlying writes are reported by the next flush or
+/// close; appending after an error or after close is a no-op that returns NO.
+@protocol ZGByteSink <NSObject>
+
+/// Bytes appended so far, the offset the next append goes to
+@property (nonatomic, assign, readonly) uint64_t length;
+
+- (BOOL)appendBytes:(const void *)bytes length:(size_t)length;
+
+- (BOOL)appendData:(NSData *)data;
+
+/// Overwrite bytes appended before, e.g. the sizes in a WAV header once the recording is done
+///
+/// @return NO when the range goes beyond `length`
+- (BOOL)replaceBytesAtOffset:(uint64_t)offset withBytes:(const void *)bytes length:(size_t)length;
+
+/// Called on a private queue once everything appended so far is handed to the system
+- (void)flushWithCompletion:(nullable ZGByteSinkCompletion)completion;
+
+/// Flush and let go of the destination
+- (void)closeWithCompletion:(nullable ZGByteSinkCompletion)completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
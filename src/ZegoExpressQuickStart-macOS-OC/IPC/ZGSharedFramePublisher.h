@@ -0,0 +1,69 @@
+//
+//  ZGSharedFramePublisher.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreMedia/CoreMedia.h>
+#import <ZegoExpressEngine/ZegoExpressEngine.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+FOUNDATION_EXPORT NSString * const ZGSharedFrameErrorDomain;
+
+@interface ZGSharedFramePublisherStatistics : NSObject
+
+@property (nonatomic, assign) NSUInteger publishedFrames;
+/// Frames not published because every slot was held by a subscriber, or the frame did not fit a slot
+@property (nonatomic, assign) NSUInteger droppedFrames;
+@property (nonatomic, assign) NSUInteger subscribers;
+/// Subscriber processes that died holding slots, whose references were taken back
+@property (nonatomic, assign) NSUInteger reclaimedSubscribers;
+@property (nonatomic, assign) double averageCopyMs;
+
+@end
+
+/// Shares video frames with other processes of the machine through a shared memory ring
+///
+/// Creates the POSIX shared memory object `name` holding `slotCount` slots of `slotBytes` each (see
+/// ZGSharedFrameRing.h for the layout and the reference protocol), and a named semaphore per subscriber place.
+/// Each frame is copied once, straight into a free slot; subscribers read it in place and are woken through their
+/// semaphore, so a frame reaches another process within microseconds of the copy. A frame is dropped rather than
+/// waited for when every slot is held.
+///
+/// As a custom video render handler it publishes the remote frames of onRemoteVideoFrameRawData and forwards every
+/// callback to `nextHandler`; publishPixelBuffer:timeStamp:streamID: takes custom capture frames, e.g. from the
+/// frameHandler of ZGCaptureFanout. Both may publish at the same time from their own threads; the copies run in
+/// parallel and only taking a slot and numbering the frame are serialised.
+///
+/// Names are limited to 30 characters by macOS. A sandboxed app must start them with its application group
+/// identifier followed by "/", and both sides need that group in their entitlements. This app's group is
+/// $(TeamIdentifierPrefix)zgframes, so its names look like "Y98YBP7T6D.zgframes/camera".
+@interface ZGSharedFramePublisher : NSObject <ZegoCustomVideoRenderHandler>
+
+/// @param slotCount 2 ~ 64
+/// @param slotBytes Plane bytes of the largest frame, e.g. 1920 * 1080 * 4 for 1080p BGRA
++ (nullable instancetype)publisherWithName:(NSString *)name slotCount:(NSUInteger)slotCount slotBytes:(size_t)slotBytes error:(NSError **)error;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, copy, readonly) NSString *name;
+
+@property (nonatomic, strong, nullable) id<ZegoCustomVideoRenderHandler> nextHandler;
+
+/// Publish planes laid out as the SDK hands them over
+///
+/// @param timeStamp Seconds on the ZGClockNow() clock
+- (BOOL)publishPlanes:(unsigned char * _Nonnull * _Nonnull)data dataLength:(unsigned int *)dataLength param:(ZegoVideoFrameParam *)param timeStamp:(double)timeStamp streamID:(NSString *)streamID;
+
+/// Publish a BGRA32 or NV12 capture frame, its time stamp taken to be on the host clock
+- (BOOL)publishPixelBuffer:(CVPixelBufferRef)buffer timeStamp:(CMTime)timeStamp streamID:(NSString *)streamID;
+
+- (ZGSharedFramePublisherStatistics *)statistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,352 @@
+//
+//  ZGSharedFramePublisher.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGSharedFramePublisher.h"
+#import "ZGSharedFrameRing.h"
+#import "ZGVideoFrameUtilities.h"
+#import "ZGClock.h"
+#import <pthread.h>
+#import <semaphore.h>
+#import <signal.h>
+#import <sys/mman.h>
+#import <fcntl.h>
+#import <unistd.h>
+
+NSString * const ZGSharedFrameErrorDomain = @"im.zego.sharedframe";
+
+/// How often dead subscribers are looked for
+static const double ZGSharedFrameReclaimInterval = 1.0;
+
+@implementation ZGSharedFramePublisherStatistics
+
+- (instancetype)snapshot {
+    ZGSharedFramePublisherStatistics *snapshot = [[ZGSharedFramePublisherStatistics alloc] init];
+    snapshot.publishedFrames = self.publishedFrames;
+    snapshot.droppedFrames = self.droppedFrames;
+    snapshot.subscribers = self.subscribers;
+    snapshot.reclaimedSubscribers = self.reclaimedSubscribers;
+    snapshot.averageCopyMs = self.averageCopyMs;
+    return snapshot;
+}
+
+@end
+
+@interface ZGSharedFramePublisher ()
+
+@property (nonatomic, copy, readwrite) NSString *name;
+/// Guarded by the statistics lock
+@property (nonatomic, strong) ZGSharedFramePublisherStatistics *counters;
+
+@end
+
+@implementation ZGSharedFramePublisher {
+    ZGSharedFrameRingHeader *_ring;
+    size_t _mappedBytes;
+    size_t _headerSize;
+    sem_t *_semaphores[ZGSharedFrameMaxSubscribers];
+    /// Guards the slot choice and the sequence, render and capture frames may be published at the same time
+    pthread_mutex_t _publishLock;
+    uint32_t _nextSlot;
+    uint64_t _sequence;
+    double _lastReclaimTime;
+    pthread_mutex_t _statisticsLock;
+}
+
++ (instancetype)publisherWithName:(NSString *)name slotCount:(NSUInteger)slotCount slotBytes:(size_t)slotBytes error:(NSError **)error {
+    if (name.length == 0 || name.length > 30) {
+        [self fillError:error message:@"The shared frame ring name must have 1 ~ 30 characters"];
+        return nil;
+    }
+    if (slotCount < 2 || slotCount > ZGSharedFrameMaxSlots || slotBytes == 0) {
+        [self fillError:error message:@"The shared frame ring needs 2 ~ 64 slots of some bytes"];
+        return nil;
+    }
+    ZGSharedFramePublisher *publisher = [[self alloc] initWithName:name];
+    return [publisher mapRingWithSlotCount:(uint32_t)slotCount slotBytes:slotBytes error:error] ? publisher : nil;
+}
+
+- (instancetype)initWithName:(NSString *)name {
+    self = [super init];
+    if (self) {
+        _name = [name copy];
+        _counters = [[ZGSharedFramePublisherStatistics alloc] init];
+        pthread_mutex_init(&_publishLock, NULL);
+        pthread_mutex_init(&_statisticsLock, NULL);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_ring) {
+        atomic_store(&_ring->publisherPID, 0);
+        munmap(_ring, _mappedBytes);
+        shm_unlink(_name.UTF8String);
+    }
+    for (int i = 0; i < ZGSharedFrameMaxSubscribers; i++) {
+        if (_semaphores[i]) {
+            // A subscriber still waiting keeps its semaphore open, unlinking only takes the name away
+            sem_post(_semaphores[i]);
+            sem_close(_semaphores[i]);
+            char semaphoreName[64];
+            ZGSharedFrameSemaphoreName(semaphoreName, sizeof(semaphoreName), _name.UTF8String, i);
+            sem_unlink(semaphoreName);
+        }
+    }
+    pthread_mutex_destroy(&_publishLock);
+    pthread_mutex_destroy(&_statisticsLock);
+}
+
+- (BOOL)mapRingWithSlotCount:(uint32_t)slotCount slotBytes:(size_t)slotBytes error:(NSError **)error {
+    const char *name = self.name.UTF8String;
+    size_t pageSize = (size_t)getpagesize();
+    _headerSize = ZGSharedFrameRingHeaderSize(pageSize);
+    size_t slotStride = ZGSharedFrameSlotStride(slotBytes, pageSize);
+    _mappedBytes = _headerSize + slotStride * slotCount;
+
+    // A ring left behind by a publisher that crashed is replaced, its subscribers have to subscribe again
+    shm_unlink(name);
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        [self.class fillError:error message:[NSString stringWithFormat:@"shm_open failed: %s", strerror(errno)]];
+        return NO;
+    }
+    if (ftruncate(fd, (off_t)_mappedBytes) != 0) {
+        [self.class fillError:error message:[NSString stringWithFormat:@"ftruncate failed: %s", strerror(errno)]];
+        close(fd);
+        shm_unlink(name);
+        return NO;
+    }
+    void *address = mmap(NULL, _mappedBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        [self.class fillError:error message:[NSString stringWithFormat:@"mmap failed: %s", strerror(errno)]];
+        shm_unlink(name);
+        return NO;
+    }
+    _ring = address;
+
+    for (int i = 0; i < ZGSharedFrameMaxSubscribers; i++) {
+        char semaphoreName[64];
+        ZGSharedFrameSemaphoreName(semaphoreName, sizeof(semaphoreName), name, i);
+        sem_unlink(semaphoreName);
+        sem_t *semaphore = sem_open(semaphoreName, O_CREAT | O_EXCL, S_IRUSR | S_IWUSR, 0);
+        if (semaphore == SEM_FAILED) {
+            [self.class fillError:error message:[NSString stringWithFormat:@"sem_open failed: %s", strerror(errno)]];
+            return NO;
+        }
+        _semaphores[i] = semaphore;
+    }
+
+    // The object starts zeroed, so only the geometry needs writing; the magic goes last for subscribers to check
+    _ring->version = ZGSharedFrameRingVersion;
+    _ring->slotCount = slotCount;
+    _ring->slotBytes = slotBytes;
+    _ring->slotStride = slotStride;
+    atomic_store(&_ring->publisherPID, getpid());
+    atomic_thread_fence(memory_order_release);
+    _ring->magic = ZGSharedFrameRingMagic;
+    return YES;
+}
+
+#pragma mark - Forwarding
+
+- (BOOL)respondsToSelector:(SEL)aSelector {
+    return [super respondsToSelector:aSelector] || [self.nextHandler respondsToSelector:aSelector];
+}
+
+- (id)forwardingTargetForSelector:(SEL)aSelector {
+    return [self.nextHandler respondsToSelector:aSelector] ? self.nextHandler : [super forwardingTargetForSelector:aSelector];
+}
+
+#pragma mark - ZegoCustomVideoRenderHandler
+
+- (void)onRemoteVideoFrameRawData:(unsigned char * _Nonnull *)data dataLength:(unsigned int *)dataLength param:(ZegoVideoFrameParam *)param streamID:(NSString *)streamID {
+    [self publishPlanes:data dataLength:dataLength param:param timeStamp:ZGClockNow() streamID:streamID];
+    if ([self.nextHandler respondsToSelector:_cmd]) {
+        [self.nextHandler onRemoteVideoFrameRawData:data dataLength:dataLength param:param streamID:streamID];
+    }
+}
+
+#pragma mark - Publishing
+
+- (BOOL)publishPlanes:(unsigned char * _Nonnull *)data dataLength:(unsigned int *)dataLength param:(ZegoVideoFrameParam *)param timeStamp:(double)timeStamp streamID:(NSString *)streamID {
+    int width = (int)param.size.width;
+    int height = (int)param.size.height;
+    int rowBytes[ZGVideoFrameMaxPlanes], rows[ZGVideoFrameMaxPlanes];
+    int planeCount = width > 0 && height > 0 && param.strides ? ZGVideoFramePlaneLayout(param.format, width, height, rowBytes, rows) : 0;
+    int strides[ZGVideoFrameMaxPlanes];
+    for (int plane = 0; plane < planeCount; plane++) {
+        strides[plane] = param.strides[plane];
+        if (!data[plane] || strides[plane] < rowBytes[plane] || dataLength[plane] < (size_t)strides[plane] * (rows[plane] - 1) + rowBytes[plane]) {
+            planeCount = 0;
+        }
+    }
+    if (planeCount == 0) {
+        [self recordDrop];
+        return NO;
+    }
+    return [self publishFormat:param.format width:width height:height planeCount:planeCount planes:(const uint8_t **)data strides:strides rowBytes:rowBytes rows:rows timeStamp:timeStamp streamID:streamID];
+}
+
+- (BOOL)publishPixelBuffer:(CVPixelBufferRef)buffer timeStamp:(CMTime)timeStamp streamID:(NSString *)streamID {
+    OSType pixelFormat = CVPixelBufferGetPixelFormatType(buffer);
+    ZegoVideoFrameFormat format;
+    if (pixelFormat == kCVPixelFormatType_32BGRA) {
+        format = ZegoVideoFrameFormatBGRA32;
+    } else if (pixelFormat == kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange || pixelFormat == kCVPixelFormatType_420YpCbCr8BiPlanarFullRange) {
+        format = ZegoVideoFrameFormatNV12;
+    } else {
+        [self recordDrop];
+        return NO;
+    }
+    if (CVPixelBufferLockBaseAddress(buffer, kCVPixelBufferLock_ReadOnly) != kCVReturnSuccess) {
+        [self recordDrop];
+        return NO;
+    }
+    int width = (int)CVPixelBufferGetWidth(buffer);
+    int height = (int)CVPixelBufferGetHeight(buffer);
+    int rowBytes[ZGVideoFrameMaxPlanes], rows[ZGVideoFrameMaxPlanes], strides[ZGVideoFrameMaxPlanes];
+    const uint8_t *planes[ZGVideoFrameMaxPlanes];
+    int planeCount = ZGVideoFramePlaneLayout(format, width, height, rowBytes, rows);
+    for (int plane = 0; plane < planeCount; plane++) {
+        BOOL planar = CVPixelBufferIsPlanar(buffer);
+        planes[plane] = planar ? CVPixelBufferGetBaseAddressOfPlane(buffer, plane) : CVPixelBufferGetBaseAddress(buffer);
+        strides[plane] = (int)(planar ? CVPixelBufferGetBytesPerRowOfPlane(buffer, plane) : CVPixelBufferGetBytesPerRow(buffer));
+    }
+    BOOL published = [self publishFormat:format width:width height:height planeCount:planeCount planes:planes strides:strides rowBytes:rowBytes rows:rows timeStamp:CMTimeGetSeconds(timeStamp) streamID:streamID];
+    CVPixelBufferUnlockBaseAddress(buffer, kCVPixelBufferLock_ReadOnly);
+    return published;
+}
+
+- (BOOL)publishFormat:(ZegoVideoFrameFormat)format width:(int)width height:(int)height planeCount:(int)planeCount planes:(const uint8_t * const *)planes strides:(const int *)strides rowBytes:(const int *)rowBytes rows:(const int *)rows timeStamp:(double)timeStamp streamID:(NSString *)streamID {
+    double startTime = ZGClockNow();
+    uint64_t offsets[ZGVideoFrameMaxPlanes];
+    uint64_t bytes = 0;
+    for (int plane = 0; plane < planeCount; plane++) {
+        offsets[plane] = bytes;
+        // Planes start on cache lines, a reader can hand them to SIMD code as they are
+        bytes += ((uint64_t)rowBytes[plane] * rows[plane] + 63) / 64 * 64;
+    }
+    pthread_mutex_lock(&_publishLock);
+    if (startTime - _lastReclaimTime >= ZGSharedFrameReclaimInterval) {
+        _lastReclaimTime = startTime;
+        [self reclaimDeadSubscribers];
+    }
+    ZGSharedFrameSlotHeader *slot = bytes <= _ring->slotBytes ? [self takeFreeSlot] : NULL;
+    pthread_mutex_unlock(&_publishLock);
+    if (!slot) {
+        [self recordDrop];
+        return NO;
+    }
+
+    uint8_t *data = ZGSharedFrameSlotData(slot);
+    for (int plane = 0; plane < planeCount; plane++) {
+        uint8_t *dst = data + offsets[plane];
+        if (strides[plane] == rowBytes[plane]) {
+            memcpy(dst, planes[plane], (size_t)rowBytes[plane] * rows[plane]);
+        } else {
+            for (int y = 0; y < rows[plane]; y++) {
+                memcpy(dst + (size_t)y * rowBytes[plane], planes[plane] + (size_t)y * strides[plane], rowBytes[plane]);
+            }
+        }
+        slot->strides[plane] = rowBytes[plane];
+        slot->offsets[plane] = offsets[plane];
+        slot->lengths[plane] = (uint64_t)rowBytes[plane] * rows[plane];
+    }
+    slot->timestamp = timeStamp;
+    slot->format = format;
+    slot->width = width;
+    slot->height = height;
+    slot->planeCount = planeCount;
+    strlcpy(slot->streamID, streamID.UTF8String ?: "", sizeof(slot->streamID));
+
+    // Numbered when it is complete, not when its slot was taken, so frames become visible in sequence order
+    // and a subscriber taking the lowest new sequence never steps over a frame still being copied
+    pthread_mutex_lock(&_publishLock);
+    uint64_t sequence = ++_sequence;
+    atomic_store_explicit(&slot->sequence, sequence, memory_order_relaxed);
+    atomic_store_explicit(&slot->references, 0, memory_order_release);
+    atomic_store_explicit(&_ring->sequence, sequence, memory_order_release);
+    pthread_mutex_unlock(&_publishLock);
+
+    NSUInteger subscribers = 0;
+    for (int i = 0; i < ZGSharedFrameMaxSubscribers; i++) {
+        if (atomic_load_explicit(&_ring->subscribers[i].pid, memory_order_relaxed) != 0) {
+            sem_post(_semaphores[i]);
+            subscribers++;
+        }
+    }
+
+    double copyMs = (ZGClockNow() - startTime) * 1000;
+    pthread_mutex_lock(&_statisticsLock);
+    self.counters.publishedFrames += 1;
+    self.counters.subscribers = subscribers;
+    self.counters.averageCopyMs += (copyMs - self.counters.averageCopyMs) / MIN(self.counters.publishedFrames, 100);
+    pthread_mutex_unlock(&_statisticsLock);
+    return YES;
+}
+
+- (ZGSharedFramePublisherStatistics *)statistics {
+    pthread_mutex_lock(&_statisticsLock);
+    ZGSharedFramePublisherStatistics *snapshot = [self.counters snapshot];
+    pthread_mutex_unlock(&_statisticsLock);
+    return snapshot;
+}
+
+#pragma mark - Helper Methods
+
+/// The oldest slot no subscriber holds, marked as being written
+- (nullable ZGSharedFrameSlotHeader *)takeFreeSlot {
+    uint32_t slotCount = _ring->slotCount;
+    for (uint32_t i = 0; i < slotCount; i++) {
+        uint32_t index = (_nextSlot + i) % slotCount;
+        ZGSharedFrameSlotHeader *slot = ZGSharedFrameRingSlot(_ring, _headerSize, index);
+        uint32_t expected = 0;
+        if (atomic_compare_exchange_strong_explicit(&slot->references, &expected, ZGSharedFrameSlotWriting, memory_order_acquire, memory_order_relaxed)) {
+            _nextSlot = (index + 1) % slotCount;
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+/// Give back the slots of subscriber processes that exited without letting go of them
+- (void)reclaimDeadSubscribers {
+    for (int i = 0; i < ZGSharedFrameMaxSubscribers; i++) {
+        ZGSharedFrameSubscriberEntry *entry = &_ring->subscribers[i];
+        pid_t pid = atomic_load(&entry->pid);
+        // Only "no such process" counts, a sandbox answers EPERM for processes that are alive
+        if (pid == 0 || kill(pid, 0) == 0 || errno != ESRCH) {
+            continue;
+        }
+        uint64_t heldSlots = atomic_exchange(&entry->heldSlots, 0);
+        for (uint32_t index = 0; index < _ring->slotCount; index++) {
+            if (heldSlots & (1ull << index)) {
+                ZGSharedFrameSlotRelease(ZGSharedFrameRingSlot(_ring, _headerSize, index));
+            }
+        }
+        atomic_store(&entry->pid, 0);
+        pthread_mutex_lock(&_statisticsLock);
+        self.counters.reclaimedSubscribers += 1;
+        pthread_mutex_unlock(&_statisticsLock);
+    }
+}
+
+- (void)recordDrop {
+    pthread_mutex_lock(&_statisticsLock);
+    self.counters.droppedFrames += 1;
+    pthread_mutex_unlock(&_statisticsLock);
+}
+
++ (void)fillError:(NSError **)error message:(NSString *)message {
+    if (error) {
+        *error = [NSError errorWithDomain:ZGSharedFrameErrorDomain code:-1 userInfo:@{NSLocalizedDescriptionKey: message}];
+    }
+}
+
+@end
@@ -0,0 +1,129 @@
+//
+//  ZGSharedFrameRing.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#ifndef ZGSharedFrameRing_h
+#define ZGSharedFrameRing_h
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/// Layout of the shared memory object ZGSharedFramePublisher writes and ZGSharedFrameSubscriber reads
+///
+/// A ring header, then `slotCount` slots of `slotStride` bytes, each a slot header followed by the planes of one
+/// frame. Both sides map the same object, so everything in here is position independent and the atomics are
+/// lock-free ones, which work across processes.
+///
+/// Slot protocol, on the `references` word of each slot:
+///   - The publisher takes a slot only when it is 0, by swapping in ZGSharedFrameSlotWriting, fills it, stores the
+///     new sequence and then 0 again (release). It prefers the slot after the one written last, so the ring keeps
+///     the latest `slotCount` frames.
+///   - A subscriber increments it only while ZGSharedFrameSlotWriting is clear (acquire), then checks the slot still
+///     has the sequence it was after; while the count is above 0 the publisher skips the slot. The subscriber also
+///     sets the slot's bit in its own `heldSlots`, so the publisher can take the references of a subscriber process
+///     that died back.
+///   - After publishing, the publisher posts the named semaphore of every subscriber in the table.
+
+#define ZGSharedFrameRingMagic 0x5A475346u
+#define ZGSharedFrameRingVersion 1
+#define ZGSharedFrameMaxSubscribers 8
+#define ZGSharedFrameMaxSlots 64
+#define ZGSharedFrameMaxPlanes 4
+#define ZGSharedFrameSlotWriting 0x80000000u
+
+_Static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2, "Shared atomics must be lock-free");
+
+typedef struct {
+    /// 0 when the entry is free
+    _Atomic(int32_t) pid;
+    /// Bit i set while the subscriber holds a reference on slot i
+    _Atomic(uint64_t) heldSlots;
+} ZGSharedFrameSubscriberEntry;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t reserved;
+    /// Bytes of plane data a slot can take, and the distance between slots
+    uint64_t slotBytes;
+    uint64_t slotStride;
+    _Atomic(int32_t) publisherPID;
+    /// Of the last published frame, 0 before the first
+    _Atomic(uint64_t) sequence;
+    ZGSharedFrameSubscriberEntry subscribers[ZGSharedFrameMaxSubscribers];
+} ZGSharedFrameRingHeader;
+
+typedef struct {
+    _Atomic(uint32_t) references;
+    /// 0 for a slot never written
+    _Atomic(uint64_t) sequence;
+    /// Seconds on the publisher's ZGClockNow() clock, which is the same clock in every process of the machine
+    double timestamp;
+    /// A ZegoVideoFrameFormat
+    int32_t format;
+    int32_t width;
+    int32_t height;
+    int32_t planeCount;
+    int32_t strides[ZGSharedFrameMaxPlanes];
+    /// Of each plane from the start of the slot data
+    uint64_t offsets[ZGSharedFrameMaxPlanes];
+    uint64_t lengths[ZGSharedFrameMaxPlanes];
+    /// NUL terminated UTF-8, cut to fit
+    char streamID[128];
+} ZGSharedFrameSlotHeader;
+
+/// Room for the ring header, rounded up so the first slot starts on a page
+static inline size_t ZGSharedFrameRingHeaderSize(size_t pageSize) {
+    return (sizeof(ZGSharedFrameRingHeader) + pageSize - 1) / pageSize * pageSize;
+}
+
+/// Slot header and data of one slot, rounded up to whole pages
+static inline size_t ZGSharedFrameSlotStride(size_t slotBytes, size_t pageSize) {
+    size_t bytes = sizeof(ZGSharedFrameSlotHeader) + 64 + slotBytes;
+    return (bytes + pageSize - 1) / pageSize * pageSize;
+}
+
+static inline ZGSharedFrameSlotHeader *ZGSharedFrameRingSlot(ZGSharedFrameRingHeader *ring, size_t headerSize, uint32_t index) {
+    return (ZGSharedFrameSlotHeader *)((uint8_t *)ring + headerSize + (size_t)index * ring->slotStride);
+}
+
+/// Plane data of a slot, 64 byte aligned
+static inline uint8_t *ZGSharedFrameSlotData(ZGSharedFrameSlotHeader *slot) {
+    return (uint8_t *)slot + (sizeof(ZGSharedFrameSlotHeader) + 63) / 64 * 64;
+}
+
+/// Take a reader reference on a slot
+///
+/// @return 0 when the publisher is writing it
+static inline int ZGSharedFrameSlotRetain(ZGSharedFrameSlotHeader *slot) {
+    uint32_t references = atomic_load_explicit(&slot->references, memory_order_relaxed);
+    while (!(references & ZGSharedFrameSlotWriting)) {
+        if (atomic_compare_exchange_weak_explicit(&slot->references, &references, references + 1, memory_order_acquire, memory_order_relaxed)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static inline void ZGSharedFrameSlotRelease(ZGSharedFrameSlotHeader *slot) {
+    atomic_fetch_sub_explicit(&slot->references, 1, memory_order_release);
+}
+
+/// Names of the semaphores that wake subscriber `index`, the shared memory object name plus one character
+static inline void ZGSharedFrameSemaphoreName(char *buffer, size_t size, const char *name, int index) {
+    size_t length = 0;
+    while (name[length] && length + 2 < size) {
+        buffer[length] = name[length];
+        length++;
+    }
+    buffer[length] = (char)('0' + index);
+    buffer[length + 1] = '\0';
+}
+
+#endif /* ZGSharedFrameRing_h */
@@ -0,0 +1,70 @@
+//
+//  ZGSharedFrameSubscriber.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <ZegoExpressEngine/ZegoExpressEngine.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// A frame read in place from the shared ring
+///
+/// The planes point into shared memory and hold the slot; the publisher cannot reuse it until the frame and every
+/// plane taken from it are released, so do not keep frames longer than the ring is deep.
+@interface ZGSharedFrame : NSObject
+
+/// Consecutive across the publisher's frames
+@property (nonatomic, assign, readonly) uint64_t sequence;
+/// Seconds on the ZGClockNow() clock
+@property (nonatomic, assign, readonly) double timestamp;
+@property (nonatomic, assign, readonly) ZegoVideoFrameFormat format;
+@property (nonatomic, assign, readonly) CGSize size;
+@property (nonatomic, copy, readonly) NSString *streamID;
+@property (nonatomic, copy, readonly) NSArray<NSData *> *planes;
+@property (nonatomic, copy, readonly) NSArray<NSNumber *> *strides;
+
+@end
+
+/// Called on the subscriber's thread, in sequence order
+typedef void(^ZGSharedFrameHandler)(ZGSharedFrame *frame);
+
+@interface ZGSharedFrameSubscriberStatistics : NSObject
+
+@property (nonatomic, assign) NSUInteger receivedFrames;
+/// Frames the publisher overwrote before they were read
+@property (nonatomic, assign) NSUInteger missedFrames;
+/// From the publisher's time stamp to the handler call
+@property (nonatomic, assign) double averageLatencyMs;
+
+@end
+
+/// Reads the frames a ZGSharedFramePublisher of another process shares under `name`
+///
+/// Takes one of the ring's subscriber places and waits on its semaphore on a thread of its own. Every wake-up
+/// delivers the frames published since the last one still in the ring, oldest first; a subscriber that falls more
+/// than the ring's depth behind misses the frames in between. The publisher has to be running first, and a
+/// publisher that restarts needs a new subscriber. A sandboxed subscriber needs the publisher's application group
+/// in its entitlements, see ZGSharedFramePublisher.
+@interface ZGSharedFrameSubscriber : NSObject
+
++ (nullable instancetype)subscriberWithName:(NSString *)name frameHandler:(ZGSharedFrameHandler)frameHandler error:(NSError **)error;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, copy, readonly) NSString *name;
+
+/// NO once the publisher went away or stop was called
+@property (nonatomic, assign, readonly, getter=isConnected) BOOL connected;
+
+/// Stop receiving, the subscriber place is given back once no frame of it is held any more
+- (void)stop;
+
+- (ZGSharedFrameSubscriberStatistics *)statistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,379 @@
+//
+//  ZGSharedFrameSubscriber.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGSharedFrameSubscriber.h"
+#import "ZGSharedFramePublisher.h"
+#import "ZGSharedFrameRing.h"
+#import "ZGClock.h"
+#import <pthread.h>
+#import <semaphore.h>
+#import <sys/mman.h>
+#import <sys/stat.h>
+#import <fcntl.h>
+#import <unistd.h>
+
+#pragma mark - Mapping
+
+/// The mapped ring and the subscriber place in it, alive while the subscriber or any frame it delivered is
+@interface ZGSharedFrameMapping : NSObject
+
+@property (nonatomic, assign) ZGSharedFrameRingHeader *ring;
+@property (nonatomic, assign) size_t mappedBytes;
+@property (nonatomic, assign) size_t headerSize;
+/// -1 until a place is taken
+@property (nonatomic, assign) int entryIndex;
+
+@end
+
+@implementation ZGSharedFrameMapping
+
+- (void)dealloc {
+    if (!_ring) {
+        return;
+    }
+    if (_entryIndex >= 0) {
+        atomic_store(&_ring->subscribers[_entryIndex].pid, 0);
+    }
+    munmap(_ring, _mappedBytes);
+}
+
+- (ZGSharedFrameSlotHeader *)slotAtIndex:(uint32_t)index {
+    return ZGSharedFrameRingSlot(self.ring, self.headerSize, index);
+}
+
+@end
+
+/// One reference on a slot, given back when the last frame or plane holding it goes
+@interface ZGSharedFrameLease : NSObject
+
+@property (nonatomic, strong) ZGSharedFrameMapping *mapping;
+@property (nonatomic, assign) uint32_t slotIndex;
+
+@end
+
+@implementation ZGSharedFrameLease
+
+- (void)dealloc {
+    // The held bit goes first: should the process die in between, the slot leaks rather than being released twice
+    atomic_fetch_and(&_mapping.ring->subscribers[_mapping.entryIndex].heldSlots, ~(1ull << _slotIndex));
+    ZGSharedFrameSlotRelease([_mapping slotAtIndex:_slotIndex]);
+}
+
+@end
+
+#pragma mark - Frame
+
+@interface ZGSharedFrame ()
+
+@property (nonatomic, assign, readwrite) uint64_t sequence;
+@property (nonatomic, assign, readwrite) double timestamp;
+@property (nonatomic, assign, readwrite) ZegoVideoFrameFormat format;
+@property (nonatomic, assign, readwrite) CGSize size;
+@property (nonatomic, copy, readwrite) NSString *streamID;
+@property (nonatomic, copy, readwrite) NSArray<NSData *> *planes;
+@property (nonatomic, copy, readwrite) NSArray<NSNumber *> *strides;
+@property (nonatomic, strong) ZGSharedFrameLease *lease;
+
+@end
+
+@implementation ZGSharedFrame
+
+@end
+
+@implementation ZGSharedFrameSubscriberStatistics
+
+- (instancetype)snapshot {
+    ZGSharedFrameSubscriberStatistics *snapshot = [[ZGSharedFrameSubscriberStatistics alloc] init];
+    snapshot.receivedFrames = self.receivedFrames;
+    snapshot.missedFrames = self.missedFrames;
+    snapshot.averageLatencyMs = self.averageLatencyMs;
+    return snapshot;
+}
+
+@end
+
+#pragma mark - Worker
+
+/// Waits for frames on the subscriber thread, kept apart from the subscriber so the thread does not retain it
+@interface ZGSharedFrameSubscriberWorker : NSObject
+
+@property (nonatomic, strong) ZGSharedFrameMapping *mapping;
+@property (nonatomic, copy) ZGSharedFrameHandler frameHandler;
+/// Subscriber thread only
+@property (nonatomic, assign) uint64_t lastSequence;
+/// Guarded by the statistics lock
+@property (nonatomic, strong) ZGSharedFrameSubscriberStatistics *counters;
+
+@end
+
+@implementation ZGSharedFrameSubscriberWorker {
+    sem_t *_semaphore;
+    atomic_bool _stopping;
+    atomic_bool _connected;
+    pthread_mutex_t _statisticsLock;
+}
+
+- (instancetype)initWithMapping:(ZGSharedFrameMapping *)mapping semaphore:(sem_t *)semaphore {
+    self = [super init];
+    if (self) {
+        _mapping = mapping;
+        _semaphore = semaphore;
+        _counters = [[ZGSharedFrameSubscriberStatistics alloc] init];
+        atomic_init(&_stopping, false);
+        atomic_init(&_connected, true);
+        pthread_mutex_init(&_statisticsLock, NULL);
+        // Only what is published from now on
+        _lastSequence = atomic_load(&mapping.ring->sequence);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    sem_close(_semaphore);
+    pthread_mutex_destroy(&_statisticsLock);
+}
+
+- (BOOL)isConnected {
+    return atomic_load(&_connected);
+}
+
+- (void)stop {
+    atomic_store(&_stopping, true);
+    sem_post(_semaphore);
+}
+
+- (void)run {
+    while (!atomic_load(&_stopping)) {
+        if (sem_wait(_semaphore) != 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        // The publisher clears its pid and wakes everyone on the way out
+        if (atomic_load(&_stopping) || atomic_load(&self.mapping.ring->publisherPID) == 0) {
+            break;
+        }
+        @autoreleasepool {
+            [self deliverFrames];
+        }
+    }
+    atomic_store(&_connected, false);
+    // Frames still held keep the mapping, the place is given back with it
+    self.mapping = nil;
+}
+
+- (void)deliverFrames {
+    ZGSharedFrameMapping *mapping = self.mapping;
+    uint32_t slotCount = mapping.ring->slotCount;
+    while (YES) {
+        // The oldest frame not delivered yet
+        uint64_t sequence = UINT64_MAX;
+        uint32_t index = 0;
+        for (uint32_t i = 0; i < slotCount; i++) {
+            ZGSharedFrameSlotHeader *slot = [mapping slotAtIndex:i];
+            uint64_t slotSequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+            if (slotSequence > self.lastSequence && slotSequence < sequence) {
+                sequence = slotSequence;
+                index = i;
+            }
+        }
+        if (sequence == UINT64_MAX) {
+            return;
+        }
+
+        ZGSharedFrameSlotHeader *slot = [mapping slotAtIndex:index];
+        if (!ZGSharedFrameSlotRetain(slot)) {
+            // Being overwritten, look again
+            continue;
+        }
+        if (atomic_load_explicit(&slot->sequence, memory_order_relaxed) != sequence) {
+            ZGSharedFrameSlotRelease(slot);
+            continue;
+        }
+        atomic_fetch_or(&mapping.ring->subscribers[mapping.entryIndex].heldSlots, 1ull << index);
+        ZGSharedFrameLease *lease = [[ZGSharedFrameLease alloc] init];
+        lease.mapping = mapping;
+        lease.slotIndex = index;
+
+        NSUInteger missed = (NSUInteger)(sequence - self.lastSequence - 1);
+        self.lastSequence = sequence;
+        ZGSharedFrame *frame = [self frameInSlot:slot lease:lease sequence:sequence];
+        double latencyMs = frame ? (ZGClockNow() - frame.timestamp) * 1000 : 0;
+        if (frame) {
+            self.frameHandler(frame);
+        }
+
+        pthread_mutex_lock(&_statisticsLock);
+        self.counters.missedFrames += missed;
+        if (frame) {
+            self.counters.receivedFrames += 1;
+            self.counters.averageLatencyMs += (latencyMs - self.counters.averageLatencyMs) / MIN(self.counters.receivedFrames, 100);
+        }
+        pthread_mutex_unlock(&_statisticsLock);
+    }
+}
+
+/// @return nil when the slot header does not describe a frame inside the slot
+- (nullable ZGSharedFrame *)frameInSlot:(ZGSharedFrameSlotHeader *)slot lease:(ZGSharedFrameLease *)lease sequence:(uint64_t)sequence {
+    // The header comes from another process, trust none of it
+    if (slot->planeCount < 1 || slot->planeCount > ZGSharedFrameMaxPlanes) {
+        return nil;
+    }
+    uint8_t *data = ZGSharedFrameSlotData(slot);
+    NSMutableArray<NSData *> *planes = [NSMutableArray arrayWithCapacity:slot->planeCount];
+    NSMutableArray<NSNumber *> *strides = [NSMutableArray arrayWithCapacity:slot->planeCount];
+    for (int plane = 0; plane < slot->planeCount; plane++) {
+        uint64_t offset = slot->offsets[plane];
+        uint64_t length = slot->lengths[plane];
+        if (offset > self.mapping.ring->slotBytes || length > self.mapping.ring->slotBytes - offset) {
+            return nil;
+        }
+        // Each plane keeps the slot, also once the frame itself is gone
+        [planes addObject:[[NSData alloc] initWithBytesNoCopy:data + offset length:(NSUInteger)length deallocator:^(void *bytes, NSUInteger bytesLength) {
+            (void)lease;
+        }]];
+        [strides addObject:@(slot->strides[plane])];
+    }
+
+    ZGSharedFrame *frame = [[ZGSharedFrame alloc] init];
+    frame.sequence = sequence;
+    frame.timestamp = slot->timestamp;
+    frame.format = (ZegoVideoFrameFormat)slot->format;
+    frame.size = CGSizeMake(slot->width, slot->height);
+    slot->streamID[sizeof(slot->streamID) - 1] = '\0';
+    frame.streamID = [NSString stringWithUTF8String:slot->streamID] ?: @"";
+    frame.planes = planes;
+    frame.strides = strides;
+    frame.lease = lease;
+    return frame;
+}
+
+- (ZGSharedFrameSubscriberStatistics *)statisticsSnapshot {
+    pthread_mutex_lock(&_statisticsLock);
+    ZGSharedFrameSubscriberStatistics *snapshot = [self.counters snapshot];
+    pthread_mutex_unlock(&_statisticsLock);
+    return snapshot;
+}
+
+@end
+
+#pragma mark - Subscriber
+
+@interface ZGSharedFrameSubscriber ()
+
+@property (nonatomic, copy, readwrite) NSString *name;
+@property (nonatomic, strong) ZGSharedFrameSubscriberWorker *worker;
+@property (nonatomic, strong) NSThread *thread;
+
+@end
+
+@implementation ZGSharedFrameSubscriber
+
++ (instancetype)subscriberWithName:(NSString *)name frameHandler:(ZGSharedFrameHandler)frameHandler error:(NSError **)error {
+    const char *cName = name.UTF8String;
+    int fd = shm_open(cName, O_RDWR);
+    if (fd < 0) {
+        [self fillError:error message:[NSString stringWithFormat:@"No shared frame ring named %@: %s", name, strerror(errno)]];
+        return nil;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(ZGSharedFrameRingHeader)) {
+        close(fd);
+        [self fillError:error message:@"The shared frame ring is not set up yet"];
+        return nil;
+    }
+    void *address = mmap(NULL, (size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        [self fillError:error message:[NSString stringWithFormat:@"mmap failed: %s", strerror(errno)]];
+        return nil;
+    }
+
+    ZGSharedFrameMapping *mapping = [[ZGSharedFrameMapping alloc] init];
+    mapping.ring = address;
+    mapping.mappedBytes = (size_t)info.st_size;
+    mapping.headerSize = ZGSharedFrameRingHeaderSize((size_t)getpagesize());
+    mapping.entryIndex = -1;
+
+    ZGSharedFrameRingHeader *ring = mapping.ring;
+    BOOL valid = ring->magic == ZGSharedFrameRingMagic;
+    atomic_thread_fence(memory_order_acquire);
+    valid = valid && ring->version == ZGSharedFrameRingVersion && ring->slotCount >= 1 && ring->slotCount <= ZGSharedFrameMaxSlots;
+    valid = valid && ring->slotStride >= ring->slotBytes + sizeof(ZGSharedFrameSlotHeader) && mapping.headerSize + ring->slotStride * ring->slotCount <= mapping.mappedBytes;
+    if (!valid) {
+        [self fillError:error message:@"Not a shared frame ring of this version"];
+        return nil;
+    }
+
+    for (int i = 0; i < ZGSharedFrameMaxSubscribers && mapping.entryIndex < 0; i++) {
+        int32_t expected = 0;
+        if (atomic_compare_exchange_strong(&ring->subscribers[i].pid, &expected, getpid())) {
+            atomic_store(&ring->subscribers[i].heldSlots, 0);
+            mapping.entryIndex = i;
+        }
+    }
+    if (mapping.entryIndex < 0) {
+        [self fillError:error message:@"The shared frame ring has no free subscriber place"];
+        return nil;
+    }
+
+    char semaphoreName[64];
+    ZGSharedFrameSemaphoreName(semaphoreName, sizeof(semaphoreName), cName, mapping.entryIndex);
+    sem_t *semaphore = sem_open(semaphoreName, 0);
+    if (semaphore == SEM_FAILED) {
+        [self fillError:error message:[NSString stringWithFormat:@"sem_open failed: %s", strerror(errno)]];
+        return nil;
+    }
+    // Wake-ups meant for the subscriber that had the place before
+    while (sem_trywait(semaphore) == 0) {
+    }
+
+    ZGSharedFrameSubscriberWorker *worker = [[ZGSharedFrameSubscriberWorker alloc] initWithMapping:mapping semaphore:semaphore];
+    worker.frameHandler = frameHandler;
+    return [[self alloc] initWithName:name worker:worker];
+}
+
+- (instancetype)initWithName:(NSString *)name worker:(ZGSharedFrameSubscriberWorker *)worker {
+    self = [super init];
+    if (self) {
+        _name = [name copy];
+        _worker = worker;
+        _thread = [[NSThread alloc] initWithTarget:_worker selector:@selector(run) object:nil];
+        _thread.name = @"im.zego.sharedframe.subscriber";
+        _thread.qualityOfService = NSQualityOfServiceUserInteractive;
+        [_thread start];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_worker stop];
+}
+
+- (BOOL)isConnected {
+    return [self.worker isConnected];
+}
+
+- (void)stop {
+    [self.worker stop];
+}
+
+- (ZGSharedFrameSubscriberStatistics *)statistics {
+    return [self.worker statisticsSnapshot];
+}
+
+#pragma mark - Helper Methods
+
++ (void)fillError:(NSError **)error message:(NSString *)message {
+    if (error) {
+        *error = [NSError errorWithDomain:ZGSharedFrameErrorDomain code:-1 userInfo:@{NSLocalizedDescriptionKey: message}];
+    }
+}
+
+@end
@@ -0,0 +1,48 @@
+//
+//  ZGLoadFrameSource.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ZGExpressEngine.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// File-driven custom capture source shared by every virtual publisher
+///
+/// Frames are read once from a raw NV12 file (width * height * 3 / 2 bytes each) into pixel buffers and looped.
+/// A single timer feeds the current frame to every subscribed engine through
+/// sendCustomVideoCapturePixelBuffer:timeStamp:, so the cost per publisher is one call per frame.
+@interface ZGLoadFrameSource : NSObject
+
+/// Create a frame source
+///
+/// @param path Raw NV12 file, nil to generate a synthetic moving gradient
+/// @param width Frame width, must be even
+/// @param height Frame height, must be even
+/// @param frameRate Frames per second
+/// @param maxFrames Upper bound of frames kept in memory, the sequence loops after that
+/// @param error Set when the file cannot be read or holds no complete frame
+- (nullable instancetype)initWithPath:(nullable NSString *)path width:(size_t)width height:(size_t)height frameRate:(double)frameRate maxFrames:(NSUInteger)maxFrames error:(NSError **)error;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, assign, readonly) double frameRate;
+@property (nonatomic, assign, readonly) NSUInteger frameCount;
+
+/// Start feeding frames to an engine
+- (void)addEngine:(id<ZGExpressEngine>)engine;
+
+/// Stop feeding frames to an engine
+- (void)removeEngine:(id<ZGExpressEngine>)engine;
+
+- (void)start;
+
+- (void)stop;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,176 @@
+//
+//  ZGLoadFrameSource.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGLoadFrameSource.h"
+#import "ZGMemoryAccountant.h"
+
+static NSString * const ZGLoadFrameSourceErrorDomain = @"im.zego.loadtest.framesource";
+
+@interface ZGLoadFrameSource ()
+
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) dispatch_source_t timer;
+@property (nonatomic, strong) NSHashTable<id<ZGExpressEngine>> *engines;
+@property (nonatomic, assign) NSUInteger frameIndex;
+@property (nonatomic, assign) int64_t frameNumber;
+@property (nonatomic, strong) ZGMemoryAllocation *allocation;
+
+@end
+
+@implementation ZGLoadFrameSource {
+    CVPixelBufferRef *_frames;
+    NSUInteger _frameCount;
+}
+
+- (instancetype)initWithPath:(NSString *)path width:(size_t)width height:(size_t)height frameRate:(double)frameRate maxFrames:(NSUInteger)maxFrames error:(NSError **)error {
+    self = [super init];
+    if (self) {
+        _frameRate = frameRate > 0 ? frameRate : 15;
+        _queue = dispatch_queue_create("im.zego.loadtest.framesource", DISPATCH_QUEUE_SERIAL);
+        _engines = [NSHashTable weakObjectsHashTable];
+
+        size_t frameSize = width * height * 3 / 2;
+        NSData *file = nil;
+        if (path) {
+            file = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:error];
+            if (!file) {
+                return nil;
+            }
+            if (file.length < frameSize) {
+                if (error) {
+                    *error = [NSError errorWithDomain:ZGLoadFrameSourceErrorDomain code:-1 userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"%@ holds no complete %zux%zu NV12 frame", path, width, height]}];
+                }
+                return nil;
+            }
+        }
+
+        NSUInteger count = file ? MIN(MAX(maxFrames, 1), file.length / frameSize) : MAX(MIN(maxFrames, (NSUInteger)_frameRate), 1);
+        _frames = calloc(count, sizeof(CVPixelBufferRef));
+        NSDictionary *attributes = @{(id)kCVPixelBufferIOSurfacePropertiesKey: @{}};
+        for (NSUInteger i = 0; i < count; i++) {
+            CVPixelBufferRef buffer = NULL;
+            if (CVPixelBufferCreate(kCFAllocatorDefault, width, height, kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange, (__bridge CFDictionaryRef)attributes, &buffer) != kCVReturnSuccess) {
+                break;
+            }
+            if (file) {
+                [self fillBuffer:buffer fromNV12:(const uint8_t *)file.bytes + i * frameSize width:width height:height];
+            } else {
+                [self fillSyntheticBuffer:buffer index:i count:count];
+            }
+            _frames[_frameCount++] = buffer;
+        }
+
+        size_t bytes = 0;
+        for (NSUInteger i = 0; i < _frameCount; i++) {
+            bytes += CVPixelBufferGetDataSize(_frames[i]);
+        }
+        _allocation = [[ZGMemoryAccountant sharedAccountant] trackBytes:bytes streamID:nil subsystem:ZGMemorySubsystemCapture label:[NSString stringWithFormat:@"load test frames %lux %zux%zu", (unsigned long)_frameCount, width, height]];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_timer) {
+        dispatch_source_cancel(_timer);
+    }
+    for (NSUInteger i = 0; i < _frameCount; i++) {
+        CVPixelBufferRelease(_frames[i]);
+    }
+    free(_frames);
+    if (_allocation) {
+        [[ZGMemoryAccountant sharedAccountant] releaseAllocation:_allocation];
+    }
+}
+
+- (NSUInteger)frameCount {
+    return _frameCount;
+}
+
+#pragma mark - Subscribers
+
+- (void)addEngine:(id<ZGExpressEngine>)engine {
+    dispatch_async(self.queue, ^{
+        [self.engines addObject:engine];
+    });
+}
+
+- (void)removeEngine:(id<ZGExpressEngine>)engine {
+    dispatch_async(self.queue, ^{
+        [self.engines removeObject:engine];
+    });
+}
+
+- (void)start {
+    if (self.timer || _frameCount == 0) {
+        return;
+    }
+    __weak typeof(self) weakSelf = self;
+    uint64_t interval = (uint64_t)(NSEC_PER_SEC / self.frameRate);
+    self.timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.queue);
+    dispatch_source_set_timer(self.timer, dispatch_time(DISPATCH_TIME_NOW, 0), interval, interval / 10);
+    dispatch_source_set_event_handler(self.timer, ^{
+        [weakSelf tick];
+    });
+    dispatch_resume(self.timer);
+}
+
+- (void)stop {
+    if (self.timer) {
+        dispatch_source_cancel(self.timer);
+        self.timer = nil;
+    }
+}
+
+- (void)tick {
+    CVPixelBufferRef frame = _frames[self.frameIndex];
+    CMTime timeStamp = CMTimeMakeWithSeconds(self.frameNumber / self.frameRate, 1000);
+    for (id<ZGExpressEngine> engine in self.engines.allObjects) {
+        [engine sendCustomVideoCapturePixelBuffer:frame timeStamp:timeStamp];
+    }
+    self.frameIndex = (self.frameIndex + 1) % _frameCount;
+    self.frameNumber += 1;
+}
+
+#pragma mark - Helper Methods
+
+- (void)fillBuffer:(CVPixelBufferRef)buffer fromNV12:(const uint8_t *)source width:(size_t)width height:(size_t)height {
+    CVPixelBufferLockBaseAddress(buffer, 0);
+    const uint8_t *plane = source;
+    for (size_t p = 0; p < 2; p++) {
+        uint8_t *destination = CVPixelBufferGetBaseAddressOfPlane(buffer, p);
+        size_t stride = CVPixelBufferGetBytesPerRowOfPlane(buffer, p);
+        size_t rows = p == 0 ? height : height / 2;
+        for (size_t row = 0; row < rows; row++) {
+            memcpy(destination + row * stride, plane + row * width, width);
+        }
+        plane += width * rows;
+    }
+    CVPixelBufferUnlockBaseAddress(buffer, 0);
+}
+
+- (void)fillSyntheticBuffer:(CVPixelBufferRef)buffer index:(NSUInteger)index count:(NSUInteger)count {
+    CVPixelBufferLockBaseAddress(buffer, 0);
+    size_t width = CVPixelBufferGetWidth(buffer);
+    size_t height = CVPixelBufferGetHeight(buffer);
+    uint8_t *luma = CVPixelBufferGetBaseAddressOfPlane(buffer, 0);
+    size_t lumaStride = CVPixelBufferGetBytesPerRowOfPlane(buffer, 0);
+    size_t shift = index * width / count;
+    for (size_t row = 0; row < height; row++) {
+        for (size_t column = 0; column < width; column++) {
+            luma[row * lumaStride + column] = (uint8_t)(16 + ((column + shift) % width) * 219 / width);
+        }
+    }
+    uint8_t *chroma = CVPixelBufferGetBaseAddressOfPlane(buffer, 1);
+    size_t chromaStride = CVPixelBufferGetBytesPerRowOfPlane(buffer, 1);
+    for (size_t row = 0; row < height / 2; row++) {
+        memset(chroma + row * chromaStride, 128, width);
+    }
+    CVPixelBufferUnlockBaseAddress(buffer, 0);
+}
+
+@end
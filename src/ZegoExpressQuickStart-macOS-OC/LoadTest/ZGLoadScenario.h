@@ -0,0 +1,103 @@
+//
+//  ZGLoadScenario.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ZGSignalingSimulatorConfig;
+@class ZGStandInNetworkProfile;
+
+/// Load test scenario, loaded from a JSON file
+///
+/// e.g.
+/// {
+///     "roomID": "LoadTestRoom-1",
+///     "userCount": 200,
+///     "rampUpUsersPerSecond": 20,
+///     "playStreamsPerUser": 4,
+///     "durationSeconds": 120,
+///     "churn": { "meanSessionSeconds": 45, "rejoinDelaySeconds": 2 },
+///     "frameSource": { "path": "/tmp/640x360.nv12", "width": 640, "height": 360, "fps": 15 },
+///     "stallThresholdMs": 500,
+///     "network": "/tmp/congestion.json",
+///     "signaling": { "targetUserCount": 10000, "userArrivalsPerSecond": 500, "targetStreamCount": 500, "streamArrivalsPerSecond": 20 },
+///     "token": { "latencyMinMs": 50, "latencyMaxMs": 300, "failureRate": 0.01, "lifetimeSeconds": 600, "prefetch": true },
+///     "reportPath": "/tmp/load-report.json"
+/// }
+///
+/// Only `userCount` and `durationSeconds` are required. Without `churn` every user stays for the whole run,
+/// without `frameSource.path` a synthetic frame sequence of the given size is published. `signaling` adds synthetic
+/// room members and IM traffic, see ZGSignalingSimulatorConfig for its keys. `network` puts every user behind
+/// the same scripted network, either a profile file or an inline profile, see ZGStandInNetworkProfile.
+/// `token` makes logins require a room token from a stand-in token service; with `prefetch` every user fetches
+/// its token ahead of joining through ZGRoomTokenManager, without it the fetch is part of the join.
+@interface ZGLoadScenario : NSObject
+
+@property (nonatomic, copy) NSString *roomID;
+
+/// Number of concurrent virtual users
+@property (nonatomic, assign) NSUInteger userCount;
+
+/// Users started per second during ramp-up, 0 starts everybody at once
+@property (nonatomic, assign) double rampUpUsersPerSecond;
+
+/// Number of remote streams each user plays
+@property (nonatomic, assign) NSUInteger playStreamsPerUser;
+
+/// Whether every user publishes a stream, default YES
+@property (nonatomic, assign) BOOL publish;
+
+/// Total run time in seconds, ramp-up included
+@property (nonatomic, assign) NSTimeInterval durationSeconds;
+
+/// Mean of the exponentially distributed session length, 0 disables churn
+@property (nonatomic, assign) NSTimeInterval meanSessionSeconds;
+
+/// Pause between a churned user leaving and rejoining
+@property (nonatomic, assign) NSTimeInterval rejoinDelaySeconds;
+
+/// Raw NV12 frame file, nil to publish synthetic frames
+@property (nonatomic, copy, nullable) NSString *frameSourcePath;
+@property (nonatomic, assign) size_t frameWidth;
+@property (nonatomic, assign) size_t frameHeight;
+@property (nonatomic, assign) double frameRate;
+
+/// A gap between two rendered frames longer than this counts as a stall
+@property (nonatomic, assign) double stallThresholdMs;
+
+/// Network every virtual user sits behind, nil for an ideal network
+@property (nonatomic, strong, nullable) ZGStandInNetworkProfile *networkProfile;
+
+/// Synthetic room traffic generated alongside the virtual users, nil for none
+@property (nonatomic, strong, nullable) ZGSignalingSimulatorConfig *signalingConfig;
+
+/// Whether logins need a room token, and how the stand-in token service behaves
+@property (nonatomic, assign) BOOL requireToken;
+@property (nonatomic, assign) double tokenLatencyMinMs;
+@property (nonatomic, assign) double tokenLatencyMaxMs;
+@property (nonatomic, assign) double tokenFailureRate;
+@property (nonatomic, assign) NSTimeInterval tokenLifetime;
+/// Fetch tokens before joining, default YES
+@property (nonatomic, assign) BOOL prefetchTokens;
+
+/// Where to write the JSON report, nil to only print the summary
+@property (nonatomic, copy, nullable) NSString *reportPath;
+
+/// Load a scenario file
+///
+/// @param path Path of the scenario JSON file
+/// @param error Set when the file cannot be read or a field is invalid
++ (nullable instancetype)scenarioWithContentsOfFile:(NSString *)path error:(NSError **)error;
+
+/// Build a scenario from an already parsed dictionary
++ (nullable instancetype)scenarioWithDictionary:(NSDictionary *)dictionary error:(NSError **)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
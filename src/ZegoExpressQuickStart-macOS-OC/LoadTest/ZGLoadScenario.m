@@ -0,0 +1,119 @@
+//
+//  ZGLoadScenario.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGLoadScenario.h"
+#import "ZGStandInSignalingSimulator.h"
+#import "ZGStandInNetworkProfile.h"
+
+static NSString * const ZGLoadScenarioErrorDomain = @"im.zego.loadtest.scenario";
+
+@implementation ZGLoadScenario
+
++ (instancetype)scenarioWithContentsOfFile:(NSString *)path error:(NSError **)error {
+    NSData *data = [NSData dataWithContentsOfFile:path options:0 error:error];
+    if (!data) {
+        return nil;
+    }
+    id object = [NSJSONSerialization JSONObjectWithData:data options:0 error:error];
+    if (!object) {
+        return nil;
+    }
+    if (![object isKindOfClass:[NSDictionary class]]) {
+        [self fillError:error message:@"The scenario must be a JSON object"];
+        return nil;
+    }
+    return [self scenarioWithDictionary:object error:error];
+}
+
++ (instancetype)scenarioWithDictionary:(NSDictionary *)dictionary error:(NSError **)error {
+    ZGLoadScenario *scenario = [[ZGLoadScenario alloc] init];
+    scenario.roomID = [self stringIn:dictionary key:@"roomID"] ?: @"LoadTestRoom-1";
+    scenario.userCount = [[self numberIn:dictionary key:@"userCount"] unsignedIntegerValue];
+    scenario.rampUpUsersPerSecond = [[self numberIn:dictionary key:@"rampUpUsersPerSecond"] doubleValue];
+    scenario.playStreamsPerUser = [[self numberIn:dictionary key:@"playStreamsPerUser"] unsignedIntegerValue];
+    scenario.publish = [self numberIn:dictionary key:@"publish"] ? [[self numberIn:dictionary key:@"publish"] boolValue] : YES;
+    scenario.durationSeconds = [[self numberIn:dictionary key:@"durationSeconds"] doubleValue];
+    scenario.stallThresholdMs = [[self numberIn:dictionary key:@"stallThresholdMs"] doubleValue] ?: 500;
+    scenario.reportPath = [self stringIn:dictionary key:@"reportPath"];
+
+    NSDictionary *churn = [dictionary[@"churn"] isKindOfClass:[NSDictionary class]] ? dictionary[@"churn"] : nil;
+    scenario.meanSessionSeconds = [[self numberIn:churn key:@"meanSessionSeconds"] doubleValue];
+    scenario.rejoinDelaySeconds = [[self numberIn:churn key:@"rejoinDelaySeconds"] doubleValue];
+
+    NSDictionary *frameSource = [dictionary[@"frameSource"] isKindOfClass:[NSDictionary class]] ? dictionary[@"frameSource"] : nil;
+    scenario.frameSourcePath = [self stringIn:frameSource key:@"path"];
+    scenario.frameWidth = [[self numberIn:frameSource key:@"width"] unsignedIntegerValue] ?: 640;
+    scenario.frameHeight = [[self numberIn:frameSource key:@"height"] unsignedIntegerValue] ?: 360;
+    scenario.frameRate = [self numberIn:frameSource key:@"fps"] ? [[self numberIn:frameSource key:@"fps"] doubleValue] : 15;
+
+    id network = dictionary[@"network"];
+    if ([network isKindOfClass:[NSString class]]) {
+        scenario.networkProfile = [ZGStandInNetworkProfile profileWithContentsOfFile:network error:error];
+        if (!scenario.networkProfile) {
+            return nil;
+        }
+    } else if ([network isKindOfClass:[NSDictionary class]]) {
+        scenario.networkProfile = [ZGStandInNetworkProfile profileWithDictionary:network error:error];
+        if (!scenario.networkProfile) {
+            return nil;
+        }
+    }
+
+    NSDictionary *signaling = [dictionary[@"signaling"] isKindOfClass:[NSDictionary class]] ? dictionary[@"signaling"] : nil;
+    scenario.signalingConfig = signaling ? [ZGSignalingSimulatorConfig configWithDictionary:signaling] : nil;
+
+    NSDictionary *token = [dictionary[@"token"] isKindOfClass:[NSDictionary class]] ? dictionary[@"token"] : nil;
+    scenario.requireToken = token != nil;
+    scenario.tokenLatencyMinMs = [self numberIn:token key:@"latencyMinMs"] ? [[self numberIn:token key:@"latencyMinMs"] doubleValue] : 50;
+    scenario.tokenLatencyMaxMs = [self numberIn:token key:@"latencyMaxMs"] ? [[self numberIn:token key:@"latencyMaxMs"] doubleValue] : 300;
+    scenario.tokenFailureRate = [[self numberIn:token key:@"failureRate"] doubleValue];
+    scenario.tokenLifetime = [[self numberIn:token key:@"lifetimeSeconds"] doubleValue] ?: 600;
+    scenario.prefetchTokens = [self numberIn:token key:@"prefetch"] ? [[self numberIn:token key:@"prefetch"] boolValue] : YES;
+
+    if (scenario.userCount == 0) {
+        [self fillError:error message:@"userCount must be greater than 0"];
+        return nil;
+    }
+    if (scenario.durationSeconds <= 0) {
+        [self fillError:error message:@"durationSeconds must be greater than 0"];
+        return nil;
+    }
+    if (scenario.rampUpUsersPerSecond < 0 || scenario.meanSessionSeconds < 0 || scenario.rejoinDelaySeconds < 0) {
+        [self fillError:error message:@"rampUpUsersPerSecond and churn values must not be negative"];
+        return nil;
+    }
+    if (scenario.frameRate <= 0) {
+        [self fillError:error message:@"frameSource fps must be greater than 0"];
+        return nil;
+    }
+    if (scenario.frameWidth % 2 != 0 || scenario.frameHeight % 2 != 0) {
+        [self fillError:error message:@"frameSource width and height must be even for NV12"];
+        return nil;
+    }
+    return scenario;
+}
+
+#pragma mark - Helper Methods
+
++ (NSString *)stringIn:(NSDictionary *)dictionary key:(NSString *)key {
+    id value = dictionary[key];
+    return [value isKindOfClass:[NSString class]] ? value : nil;
+}
+
++ (NSNumber *)numberIn:(NSDictionary *)dictionary key:(NSString *)key {
+    id value = dictionary[key];
+    return [value isKindOfClass:[NSNumber class]] ? value : nil;
+}
+
++ (void)fillError:(NSError **)error message:(NSString *)message {
+    if (error) {
+        *error = [NSError errorWithDomain:ZGLoadScenarioErrorDomain code:-1 userInfo:@{NSLocalizedDescriptionKey: message}];
+    }
+}
+
+@end
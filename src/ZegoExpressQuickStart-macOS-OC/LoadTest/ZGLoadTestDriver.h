@@ -0,0 +1,45 @@
+//
+//  ZGLoadTestDriver.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ZGLoadScenario.h"
+#import "ZGLoadTestReport.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Command line argument that switches the app into a headless load test
+///
+/// e.g. ZegoExpressQuickStart-macOS-OC --load-scenario /path/to/scenario.json
+FOUNDATION_EXPORT NSString * const ZGLoadTestScenarioArgument;
+
+/// Runs a load test scenario against the local stand-in engine
+///
+/// Ramps virtual users up at the configured rate, churns them according to the session length distribution,
+/// and collects every finished session into a ZGLoadTestReport. Runs entirely on the main queue.
+@interface ZGLoadTestDriver : NSObject
+
+- (instancetype)initWithScenario:(ZGLoadScenario *)scenario;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, strong, readonly) ZGLoadScenario *scenario;
+
+/// Start the run, the completion is called on the main queue once the duration has elapsed
+///
+/// @param error Set when the frame source cannot be created
+- (BOOL)runWithCompletion:(void (^)(ZGLoadTestReport *report))completion error:(NSError **)error;
+
+/// Entry point of the headless mode, blocks until the run is over
+///
+/// @param arguments Process arguments containing ZGLoadTestScenarioArgument followed by the scenario path
+/// @return Process exit code
++ (int)runHeadlessWithArguments:(NSArray<NSString *> *)arguments;
+
+@end
+
+NS_ASSUME_NONNULL_END
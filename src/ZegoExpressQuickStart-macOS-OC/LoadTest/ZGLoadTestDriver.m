@@ -0,0 +1,226 @@
+//
+//  ZGLoadTestDriver.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGLoadTestDriver.h"
+#import "ZGLoadVirtualUser.h"
+#import "ZGLoadFrameSource.h"
+#import "ZGStandInRoomService.h"
+#import "ZGStandInSignalingSimulator.h"
+#import "ZGStandInTokenService.h"
+#import "ZGClock.h"
+
+NSString * const ZGLoadTestScenarioArgument = @"--load-scenario";
+
+/// Number of distinct frames kept in memory by the shared frame source
+static const NSUInteger ZGLoadFrameSourceMaxFrames = 60;
+
+@interface ZGLoadTestDriver ()
+
+@property (nonatomic, strong) ZGStandInRoomService *roomService;
+@property (nonatomic, strong) ZGLoadFrameSource *frameSource;
+@property (nonatomic, strong, nullable) ZGStandInSignalingSimulator *signalingSimulator;
+@property (nonatomic, strong) NSMutableArray<ZGLoadVirtualUser *> *users;
+@property (nonatomic, strong) ZGLoadTestReport *report;
+@property (nonatomic, copy) void (^completion)(ZGLoadTestReport *report);
+@property (nonatomic, strong) dispatch_source_t rampTimer;
+@property (nonatomic, assign) double startTime;
+@property (nonatomic, assign) BOOL finished;
+
+@end
+
+@implementation ZGLoadTestDriver
+
+- (instancetype)initWithScenario:(ZGLoadScenario *)scenario {
+    self = [super init];
+    if (self) {
+        _scenario = scenario;
+        _roomService = [[ZGStandInRoomService alloc] init];
+        if (scenario.requireToken) {
+            ZGStandInTokenService *tokenService = [[ZGStandInTokenService alloc] initWithSeed:1];
+            tokenService.latencyMinMs = scenario.tokenLatencyMinMs;
+            tokenService.latencyMaxMs = scenario.tokenLatencyMaxMs;
+            tokenService.failureRate = scenario.tokenFailureRate;
+            tokenService.tokenLifetime = scenario.tokenLifetime;
+            _roomService.tokenService = tokenService;
+        }
+        _users = [NSMutableArray array];
+        _report = [[ZGLoadTestReport alloc] init];
+    }
+    return self;
+}
+
+#pragma mark - Run
+
+- (BOOL)runWithCompletion:(void (^)(ZGLoadTestReport *))completion error:(NSError **)error {
+    ZGLoadScenario *scenario = self.scenario;
+    self.frameSource = [[ZGLoadFrameSource alloc] initWithPath:scenario.frameSourcePath width:scenario.frameWidth height:scenario.frameHeight frameRate:scenario.frameRate maxFrames:ZGLoadFrameSourceMaxFrames error:error];
+    if (!self.frameSource) {
+        return NO;
+    }
+    self.completion = completion;
+    self.startTime = ZGClockNow();
+    [self.frameSource start];
+
+    if (scenario.signalingConfig) {
+        self.signalingSimulator = [[ZGStandInSignalingSimulator alloc] initWithRoomService:self.roomService roomID:scenario.roomID config:scenario.signalingConfig];
+        [self.signalingSimulator start];
+    }
+
+    __weak typeof(self) weakSelf = self;
+    for (NSUInteger i = 0; i < scenario.userCount; i++) {
+        NSString *userID = [NSString stringWithFormat:@"vu-%05lu", (unsigned long)i];
+        ZGLoadVirtualUser *user = [[ZGLoadVirtualUser alloc] initWithUserID:userID scenario:scenario roomService:self.roomService frameSource:self.frameSource];
+        // A failed join is reported right away; with churn the user tries again when its session would have ended
+        user.sessionEndedHandler = ^(ZGLoadVirtualUser *endedUser, ZGLoadSessionMetrics *metrics) {
+            [weakSelf.report addSession:metrics];
+        };
+        [self.users addObject:user];
+    }
+
+    if (scenario.rampUpUsersPerSecond <= 0) {
+        for (ZGLoadVirtualUser *user in self.users) {
+            [self startSessionOfUser:user];
+        }
+    } else {
+        [self startRamp];
+    }
+
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(scenario.durationSeconds * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [weakSelf finish];
+    });
+    return YES;
+}
+
+- (void)startRamp {
+    __block NSUInteger nextUser = 0;
+    __weak typeof(self) weakSelf = self;
+    uint64_t interval = (uint64_t)(NSEC_PER_SEC / self.scenario.rampUpUsersPerSecond);
+    self.rampTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, dispatch_get_main_queue());
+    dispatch_source_set_timer(self.rampTimer, dispatch_time(DISPATCH_TIME_NOW, 0), interval, interval / 10);
+    dispatch_source_set_event_handler(self.rampTimer, ^{
+        typeof(self) strongSelf = weakSelf;
+        if (!strongSelf || nextUser >= strongSelf.users.count) {
+            [strongSelf stopRamp];
+            return;
+        }
+        [strongSelf startSessionOfUser:strongSelf.users[nextUser++]];
+    });
+    dispatch_resume(self.rampTimer);
+}
+
+- (void)stopRamp {
+    if (self.rampTimer) {
+        dispatch_source_cancel(self.rampTimer);
+        self.rampTimer = nil;
+    }
+}
+
+- (void)startSessionOfUser:(ZGLoadVirtualUser *)user {
+    if (self.finished) {
+        return;
+    }
+    [user join];
+    [self updatePeakConcurrency];
+
+    if (self.scenario.meanSessionSeconds <= 0) {
+        return;
+    }
+    // Exponentially distributed session length, i.e. users leave as a Poisson process
+    double u = arc4random_uniform(UINT32_MAX) / (double)UINT32_MAX;
+    NSTimeInterval sessionSeconds = -self.scenario.meanSessionSeconds * log(1.0 - u);
+    __weak typeof(self) weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(sessionSeconds * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [weakSelf churnUser:user];
+    });
+}
+
+- (void)churnUser:(ZGLoadVirtualUser *)user {
+    if (self.finished) {
+        return;
+    }
+    // Not active when its join already failed, it still rejoins
+    ZGLoadSessionMetrics *metrics = [user leave];
+    if (metrics) {
+        [self.report addSession:metrics];
+    }
+    __weak typeof(self) weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.scenario.rejoinDelaySeconds * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [weakSelf startSessionOfUser:user];
+    });
+}
+
+- (void)updatePeakConcurrency {
+    NSUInteger active = 0;
+    for (ZGLoadVirtualUser *user in self.users) {
+        active += user.active ? 1 : 0;
+    }
+    self.report.peakConcurrentUsers = MAX(self.report.peakConcurrentUsers, active);
+}
+
+- (void)finish {
+    if (self.finished) {
+        return;
+    }
+    self.finished = YES;
+    [self stopRamp];
+    for (ZGLoadVirtualUser *user in self.users) {
+        ZGLoadSessionMetrics *metrics = [user leave];
+        if (metrics) {
+            [self.report addSession:metrics];
+        }
+    }
+    [self.frameSource stop];
+    [self.signalingSimulator stopRemovingMembers:YES];
+    self.report.wallSeconds = ZGClockNow() - self.startTime;
+    if (self.completion) {
+        self.completion(self.report);
+        self.completion = nil;
+    }
+}
+
+#pragma mark - Headless
+
++ (int)runHeadlessWithArguments:(NSArray<NSString *> *)arguments {
+    NSUInteger index = [arguments indexOfObject:ZGLoadTestScenarioArgument];
+    if (index == NSNotFound || index + 1 >= arguments.count) {
+        fprintf(stderr, "usage: %s %s <scenario.json>\n", arguments.firstObject.UTF8String, ZGLoadTestScenarioArgument.UTF8String);
+        return 2;
+    }
+
+    NSError *error = nil;
+    ZGLoadScenario *scenario = [ZGLoadScenario scenarioWithContentsOfFile:arguments[index + 1] error:&error];
+    if (!scenario) {
+        fprintf(stderr, "Invalid scenario: %s\n", error.localizedDescription.UTF8String);
+        return 2;
+    }
+
+    ZGLoadTestDriver *driver = [[ZGLoadTestDriver alloc] initWithScenario:scenario];
+    __block ZGLoadTestReport *result = nil;
+    if (![driver runWithCompletion:^(ZGLoadTestReport *report) {
+        result = report;
+    } error:&error]) {
+        fprintf(stderr, "Cannot start load test: %s\n", error.localizedDescription.UTF8String);
+        return 1;
+    }
+
+    // Callbacks are delivered on the main queue, which the main run loop drains
+    while (!result) {
+        @autoreleasepool {
+            [[NSRunLoop mainRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+        }
+    }
+
+    printf("%s", result.summary.UTF8String);
+    if (scenario.reportPath && ![result writeToFile:scenario.reportPath error:&error]) {
+        fprintf(stderr, "Cannot write report: %s\n", error.localizedDescription.UTF8String);
+        return 1;
+    }
+    return 0;
+}
+
+@end
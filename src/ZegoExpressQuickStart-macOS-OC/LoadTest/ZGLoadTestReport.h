@@ -0,0 +1,65 @@
+//
+//  ZGLoadTestReport.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Metrics of one played stream within a session
+@interface ZGLoadPlayMetrics : NSObject
+
+@property (nonatomic, copy) NSString *streamID;
+/// From startPlayingStream to the first rendered frame, negative when no frame arrived
+@property (nonatomic, assign) double firstFrameLatencyMs;
+@property (nonatomic, assign) NSUInteger renderedFrames;
+/// Time between the first and the last rendered frame
+@property (nonatomic, assign) double renderSeconds;
+@property (nonatomic, assign) NSUInteger stallCount;
+@property (nonatomic, assign) double stallMs;
+
+/// Average rendered frame rate, 0 when fewer than two frames arrived
+- (double)averageFPS;
+
+@end
+
+/// Metrics of one login-to-logout session of a virtual user
+@interface ZGLoadSessionMetrics : NSObject
+
+@property (nonatomic, copy) NSString *userID;
+/// From loginRoom to the Connected state, negative when the login failed
+@property (nonatomic, assign) double joinLatencyMs;
+/// Why the login was never attempted or failed, e.g. no room token could be had
+@property (nonatomic, copy, nullable) NSString *joinError;
+/// From startPublishing to the Publishing state, negative when not published
+@property (nonatomic, assign) double publishLatencyMs;
+@property (nonatomic, assign) double sessionSeconds;
+@property (nonatomic, strong) NSMutableArray<ZGLoadPlayMetrics *> *plays;
+
+@end
+
+/// Aggregated load test results
+@interface ZGLoadTestReport : NSObject
+
+@property (nonatomic, assign) NSTimeInterval wallSeconds;
+@property (nonatomic, assign) NSUInteger peakConcurrentUsers;
+
+- (void)addSession:(ZGLoadSessionMetrics *)session;
+
+- (NSUInteger)sessionCount;
+
+/// Human readable summary with percentiles of join latency, first frame latency, FPS and stalls
+- (NSString *)summary;
+
+/// JSON friendly representation of the summary plus the raw sessions
+- (NSDictionary *)dictionaryRepresentation;
+
+- (BOOL)writeToFile:(NSString *)path error:(NSError **)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,219 @@
+//
+//  ZGLoadTestReport.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGLoadTestReport.h"
+
+@implementation ZGLoadPlayMetrics
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _firstFrameLatencyMs = -1;
+    }
+    return self;
+}
+
+- (double)averageFPS {
+    if (self.renderedFrames < 2 || self.renderSeconds <= 0) {
+        return 0;
+    }
+    return (self.renderedFrames - 1) / self.renderSeconds;
+}
+
+@end
+
+@implementation ZGLoadSessionMetrics
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _joinLatencyMs = -1;
+        _publishLatencyMs = -1;
+        _plays = [NSMutableArray array];
+    }
+    return self;
+}
+
+@end
+
+@interface ZGLoadTestReport ()
+
+@property (nonatomic, strong) NSMutableArray<ZGLoadSessionMetrics *> *sessions;
+
+@end
+
+@implementation ZGLoadTestReport
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _sessions = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)addSession:(ZGLoadSessionMetrics *)session {
+    @synchronized (self) {
+        [self.sessions addObject:session];
+    }
+}
+
+- (NSUInteger)sessionCount {
+    @synchronized (self) {
+        return self.sessions.count;
+    }
+}
+
+#pragma mark - Aggregation
+
+- (NSDictionary *)aggregate {
+    NSMutableArray<NSNumber *> *join = [NSMutableArray array];
+    NSMutableArray<NSNumber *> *publish = [NSMutableArray array];
+    NSMutableArray<NSNumber *> *firstFrame = [NSMutableArray array];
+    NSMutableArray<NSNumber *> *fps = [NSMutableArray array];
+    NSUInteger failedLogins = 0, plays = 0, playsWithoutFrame = 0, stalls = 0;
+    NSUInteger sessionCount = 0;
+    double stallMs = 0, renderSeconds = 0;
+
+    @synchronized (self) {
+        sessionCount = self.sessions.count;
+        for (ZGLoadSessionMetrics *session in self.sessions) {
+            if (session.joinLatencyMs < 0) {
+                failedLogins += 1;
+            } else {
+                [join addObject:@(session.joinLatencyMs)];
+            }
+            if (session.publishLatencyMs >= 0) {
+                [publish addObject:@(session.publishLatencyMs)];
+            }
+            for (ZGLoadPlayMetrics *play in session.plays) {
+                plays += 1;
+                if (play.firstFrameLatencyMs < 0) {
+                    playsWithoutFrame += 1;
+                    continue;
+                }
+                [firstFrame addObject:@(play.firstFrameLatencyMs)];
+                if (play.averageFPS > 0) {
+                    [fps addObject:@(play.averageFPS)];
+                }
+                stalls += play.stallCount;
+                stallMs += play.stallMs;
+                renderSeconds += play.renderSeconds;
+            }
+        }
+    }
+
+    return @{
+        @"sessions": @(sessionCount),
+        @"failedLogins": @(failedLogins),
+        @"peakConcurrentUsers": @(self.peakConcurrentUsers),
+        @"wallSeconds": @(self.wallSeconds),
+        @"joinLatencyMs": [self distributionOf:join],
+        @"publishLatencyMs": [self distributionOf:publish],
+        @"firstFrameLatencyMs": [self distributionOf:firstFrame],
+        @"renderFPS": [self distributionOf:fps],
+        @"plays": @(plays),
+        @"playsWithoutFrame": @(playsWithoutFrame),
+        @"stalls": @(stalls),
+        @"stallMs": @(stallMs),
+        @"stallsPerPlayMinute": @(renderSeconds > 0 ? stalls / (renderSeconds / 60.0) : 0),
+        @"stallRatio": @(renderSeconds > 0 ? stallMs / 1000.0 / renderSeconds : 0),
+    };
+}
+
+- (NSDictionary *)distributionOf:(NSArray<NSNumber *> *)values {
+    if (values.count == 0) {
+        return @{@"count": @0};
+    }
+    NSArray<NSNumber *> *sorted = [values sortedArrayUsingSelector:@selector(compare:)];
+    double sum = 0;
+    for (NSNumber *value in sorted) {
+        sum += value.doubleValue;
+    }
+    return @{
+        @"count": @(sorted.count),
+        @"mean": @(sum / sorted.count),
+        @"min": sorted.firstObject,
+        @"p5": [self percentile:0.05 ofSorted:sorted],
+        @"p50": [self percentile:0.50 ofSorted:sorted],
+        @"p95": [self percentile:0.95 ofSorted:sorted],
+        @"p99": [self percentile:0.99 ofSorted:sorted],
+        @"max": sorted.lastObject,
+    };
+}
+
+- (NSNumber *)percentile:(double)percentile ofSorted:(NSArray<NSNumber *> *)sorted {
+    NSUInteger index = (NSUInteger)llround(percentile * (sorted.count - 1));
+    return sorted[index];
+}
+
+#pragma mark - Output
+
+- (NSString *)summary {
+    NSDictionary *aggregate = [self aggregate];
+    NSMutableString *summary = [NSMutableString string];
+    [summary appendFormat:@"Load test: %@ sessions in %.1f s, peak %@ concurrent users, %@ failed logins\n",
+     aggregate[@"sessions"], self.wallSeconds, aggregate[@"peakConcurrentUsers"], aggregate[@"failedLogins"]];
+    [summary appendString:[self line:@"Join latency (ms)" distribution:aggregate[@"joinLatencyMs"]]];
+    [summary appendString:[self line:@"Publish latency (ms)" distribution:aggregate[@"publishLatencyMs"]]];
+    [summary appendString:[self line:@"First frame (ms)" distribution:aggregate[@"firstFrameLatencyMs"]]];
+    [summary appendString:[self line:@"Render FPS" distribution:aggregate[@"renderFPS"]]];
+    [summary appendFormat:@"Plays: %@ (%@ without frames), stalls: %@ (%.2f per play-minute, %.2f%% of play time)\n",
+     aggregate[@"plays"], aggregate[@"playsWithoutFrame"], aggregate[@"stalls"],
+     [aggregate[@"stallsPerPlayMinute"] doubleValue], [aggregate[@"stallRatio"] doubleValue] * 100];
+    return summary;
+}
+
+- (NSString *)line:(NSString *)title distribution:(NSDictionary *)distribution {
+    title = [title stringByPaddingToLength:22 withString:@" " startingAtIndex:0];
+    if ([distribution[@"count"] unsignedIntegerValue] == 0) {
+        return [NSString stringWithFormat:@"%@ n=0\n", title];
+    }
+    return [NSString stringWithFormat:@"%@ n=%@ mean=%.1f p5=%.1f p50=%.1f p95=%.1f p99=%.1f max=%.1f\n", title,
+            distribution[@"count"], [distribution[@"mean"] doubleValue], [distribution[@"p5"] doubleValue],
+            [distribution[@"p50"] doubleValue], [distribution[@"p95"] doubleValue],
+            [distribution[@"p99"] doubleValue], [distribution[@"max"] doubleValue]];
+}
+
+- (NSDictionary *)dictionaryRepresentation {
+    NSMutableArray *sessions = [NSMutableArray array];
+    @synchronized (self) {
+        for (ZGLoadSessionMetrics *session in self.sessions) {
+            NSMutableArray *plays = [NSMutableArray array];
+            for (ZGLoadPlayMetrics *play in session.plays) {
+                [plays addObject:@{
+                    @"streamID": play.streamID,
+                    @"firstFrameLatencyMs": @(play.firstFrameLatencyMs),
+                    @"renderedFrames": @(play.renderedFrames),
+                    @"averageFPS": @(play.averageFPS),
+                    @"stallCount": @(play.stallCount),
+                    @"stallMs": @(play.stallMs),
+                }];
+            }
+            NSMutableDictionary *sessionDictionary = [@{
+                @"userID": session.userID,
+                @"joinLatencyMs": @(session.joinLatencyMs),
+                @"publishLatencyMs": @(session.publishLatencyMs),
+                @"sessionSeconds": @(session.sessionSeconds),
+                @"plays": plays,
+            } mutableCopy];
+            if (session.joinError) {
+                sessionDictionary[@"joinError"] = session.joinError;
+            }
+            [sessions addObject:sessionDictionary];
+        }
+    }
+    return @{@"summary": [self aggregate], @"sessions": sessions};
+}
+
+- (BOOL)writeToFile:(NSString *)path error:(NSError **)error {
+    NSData *data = [NSJSONSerialization dataWithJSONObject:[self dictionaryRepresentation] options:NSJSONWritingPrettyPrinted error:error];
+    return data && [data writeToFile:path options:NSDataWritingAtomic error:error];
+}
+
+@end
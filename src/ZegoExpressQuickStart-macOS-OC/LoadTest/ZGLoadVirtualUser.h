@@ -0,0 +1,43 @@
+//
+//  ZGLoadVirtualUser.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ZGLoadTestReport.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ZGLoadScenario, ZGLoadFrameSource, ZGStandInRoomService;
+
+/// One scripted user of a load test
+///
+/// Follows the same steps as the quick start buttons: login room, publish from the shared frame source, then
+/// play up to `playStreamsPerUser` remote streams as they appear. Every callback is timed into a ZGLoadSessionMetrics.
+/// All methods must be called on the main queue, where the stand-in engine also delivers its callbacks.
+@interface ZGLoadVirtualUser : NSObject
+
+- (instancetype)initWithUserID:(NSString *)userID scenario:(ZGLoadScenario *)scenario roomService:(ZGStandInRoomService *)roomService frameSource:(ZGLoadFrameSource *)frameSource;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, copy, readonly) NSString *userID;
+
+/// Whether a session is in progress
+@property (nonatomic, assign, readonly) BOOL active;
+
+/// Create a fresh engine and login, starting a new session
+- (void)join;
+
+/// Logout, destroy the engine and return the metrics of the finished session, nil when not joined
+- (nullable ZGLoadSessionMetrics *)leave;
+
+/// Called with the metrics of a session that ended by itself, e.g. a join that could not get a room token
+@property (nonatomic, copy, nullable) void (^sessionEndedHandler)(ZGLoadVirtualUser *user, ZGLoadSessionMetrics *metrics);
+
+@end
+
+NS_ASSUME_NONNULL_END
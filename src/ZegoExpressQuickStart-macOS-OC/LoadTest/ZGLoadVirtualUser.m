@@ -0,0 +1,239 @@
+//
+//  ZGLoadVirtualUser.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGLoadVirtualUser.h"
+#import "ZGLoadScenario.h"
+#import "ZGLoadFrameSource.h"
+#import "ZGStandInEngine.h"
+#import "ZGStandInRoomService.h"
+#import "ZGStandInTokenService.h"
+#import "ZGRoomTokenManager.h"
+#import "ZGClock.h"
+
+/// Timing state of one played stream
+@interface ZGLoadPlayState : NSObject
+
+@property (nonatomic, strong) ZGLoadPlayMetrics *metrics;
+@property (nonatomic, assign) double startTime;
+@property (nonatomic, assign) double firstFrameTime;
+@property (nonatomic, assign) double lastFrameTime;
+
+@end
+
+@implementation ZGLoadPlayState
+
+@end
+
+@interface ZGLoadVirtualUser () <ZegoEventHandler, ZegoCustomVideoRenderHandler>
+
+@property (nonatomic, strong) ZGLoadScenario *scenario;
+@property (nonatomic, strong) ZGStandInRoomService *roomService;
+@property (nonatomic, strong) ZGLoadFrameSource *frameSource;
+/// Only when the room service requires tokens, kept across sessions so a rejoin finds its token cached
+@property (nonatomic, strong, nullable) ZGRoomTokenManager *tokenManager;
+
+@property (nonatomic, strong) ZGStandInEngine *engine;
+@property (nonatomic, strong) ZGLoadSessionMetrics *metrics;
+@property (nonatomic, copy) NSString *publishStreamID;
+@property (nonatomic, assign) double loginTime;
+@property (nonatomic, assign) double publishTime;
+/// Remote streams in arrival order, the candidates to play
+@property (nonatomic, strong) NSMutableOrderedSet<NSString *> *remoteStreamIDs;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZGLoadPlayState *> *plays;
+
+@end
+
+@implementation ZGLoadVirtualUser
+
+- (instancetype)initWithUserID:(NSString *)userID scenario:(ZGLoadScenario *)scenario roomService:(ZGStandInRoomService *)roomService frameSource:(ZGLoadFrameSource *)frameSource {
+    self = [super init];
+    if (self) {
+        _userID = [userID copy];
+        _scenario = scenario;
+        _roomService = roomService;
+        _frameSource = frameSource;
+        if (roomService.tokenService) {
+            _tokenManager = [[ZGRoomTokenManager alloc] initWithProvider:roomService.tokenService userID:userID];
+            [_tokenManager start];
+            if (scenario.prefetchTokens) {
+                [_tokenManager prefetchRoomIDs:@[scenario.roomID]];
+            }
+        }
+    }
+    return self;
+}
+
+- (BOOL)active {
+    return self.engine != nil;
+}
+
+#pragma mark - Session
+
+- (void)join {
+    if (self.engine) {
+        return;
+    }
+    self.metrics = [[ZGLoadSessionMetrics alloc] init];
+    self.metrics.userID = self.userID;
+    self.remoteStreamIDs = [NSMutableOrderedSet orderedSet];
+    self.plays = [NSMutableDictionary dictionary];
+    self.publishStreamID = [NSString stringWithFormat:@"load-%@", self.userID];
+
+    self.engine = [[ZGStandInEngine alloc] initWithRoomService:self.roomService eventHandler:self];
+    [self.engine setCustomVideoRenderHandler:self];
+    self.engine.networkProfile = self.scenario.networkProfile;
+
+    self.loginTime = ZGClockNowMs();
+    if (!self.tokenManager) {
+        [self loginWithConfig:[ZegoRoomConfig defaultConfig]];
+        return;
+    }
+    // The join latency includes waiting for the token, which is what prefetching saves
+    ZGStandInEngine *engine = self.engine;
+    __weak typeof(self) weakSelf = self;
+    [[self.tokenManager roomConfigForRoomID:self.scenario.roomID] whenCompleteOnQueue:dispatch_get_main_queue() block:^(ZegoRoomConfig *config, NSError *error) {
+        typeof(self) strongSelf = weakSelf;
+        // Left again while the token was on its way
+        if (!strongSelf || strongSelf.engine != engine) {
+            return;
+        }
+        if (!config) {
+            // No token could be had, the session ends here as a failed join
+            strongSelf.metrics.joinError = error.localizedDescription ?: @"No room token";
+            ZGLoadSessionMetrics *metrics = [strongSelf leave];
+            if (strongSelf.sessionEndedHandler) {
+                strongSelf.sessionEndedHandler(strongSelf, metrics);
+            }
+            return;
+        }
+        [strongSelf loginWithConfig:config];
+    }];
+}
+
+- (void)loginWithConfig:(ZegoRoomConfig *)config {
+    config.isUserStatusNotify = YES;
+    [self.engine loginRoom:self.scenario.roomID user:[ZegoUser userWithUserID:self.userID] config:config];
+}
+
+- (ZGLoadSessionMetrics *)leave {
+    ZGLoadSessionMetrics *metrics = self.metrics;
+    if (!self.engine) {
+        return metrics;
+    }
+    double now = ZGClockNowMs();
+    for (ZGLoadPlayState *play in self.plays.allValues) {
+        [self finishPlay:play now:now];
+    }
+    [self.plays removeAllObjects];
+    metrics.sessionSeconds = (now - self.loginTime) / 1000.0;
+
+    [self.frameSource removeEngine:self.engine];
+    [self.engine logoutRoom:self.scenario.roomID];
+    [self.engine setEventHandler:nil];
+    [self.engine setCustomVideoRenderHandler:nil];
+    self.engine = nil;
+    self.metrics = nil;
+    return metrics;
+}
+
+#pragma mark - Play scheduling
+
+- (void)fillPlays {
+    for (NSString *streamID in self.remoteStreamIDs) {
+        if (self.plays.count >= self.scenario.playStreamsPerUser) {
+            return;
+        }
+        if (self.plays[streamID]) {
+            continue;
+        }
+        ZGLoadPlayState *play = [[ZGLoadPlayState alloc] init];
+        play.metrics = [[ZGLoadPlayMetrics alloc] init];
+        play.metrics.streamID = streamID;
+        play.startTime = ZGClockNowMs();
+        self.plays[streamID] = play;
+        [self.engine startPlayingStream:streamID canvas:nil];
+    }
+}
+
+- (void)finishPlay:(ZGLoadPlayState *)play now:(double)now {
+    if (play.lastFrameTime > 0) {
+        // A stream that froze until the end of the play is a stall as well
+        double gap = now - play.lastFrameTime;
+        if (gap > self.scenario.stallThresholdMs) {
+            play.metrics.stallCount += 1;
+            play.metrics.stallMs += gap;
+        }
+        play.metrics.renderSeconds = (play.lastFrameTime - play.firstFrameTime) / 1000.0;
+    }
+    [self.metrics.plays addObject:play.metrics];
+}
+
+#pragma mark - ZegoEventHandler
+
+- (void)onRoomStateUpdate:(ZegoRoomState)state errorCode:(int)errorCode extendedData:(NSDictionary *)extendedData roomID:(NSString *)roomID {
+    if (state == ZegoRoomStateConnected && errorCode == 0) {
+        self.metrics.joinLatencyMs = ZGClockNowMs() - self.loginTime;
+        if (self.scenario.publish) {
+            self.publishTime = ZGClockNowMs();
+            [self.engine startPublishing:self.publishStreamID];
+        }
+        [self fillPlays];
+    }
+    if (errorCode == ZGStandInErrorCodeTokenInvalid) {
+        [self.tokenManager invalidateTokenForRoomID:roomID];
+    }
+}
+
+- (void)onPublisherStateUpdate:(ZegoPublisherState)state errorCode:(int)errorCode extendedData:(NSDictionary *)extendedData streamID:(NSString *)streamID {
+    if (state == ZegoPublisherStatePublishing && errorCode == 0 && self.metrics.publishLatencyMs < 0) {
+        self.metrics.publishLatencyMs = ZGClockNowMs() - self.publishTime;
+        [self.frameSource addEngine:self.engine];
+    }
+}
+
+- (void)onRoomStreamUpdate:(ZegoUpdateType)updateType streamList:(NSArray<ZegoStream *> *)streamList roomID:(NSString *)roomID {
+    double now = ZGClockNowMs();
+    for (ZegoStream *stream in streamList) {
+        if (updateType == ZegoUpdateTypeAdd) {
+            [self.remoteStreamIDs addObject:stream.streamID];
+        } else {
+            [self.remoteStreamIDs removeObject:stream.streamID];
+            ZGLoadPlayState *play = self.plays[stream.streamID];
+            if (play) {
+                [self finishPlay:play now:now];
+                [self.plays removeObjectForKey:stream.streamID];
+                [self.engine stopPlayingStream:stream.streamID];
+            }
+        }
+    }
+    [self fillPlays];
+}
+
+#pragma mark - ZegoCustomVideoRenderHandler
+
+- (void)onRemoteVideoFrameCVPixelBuffer:(CVPixelBufferRef)buffer param:(ZegoVideoFrameParam *)param streamID:(NSString *)streamID {
+    ZGLoadPlayState *play = self.plays[streamID];
+    if (!play) {
+        return;
+    }
+    double now = ZGClockNowMs();
+    if (play.firstFrameTime == 0) {
+        play.firstFrameTime = now;
+        play.metrics.firstFrameLatencyMs = now - play.startTime;
+    } else {
+        double gap = now - play.lastFrameTime;
+        if (gap > self.scenario.stallThresholdMs) {
+            play.metrics.stallCount += 1;
+            play.metrics.stallMs += gap;
+        }
+    }
+    play.lastFrameTime = now;
+    play.metrics.renderedFrames += 1;
+}
+
+@end
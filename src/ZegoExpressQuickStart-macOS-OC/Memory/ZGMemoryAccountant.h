@@ -0,0 +1,125 @@
+//
+//  ZGMemoryAccountant.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// The part of the app an allocation belongs to
+typedef NSString *ZGMemorySubsystem NS_EXTENSIBLE_STRING_ENUM;
+
+FOUNDATION_EXPORT ZGMemorySubsystem const ZGMemorySubsystemCapture;
+FOUNDATION_EXPORT ZGMemorySubsystem const ZGMemorySubsystemRender;
+FOUNDATION_EXPORT ZGMemorySubsystem const ZGMemorySubsystemPlayout;
+FOUNDATION_EXPORT ZGMemorySubsystem const ZGMemorySubsystemCompositor;
+FOUNDATION_EXPORT ZGMemorySubsystem const ZGMemorySubsystemCache;
+FOUNDATION_EXPORT ZGMemorySubsystem const ZGMemorySubsystemIO;
+
+/// Eviction order of caches, lower priorities are evicted first
+typedef NS_ENUM(NSInteger, ZGMemoryPriority) {
+    ZGMemoryPriorityLow = 0,
+    ZGMemoryPriorityNormal = 1,
+    ZGMemoryPriorityHigh = 2
+};
+
+/// A cache that can give memory back when the budget is exceeded
+@protocol ZGMemoryEvictable <NSObject>
+
+/// Free up to `bytes`, releasing or resizing the cache's accounted allocations
+///
+/// Called on the thread whose allocation went over the budget, without any accountant lock held.
+///
+/// @return The number of bytes actually freed
+- (size_t)evictBytes:(size_t)bytes;
+
+@end
+
+/// An accounted allocation, resized and released through the accountant
+@interface ZGMemoryAllocation : NSObject
+
+@property (nonatomic, copy, readonly, nullable) NSString *streamID;
+@property (nonatomic, copy, readonly) ZGMemorySubsystem subsystem;
+@property (nonatomic, copy, readonly) NSString *label;
+@property (nonatomic, assign, readonly) size_t bytes;
+/// ZGClockNow() when the allocation was tracked
+@property (nonatomic, assign, readonly) double creationTime;
+
+@end
+
+/// Attributes the memory of pools, queues and caches to streams and subsystems
+///
+/// Owners report their allocations here; nothing is allocated by the accountant itself. Per-stream and
+/// per-subsystem totals are kept up to date on every change, so the queries are O(1). When the total goes
+/// over `budgetBytes`, registered caches are asked to evict, lowest priority first, down to `targetRatio` of
+/// the budget. Thread safe.
+@interface ZGMemoryAccountant : NSObject
+
+/// The accountant of the process
++ (instancetype)sharedAccountant;
+
+/// Global budget in bytes, 0 (default) for unlimited
+@property (atomic, assign) size_t budgetBytes;
+
+/// Eviction frees memory down to this fraction of the budget, default 0.9, so it does not run on every allocation
+@property (atomic, assign) double targetRatio;
+
+/// Total of the accounted allocations
+@property (atomic, assign, readonly) size_t totalBytes;
+
+/// Highest total seen
+@property (atomic, assign, readonly) size_t peakBytes;
+
+/// Number of eviction passes so far
+@property (atomic, assign, readonly) NSUInteger evictionCount;
+
+#pragma mark Allocations
+
+/// Start accounting an allocation
+///
+/// @param bytes Current size
+/// @param streamID The stream the memory serves, nil for memory shared by every stream
+/// @param subsystem The subsystem owning the memory
+/// @param label Shown in the debug dump, e.g. "frame pool 1280x720"
+- (ZGMemoryAllocation *)trackBytes:(size_t)bytes streamID:(nullable NSString *)streamID subsystem:(ZGMemorySubsystem)subsystem label:(NSString *)label;
+
+/// Change the size of an allocation, e.g. a queue that grew
+- (void)resizeAllocation:(ZGMemoryAllocation *)allocation toBytes:(size_t)bytes;
+
+/// Stop accounting an allocation, releasing an allocation twice is ignored
+- (void)releaseAllocation:(ZGMemoryAllocation *)allocation;
+
+#pragma mark Caches
+
+/// Register a cache for eviction, held weakly
+- (void)registerCache:(id<ZGMemoryEvictable>)cache priority:(ZGMemoryPriority)priority;
+
+- (void)unregisterCache:(id<ZGMemoryEvictable>)cache;
+
+#pragma mark Streams
+
+/// Mark a stream as finished, whatever is still accounted to it afterwards shows up as a leak in the dump
+- (void)streamDidEnd:(NSString *)streamID;
+
+#pragma mark Queries
+
+- (size_t)bytesForStream:(nullable NSString *)streamID;
+
+- (size_t)bytesForSubsystem:(ZGMemorySubsystem)subsystem;
+
+/// Bytes per stream ID, memory shared by every stream is under @"(shared)"
+- (NSDictionary<NSString *, NSNumber *> *)bytesByStream;
+
+- (NSDictionary<ZGMemorySubsystem, NSNumber *> *)bytesBySubsystem;
+
+/// Human readable report: totals, the per-subsystem and per-stream breakdown, the largest allocations,
+/// and every allocation still attributed to an ended stream
+- (NSString *)debugDump;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,412 @@
+//
+//  ZGMemoryAccountant.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGMemoryAccountant.h"
+#import "ZGClock.h"
+#import <pthread.h>
+
+ZGMemorySubsystem const ZGMemorySubsystemCapture = @"capture";
+ZGMemorySubsystem const ZGMemorySubsystemRender = @"render";
+ZGMemorySubsystem const ZGMemorySubsystemPlayout = @"playout";
+ZGMemorySubsystem const ZGMemorySubsystemCompositor = @"compositor";
+ZGMemorySubsystem const ZGMemorySubsystemCache = @"cache";
+ZGMemorySubsystem const ZGMemorySubsystemIO = @"io";
+
+/// Key of the memory not attributed to a single stream
+static NSString * const ZGMemorySharedStreamKey = @"(shared)";
+
+/// Number of allocations listed in the debug dump
+static const NSUInteger ZGMemoryDumpTopAllocations = 20;
+
+@interface ZGMemoryAllocation ()
+
+@property (nonatomic, copy, readwrite, nullable) NSString *streamID;
+@property (nonatomic, copy, readwrite) ZGMemorySubsystem subsystem;
+@property (nonatomic, copy, readwrite) NSString *label;
+@property (nonatomic, assign, readwrite) size_t bytes;
+@property (nonatomic, assign, readwrite) double creationTime;
+@property (nonatomic, assign) BOOL released;
+
+@end
+
+@implementation ZGMemoryAllocation
+
+@end
+
+/// Running total of one stream or subsystem
+@interface ZGMemoryCounter : NSObject
+
+@property (nonatomic, assign) size_t bytes;
+@property (nonatomic, assign) NSUInteger allocations;
+
+@end
+
+@implementation ZGMemoryCounter
+
+@end
+
+/// A registered cache
+@interface ZGMemoryCacheEntry : NSObject
+
+@property (nonatomic, weak) id<ZGMemoryEvictable> cache;
+@property (nonatomic, assign) ZGMemoryPriority priority;
+
+@end
+
+@implementation ZGMemoryCacheEntry
+
+@end
+
+@interface ZGMemoryAccountant ()
+
+@property (nonatomic, strong) NSMutableSet<ZGMemoryAllocation *> *allocations;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZGMemoryCounter *> *streamCounters;
+@property (nonatomic, strong) NSMutableDictionary<ZGMemorySubsystem, ZGMemoryCounter *> *subsystemCounters;
+@property (nonatomic, strong) NSMutableSet<NSString *> *endedStreamIDs;
+@property (nonatomic, strong) NSMutableArray<ZGMemoryCacheEntry *> *caches;
+
+@end
+
+@implementation ZGMemoryAccountant {
+    pthread_mutex_t _lock;
+    size_t _totalBytes;
+    size_t _peakBytes;
+    NSUInteger _evictionCount;
+    BOOL _evicting;
+}
+
++ (instancetype)sharedAccountant {
+    static ZGMemoryAccountant *accountant = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        accountant = [[ZGMemoryAccountant alloc] init];
+    });
+    return accountant;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        pthread_mutex_init(&_lock, NULL);
+        _targetRatio = 0.9;
+        _allocations = [NSMutableSet set];
+        _streamCounters = [NSMutableDictionary dictionary];
+        _subsystemCounters = [NSMutableDictionary dictionary];
+        _endedStreamIDs = [NSMutableSet set];
+        _caches = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    pthread_mutex_destroy(&_lock);
+}
+
+#pragma mark - Allocations
+
+- (ZGMemoryAllocation *)trackBytes:(size_t)bytes streamID:(NSString *)streamID subsystem:(ZGMemorySubsystem)subsystem label:(NSString *)label {
+    ZGMemoryAllocation *allocation = [[ZGMemoryAllocation alloc] init];
+    allocation.streamID = streamID;
+    allocation.subsystem = subsystem;
+    allocation.label = label;
+    allocation.creationTime = ZGClockNow();
+
+    pthread_mutex_lock(&_lock);
+    [self.allocations addObject:allocation];
+    if (streamID) {
+        // A stream ID that comes back is a new stream
+        [self.endedStreamIDs removeObject:streamID];
+    }
+    [self counterForStream:streamID].allocations += 1;
+    [self counterForSubsystem:subsystem].allocations += 1;
+    [self applyDelta:(int64_t)bytes toAllocation:allocation];
+    pthread_mutex_unlock(&_lock);
+
+    [self enforceBudget];
+    return allocation;
+}
+
+- (void)resizeAllocation:(ZGMemoryAllocation *)allocation toBytes:(size_t)bytes {
+    pthread_mutex_lock(&_lock);
+    BOOL grew = bytes > allocation.bytes;
+    if (!allocation.released) {
+        [self applyDelta:(int64_t)bytes - (int64_t)allocation.bytes toAllocation:allocation];
+    }
+    pthread_mutex_unlock(&_lock);
+
+    if (grew) {
+        [self enforceBudget];
+    }
+}
+
+- (void)releaseAllocation:(ZGMemoryAllocation *)allocation {
+    pthread_mutex_lock(&_lock);
+    if (!allocation.released) {
+        [self applyDelta:-(int64_t)allocation.bytes toAllocation:allocation];
+        [self counterForStream:allocation.streamID].allocations -= 1;
+        [self counterForSubsystem:allocation.subsystem].allocations -= 1;
+        [self.allocations removeObject:allocation];
+        allocation.released = YES;
+        if (allocation.streamID && [self.endedStreamIDs containsObject:allocation.streamID] && [self counterForStream:allocation.streamID].allocations == 0) {
+            [self.streamCounters removeObjectForKey:allocation.streamID];
+            [self.endedStreamIDs removeObject:allocation.streamID];
+        }
+    }
+    pthread_mutex_unlock(&_lock);
+}
+
+/// Called with the lock held
+- (void)applyDelta:(int64_t)delta toAllocation:(ZGMemoryAllocation *)allocation {
+    allocation.bytes = (size_t)((int64_t)allocation.bytes + delta);
+    ZGMemoryCounter *streamCounter = [self counterForStream:allocation.streamID];
+    streamCounter.bytes = (size_t)((int64_t)streamCounter.bytes + delta);
+    ZGMemoryCounter *subsystemCounter = [self counterForSubsystem:allocation.subsystem];
+    subsystemCounter.bytes = (size_t)((int64_t)subsystemCounter.bytes + delta);
+    _totalBytes = (size_t)((int64_t)_totalBytes + delta);
+    _peakBytes = MAX(_peakBytes, _totalBytes);
+}
+
+- (ZGMemoryCounter *)counterForStream:(NSString *)streamID {
+    NSString *key = streamID ?: ZGMemorySharedStreamKey;
+    ZGMemoryCounter *counter = self.streamCounters[key];
+    if (!counter) {
+        counter = [[ZGMemoryCounter alloc] init];
+        self.streamCounters[key] = counter;
+    }
+    return counter;
+}
+
+- (ZGMemoryCounter *)counterForSubsystem:(ZGMemorySubsystem)subsystem {
+    ZGMemoryCounter *counter = self.subsystemCounters[subsystem];
+    if (!counter) {
+        counter = [[ZGMemoryCounter alloc] init];
+        self.subsystemCounters[subsystem] = counter;
+    }
+    return counter;
+}
+
+#pragma mark - Budget
+
+- (void)enforceBudget {
+    size_t budget = self.budgetBytes;
+    if (budget == 0) {
+        return;
+    }
+
+    pthread_mutex_lock(&_lock);
+    if (_totalBytes <= budget || _evicting) {
+        pthread_mutex_unlock(&_lock);
+        return;
+    }
+    // Caches release their allocations while evicting, which takes the lock again
+    _evicting = YES;
+    _evictionCount += 1;
+    NSMutableArray<ZGMemoryCacheEntry *> *entries = [NSMutableArray arrayWithCapacity:self.caches.count];
+    for (ZGMemoryCacheEntry *entry in self.caches) {
+        if (entry.cache) {
+            [entries addObject:entry];
+        }
+    }
+    [self.caches setArray:entries];
+    pthread_mutex_unlock(&_lock);
+
+    // Stable sort, caches of one priority are evicted in registration order
+    NSArray<ZGMemoryCacheEntry *> *ordered = [entries sortedArrayWithOptions:NSSortStable usingComparator:^NSComparisonResult(ZGMemoryCacheEntry *a, ZGMemoryCacheEntry *b) {
+        return a.priority < b.priority ? NSOrderedAscending : a.priority > b.priority ? NSOrderedDescending : NSOrderedSame;
+    }];
+    size_t target = (size_t)(budget * self.targetRatio);
+    for (ZGMemoryCacheEntry *entry in ordered) {
+        size_t total = self.totalBytes;
+        if (total <= target) {
+            break;
+        }
+        [entry.cache evictBytes:total - target];
+    }
+
+    pthread_mutex_lock(&_lock);
+    _evicting = NO;
+    pthread_mutex_unlock(&_lock);
+}
+
+- (void)registerCache:(id<ZGMemoryEvictable>)cache priority:(ZGMemoryPriority)priority {
+    ZGMemoryCacheEntry *entry = [[ZGMemoryCacheEntry alloc] init];
+    entry.cache = cache;
+    entry.priority = priority;
+    pthread_mutex_lock(&_lock);
+    [self.caches addObject:entry];
+    pthread_mutex_unlock(&_lock);
+}
+
+- (void)unregisterCache:(id<ZGMemoryEvictable>)cache {
+    pthread_mutex_lock(&_lock);
+    NSIndexSet *indexes = [self.caches indexesOfObjectsPassingTest:^BOOL(ZGMemoryCacheEntry *entry, NSUInteger idx, BOOL *stop) {
+        return !entry.cache || entry.cache == cache;
+    }];
+    [self.caches removeObjectsAtIndexes:indexes];
+    pthread_mutex_unlock(&_lock);
+}
+
+#pragma mark - Streams
+
+- (void)streamDidEnd:(NSString *)streamID {
+    pthread_mutex_lock(&_lock);
+    ZGMemoryCounter *counter = self.streamCounters[streamID];
+    if (counter.allocations > 0) {
+        // Kept until its last allocation goes, anything left meanwhile shows up as leaked
+        [self.endedStreamIDs addObject:streamID];
+    } else if (counter) {
+        // Drop the counter of a stream that cleaned up after itself
+        [self.streamCounters removeObjectForKey:streamID];
+    }
+    pthread_mutex_unlock(&_lock);
+}
+
+#pragma mark - Queries
+
+- (size_t)totalBytes {
+    pthread_mutex_lock(&_lock);
+    size_t bytes = _totalBytes;
+    pthread_mutex_unlock(&_lock);
+    return bytes;
+}
+
+- (size_t)peakBytes {
+    pthread_mutex_lock(&_lock);
+    size_t bytes = _peakBytes;
+    pthread_mutex_unlock(&_lock);
+    return bytes;
+}
+
+- (NSUInteger)evictionCount {
+    pthread_mutex_lock(&_lock);
+    NSUInteger count = _evictionCount;
+    pthread_mutex_unlock(&_lock);
+    return count;
+}
+
+- (size_t)bytesForStream:(NSString *)streamID {
+    pthread_mutex_lock(&_lock);
+    size_t bytes = self.streamCounters[streamID ?: ZGMemorySharedStreamKey].bytes;
+    pthread_mutex_unlock(&_lock);
+    return bytes;
+}
+
+- (size_t)bytesForSubsystem:(ZGMemorySubsystem)subsystem {
+    pthread_mutex_lock(&_lock);
+    size_t bytes = self.subsystemCounters[subsystem].bytes;
+    pthread_mutex_unlock(&_lock);
+    return bytes;
+}
+
+- (NSDictionary<NSString *, NSNumber *> *)bytesByStream {
+    pthread_mutex_lock(&_lock);
+    NSDictionary *bytes = [self bytesOfCounters:self.streamCounters];
+    pthread_mutex_unlock(&_lock);
+    return bytes;
+}
+
+- (NSDictionary<ZGMemorySubsystem, NSNumber *> *)bytesBySubsystem {
+    pthread_mutex_lock(&_lock);
+    NSDictionary *bytes = [self bytesOfCounters:self.subsystemCounters];
+    pthread_mutex_unlock(&_lock);
+    return bytes;
+}
+
+- (NSDictionary<NSString *, NSNumber *> *)bytesOfCounters:(NSDictionary<NSString *, ZGMemoryCounter *> *)counters {
+    NSMutableDictionary<NSString *, NSNumber *> *bytes = [NSMutableDictionary dictionaryWithCapacity:counters.count];
+    [counters enumerateKeysAndObjectsUsingBlock:^(NSString *key, ZGMemoryCounter *counter, BOOL *stop) {
+        bytes[key] = @(counter.bytes);
+    }];
+    return bytes;
+}
+
+#pragma mark - Debug dump
+
+- (NSString *)debugDump {
+    pthread_mutex_lock(&_lock);
+    NSArray<ZGMemoryAllocation *> *allocations = self.allocations.allObjects;
+    // Copies of the counters, the live ones keep changing once the lock is released
+    NSDictionary<NSString *, ZGMemoryCounter *> *streamCounters = [self snapshotOfCounters:self.streamCounters];
+    NSDictionary<NSString *, ZGMemoryCounter *> *subsystemCounters = [self snapshotOfCounters:self.subsystemCounters];
+    NSSet<NSString *> *endedStreamIDs = [self.endedStreamIDs copy];
+    size_t total = _totalBytes;
+    size_t peak = _peakBytes;
+    NSUInteger evictions = _evictionCount;
+    // Snapshot the sizes, the allocations keep changing once the lock is released
+    NSMutableArray<NSArray *> *rows = [NSMutableArray arrayWithCapacity:allocations.count];
+    for (ZGMemoryAllocation *allocation in allocations) {
+        [rows addObject:@[allocation, @(allocation.bytes)]];
+    }
+    pthread_mutex_unlock(&_lock);
+
+    double now = ZGClockNow();
+    NSMutableString *dump = [NSMutableString string];
+    [dump appendFormat:@"Memory: %@ in %lu allocations, peak %@, budget %@, %lu evictions\n", [self formatBytes:total], (unsigned long)allocations.count, [self formatBytes:peak], self.budgetBytes ? [self formatBytes:self.budgetBytes] : @"unlimited", (unsigned long)evictions];
+
+    [dump appendString:@"\nBy subsystem\n"];
+    [self appendCounters:subsystemCounters toDump:dump];
+    [dump appendString:@"\nBy stream\n"];
+    [self appendCounters:streamCounters toDump:dump];
+
+    [rows sortUsingComparator:^NSComparisonResult(NSArray *a, NSArray *b) {
+        return [b[1] compare:a[1]];
+    }];
+    [dump appendString:@"\nLargest allocations\n"];
+    for (NSArray *row in [rows subarrayWithRange:NSMakeRange(0, MIN(rows.count, ZGMemoryDumpTopAllocations))]) {
+        [self appendAllocation:row[0] bytes:[row[1] unsignedLongLongValue] now:now toDump:dump];
+    }
+
+    // Anything left on an ended stream should have been released with it
+    NSMutableArray<NSArray *> *leaks = [NSMutableArray array];
+    for (NSArray *row in rows) {
+        ZGMemoryAllocation *allocation = row[0];
+        if (allocation.streamID && [endedStreamIDs containsObject:allocation.streamID]) {
+            [leaks addObject:row];
+        }
+    }
+    [dump appendFormat:@"\nLeaked on ended streams: %lu\n", (unsigned long)leaks.count];
+    for (NSArray *row in leaks) {
+        [self appendAllocation:row[0] bytes:[row[1] unsignedLongLongValue] now:now toDump:dump];
+    }
+    return dump;
+}
+
+/// Called with the lock held
+- (NSDictionary<NSString *, ZGMemoryCounter *> *)snapshotOfCounters:(NSDictionary<NSString *, ZGMemoryCounter *> *)counters {
+    NSMutableDictionary<NSString *, ZGMemoryCounter *> *snapshot = [NSMutableDictionary dictionaryWithCapacity:counters.count];
+    [counters enumerateKeysAndObjectsUsingBlock:^(NSString *key, ZGMemoryCounter *counter, BOOL *stop) {
+        ZGMemoryCounter *copy = [[ZGMemoryCounter alloc] init];
+        copy.bytes = counter.bytes;
+        copy.allocations = counter.allocations;
+        snapshot[key] = copy;
+    }];
+    return snapshot;
+}
+
+- (void)appendCounters:(NSDictionary<NSString *, ZGMemoryCounter *> *)counters toDump:(NSMutableString *)dump {
+    NSArray<NSString *> *keys = [counters keysSortedByValueUsingComparator:^NSComparisonResult(ZGMemoryCounter *a, ZGMemoryCounter *b) {
+        return a.bytes > b.bytes ? NSOrderedAscending : a.bytes < b.bytes ? NSOrderedDescending : NSOrderedSame;
+    }];
+    for (NSString *key in keys) {
+        ZGMemoryCounter *counter = counters[key];
+        [dump appendFormat:@"  %-24s %10s %6lu allocations\n", key.UTF8String, [self formatBytes:counter.bytes].UTF8String, (unsigned long)counter.allocations];
+    }
+}
+
+- (void)appendAllocation:(ZGMemoryAllocation *)allocation bytes:(unsigned long long)bytes now:(double)now toDump:(NSMutableString *)dump {
+    [dump appendFormat:@"  %10s  %-10s %-24s age %.0fs  %@\n", [self formatBytes:bytes].UTF8String, allocation.subsystem.UTF8String, (allocation.streamID ?: ZGMemorySharedStreamKey).UTF8String, now - allocation.creationTime, allocation.label];
+}
+
+- (NSString *)formatBytes:(unsigned long long)bytes {
+    if (bytes >= 1024 * 1024) {
+        return [NSString stringWithFormat:@"%.1f MB", bytes / (1024.0 * 1024.0)];
+    }
+    return [NSString stringWithFormat:@"%.1f KB", bytes / 1024.0];
+}
+
+@end
@@ -0,0 +1,87 @@
+//
+//  ZGAuxDuckingController.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <ZegoExpressEngine/ZegoExpressEngine.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ZGEngineCommandProxy;
+
+@interface ZGAuxDuckingStatistics : NSObject
+
+/// Envelope samples computed
+@property (nonatomic, assign) NSUInteger samples;
+/// setVolume calls made on the media player
+@property (nonatomic, assign) NSUInteger issuedCalls;
+/// Time the music spent turned down by more than half the depth
+@property (nonatomic, assign) NSTimeInterval duckedTime;
+/// Volume last sent to the media player
+@property (nonatomic, assign) int appliedVolume;
+
+@end
+
+/// Turns the background music down while the host talks
+///
+/// Watches the local voice level, from onCapturedSoundLevelUpdate or any voice activity detector, and moves a
+/// ducking envelope towards "ducked" within `attackTime` when the host speaks and back within `releaseTime`
+/// once they were quiet for `holdTime`. The envelope is sampled every `sampleInterval`, in dB so the fades
+/// sound even, but the media player only gets a setVolume call when the volume moved by `minimumVolumeStep`
+/// and at most once per `controlInterval`, on the engine command thread. The sampling timer only runs while
+/// the envelope is moving.
+@interface ZGAuxDuckingController : NSObject
+
+/// @param mediaPlayer The player mixed into the publish stream with enableAux:
+- (instancetype)initWithCommandProxy:(ZGEngineCommandProxy *)commandProxy mediaPlayer:(ZegoMediaPlayer *)mediaPlayer;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Music volume while nobody talks, 0 ~ 100, default 100
+@property (nonatomic, assign) int normalVolume;
+
+/// How far the music is turned down, default 12 dB
+@property (nonatomic, assign) double depthDB;
+
+/// Captured sound level (0 ~ 100) above which the host counts as talking, default 10
+@property (nonatomic, assign) double voiceThreshold;
+
+/// Default 0.05 s
+@property (nonatomic, assign) NSTimeInterval attackTime;
+
+/// Default 0.6 s
+@property (nonatomic, assign) NSTimeInterval releaseTime;
+
+/// Quiet time before the release starts, bridges pauses between words, default 0.3 s
+@property (nonatomic, assign) NSTimeInterval holdTime;
+
+/// Envelope sampling period, default 0.005 s, takes effect on the next `start`
+@property (nonatomic, assign) NSTimeInterval sampleInterval;
+
+/// Shortest time between two setVolume calls, default 0.04 s
+@property (nonatomic, assign) NSTimeInterval controlInterval;
+
+/// Smaller volume changes are not sent unless the envelope settled, default 2
+@property (nonatomic, assign) int minimumVolumeStep;
+
+/// Start following the voice level
+- (void)start;
+
+/// Stop and restore the normal volume
+- (void)stop;
+
+/// Feed from onCapturedSoundLevelUpdate, any thread
+- (void)updateWithCapturedSoundLevel:(double)soundLevel;
+
+/// Feed from a voice activity detector instead, any thread
+- (void)updateWithVoiceActive:(BOOL)voiceActive;
+
+- (ZGAuxDuckingStatistics *)statistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,225 @@
+//
+//  ZGAuxDuckingController.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGAuxDuckingController.h"
+#import "ZGEngineCommandProxy.h"
+#import "ZGClock.h"
+
+@implementation ZGAuxDuckingStatistics
+
+@end
+
+@interface ZGAuxDuckingController ()
+
+@property (nonatomic, strong) ZGEngineCommandProxy *commandProxy;
+@property (nonatomic, strong) ZegoMediaPlayer *mediaPlayer;
+@property (nonatomic, strong) dispatch_queue_t queue;
+
+// Everything below is only touched on `queue`
+@property (nonatomic, strong, nullable) dispatch_source_t timer;
+/// Dispatch sources start suspended, resumes and suspends must stay balanced
+@property (nonatomic, assign) BOOL timerRunning;
+@property (nonatomic, assign) BOOL wakeScheduled;
+@property (nonatomic, assign) double lastVoiceTime;
+/// 0 is the normal volume, 1 fully ducked
+@property (nonatomic, assign) double envelope;
+@property (nonatomic, assign) double lastSampleTime;
+@property (nonatomic, assign) double lastCallTime;
+@property (nonatomic, strong) ZGAuxDuckingStatistics *counters;
+
+@end
+
+@implementation ZGAuxDuckingController
+
+@synthesize normalVolume = _normalVolume;
+
+- (instancetype)initWithCommandProxy:(ZGEngineCommandProxy *)commandProxy mediaPlayer:(ZegoMediaPlayer *)mediaPlayer {
+    self = [super init];
+    if (self) {
+        _commandProxy = commandProxy;
+        _mediaPlayer = mediaPlayer;
+        _normalVolume = 100;
+        _depthDB = 12;
+        _voiceThreshold = 10;
+        _attackTime = 0.05;
+        _releaseTime = 0.6;
+        _holdTime = 0.3;
+        _sampleInterval = 0.005;
+        _controlInterval = 0.04;
+        _minimumVolumeStep = 2;
+        _queue = dispatch_queue_create("im.zego.ducking", DISPATCH_QUEUE_SERIAL);
+        _lastVoiceTime = -INFINITY;
+        _counters = [[ZGAuxDuckingStatistics alloc] init];
+        _counters.appliedVolume = -1;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_timer) {
+        if (!_timerRunning) {
+            dispatch_resume(_timer);
+        }
+        dispatch_source_cancel(_timer);
+    }
+}
+
+#pragma mark - Lifecycle
+
+- (void)start {
+    dispatch_async(self.queue, ^{
+        if (self.timer) {
+            return;
+        }
+        __weak typeof(self) weakSelf = self;
+        uint64_t interval = (uint64_t)(self.sampleInterval * NSEC_PER_SEC);
+        self.timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.queue);
+        dispatch_source_set_timer(self.timer, DISPATCH_TIME_NOW, interval, interval / 10);
+        dispatch_source_set_event_handler(self.timer, ^{
+            [weakSelf sample];
+        });
+        self.timerRunning = NO;
+        self.envelope = 0;
+        self.lastVoiceTime = -INFINITY;
+        [self sendVolume:[self currentVolume] now:ZGClockNow()];
+    });
+}
+
+- (void)stop {
+    dispatch_async(self.queue, ^{
+        if (!self.timer) {
+            return;
+        }
+        if (!self.timerRunning) {
+            dispatch_resume(self.timer);
+        }
+        dispatch_source_cancel(self.timer);
+        self.timer = nil;
+        self.timerRunning = NO;
+        self.envelope = 0;
+        if (self.counters.appliedVolume != self.normalVolume) {
+            [self sendVolume:self.normalVolume now:ZGClockNow()];
+        }
+    });
+}
+
+- (void)setNormalVolume:(int)normalVolume {
+    dispatch_async(self.queue, ^{
+        self->_normalVolume = MAX(0, MIN(100, normalVolume));
+        [self wakeIfNeeded];
+    });
+}
+
+- (int)normalVolume {
+    return _normalVolume;
+}
+
+- (ZGAuxDuckingStatistics *)statistics {
+    ZGAuxDuckingStatistics *snapshot = [[ZGAuxDuckingStatistics alloc] init];
+    dispatch_sync(self.queue, ^{
+        snapshot.samples = self.counters.samples;
+        snapshot.issuedCalls = self.counters.issuedCalls;
+        snapshot.duckedTime = self.counters.duckedTime;
+        snapshot.appliedVolume = self.counters.appliedVolume;
+    });
+    return snapshot;
+}
+
+#pragma mark - Voice activity
+
+- (void)updateWithCapturedSoundLevel:(double)soundLevel {
+    [self updateWithVoiceActive:soundLevel >= self.voiceThreshold];
+}
+
+- (void)updateWithVoiceActive:(BOOL)voiceActive {
+    dispatch_async(self.queue, ^{
+        if (!self.timer) {
+            return;
+        }
+        if (voiceActive) {
+            self.lastVoiceTime = ZGClockNow();
+        }
+        [self wakeIfNeeded];
+    });
+}
+
+#pragma mark - Envelope
+
+- (double)targetAt:(double)now {
+    return now - self.lastVoiceTime < self.holdTime ? 1 : 0;
+}
+
+- (int)currentVolume {
+    return (int)lround(self.normalVolume * pow(10, -self.depthDB * self.envelope / 20));
+}
+
+/// Run the sampling timer if the volume has somewhere to go, or come back when the hold runs out
+- (void)wakeIfNeeded {
+    if (!self.timer || self.timerRunning) {
+        return;
+    }
+    double now = ZGClockNow();
+    double target = [self targetAt:now];
+    if (target != self.envelope || [self currentVolume] != self.counters.appliedVolume) {
+        self.lastSampleTime = now;
+        self.timerRunning = YES;
+        dispatch_resume(self.timer);
+        return;
+    }
+    if (target > 0 && !self.wakeScheduled) {
+        self.wakeScheduled = YES;
+        double delay = self.lastVoiceTime + self.holdTime - now + 0.001;
+        __weak typeof(self) weakSelf = self;
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.queue, ^{
+            weakSelf.wakeScheduled = NO;
+            [weakSelf wakeIfNeeded];
+        });
+    }
+}
+
+- (void)sample {
+    double now = ZGClockNow();
+    double dt = now - self.lastSampleTime;
+    self.lastSampleTime = now;
+
+    double target = [self targetAt:now];
+    double timeConstant = MAX(target > self.envelope ? self.attackTime : self.releaseTime, 0.001);
+    self.envelope += (target - self.envelope) * (1 - exp(-dt / timeConstant));
+    if (fabs(target - self.envelope) < 0.001) {
+        self.envelope = target;
+    }
+    self.counters.samples += 1;
+    if (self.envelope > 0.5) {
+        self.counters.duckedTime += dt;
+    }
+
+    int volume = [self currentVolume];
+    BOOL settled = self.envelope == target;
+    int step = abs(volume - self.counters.appliedVolume);
+    if (step > 0 && now - self.lastCallTime >= self.controlInterval && (step >= self.minimumVolumeStep || settled)) {
+        [self sendVolume:volume now:now];
+    }
+
+    if (settled && volume == self.counters.appliedVolume) {
+        self.timerRunning = NO;
+        dispatch_suspend(self.timer);
+        [self wakeIfNeeded];
+    }
+}
+
+- (void)sendVolume:(int)volume now:(double)now {
+    self.counters.appliedVolume = volume;
+    self.counters.issuedCalls += 1;
+    self.lastCallTime = now;
+    ZegoMediaPlayer *mediaPlayer = self.mediaPlayer;
+    [self.commandProxy submitCommand:@"auxVolume" block:^(id<ZGExpressEngine> _Nullable engine) {
+        [mediaPlayer setVolume:volume];
+    }];
+}
+
+@end
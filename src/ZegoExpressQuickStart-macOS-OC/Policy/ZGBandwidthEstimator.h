@@ -0,0 +1,81 @@
+//
+//  ZGBandwidthEstimator.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <ZegoExpressEngine/ZegoExpressEngine.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSUInteger, ZGBandwidthDirection) {
+    /// Publishing, estimated from publisher quality
+    ZGBandwidthDirectionUplink = 0,
+    /// Playing, estimated from player quality
+    ZGBandwidthDirectionDownlink = 1
+};
+
+/// Estimated capacity of one direction
+typedef struct ZGBandwidthEstimate {
+    /// Smoothed capacity estimate
+    double capacityKBPS;
+    /// Confidence bounds of the capacity, about two standard deviations wide
+    double lowerKBPS;
+    double upperKBPS;
+    /// Sum of the current throughput of every stream in this direction
+    double throughputKBPS;
+    /// Throughput weighted packet loss rate, 0.0 ~ 1.0
+    double lossRate;
+    /// Largest rtt over the streams, and the lowest rtt seen recently
+    double rttMs;
+    double baseRTTMs;
+    /// Whether loss or rtt inflation currently indicate congestion
+    BOOL congested;
+    NSUInteger streamCount;
+    /// No stream has reported within `staleInterval`, or none ever did: the capacity is the last one known,
+    /// with bounds no tighter than the initial ones
+    BOOL stale;
+} ZGBandwidthEstimate;
+
+/// Estimates the available uplink and downlink from the SDK's per-stream quality callbacks
+///
+/// Throughput of all streams of a direction is summed. While neither loss nor rtt inflation signal congestion,
+/// the throughput is a lower bound of the capacity and the estimate slowly probes upwards; once congestion is
+/// seen, the throughput is taken as the capacity and the estimate backs off multiplicatively. Feed it from
+/// onPublisherQualityUpdate / onPlayerQualityUpdate on any thread, and query it from any thread in O(1). Once all
+/// reports of a direction are older than `staleInterval`, a query drops them and returns a stale estimate.
+@interface ZGBandwidthEstimator : NSObject
+
+/// Capacity assumed before any report, default 1000 kbps in each direction, applied by `reset`
+@property (nonatomic, assign) double initialCapacityKBPS;
+
+/// Loss rate above which a direction counts as congested, default 0.05
+@property (nonatomic, assign) double congestionLossRate;
+
+/// rtt above baseRTT * this factor + 30 ms counts as congestion, default 1.5
+@property (nonatomic, assign) double congestionRTTFactor;
+
+/// Streams without a report for this long are dropped from the sum, default 10 s (the SDK reports every 3 s)
+@property (nonatomic, assign) NSTimeInterval staleInterval;
+
+/// The estimate never backs off below this, so probing can always grow it again, default 50 kbps
+@property (nonatomic, assign) double minimumCapacityKBPS;
+
+- (void)updateWithPublishQuality:(ZegoPublishStreamQuality *)quality streamID:(NSString *)streamID;
+- (void)updateWithPlayQuality:(ZegoPlayStreamQuality *)quality streamID:(NSString *)streamID;
+
+/// Forget a stream that stopped publishing or playing
+- (void)removeStream:(NSString *)streamID direction:(ZGBandwidthDirection)direction;
+
+/// Start over from `initialCapacityKBPS`, e.g. after a network change
+- (void)reset;
+
+/// The current estimate, O(1)
+- (ZGBandwidthEstimate)estimateForDirection:(ZGBandwidthDirection)direction;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,236 @@
+//
+//  ZGBandwidthEstimator.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGBandwidthEstimator.h"
+#import "ZGClock.h"
+
+/// The estimate moves at most once per step, whatever the number of streams reporting
+static const NSTimeInterval ZGBandwidthStepInterval = 1.0;
+/// After a back-off, wait one SDK report period so the same congested reports do not count twice
+static const NSTimeInterval ZGBandwidthDecreaseHoldInterval = 3.0;
+static const double ZGBandwidthDecreaseFactor = 0.85;
+/// Upward probing per second while nothing signals congestion
+static const double ZGBandwidthProbeGrowthPerSecond = 1.05;
+/// Probing never runs further ahead of the demonstrated throughput than this
+static const double ZGBandwidthProbeHeadroom = 1.5;
+static const double ZGBandwidthVarianceGain = 0.1;
+
+/// The last report of one stream
+@interface ZGBandwidthStreamSample : NSObject
+
+@property (nonatomic, assign) double kbps;
+@property (nonatomic, assign) double lossRate;
+@property (nonatomic, assign) double rtt;
+@property (nonatomic, assign) double time;
+
+@end
+
+@implementation ZGBandwidthStreamSample
+
+@end
+
+/// Estimator state of one direction
+@interface ZGBandwidthDirectionState : NSObject
+
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZGBandwidthStreamSample *> *streams;
+@property (nonatomic, assign) double capacityKBPS;
+@property (nonatomic, assign) double variance;
+@property (nonatomic, assign) double baseRTTMs;
+@property (nonatomic, assign) double lastStepTime;
+@property (nonatomic, assign) double lastDecreaseTime;
+/// Time of the newest stream report
+@property (nonatomic, assign) double lastReportTime;
+@property (nonatomic, assign) ZGBandwidthEstimate estimate;
+
+@end
+
+@implementation ZGBandwidthDirectionState
+
+@end
+
+@interface ZGBandwidthEstimator ()
+
+@property (nonatomic, strong) NSArray<ZGBandwidthDirectionState *> *states;
+
+@end
+
+@implementation ZGBandwidthEstimator
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _initialCapacityKBPS = 1000;
+        _congestionLossRate = 0.05;
+        _congestionRTTFactor = 1.5;
+        _staleInterval = 10;
+        _minimumCapacityKBPS = 50;
+        [self reset];
+    }
+    return self;
+}
+
+- (void)reset {
+    @synchronized (self) {
+        ZGBandwidthDirectionState *uplink = [[ZGBandwidthDirectionState alloc] init];
+        ZGBandwidthDirectionState *downlink = [[ZGBandwidthDirectionState alloc] init];
+        for (ZGBandwidthDirectionState *state in @[uplink, downlink]) {
+            state.streams = [NSMutableDictionary dictionary];
+            state.capacityKBPS = self.initialCapacityKBPS;
+            // Nothing is known yet, start with wide bounds
+            state.variance = pow(self.initialCapacityKBPS / 2, 2);
+            [self publishStaleEstimateOfState:state];
+        }
+        self.states = @[uplink, downlink];
+    }
+}
+
+#pragma mark - Update
+
+- (void)updateWithPublishQuality:(ZegoPublishStreamQuality *)quality streamID:(NSString *)streamID {
+    [self updateDirection:ZGBandwidthDirectionUplink streamID:streamID kbps:quality.videoKBPS + quality.audioKBPS lossRate:quality.packetLostRate rtt:quality.rtt];
+}
+
+- (void)updateWithPlayQuality:(ZegoPlayStreamQuality *)quality streamID:(NSString *)streamID {
+    [self updateDirection:ZGBandwidthDirectionDownlink streamID:streamID kbps:quality.videoKBPS + quality.audioKBPS lossRate:quality.packetLostRate rtt:quality.rtt];
+}
+
+- (void)removeStream:(NSString *)streamID direction:(ZGBandwidthDirection)direction {
+    @synchronized (self) {
+        ZGBandwidthDirectionState *state = self.states[direction];
+        [state.streams removeObjectForKey:streamID];
+        [self stepState:state now:ZGClockNow()];
+    }
+}
+
+- (void)updateDirection:(ZGBandwidthDirection)direction streamID:(NSString *)streamID kbps:(double)kbps lossRate:(double)lossRate rtt:(double)rtt {
+    double now = ZGClockNow();
+    ZGBandwidthStreamSample *sample = [[ZGBandwidthStreamSample alloc] init];
+    sample.kbps = kbps;
+    sample.lossRate = lossRate;
+    sample.rtt = rtt;
+    sample.time = now;
+    @synchronized (self) {
+        ZGBandwidthDirectionState *state = self.states[direction];
+        state.streams[streamID] = sample;
+        state.lastReportTime = now;
+        [self stepState:state now:now];
+    }
+}
+
+#pragma mark - Estimation
+
+- (void)stepState:(ZGBandwidthDirectionState *)state now:(double)now {
+    // Aggregate the live streams
+    double throughput = 0;
+    double lostKBPS = 0;
+    double lossSum = 0;
+    double maxRTT = 0;
+    double minRTT = DBL_MAX;
+    for (NSString *streamID in state.streams.allKeys) {
+        ZGBandwidthStreamSample *sample = state.streams[streamID];
+        if (now - sample.time > self.staleInterval) {
+            [state.streams removeObjectForKey:streamID];
+            continue;
+        }
+        throughput += sample.kbps;
+        lostKBPS += sample.kbps * sample.lossRate;
+        lossSum += sample.lossRate;
+        maxRTT = MAX(maxRTT, sample.rtt);
+        minRTT = MIN(minRTT, sample.rtt);
+    }
+    NSUInteger count = state.streams.count;
+    if (count == 0) {
+        [self publishStaleEstimateOfState:state];
+        return;
+    }
+    // Weighted by throughput, a stream that sends nothing still tells its loss
+    double lossRate = throughput > 0 ? lostKBPS / throughput : lossSum / count;
+
+    // The base rtt follows drops at once and rises only slowly, so queueing shows up as inflation
+    if (state.baseRTTMs <= 0 || minRTT < state.baseRTTMs) {
+        state.baseRTTMs = minRTT;
+    } else {
+        state.baseRTTMs += (minRTT - state.baseRTTMs) * 0.02;
+    }
+    BOOL congested = lossRate > self.congestionLossRate || maxRTT > state.baseRTTMs * self.congestionRTTFactor + 30;
+
+    double elapsed = state.lastStepTime > 0 ? now - state.lastStepTime : ZGBandwidthStepInterval;
+    if (elapsed >= ZGBandwidthStepInterval) {
+        state.lastStepTime = now;
+        if (congested) {
+            // What gets through a congested link is its capacity
+            if (now - state.lastDecreaseTime >= ZGBandwidthDecreaseHoldInterval) {
+                [self observeCapacity:throughput ofState:state];
+                // A link that lets nothing through must not end at 0, probing could never grow it again
+                state.capacityKBPS = MAX(MIN(state.capacityKBPS, throughput) * ZGBandwidthDecreaseFactor, self.minimumCapacityKBPS);
+                state.lastDecreaseTime = now;
+            }
+        } else if (throughput > state.capacityKBPS) {
+            [self observeCapacity:throughput ofState:state];
+            state.capacityKBPS = throughput;
+        } else {
+            double ceiling = MAX(throughput * ZGBandwidthProbeHeadroom, self.initialCapacityKBPS);
+            if (state.capacityKBPS < ceiling) {
+                double capacity = MAX(state.capacityKBPS, self.minimumCapacityKBPS);
+                state.capacityKBPS = MIN(capacity * pow(ZGBandwidthProbeGrowthPerSecond, elapsed), ceiling);
+            }
+        }
+    }
+    [self publishEstimateOfState:state throughput:throughput lossRate:lossRate rtt:maxRTT congested:congested];
+}
+
+- (void)observeCapacity:(double)capacity ofState:(ZGBandwidthDirectionState *)state {
+    double error = capacity - state.capacityKBPS;
+    state.variance += (error * error - state.variance) * ZGBandwidthVarianceGain;
+}
+
+- (void)publishEstimateOfState:(ZGBandwidthDirectionState *)state throughput:(double)throughput lossRate:(double)lossRate rtt:(double)rtt congested:(BOOL)congested {
+    double deviation = sqrt(state.variance);
+    ZGBandwidthEstimate estimate;
+    estimate.capacityKBPS = state.capacityKBPS;
+    estimate.lowerKBPS = MAX(state.capacityKBPS - 2 * deviation, 0);
+    // Without congestion the current throughput has been proven to fit
+    if (!congested) {
+        estimate.lowerKBPS = MAX(estimate.lowerKBPS, MIN(throughput, state.capacityKBPS));
+    }
+    estimate.upperKBPS = state.capacityKBPS + 2 * deviation;
+    estimate.throughputKBPS = throughput;
+    estimate.lossRate = lossRate;
+    estimate.rttMs = rtt;
+    estimate.baseRTTMs = state.baseRTTMs;
+    estimate.congested = congested;
+    estimate.streamCount = state.streams.count;
+    estimate.stale = NO;
+    state.estimate = estimate;
+}
+
+/// Nothing measured any more: keep the capacity as a guess, but no tighter than before the first report
+- (void)publishStaleEstimateOfState:(ZGBandwidthDirectionState *)state {
+    state.variance = MAX(state.variance, pow(self.initialCapacityKBPS / 2, 2));
+    [self publishEstimateOfState:state throughput:0 lossRate:0 rtt:0 congested:NO];
+    ZGBandwidthEstimate estimate = state.estimate;
+    estimate.stale = YES;
+    state.estimate = estimate;
+}
+
+#pragma mark - Query
+
+- (ZGBandwidthEstimate)estimateForDirection:(ZGBandwidthDirection)direction {
+    double now = ZGClockNow();
+    @synchronized (self) {
+        ZGBandwidthDirectionState *state = self.states[direction];
+        // Reports stopped coming, so the published figures describe streams that are gone
+        if (state.streams.count > 0 && now - state.lastReportTime > self.staleInterval) {
+            [state.streams removeAllObjects];
+            [self publishStaleEstimateOfState:state];
+        }
+        return state.estimate;
+    }
+}
+
+@end
@@ -0,0 +1,79 @@
+//
+//  ZGLoudnessNormalizer.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ZGPlayControlBatcher;
+
+/// Loudness settings of one room
+@interface ZGLoudnessConfig : NSObject <NSCopying>
+
++ (instancetype)defaultConfig;
+
+/// Turn normalisation off to leave only the user's volumes, default YES
+@property (nonatomic, assign) BOOL enabled;
+
+/// Level (dB below a sound level of 100) that louder streams are brought down to, default -24 (a sound level of 60)
+@property (nonatomic, assign) double targetLevelDB;
+
+/// dB spanned by the SDK's 0 ~ 100 sound level, default 60
+///
+/// The sound level is a perceptual scale rather than a linear amplitude, so each step of it is taken as the
+/// same number of dB: level L is (L / 100 - 1) * levelRangeDB.
+@property (nonatomic, assign) double levelRangeDB;
+
+/// Time constant of the level integrator, default 8 s
+@property (nonatomic, assign) NSTimeInterval integrationTime;
+
+/// Sound levels below this (0 ~ 100) count as silence and are not integrated, default 5
+@property (nonatomic, assign) double gateLevel;
+
+/// Most a stream is turned down, default 18 dB
+@property (nonatomic, assign) double maxAttenuationDB;
+
+/// Gain changes smaller than this are not applied, default 1.5 dB
+@property (nonatomic, assign) double stepThresholdDB;
+
+@end
+
+/// Evens out how loud remote participants are
+///
+/// Integrates each stream's level from onRemoteSoundLevelUpdate while the participant is speaking, and turns
+/// streams that are louder than the room's target down through setPlayVolume. setPlayVolume cannot go above
+/// 100, so quiet streams are left at the user's volume rather than boosted. The volume a user picks for a
+/// stream is kept as an upper bound the gain is applied on. A new volume is only sent when the gain moved by
+/// more than the step threshold, through the play control batcher. All work runs on a private queue.
+@interface ZGLoudnessNormalizer : NSObject
+
+- (instancetype)initWithControlBatcher:(ZGPlayControlBatcher *)controlBatcher;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Settings for streams of a room, rooms without one use +[ZGLoudnessConfig defaultConfig]
+- (void)setConfig:(ZGLoudnessConfig *)config forRoomID:(NSString *)roomID;
+
+/// Start normalising a played stream
+- (void)addStream:(NSString *)streamID roomID:(NSString *)roomID;
+
+/// Forget a stream, its volume goes back to the one the user chose
+- (void)removeStream:(NSString *)streamID;
+
+/// The volume the user chose for a stream, 0 ~ 100, default 100
+- (void)setUserVolume:(int)volume streamID:(NSString *)streamID;
+
+/// Feed from onRemoteSoundLevelUpdate, returns at once
+- (void)updateWithSoundLevels:(NSDictionary<NSString *, NSNumber *> *)soundLevels;
+
+/// The gain currently applied to a stream in dB, 0 or negative
+- (double)gainOfStream:(NSString *)streamID;
+
+@end
+
+NS_ASSUME_NONNULL_END
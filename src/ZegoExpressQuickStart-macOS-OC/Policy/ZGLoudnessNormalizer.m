@@ -0,0 +1,195 @@
+//
+//  ZGLoudnessNormalizer.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGLoudnessNormalizer.h"
+#import "ZGPlayControlBatcher.h"
+#import "ZGClock.h"
+
+@implementation ZGLoudnessConfig
+
++ (instancetype)defaultConfig {
+    ZGLoudnessConfig *config = [[ZGLoudnessConfig alloc] init];
+    config.enabled = YES;
+    config.targetLevelDB = -24;
+    config.levelRangeDB = 60;
+    config.integrationTime = 8;
+    config.gateLevel = 5;
+    config.maxAttenuationDB = 18;
+    config.stepThresholdDB = 1.5;
+    return config;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    ZGLoudnessConfig *copy = [[ZGLoudnessConfig alloc] init];
+    copy.enabled = self.enabled;
+    copy.targetLevelDB = self.targetLevelDB;
+    copy.levelRangeDB = self.levelRangeDB;
+    copy.integrationTime = self.integrationTime;
+    copy.gateLevel = self.gateLevel;
+    copy.maxAttenuationDB = self.maxAttenuationDB;
+    copy.stepThresholdDB = self.stepThresholdDB;
+    return copy;
+}
+
+@end
+
+/// Loudness state of one stream
+@interface ZGLoudnessStream : NSObject
+
+@property (nonatomic, copy) NSString *roomID;
+/// Integrated level in dB, NAN until the participant first spoke
+@property (nonatomic, assign) double levelDB;
+@property (nonatomic, assign) double lastUpdateTime;
+@property (nonatomic, assign) int userVolume;
+/// Gain behind the volume last sent
+@property (nonatomic, assign) double appliedGainDB;
+
+@end
+
+@implementation ZGLoudnessStream
+
+@end
+
+@interface ZGLoudnessNormalizer ()
+
+@property (nonatomic, strong) ZGPlayControlBatcher *controlBatcher;
+@property (nonatomic, strong) dispatch_queue_t queue;
+
+// Only touched on `queue`
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZGLoudnessConfig *> *configs;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZGLoudnessStream *> *streams;
+
+@end
+
+@implementation ZGLoudnessNormalizer
+
+- (instancetype)initWithControlBatcher:(ZGPlayControlBatcher *)controlBatcher {
+    self = [super init];
+    if (self) {
+        _controlBatcher = controlBatcher;
+        _queue = dispatch_queue_create("im.zego.loudness", DISPATCH_QUEUE_SERIAL);
+        _configs = [NSMutableDictionary dictionary];
+        _streams = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+#pragma mark - Configuration
+
+- (void)setConfig:(ZGLoudnessConfig *)config forRoomID:(NSString *)roomID {
+    ZGLoudnessConfig *copy = [config copy];
+    dispatch_async(self.queue, ^{
+        self.configs[roomID] = copy;
+        for (NSString *streamID in self.streams) {
+            ZGLoudnessStream *stream = self.streams[streamID];
+            if ([stream.roomID isEqualToString:roomID]) {
+                [self applyGainOfStream:stream streamID:streamID force:YES];
+            }
+        }
+    });
+}
+
+- (ZGLoudnessConfig *)configForRoomID:(NSString *)roomID {
+    ZGLoudnessConfig *config = self.configs[roomID];
+    if (!config) {
+        config = [ZGLoudnessConfig defaultConfig];
+        self.configs[roomID] = config;
+    }
+    return config;
+}
+
+#pragma mark - Streams
+
+- (void)addStream:(NSString *)streamID roomID:(NSString *)roomID {
+    dispatch_async(self.queue, ^{
+        ZGLoudnessStream *stream = [[ZGLoudnessStream alloc] init];
+        stream.roomID = roomID;
+        stream.levelDB = NAN;
+        stream.userVolume = 100;
+        self.streams[streamID] = stream;
+    });
+}
+
+- (void)removeStream:(NSString *)streamID {
+    dispatch_async(self.queue, ^{
+        ZGLoudnessStream *stream = self.streams[streamID];
+        [self.streams removeObjectForKey:streamID];
+        // Leave the stream at the user's volume, the attenuation was ours
+        if (stream && stream.appliedGainDB != 0) {
+            [self.controlBatcher setVolume:stream.userVolume streamID:streamID];
+        }
+    });
+}
+
+- (void)setUserVolume:(int)volume streamID:(NSString *)streamID {
+    dispatch_async(self.queue, ^{
+        ZGLoudnessStream *stream = self.streams[streamID];
+        if (!stream) {
+            return;
+        }
+        stream.userVolume = MAX(0, MIN(100, volume));
+        // The user expects to hear the change now
+        [self applyGainOfStream:stream streamID:streamID force:YES];
+    });
+}
+
+- (double)gainOfStream:(NSString *)streamID {
+    __block double gain = 0;
+    dispatch_sync(self.queue, ^{
+        gain = self.streams[streamID].appliedGainDB;
+    });
+    return gain;
+}
+
+#pragma mark - Levels
+
+- (void)updateWithSoundLevels:(NSDictionary<NSString *, NSNumber *> *)soundLevels {
+    // The SDK calls back on the main thread, leave it right away
+    NSDictionary<NSString *, NSNumber *> *levels = [soundLevels copy];
+    dispatch_async(self.queue, ^{
+        double now = ZGClockNow();
+        [levels enumerateKeysAndObjectsUsingBlock:^(NSString *streamID, NSNumber *level, BOOL *stop) {
+            ZGLoudnessStream *stream = self.streams[streamID];
+            if (!stream) {
+                return;
+            }
+            ZGLoudnessConfig *config = [self configForRoomID:stream.roomID];
+            double dt = stream.lastUpdateTime > 0 ? now - stream.lastUpdateTime : 0;
+            stream.lastUpdateTime = now;
+            // Silence says nothing about how loud someone talks
+            if (level.doubleValue < config.gateLevel) {
+                return;
+            }
+            // Already perceptual, so steps of it map linearly onto dB
+            double levelDB = (MIN(level.doubleValue, 100) / 100 - 1) * config.levelRangeDB;
+            if (isnan(stream.levelDB)) {
+                stream.levelDB = levelDB;
+            } else {
+                double alpha = 1 - exp(-dt / MAX(config.integrationTime, 0.01));
+                stream.levelDB += alpha * (levelDB - stream.levelDB);
+            }
+            [self applyGainOfStream:stream streamID:streamID force:NO];
+        }];
+    });
+}
+
+- (void)applyGainOfStream:(ZGLoudnessStream *)stream streamID:(NSString *)streamID force:(BOOL)force {
+    ZGLoudnessConfig *config = [self configForRoomID:stream.roomID];
+    double gainDB = 0;
+    if (config.enabled && !isnan(stream.levelDB)) {
+        gainDB = MAX(-config.maxAttenuationDB, MIN(0, config.targetLevelDB - stream.levelDB));
+    }
+    if (!force && fabs(gainDB - stream.appliedGainDB) < config.stepThresholdDB) {
+        return;
+    }
+    stream.appliedGainDB = gainDB;
+    int volume = (int)lround(stream.userVolume * pow(10, gainDB / 20));
+    [self.controlBatcher setVolume:volume streamID:streamID];
+}
+
+@end
@@ -0,0 +1,95 @@
+//
+//  ZGSubscriptionManager.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Cocoa/Cocoa.h>
+#import <ZegoExpressEngine/ZegoExpressEngine.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ZGEngineCommandProxy;
+@class ZGPlayControlBatcher;
+
+/// How much of a played stream is decoded
+typedef NS_ENUM(NSUInteger, ZGSubscriptionTier) {
+    /// Full resolution
+    ZGSubscriptionTierFull = 0,
+    /// The small base layer of a multi-layer stream
+    ZGSubscriptionTierBaseLayer = 1,
+    /// Video muted, only audio is received
+    ZGSubscriptionTierAudioOnly = 2
+};
+
+@interface ZGSubscriptionStatistics : NSObject
+
+@property (nonatomic, assign) NSUInteger streamCount;
+@property (nonatomic, assign) NSUInteger baseLayerCount;
+@property (nonatomic, assign) NSUInteger audioOnlyCount;
+/// Pixels decoded per second at the current tiers
+@property (nonatomic, assign) double decodedPixelsPerSecond;
+/// Pixels that would be decoded per second with every stream at full resolution
+@property (nonatomic, assign) double fullPixelsPerSecond;
+/// Tier changes made so far
+@property (nonatomic, assign) NSUInteger downgrades;
+@property (nonatomic, assign) NSUInteger upgrades;
+
+@end
+
+/// Decodes only what the user can actually see
+///
+/// Feed it the visibility of the window and of each video tile. A stream whose tile is hidden, or whose window
+/// is minimised or fully covered, drops to audio only (mutePlayStreamVideo) once it has stayed hidden for
+/// `downgradeDelay`; with `useVideoLayers`, a visible but small tile drops to the base layer. Anything that
+/// becomes visible again is restored on the spot. Video mutes go through the play control batcher, layer
+/// switches through the command proxy; the manager owns the video mute of the streams it manages.
+@interface ZGSubscriptionManager : NSObject
+
+- (instancetype)initWithCommandProxy:(ZGEngineCommandProxy *)commandProxy controlBatcher:(ZGPlayControlBatcher *)controlBatcher;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// How long a stream must stay hidden (or small) before it is downgraded, default 1.5 s
+@property (nonatomic, assign) NSTimeInterval downgradeDelay;
+
+/// Switch small tiles to the base layer, only for publishers using the multi-layer codec, default NO
+@property (nonatomic, assign) BOOL useVideoLayers;
+
+/// Tiles with fewer on-screen pixels than this play the base layer, default 320 x 180
+@property (nonatomic, assign) double baseLayerMaxTilePixels;
+
+/// Pixel share of the base layer against the full stream, default 0.25
+@property (nonatomic, assign) double baseLayerPixelRatio;
+
+#pragma mark Streams
+
+/// Manage a played stream, it is assumed to be playing at full resolution and visible
+///
+/// @param canvas The canvas it plays on, needed to restart it with another layer
+/// @param videoSize Resolution of the full stream, for the pixel accounting
+/// @param frameRate Frame rate of the stream, for the pixel accounting
+- (void)addStream:(NSString *)streamID canvas:(nullable ZegoCanvas *)canvas videoSize:(CGSize)videoSize frameRate:(double)frameRate;
+
+- (void)removeStream:(NSString *)streamID;
+
+#pragma mark Visibility
+
+/// Follow the occlusion and miniaturization of a window, main thread
+- (void)observeWindow:(NSWindow *)window;
+
+- (void)setWindowVisible:(BOOL)visible;
+
+/// @param visibleFraction Share of the tile that is on screen, 0.0 ~ 1.0
+/// @param tilePixels On-screen size of the tile in pixels
+- (void)setVisibleFraction:(double)visibleFraction tilePixels:(CGSize)tilePixels forStreamID:(NSString *)streamID;
+
+- (ZGSubscriptionTier)tierOfStream:(NSString *)streamID;
+
+- (ZGSubscriptionStatistics *)statistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
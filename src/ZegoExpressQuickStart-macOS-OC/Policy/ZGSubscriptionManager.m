@@ -0,0 +1,268 @@
+//
+//  ZGSubscriptionManager.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGSubscriptionManager.h"
+#import "ZGEngineCommandProxy.h"
+#import "ZGPlayControlBatcher.h"
+
+/// One managed stream
+@interface ZGSubscribedStream : NSObject
+
+@property (nonatomic, copy) NSString *streamID;
+@property (nonatomic, strong, nullable) ZegoCanvas *canvas;
+@property (nonatomic, assign) CGSize videoSize;
+@property (nonatomic, assign) double frameRate;
+@property (nonatomic, assign) double visibleFraction;
+/// On-screen tile size, the full video size until told otherwise
+@property (nonatomic, assign) CGSize tilePixels;
+@property (nonatomic, assign) ZGSubscriptionTier tier;
+/// Layer the stream currently plays, kept while audio only so unmuting needs no restart
+@property (nonatomic, assign) ZegoPlayerVideoLayer layer;
+/// Bumped whenever a scheduled downgrade becomes obsolete
+@property (nonatomic, assign) NSUInteger generation;
+@property (nonatomic, assign) BOOL downgradePending;
+
+@end
+
+@implementation ZGSubscribedStream
+
+@end
+
+@implementation ZGSubscriptionStatistics
+
+@end
+
+@interface ZGSubscriptionManager ()
+
+@property (nonatomic, strong) ZGEngineCommandProxy *commandProxy;
+@property (nonatomic, strong) ZGPlayControlBatcher *controlBatcher;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) NSMutableArray<id> *windowObservers;
+
+// Only touched on `queue`
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZGSubscribedStream *> *streams;
+@property (nonatomic, assign) BOOL windowVisible;
+@property (nonatomic, assign) NSUInteger downgrades;
+@property (nonatomic, assign) NSUInteger upgrades;
+
+@end
+
+@implementation ZGSubscriptionManager
+
+- (instancetype)initWithCommandProxy:(ZGEngineCommandProxy *)commandProxy controlBatcher:(ZGPlayControlBatcher *)controlBatcher {
+    self = [super init];
+    if (self) {
+        _commandProxy = commandProxy;
+        _controlBatcher = controlBatcher;
+        _downgradeDelay = 1.5;
+        _baseLayerMaxTilePixels = 320 * 180;
+        _baseLayerPixelRatio = 0.25;
+        _queue = dispatch_queue_create("im.zego.subscription", DISPATCH_QUEUE_SERIAL);
+        _windowObservers = [NSMutableArray array];
+        _streams = [NSMutableDictionary dictionary];
+        _windowVisible = YES;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    for (id observer in _windowObservers) {
+        [[NSNotificationCenter defaultCenter] removeObserver:observer];
+    }
+}
+
+#pragma mark - Streams
+
+- (void)addStream:(NSString *)streamID canvas:(ZegoCanvas *)canvas videoSize:(CGSize)videoSize frameRate:(double)frameRate {
+    dispatch_async(self.queue, ^{
+        ZGSubscribedStream *stream = [[ZGSubscribedStream alloc] init];
+        stream.streamID = streamID;
+        stream.canvas = canvas;
+        stream.videoSize = videoSize;
+        stream.frameRate = frameRate;
+        stream.visibleFraction = 1;
+        stream.tilePixels = videoSize;
+        stream.tier = ZGSubscriptionTierFull;
+        stream.layer = ZegoPlayerVideoLayerAuto;
+        self.streams[streamID] = stream;
+        [self evaluateStream:stream];
+    });
+}
+
+- (void)removeStream:(NSString *)streamID {
+    dispatch_async(self.queue, ^{
+        ZGSubscribedStream *stream = self.streams[streamID];
+        // Invalidates a pending downgrade
+        stream.generation += 1;
+        [self.streams removeObjectForKey:streamID];
+        // Leave the stream as we found it, other intents on it (e.g. a normalised volume) are not ours to drop
+        if (stream.tier == ZGSubscriptionTierAudioOnly) {
+            [self.controlBatcher setVideoMuted:NO streamID:streamID];
+        }
+    });
+}
+
+#pragma mark - Visibility
+
+- (void)observeWindow:(NSWindow *)window {
+    __weak typeof(self) weakSelf = self;
+    __weak NSWindow *weakWindow = window;
+    void (^update)(NSNotification *) = ^(NSNotification *notification) {
+        NSWindow *window = weakWindow;
+        BOOL visible = window && (window.occlusionState & NSWindowOcclusionStateVisible) && !window.isMiniaturized;
+        [weakSelf setWindowVisible:visible];
+    };
+    NSNotificationCenter *center = [NSNotificationCenter defaultCenter];
+    for (NSNotificationName name in @[NSWindowDidChangeOcclusionStateNotification, NSWindowDidMiniaturizeNotification, NSWindowDidDeminiaturizeNotification]) {
+        [self.windowObservers addObject:[center addObserverForName:name object:window queue:[NSOperationQueue mainQueue] usingBlock:update]];
+    }
+    update(nil);
+}
+
+- (void)setWindowVisible:(BOOL)visible {
+    dispatch_async(self.queue, ^{
+        if (self.windowVisible == visible) {
+            return;
+        }
+        self.windowVisible = visible;
+        for (ZGSubscribedStream *stream in self.streams.allValues) {
+            [self evaluateStream:stream];
+        }
+    });
+}
+
+- (void)setVisibleFraction:(double)visibleFraction tilePixels:(CGSize)tilePixels forStreamID:(NSString *)streamID {
+    dispatch_async(self.queue, ^{
+        ZGSubscribedStream *stream = self.streams[streamID];
+        if (!stream) {
+            return;
+        }
+        stream.visibleFraction = MAX(0, MIN(1, visibleFraction));
+        stream.tilePixels = tilePixels;
+        [self evaluateStream:stream];
+    });
+}
+
+- (ZGSubscriptionTier)tierOfStream:(NSString *)streamID {
+    __block ZGSubscriptionTier tier = ZGSubscriptionTierFull;
+    dispatch_sync(self.queue, ^{
+        tier = self.streams[streamID].tier;
+    });
+    return tier;
+}
+
+#pragma mark - Policy
+
+- (ZGSubscriptionTier)targetTierOfStream:(ZGSubscribedStream *)stream {
+    if (!self.windowVisible || stream.visibleFraction <= 0) {
+        return ZGSubscriptionTierAudioOnly;
+    }
+    double onScreenPixels = stream.tilePixels.width * stream.tilePixels.height * stream.visibleFraction;
+    if (self.useVideoLayers && onScreenPixels < self.baseLayerMaxTilePixels) {
+        return ZGSubscriptionTierBaseLayer;
+    }
+    return ZGSubscriptionTierFull;
+}
+
+- (void)evaluateStream:(ZGSubscribedStream *)stream {
+    ZGSubscriptionTier target = [self targetTierOfStream:stream];
+    if (target == stream.tier) {
+        if (stream.downgradePending) {
+            stream.generation += 1;
+            stream.downgradePending = NO;
+        }
+        return;
+    }
+
+    // Reveals are restored at once, the user is looking
+    if (target < stream.tier) {
+        stream.generation += 1;
+        stream.downgradePending = NO;
+        [self applyTier:target toStream:stream];
+        self.upgrades += 1;
+        return;
+    }
+
+    // Downgrades wait, so scrolling past or briefly covering a tile does not cost a restart
+    if (stream.downgradePending) {
+        return;
+    }
+    stream.downgradePending = YES;
+    NSUInteger generation = ++stream.generation;
+    __weak typeof(self) weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.downgradeDelay * NSEC_PER_SEC)), self.queue, ^{
+        [weakSelf completeDowngradeOfStream:stream generation:generation];
+    });
+}
+
+- (void)completeDowngradeOfStream:(ZGSubscribedStream *)stream generation:(NSUInteger)generation {
+    if (stream.generation != generation) {
+        return;
+    }
+    stream.downgradePending = NO;
+    ZGSubscriptionTier target = [self targetTierOfStream:stream];
+    if (target > stream.tier) {
+        [self applyTier:target toStream:stream];
+        self.downgrades += 1;
+    }
+}
+
+- (void)applyTier:(ZGSubscriptionTier)tier toStream:(ZGSubscribedStream *)stream {
+    ZGSubscriptionTier from = stream.tier;
+    stream.tier = tier;
+    if (tier == ZGSubscriptionTierAudioOnly) {
+        [self.controlBatcher setVideoMuted:YES streamID:stream.streamID];
+        return;
+    }
+    if (from == ZGSubscriptionTierAudioOnly) {
+        [self.controlBatcher setVideoMuted:NO streamID:stream.streamID];
+    }
+    if (!self.useVideoLayers) {
+        return;
+    }
+    ZegoPlayerVideoLayer layer = tier == ZGSubscriptionTierBaseLayer ? ZegoPlayerVideoLayerBase : ZegoPlayerVideoLayerAuto;
+    if (layer != stream.layer) {
+        ZegoPlayerConfig *config = [[ZegoPlayerConfig alloc] init];
+        config.videoLayer = layer;
+        // Not a plain start: the proxy may have lost track of the stream and would then start it without the stop
+        [self.commandProxy restartPlayingStream:stream.streamID canvas:stream.canvas config:config];
+        // The restart resets the SDK's mute and volume of the stream, have the batcher apply them again
+        [self.controlBatcher invalidateStream:stream.streamID];
+        stream.layer = layer;
+    }
+}
+
+#pragma mark - Statistics
+
+- (ZGSubscriptionStatistics *)statistics {
+    ZGSubscriptionStatistics *statistics = [[ZGSubscriptionStatistics alloc] init];
+    dispatch_sync(self.queue, ^{
+        for (ZGSubscribedStream *stream in self.streams.allValues) {
+            double fullPixels = stream.videoSize.width * stream.videoSize.height * stream.frameRate;
+            statistics.fullPixelsPerSecond += fullPixels;
+            switch (stream.tier) {
+                case ZGSubscriptionTierFull:
+                    statistics.decodedPixelsPerSecond += fullPixels;
+                    break;
+                case ZGSubscriptionTierBaseLayer:
+                    statistics.decodedPixelsPerSecond += fullPixels * self.baseLayerPixelRatio;
+                    statistics.baseLayerCount += 1;
+                    break;
+                case ZGSubscriptionTierAudioOnly:
+                    statistics.audioOnlyCount += 1;
+                    break;
+            }
+        }
+        statistics.streamCount = self.streams.count;
+        statistics.downgrades = self.downgrades;
+        statistics.upgrades = self.upgrades;
+    });
+    return statistics;
+}
+
+@end
@@ -0,0 +1,90 @@
+//
+//  ZGWatchPartySync.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <ZegoExpressEngine/ZegoExpressEngine.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ZGEngineCommandProxy;
+@class ZGAsyncEngine;
+@class ZGSignalingScheduler;
+
+typedef NS_ENUM(NSUInteger, ZGWatchPartyRole) {
+    ZGWatchPartyRoleNone = 0,
+    /// Plays freely and announces its position
+    ZGWatchPartyRoleLeader = 1,
+    /// Follows the leader's position
+    ZGWatchPartyRoleFollower = 2
+};
+
+@interface ZGWatchPartyStatistics : NSObject
+
+/// Leader clock minus local clock, from the ping with the lowest round trip
+@property (nonatomic, assign) double clockOffsetMs;
+@property (nonatomic, assign) double roundTripMs;
+/// Filtered position difference to the leader, positive when ahead
+@property (nonatomic, assign) double driftMs;
+@property (nonatomic, assign) NSUInteger seeks;
+@property (nonatomic, assign) NSUInteger pauses;
+/// Drift measurements, i.e. progress callbacks received while following
+@property (nonatomic, assign) NSUInteger samples;
+
+@end
+
+/// Keeps a watch party on the same frame
+///
+/// Every participant plays the same file on a ZegoMediaPlayer. The leader announces its position with custom
+/// commands; followers estimate the leader's clock with ping / pong exchanges (NTP style, keeping the sample
+/// with the shortest round trip) and compare the leader's extrapolated position with their own on every
+/// mediaPlayer:playingProgress:. Only a median drift beyond `syncThresholdMs` is corrected, at most once per
+/// `correctionCooldown`: a follower that is slightly ahead pauses for the difference, one that is behind, or far
+/// ahead, seeks to the leader's position plus its measured seek latency. Leader pause and resume are followed.
+///
+/// Forward onIMRecvCustomCommand to `handleCustomCommand:fromUser:roomID:`, and the media player events to this
+/// object, either as the player's event handler or from your own.
+@interface ZGWatchPartySync : NSObject <ZegoMediaPlayerEventHandler>
+
+- (instancetype)initWithCommandProxy:(ZGEngineCommandProxy *)commandProxy asyncEngine:(ZGAsyncEngine *)asyncEngine signalingScheduler:(ZGSignalingScheduler *)signalingScheduler mediaPlayer:(ZegoMediaPlayer *)mediaPlayer roomID:(NSString *)roomID;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Drift that is left alone, default 40 ms
+@property (nonatomic, assign) double syncThresholdMs;
+
+/// Followers ahead by less than this pause instead of seeking back, default 1500 ms
+@property (nonatomic, assign) double maxPauseMs;
+
+/// Shortest time between two corrections, default 2 s
+@property (nonatomic, assign) NSTimeInterval correctionCooldown;
+
+/// How often the leader announces its position, default 1 s
+@property (nonatomic, assign) NSTimeInterval positionInterval;
+
+/// How often followers ping the leader, default 2 s
+@property (nonatomic, assign) NSTimeInterval pingInterval;
+
+/// Progress callback period requested from the player, default 100 ms, takes effect on the next start
+@property (nonatomic, assign) unsigned long long progressIntervalMs;
+
+@property (nonatomic, assign, readonly) ZGWatchPartyRole role;
+
+- (void)startAsLeader;
+
+- (void)startFollowing:(ZegoUser *)leader;
+
+- (void)stop;
+
+/// @return YES when the command belonged to the sync and was consumed
+- (BOOL)handleCustomCommand:(NSString *)command fromUser:(ZegoUser *)fromUser roomID:(NSString *)roomID;
+
+- (ZGWatchPartyStatistics *)statistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,454 @@
+//
+//  ZGWatchPartySync.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGWatchPartySync.h"
+#import "ZGEngineCommandProxy.h"
+#import "ZGAsyncEngine.h"
+#import "ZGSignalingScheduler.h"
+#import "ZGClock.h"
+
+/// Custom commands starting with this belong to the sync
+static NSString * const ZGWatchPartyCommandPrefix = @"zgsync:";
+
+/// Clock samples the offset is picked from
+static const NSUInteger ZGWatchPartyClockSampleCount = 8;
+
+/// Drift samples the median is taken over
+static const NSUInteger ZGWatchPartyDriftSampleCount = 5;
+
+/// A seek whose callback got lost stops holding off corrections after this
+static const NSTimeInterval ZGWatchPartySeekTimeout = 3.0;
+
+@implementation ZGWatchPartyStatistics
+
+@end
+
+@interface ZGWatchPartySync ()
+
+@property (nonatomic, strong) ZGEngineCommandProxy *commandProxy;
+@property (nonatomic, strong) ZGAsyncEngine *asyncEngine;
+@property (nonatomic, strong) ZGSignalingScheduler *signalingScheduler;
+@property (nonatomic, strong) ZegoMediaPlayer *mediaPlayer;
+@property (nonatomic, copy) NSString *roomID;
+@property (nonatomic, strong) dispatch_queue_t queue;
+
+// Everything below is only touched on `queue`
+@property (nonatomic, assign, readwrite) ZGWatchPartyRole role;
+@property (nonatomic, strong, nullable) ZegoUser *leader;
+@property (nonatomic, strong, nullable) dispatch_source_t timer;
+/// Bumped on every start and stop, so corrections of an earlier session do not land in a later one
+@property (nonatomic, assign) NSUInteger session;
+
+/// Own playback, position at local time `localProgressAt`
+@property (nonatomic, assign) ZegoMediaPlayerState localState;
+@property (nonatomic, assign) double localPositionMs;
+@property (nonatomic, assign) double localProgressAt;
+
+/// Leader playback, position at leader time `leaderPositionAt`
+@property (nonatomic, assign) BOOL hasLeaderPosition;
+@property (nonatomic, assign) BOOL leaderPlaying;
+@property (nonatomic, assign) double leaderPositionMs;
+@property (nonatomic, assign) double leaderPositionAt;
+
+/// Pairs of @[offset, round trip] in ms
+@property (nonatomic, strong) NSMutableArray<NSArray<NSNumber *> *> *clockSamples;
+@property (nonatomic, strong) NSMutableArray<NSNumber *> *driftSamples;
+/// A pause or seek is in flight, drift is meaningless until it lands
+@property (nonatomic, assign) BOOL correcting;
+@property (nonatomic, assign) double lastCorrectionAt;
+/// Time from seekTo until the player reported done, smoothed
+@property (nonatomic, assign) double seekLatencyMs;
+@property (nonatomic, strong) ZGWatchPartyStatistics *counters;
+
+@end
+
+@implementation ZGWatchPartySync
+
+- (instancetype)initWithCommandProxy:(ZGEngineCommandProxy *)commandProxy asyncEngine:(ZGAsyncEngine *)asyncEngine signalingScheduler:(ZGSignalingScheduler *)signalingScheduler mediaPlayer:(ZegoMediaPlayer *)mediaPlayer roomID:(NSString *)roomID {
+    self = [super init];
+    if (self) {
+        _commandProxy = commandProxy;
+        _asyncEngine = asyncEngine;
+        _signalingScheduler = signalingScheduler;
+        _mediaPlayer = mediaPlayer;
+        _roomID = [roomID copy];
+        _syncThresholdMs = 40;
+        _maxPauseMs = 1500;
+        _correctionCooldown = 2;
+        _positionInterval = 1;
+        _pingInterval = 2;
+        _progressIntervalMs = 100;
+        _queue = dispatch_queue_create("im.zego.watchparty", DISPATCH_QUEUE_SERIAL);
+        _clockSamples = [NSMutableArray array];
+        _driftSamples = [NSMutableArray array];
+        _lastCorrectionAt = -INFINITY;
+        _seekLatencyMs = 80;
+        _counters = [[ZGWatchPartyStatistics alloc] init];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_timer) {
+        dispatch_source_cancel(_timer);
+    }
+}
+
+#pragma mark - Lifecycle
+
+- (void)startAsLeader {
+    dispatch_async(self.queue, ^{
+        [self resetWithRole:ZGWatchPartyRoleLeader leader:nil];
+        __weak typeof(self) weakSelf = self;
+        [self startTimerWithInterval:self.positionInterval handler:^{
+            [weakSelf sendPosition];
+        }];
+        [self sendPosition];
+    });
+}
+
+- (void)startFollowing:(ZegoUser *)leader {
+    dispatch_async(self.queue, ^{
+        [self resetWithRole:ZGWatchPartyRoleFollower leader:leader];
+        __weak typeof(self) weakSelf = self;
+        [self startTimerWithInterval:self.pingInterval handler:^{
+            [weakSelf sendPing];
+        }];
+        [self sendPing];
+    });
+}
+
+- (void)stop {
+    dispatch_async(self.queue, ^{
+        [self resetWithRole:ZGWatchPartyRoleNone leader:nil];
+    });
+}
+
+- (void)resetWithRole:(ZGWatchPartyRole)role leader:(nullable ZegoUser *)leader {
+    if (self.timer) {
+        dispatch_source_cancel(self.timer);
+        self.timer = nil;
+    }
+    self.session += 1;
+    self.role = role;
+    self.leader = leader;
+    self.hasLeaderPosition = NO;
+    self.correcting = NO;
+    self.lastCorrectionAt = -INFINITY;
+    [self.clockSamples removeAllObjects];
+    [self.driftSamples removeAllObjects];
+
+    if (role != ZGWatchPartyRoleNone) {
+        ZegoMediaPlayer *mediaPlayer = self.mediaPlayer;
+        unsigned long long progressInterval = self.progressIntervalMs;
+        [self.commandProxy submitCommand:@"watchPartyProgressInterval" block:^(id<ZGExpressEngine> _Nullable engine) {
+            [mediaPlayer setProgressInterval:progressInterval];
+        }];
+    }
+}
+
+- (void)startTimerWithInterval:(NSTimeInterval)interval handler:(dispatch_block_t)handler {
+    uint64_t nanoseconds = (uint64_t)(interval * NSEC_PER_SEC);
+    self.timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.queue);
+    dispatch_source_set_timer(self.timer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)nanoseconds), nanoseconds, nanoseconds / 10);
+    dispatch_source_set_event_handler(self.timer, handler);
+    dispatch_resume(self.timer);
+}
+
+- (ZGWatchPartyStatistics *)statistics {
+    ZGWatchPartyStatistics *snapshot = [[ZGWatchPartyStatistics alloc] init];
+    dispatch_sync(self.queue, ^{
+        snapshot.clockOffsetMs = self.counters.clockOffsetMs;
+        snapshot.roundTripMs = self.counters.roundTripMs;
+        snapshot.driftMs = self.counters.driftMs;
+        snapshot.seeks = self.counters.seeks;
+        snapshot.pauses = self.counters.pauses;
+        snapshot.samples = self.counters.samples;
+    });
+    return snapshot;
+}
+
+#pragma mark - Messages
+
+- (void)sendPosition {
+    if (self.role != ZGWatchPartyRoleLeader) {
+        return;
+    }
+    double now = ZGClockNowMs();
+    BOOL playing = self.localState == ZegoMediaPlayerStatePlaying;
+    NSDictionary *message = @{@"t": @"pos", @"p": @([self localPositionAt:now]), @"at": @(now), @"play": @(playing)};
+    // A position is only worth sending while it is fresh
+    [self sendMessage:message toUser:nil timeout:self.positionInterval];
+}
+
+- (void)sendPing {
+    if (self.role != ZGWatchPartyRoleFollower || !self.leader) {
+        return;
+    }
+    // t0 is read when the message actually leaves, time spent in the signaling queue would skew the offset
+    [self sendMessageBlock:^NSDictionary *{
+        return @{@"t": @"ping", @"t0": @(ZGClockNowMs())};
+    } toUser:self.leader timeout:self.pingInterval];
+}
+
+- (void)sendMessage:(NSDictionary *)message toUser:(nullable ZegoUser *)user timeout:(NSTimeInterval)timeout {
+    [self sendMessageBlock:^NSDictionary *{
+        return message;
+    } toUser:user timeout:timeout];
+}
+
+- (void)sendMessageBlock:(NSDictionary * (^)(void))messageBlock toUser:(nullable ZegoUser *)user timeout:(NSTimeInterval)timeout {
+    ZGAsyncEngine *asyncEngine = self.asyncEngine;
+    NSString *roomID = self.roomID;
+    NSArray<ZegoUser *> *toUserList = user ? @[user] : nil;
+    [self.signalingScheduler submitClass:ZGSignalingClassCommand timeout:timeout operation:^ZGFuture *{
+        NSData *data = [NSJSONSerialization dataWithJSONObject:messageBlock() options:0 error:nil];
+        NSString *json = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+        NSString *command = [ZGWatchPartyCommandPrefix stringByAppendingString:json];
+        return [asyncEngine sendCustomCommand:command toUserList:toUserList roomID:roomID];
+    }];
+}
+
+- (BOOL)handleCustomCommand:(NSString *)command fromUser:(ZegoUser *)fromUser roomID:(NSString *)roomID {
+    if (![command hasPrefix:ZGWatchPartyCommandPrefix] || ![roomID isEqualToString:self.roomID]) {
+        return NO;
+    }
+    double receivedAt = ZGClockNowMs();
+    NSData *data = [[command substringFromIndex:ZGWatchPartyCommandPrefix.length] dataUsingEncoding:NSUTF8StringEncoding];
+    NSDictionary *message = [NSJSONSerialization JSONObjectWithData:data options:0 error:nil];
+    if (![message isKindOfClass:[NSDictionary class]]) {
+        return YES;
+    }
+    // Anyone in the room can send these, nothing in them is trusted
+    NSString *type = message[@"t"];
+    if (![type isKindOfClass:[NSString class]]) {
+        return YES;
+    }
+    dispatch_async(self.queue, ^{
+        if ([type isEqualToString:@"ping"]) {
+            [self handlePing:message fromUser:fromUser receivedAt:receivedAt];
+            return;
+        }
+        // Followers only listen to their leader
+        if (self.role != ZGWatchPartyRoleFollower || ![fromUser.userID isEqualToString:self.leader.userID]) {
+            return;
+        }
+        if ([type isEqualToString:@"pong"]) {
+            [self handlePong:message receivedAt:receivedAt];
+        } else if ([type isEqualToString:@"pos"]) {
+            NSNumber *position = [ZGWatchPartySync numberIn:message key:@"p"];
+            NSNumber *positionAt = [ZGWatchPartySync numberIn:message key:@"at"];
+            NSNumber *playing = [ZGWatchPartySync numberIn:message key:@"play"];
+            if (!position || !positionAt || !playing) {
+                return;
+            }
+            self.leaderPositionMs = position.doubleValue;
+            self.leaderPositionAt = positionAt.doubleValue;
+            self.leaderPlaying = playing.boolValue;
+            self.hasLeaderPosition = YES;
+            [self evaluateAt:ZGClockNowMs()];
+        }
+    });
+    return YES;
+}
+
+- (void)handlePing:(NSDictionary *)message fromUser:(ZegoUser *)fromUser receivedAt:(double)receivedAt {
+    if (self.role != ZGWatchPartyRoleLeader) {
+        return;
+    }
+    NSNumber *t0 = [ZGWatchPartySync numberIn:message key:@"t0"];
+    if (!t0) {
+        return;
+    }
+    [self sendMessageBlock:^NSDictionary *{
+        return @{@"t": @"pong", @"t0": t0, @"t1": @(receivedAt), @"t2": @(ZGClockNowMs())};
+    } toUser:fromUser timeout:0.5];
+}
+
+- (void)handlePong:(NSDictionary *)message receivedAt:(double)t3 {
+    NSNumber *sentAt = [ZGWatchPartySync numberIn:message key:@"t0"];
+    NSNumber *leaderReceivedAt = [ZGWatchPartySync numberIn:message key:@"t1"];
+    NSNumber *leaderSentAt = [ZGWatchPartySync numberIn:message key:@"t2"];
+    if (!sentAt || !leaderReceivedAt || !leaderSentAt) {
+        return;
+    }
+    double t0 = sentAt.doubleValue;
+    double t1 = leaderReceivedAt.doubleValue;
+    double t2 = leaderSentAt.doubleValue;
+    double offset = ((t1 - t0) + (t2 - t3)) / 2;
+    double roundTrip = (t3 - t0) - (t2 - t1);
+    [self.clockSamples addObject:@[@(offset), @(roundTrip)]];
+    if (self.clockSamples.count > ZGWatchPartyClockSampleCount) {
+        [self.clockSamples removeObjectAtIndex:0];
+    }
+    // The shortest round trip is the least distorted by queueing on either leg
+    NSArray<NSNumber *> *best = self.clockSamples.firstObject;
+    for (NSArray<NSNumber *> *sample in self.clockSamples) {
+        if (sample[1].doubleValue < best[1].doubleValue) {
+            best = sample;
+        }
+    }
+    self.counters.clockOffsetMs = best[0].doubleValue;
+    self.counters.roundTripMs = best[1].doubleValue;
+}
+
+#pragma mark - ZegoMediaPlayerEventHandler
+
+- (void)mediaPlayer:(ZegoMediaPlayer *)mediaPlayer stateUpdate:(ZegoMediaPlayerState)state errorCode:(int)errorCode {
+    if (mediaPlayer != self.mediaPlayer) {
+        return;
+    }
+    dispatch_async(self.queue, ^{
+        self.localState = state;
+        self.localProgressAt = ZGClockNowMs();
+        // Followers should not wait for the next tick to see a pause or resume
+        [self sendPosition];
+    });
+}
+
+- (void)mediaPlayer:(ZegoMediaPlayer *)mediaPlayer playingProgress:(unsigned long long)millisecond {
+    if (mediaPlayer != self.mediaPlayer) {
+        return;
+    }
+    double receivedAt = ZGClockNowMs();
+    dispatch_async(self.queue, ^{
+        self.localPositionMs = millisecond;
+        self.localProgressAt = receivedAt;
+        self.localState = ZegoMediaPlayerStatePlaying;
+        if (self.role == ZGWatchPartyRoleFollower) {
+            [self evaluateAt:receivedAt];
+        }
+    });
+}
+
+#pragma mark - Steering
+
+- (double)localPositionAt:(double)now {
+    if (self.localState != ZegoMediaPlayerStatePlaying) {
+        return self.localPositionMs;
+    }
+    return self.localPositionMs + (now - self.localProgressAt);
+}
+
+/// The leader's position at local time `now`
+- (double)leaderPositionAt:(double)now {
+    if (!self.leaderPlaying) {
+        return self.leaderPositionMs;
+    }
+    double leaderNow = now + self.counters.clockOffsetMs;
+    return self.leaderPositionMs + (leaderNow - self.leaderPositionAt);
+}
+
+- (void)evaluateAt:(double)now {
+    if (!self.hasLeaderPosition || self.clockSamples.count == 0 || self.correcting) {
+        return;
+    }
+    double expected = [self leaderPositionAt:now];
+    BOOL playing = self.localState == ZegoMediaPlayerStatePlaying;
+
+    if (!self.leaderPlaying && playing) {
+        [self pausePlayer];
+        [self seekTo:expected now:now];
+        return;
+    }
+    if (self.leaderPlaying && self.localState == ZegoMediaPlayerStatePausing) {
+        [self seekTo:expected + self.seekLatencyMs now:now];
+        [self resumePlayer];
+        return;
+    }
+    if (!playing) {
+        return;
+    }
+
+    [self.driftSamples addObject:@([self localPositionAt:now] - expected)];
+    if (self.driftSamples.count > ZGWatchPartyDriftSampleCount) {
+        [self.driftSamples removeObjectAtIndex:0];
+    }
+    self.counters.samples += 1;
+    // Progress callbacks jitter by a frame or two, a single sample is never trusted
+    if (self.driftSamples.count < 3) {
+        return;
+    }
+    NSArray<NSNumber *> *sorted = [self.driftSamples sortedArrayUsingSelector:@selector(compare:)];
+    double drift = sorted[sorted.count / 2].doubleValue;
+    self.counters.driftMs = drift;
+    if (fabs(drift) < self.syncThresholdMs || now - self.lastCorrectionAt < self.correctionCooldown * 1000) {
+        return;
+    }
+
+    if (drift > 0 && drift <= self.maxPauseMs) {
+        // Slightly ahead: waiting is invisible, seeking back would repeat frames
+        [self pausePlayer];
+        self.correcting = YES;
+        NSUInteger session = self.session;
+        __weak typeof(self) weakSelf = self;
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(drift * NSEC_PER_MSEC)), self.queue, ^{
+            // Stopped or switched roles meanwhile, the player is no longer ours to resume
+            if (weakSelf.session != session) {
+                return;
+            }
+            [weakSelf resumePlayer];
+            weakSelf.correcting = NO;
+        });
+    } else {
+        [self seekTo:expected + self.seekLatencyMs now:now];
+    }
+    self.lastCorrectionAt = now;
+    [self.driftSamples removeAllObjects];
+}
+
+- (void)seekTo:(double)positionMs now:(double)now {
+    self.correcting = YES;
+    self.counters.seeks += 1;
+    NSUInteger session = self.session;
+    __weak typeof(self) weakSelf = self;
+    ZGFuture *seeked = [[self.asyncEngine seekTo:(unsigned long long)MAX(positionMs, 0) mediaPlayer:self.mediaPlayer] withTimeout:ZGWatchPartySeekTimeout];
+    [seeked whenCompleteOnQueue:self.queue block:^(id value, NSError *error) {
+        typeof(self) strongSelf = weakSelf;
+        if (!strongSelf || strongSelf.session != session) {
+            return;
+        }
+        if (!error) {
+            strongSelf.seekLatencyMs += 0.25 * ((ZGClockNowMs() - now) - strongSelf.seekLatencyMs);
+        }
+        strongSelf.correcting = NO;
+        strongSelf.lastCorrectionAt = ZGClockNowMs();
+        [strongSelf.driftSamples removeAllObjects];
+    }];
+}
+
+- (void)pausePlayer {
+    self.counters.pauses += 1;
+    self.localState = ZegoMediaPlayerStatePausing;
+    ZegoMediaPlayer *mediaPlayer = self.mediaPlayer;
+    [self.commandProxy submitCommand:@"watchPartyPause" block:^(id<ZGExpressEngine> _Nullable engine) {
+        [mediaPlayer pause];
+    }];
+}
+
+- (void)resumePlayer {
+    self.localState = ZegoMediaPlayerStatePlaying;
+    self.localProgressAt = ZGClockNowMs();
+    ZegoMediaPlayer *mediaPlayer = self.mediaPlayer;
+    [self.commandProxy submitCommand:@"watchPartyResume" block:^(id<ZGExpressEngine> _Nullable engine) {
+        [mediaPlayer resume];
+    }];
+}
+
+#pragma mark - Helper Methods
+
+/// The number under `key`, nil when it is missing or of another type
++ (nullable NSNumber *)numberIn:(NSDictionary *)message key:(NSString *)key {
+    NSNumber *number = message[key];
+    if (![number isKindOfClass:[NSNumber class]] || !isfinite(number.doubleValue)) {
+        return nil;
+    }
+    return number;
+}
+
+@end
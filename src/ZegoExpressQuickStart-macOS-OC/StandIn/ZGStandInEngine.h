@@ -0,0 +1,59 @@
+//
+//  ZGStandInEngine.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ZGExpressEngine.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ZGStandInRoomService;
+@class ZGStandInNetworkProfile;
+
+/// A local stand-in for ZegoExpressEngine
+///
+/// Implements the ZGExpressEngine control surface against an in-process ZGStandInRoomService instead of the
+/// Zego servers. Unlike the real SDK, any number of instances can live in one process, which is what lets a
+/// single load-test process act as many users. Callbacks follow the real SDK's order and threading (main queue by default).
+@interface ZGStandInEngine : NSObject <ZGExpressEngine>
+
+/// Create a stand-in engine attached to a room service
+///
+/// @param roomService The local room service that connects all stand-in engines of this process
+/// @param eventHandler Event handler, held weakly like the real SDK
+- (instancetype)initWithRoomService:(ZGStandInRoomService *)roomService eventHandler:(nullable id<ZegoEventHandler>)eventHandler;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// The room service this engine talks to
+@property (nonatomic, strong, readonly) ZGStandInRoomService *roomService;
+
+/// Unique identifier of this engine inside the room service
+@property (nonatomic, copy, readonly) NSString *engineID;
+
+/// Queue on which every callback is delivered, defaults to the main queue
+@property (nonatomic, strong) dispatch_queue_t callbackQueue;
+
+/// Scripted network this engine sits behind, nil (default) for an ideal network
+///
+/// Setting a profile restarts it from its first step.
+@property (nonatomic, strong, nullable) ZGStandInNetworkProfile *networkProfile;
+
+#pragma mark Room service delivery
+
+/// Deliver an event handler callback on the callback queue, used by the room service
+- (void)deliverEvent:(void (^)(id<ZegoEventHandler> handler))event afterDelay:(NSTimeInterval)delay;
+
+/// Run an API completion block on the callback queue, used by the room service
+- (void)deliverBlock:(dispatch_block_t)block afterDelay:(NSTimeInterval)delay;
+
+/// Hand a remote video frame to the custom video render handler, used by the room service
+- (void)deliverRemoteVideoFrame:(CVPixelBufferRef)buffer streamID:(NSString *)streamID afterDelay:(NSTimeInterval)delay;
+
+@end
+
+NS_ASSUME_NONNULL_END
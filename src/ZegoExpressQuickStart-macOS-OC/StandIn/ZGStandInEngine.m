@@ -0,0 +1,215 @@
+//
+//  ZGStandInEngine.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGStandInEngine.h"
+#import "ZGStandInRoomService.h"
+
+@interface ZGStandInEngine ()
+
+@property (nonatomic, weak) id<ZegoEventHandler> eventHandler;
+@property (nonatomic, weak) id<ZegoCustomVideoRenderHandler> customVideoRenderHandler;
+
+@end
+
+@implementation ZGStandInEngine
+
+- (instancetype)initWithRoomService:(ZGStandInRoomService *)roomService eventHandler:(id<ZegoEventHandler>)eventHandler {
+    self = [super init];
+    if (self) {
+        _roomService = roomService;
+        _eventHandler = eventHandler;
+        _engineID = [[NSUUID UUID] UUIDString];
+        _callbackQueue = dispatch_get_main_queue();
+    }
+    return self;
+}
+
+- (void)dealloc {
+    // Same as destroying the real engine: leave the room and drop every stream
+    [_roomService engineDidDestroy:_engineID];
+}
+
+#pragma mark - Handler
+
+- (void)setEventHandler:(id<ZegoEventHandler>)eventHandler {
+    _eventHandler = eventHandler;
+}
+
+- (void)setCustomVideoRenderHandler:(id<ZegoCustomVideoRenderHandler>)handler {
+    _customVideoRenderHandler = handler;
+}
+
+#pragma mark - Room
+
+- (void)loginRoom:(NSString *)roomID user:(ZegoUser *)user {
+    [self loginRoom:roomID user:user config:[ZegoRoomConfig defaultConfig]];
+}
+
+- (void)loginRoom:(NSString *)roomID user:(ZegoUser *)user config:(ZegoRoomConfig *)config {
+    [self.roomService engine:self loginRoom:roomID user:user config:config];
+}
+
+- (void)logoutRoom:(NSString *)roomID {
+    [self.roomService engine:self logoutRoom:roomID];
+}
+
+#pragma mark - Publisher
+
+- (void)startPreview:(ZegoCanvas *)canvas {
+    // Nothing is captured locally, frames come from sendCustomVideoCapturePixelBuffer
+}
+
+- (void)stopPreview {
+}
+
+- (void)startPublishing:(NSString *)streamID {
+    [self startPublishing:streamID channel:ZegoPublishChannelMain];
+}
+
+- (void)startPublishing:(NSString *)streamID channel:(ZegoPublishChannel)channel {
+    [self.roomService engine:self startPublishing:streamID channel:channel];
+}
+
+- (void)stopPublishing {
+    [self stopPublishing:ZegoPublishChannelMain];
+}
+
+- (void)stopPublishing:(ZegoPublishChannel)channel {
+    [self.roomService engine:self stopPublishing:channel];
+}
+
+- (void)setStreamExtraInfo:(NSString *)extraInfo callback:(ZegoPublisherSetStreamExtraInfoCallback)callback {
+    [self.roomService engine:self setStreamExtraInfo:extraInfo channel:ZegoPublishChannelMain callback:callback];
+}
+
+- (void)addPublishCDNURL:(NSString *)targetURL streamID:(NSString *)streamID callback:(ZegoPublisherUpdateCDNURLCallback)callback {
+    [self.roomService engine:self updatePublishCDNURL:targetURL streamID:streamID callback:callback];
+}
+
+- (void)removePublishCDNURL:(NSString *)targetURL streamID:(NSString *)streamID callback:(ZegoPublisherUpdateCDNURLCallback)callback {
+    [self.roomService engine:self updatePublishCDNURL:targetURL streamID:streamID callback:callback];
+}
+
+- (void)mutePublishStreamAudio:(BOOL)mute {
+    [self.roomService engine:self mutePublishStreamAudio:mute];
+}
+
+- (void)mutePublishStreamVideo:(BOOL)mute {
+    [self.roomService engine:self mutePublishStreamVideo:mute];
+}
+
+- (void)sendCustomVideoCapturePixelBuffer:(CVPixelBufferRef)buffer timeStamp:(CMTime)timeStamp {
+    [self sendCustomVideoCapturePixelBuffer:buffer timeStamp:timeStamp channel:ZegoPublishChannelMain];
+}
+
+- (void)sendCustomVideoCapturePixelBuffer:(CVPixelBufferRef)buffer timeStamp:(CMTime)timeStamp channel:(ZegoPublishChannel)channel {
+    [self.roomService engine:self sendVideoFrame:buffer timeStamp:timeStamp channel:channel];
+}
+
+#pragma mark - Player
+
+- (void)startPlayingStream:(NSString *)streamID canvas:(ZegoCanvas *)canvas {
+    [self startPlayingStream:streamID canvas:canvas config:[[ZegoPlayerConfig alloc] init]];
+}
+
+- (void)startPlayingStream:(NSString *)streamID canvas:(ZegoCanvas *)canvas config:(ZegoPlayerConfig *)config {
+    [self.roomService engine:self startPlayingStream:streamID config:config];
+}
+
+- (void)stopPlayingStream:(NSString *)streamID {
+    [self.roomService engine:self stopPlayingStream:streamID];
+}
+
+- (void)setPlayVolume:(int)volume streamID:(NSString *)streamID {
+    [self.roomService engine:self setPlayVolume:volume streamID:streamID];
+}
+
+- (void)mutePlayStreamAudio:(BOOL)mute streamID:(NSString *)streamID {
+    [self.roomService engine:self mutePlayStreamAudio:mute streamID:streamID];
+}
+
+- (void)mutePlayStreamVideo:(BOOL)mute streamID:(NSString *)streamID {
+    [self.roomService engine:self mutePlayStreamVideo:mute streamID:streamID];
+}
+
+#pragma mark - IM
+
+- (void)sendBroadcastMessage:(NSString *)message roomID:(NSString *)roomID callback:(ZegoIMSendBroadcastMessageCallback)callback {
+    [self.roomService engine:self sendBroadcastMessage:message roomID:roomID callback:callback];
+}
+
+- (void)sendBarrageMessage:(NSString *)message roomID:(NSString *)roomID callback:(ZegoIMSendBarrageMessageCallback)callback {
+    [self.roomService engine:self sendBarrageMessage:message roomID:roomID callback:callback];
+}
+
+- (void)sendCustomCommand:(NSString *)command toUserList:(NSArray<ZegoUser *> *)toUserList roomID:(NSString *)roomID callback:(ZegoIMSendCustomCommandCallback)callback {
+    [self.roomService engine:self sendCustomCommand:command toUserList:toUserList roomID:roomID callback:callback];
+}
+
+#pragma mark - Mixer
+
+- (void)startMixerTask:(ZegoMixerTask *)task callback:(ZegoMixerStartCallback)callback {
+    [self.roomService engine:self startMixerTask:task callback:callback];
+}
+
+- (void)stopMixerTask:(ZegoMixerTask *)task callback:(ZegoMixerStopCallback)callback {
+    [self.roomService engine:self stopMixerTask:task callback:callback];
+}
+
+#pragma mark - Device
+
+- (void)startSoundLevelMonitor {
+}
+
+- (void)stopSoundLevelMonitor {
+}
+
+#pragma mark - Network impairment
+
+- (void)setNetworkProfile:(ZGStandInNetworkProfile *)networkProfile {
+    _networkProfile = networkProfile;
+    [self.roomService engine:self setNetworkProfile:networkProfile];
+}
+
+#pragma mark - Room service delivery
+
+- (void)deliverEvent:(void (^)(id<ZegoEventHandler>))event afterDelay:(NSTimeInterval)delay {
+    __weak typeof(self) weakSelf = self;
+    [self deliverBlock:^{
+        id<ZegoEventHandler> handler = weakSelf.eventHandler;
+        if (handler) {
+            event(handler);
+        }
+    } afterDelay:delay];
+}
+
+- (void)deliverBlock:(dispatch_block_t)block afterDelay:(NSTimeInterval)delay {
+    if (delay <= 0) {
+        dispatch_async(self.callbackQueue, block);
+    } else {
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.callbackQueue, block);
+    }
+}
+
+- (void)deliverRemoteVideoFrame:(CVPixelBufferRef)buffer streamID:(NSString *)streamID afterDelay:(NSTimeInterval)delay {
+    // Blocks do not retain CF objects, keep the frame alive until it is rendered
+    CVPixelBufferRetain(buffer);
+    __weak typeof(self) weakSelf = self;
+    [self deliverBlock:^{
+        id<ZegoCustomVideoRenderHandler> handler = weakSelf.customVideoRenderHandler;
+        if ([handler respondsToSelector:@selector(onRemoteVideoFrameCVPixelBuffer:param:streamID:)]) {
+            ZegoVideoFrameParam *param = [[ZegoVideoFrameParam alloc] init];
+            param.format = CVPixelBufferGetPixelFormatType(buffer) == kCVPixelFormatType_32BGRA ? ZegoVideoFrameFormatBGRA32 : ZegoVideoFrameFormatNV12;
+            param.size = CGSizeMake(CVPixelBufferGetWidth(buffer), CVPixelBufferGetHeight(buffer));
+            [handler onRemoteVideoFrameCVPixelBuffer:buffer param:param streamID:streamID];
+        }
+        CVPixelBufferRelease(buffer);
+    } afterDelay:delay];
+}
+
+@end
@@ -0,0 +1,82 @@
+//
+//  ZGStandInImpairmentModel.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <ZegoExpressEngine/ZegoExpressEngine.h>
+#import "ZGStandInNetworkProfile.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// What a link did with the frames offered to it since the statistics were last taken
+typedef struct ZGImpairmentStatistics {
+    NSUInteger offeredFrames;
+    NSUInteger deliveredFrames;
+    /// Sum of the one-way delays of the delivered frames
+    double delaySumMs;
+} ZGImpairmentStatistics;
+
+/// One direction of a link impaired according to a ZGStandInNetworkProfile
+///
+/// The link is a drop-tail bottleneck: frames queue behind each other at the profile's bandwidth, which
+/// inflates delay as the link saturates and drops frames once the queue is full. Surviving frames are
+/// then lost at random with the profile's loss rate and get a normally distributed jitter. All sampling
+/// uses a generator seeded from the profile, so the same frame sequence always meets the same fate.
+///
+/// Times are seconds since the profile started and must not go backwards. Not thread safe.
+@interface ZGStandInImpairmentModel : NSObject
+
+/// @param profile The conditions over time
+/// @param salt Mixed into the profile seed, so links sharing a profile still drop different frames
+- (instancetype)initWithProfile:(ZGStandInNetworkProfile *)profile salt:(uint64_t)salt;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, strong, readonly) ZGStandInNetworkProfile *profile;
+
+/// Send a frame over the link
+///
+/// @param bits Size of the frame
+/// @param time When the frame enters the link
+/// @param delayMs Set to the one-way delay of the frame when it is delivered
+/// @return Whether the frame reaches the other end
+- (BOOL)transmitFrameOfBits:(double)bits atTime:(NSTimeInterval)time delayMs:(double *)delayMs;
+
+/// Return the statistics since the last call and start a new interval
+- (ZGImpairmentStatistics)takeStatistics;
+
+/// Fraction of the offered frames that did not arrive
+- (double)lossRateOfStatistics:(ZGImpairmentStatistics)statistics;
+
+/// Mean one-way delay of the delivered frames, the profile's base delay at `time` when none arrived
+- (double)meanDelayOfStatistics:(ZGImpairmentStatistics)statistics atTime:(NSTimeInterval)time;
+
+#pragma mark Quality
+
+/// Quality level the way the SDK grades rtt and packet loss
++ (ZegoStreamQualityLevel)qualityLevelWithRTT:(double)rtt lossRate:(double)lossRate;
+
+/// Publish quality of one reporting interval, shared by the room service and the offline sequences
++ (ZegoPublishStreamQuality *)publishQualityWithCaptureFPS:(double)captureFPS sendFPS:(double)sendFPS videoKBPS:(double)videoKBPS rtt:(double)rtt lossRate:(double)lossRate audioMuted:(BOOL)audioMuted;
+
+/// Play quality of one reporting interval, shared by the room service and the offline sequences
++ (ZegoPlayStreamQuality *)playQualityWithRecvFPS:(double)recvFPS renderFPS:(double)renderFPS videoKBPS:(double)videoKBPS rtt:(double)rtt lossRate:(double)lossRate delay:(double)delay audioMuted:(BOOL)audioMuted;
+
+#pragma mark Offline sequences
+
+/// Quality callbacks a publisher behind this link would receive, without running an engine
+///
+/// A constant-bitrate stream of `videoKBPS` at `videoFPS` is pushed through the link on simulated time, so the
+/// result only depends on the profile and its seed. Use a fresh model, the link state carries over between calls.
+- (NSArray<ZegoPublishStreamQuality *> *)publishQualitiesWithDuration:(NSTimeInterval)duration interval:(NSTimeInterval)interval videoKBPS:(double)videoKBPS videoFPS:(double)videoFPS;
+
+/// Quality callbacks a player whose whole path is this link would receive, see publishQualities
+- (NSArray<ZegoPlayStreamQuality *> *)playQualitiesWithDuration:(NSTimeInterval)duration interval:(NSTimeInterval)interval videoKBPS:(double)videoKBPS videoFPS:(double)videoFPS;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,160 @@
+//
+//  ZGStandInImpairmentModel.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGStandInImpairmentModel.h"
+#import "ZGStandInRandom.h"
+
+/// The bottleneck holds this much traffic before it drops, like a typical access router buffer
+static const double ZGImpairmentMaxQueueSeconds = 0.4;
+
+@implementation ZGStandInImpairmentModel {
+    ZGStandInRandom _random;
+    double _backlogBits;
+    NSTimeInterval _lastTime;
+    ZGImpairmentStatistics _statistics;
+}
+
+- (instancetype)initWithProfile:(ZGStandInNetworkProfile *)profile salt:(uint64_t)salt {
+    self = [super init];
+    if (self) {
+        _profile = profile;
+        _random = ZGStandInRandomMake(profile.seed ^ (salt * 0x9E3779B97F4A7C15ULL));
+    }
+    return self;
+}
+
+- (BOOL)transmitFrameOfBits:(double)bits atTime:(NSTimeInterval)time delayMs:(double *)delayMs {
+    ZGNetworkConditions conditions = [self.profile conditionsAtTime:time];
+    _statistics.offeredFrames += 1;
+
+    // Drain the bottleneck queue since the last frame, then enqueue this one
+    double queueDelayMs = 0;
+    double elapsed = MAX(time - _lastTime, 0);
+    _lastTime = time;
+    if (conditions.bandwidthKBPS > 0) {
+        double bitsPerSecond = conditions.bandwidthKBPS * 1000;
+        _backlogBits = MAX(_backlogBits - elapsed * bitsPerSecond, 0);
+        if (_backlogBits + bits > bitsPerSecond * ZGImpairmentMaxQueueSeconds) {
+            return NO;
+        }
+        _backlogBits += bits;
+        queueDelayMs = _backlogBits / bitsPerSecond * 1000;
+    } else {
+        _backlogBits = 0;
+    }
+
+    if (ZGStandInRandomUniform(&_random) < conditions.lossRate) {
+        return NO;
+    }
+
+    double delay = queueDelayMs + MAX(ZGStandInRandomNormal(&_random, conditions.delayMs, conditions.jitterMs), 0);
+    _statistics.deliveredFrames += 1;
+    _statistics.delaySumMs += delay;
+    if (delayMs) {
+        *delayMs = delay;
+    }
+    return YES;
+}
+
+- (ZGImpairmentStatistics)takeStatistics {
+    ZGImpairmentStatistics statistics = _statistics;
+    _statistics = (ZGImpairmentStatistics){0, 0, 0};
+    return statistics;
+}
+
+#pragma mark - Quality
+
++ (ZegoStreamQualityLevel)qualityLevelWithRTT:(double)rtt lossRate:(double)lossRate {
+    // The worse of the two grades wins
+    ZegoStreamQualityLevel rttLevel = rtt < 100 ? ZegoStreamQualityLevelExcellent : rtt < 200 ? ZegoStreamQualityLevelGood : rtt < 400 ? ZegoStreamQualityLevelMedium : rtt < 1000 ? ZegoStreamQualityLevelBad : ZegoStreamQualityLevelDie;
+    ZegoStreamQualityLevel lossLevel = lossRate < 0.01 ? ZegoStreamQualityLevelExcellent : lossRate < 0.03 ? ZegoStreamQualityLevelGood : lossRate < 0.08 ? ZegoStreamQualityLevelMedium : lossRate < 0.2 ? ZegoStreamQualityLevelBad : ZegoStreamQualityLevelDie;
+    return MAX(rttLevel, lossLevel);
+}
+
++ (ZegoPublishStreamQuality *)publishQualityWithCaptureFPS:(double)captureFPS sendFPS:(double)sendFPS videoKBPS:(double)videoKBPS rtt:(double)rtt lossRate:(double)lossRate audioMuted:(BOOL)audioMuted {
+    ZegoPublishStreamQuality *quality = [[ZegoPublishStreamQuality alloc] init];
+    quality.videoCaptureFPS = captureFPS;
+    quality.videoEncodeFPS = captureFPS;
+    quality.videoSendFPS = sendFPS;
+    quality.videoKBPS = videoKBPS;
+    quality.audioCaptureFPS = audioMuted ? 0 : 50;
+    quality.audioSendFPS = quality.audioCaptureFPS;
+    quality.audioKBPS = audioMuted ? 0 : 48;
+    quality.rtt = (int)rtt;
+    quality.packetLostRate = lossRate;
+    quality.level = [self qualityLevelWithRTT:rtt lossRate:lossRate];
+    return quality;
+}
+
++ (ZegoPlayStreamQuality *)playQualityWithRecvFPS:(double)recvFPS renderFPS:(double)renderFPS videoKBPS:(double)videoKBPS rtt:(double)rtt lossRate:(double)lossRate delay:(double)delay audioMuted:(BOOL)audioMuted {
+    ZegoPlayStreamQuality *quality = [[ZegoPlayStreamQuality alloc] init];
+    quality.videoRecvFPS = recvFPS;
+    quality.videoDecodeFPS = renderFPS;
+    quality.videoRenderFPS = renderFPS;
+    quality.videoKBPS = videoKBPS;
+    quality.audioRecvFPS = 50;
+    quality.audioDecodeFPS = 50;
+    quality.audioRenderFPS = audioMuted ? 0 : 50;
+    quality.audioKBPS = 48;
+    quality.rtt = (int)rtt;
+    quality.packetLostRate = lossRate;
+    quality.delay = (int)delay;
+    quality.level = [self qualityLevelWithRTT:rtt lossRate:lossRate];
+    return quality;
+}
+
+#pragma mark - Offline sequences
+
+- (NSArray<ZegoPublishStreamQuality *> *)publishQualitiesWithDuration:(NSTimeInterval)duration interval:(NSTimeInterval)interval videoKBPS:(double)videoKBPS videoFPS:(double)videoFPS {
+    NSMutableArray<ZegoPublishStreamQuality *> *qualities = [NSMutableArray array];
+    [self simulateDuration:duration interval:interval videoKBPS:videoKBPS videoFPS:videoFPS report:^(ZGImpairmentStatistics statistics, NSTimeInterval time) {
+        double sendFPS = statistics.deliveredFrames / interval;
+        double meanDelay = [self meanDelayOfStatistics:statistics atTime:time];
+        [qualities addObject:[ZGStandInImpairmentModel publishQualityWithCaptureFPS:statistics.offeredFrames / interval sendFPS:sendFPS videoKBPS:videoKBPS * MIN(1.0, sendFPS / videoFPS) rtt:meanDelay * 2 lossRate:[self lossRateOfStatistics:statistics] audioMuted:NO]];
+    }];
+    return qualities;
+}
+
+- (NSArray<ZegoPlayStreamQuality *> *)playQualitiesWithDuration:(NSTimeInterval)duration interval:(NSTimeInterval)interval videoKBPS:(double)videoKBPS videoFPS:(double)videoFPS {
+    NSMutableArray<ZegoPlayStreamQuality *> *qualities = [NSMutableArray array];
+    [self simulateDuration:duration interval:interval videoKBPS:videoKBPS videoFPS:videoFPS report:^(ZGImpairmentStatistics statistics, NSTimeInterval time) {
+        double recvFPS = statistics.deliveredFrames / interval;
+        double meanDelay = [self meanDelayOfStatistics:statistics atTime:time];
+        [qualities addObject:[ZGStandInImpairmentModel playQualityWithRecvFPS:recvFPS renderFPS:recvFPS videoKBPS:videoKBPS * MIN(1.0, recvFPS / videoFPS) rtt:meanDelay * 2 lossRate:[self lossRateOfStatistics:statistics] delay:meanDelay audioMuted:NO]];
+    }];
+    return qualities;
+}
+
+/// Push a constant-bitrate frame sequence through the link on simulated time, reporting every interval
+- (void)simulateDuration:(NSTimeInterval)duration interval:(NSTimeInterval)interval videoKBPS:(double)videoKBPS videoFPS:(double)videoFPS report:(void (^)(ZGImpairmentStatistics statistics, NSTimeInterval time))report {
+    if (interval <= 0 || videoFPS <= 0) {
+        return;
+    }
+    double frameBits = videoKBPS * 1000 / videoFPS;
+    [self takeStatistics];
+    NSUInteger frame = 0;
+    for (NSTimeInterval reportTime = interval; reportTime <= duration + 1e-9; reportTime += interval) {
+        // Frame times come from the frame index, accumulating them would drift
+        while (frame / videoFPS < reportTime) {
+            [self transmitFrameOfBits:frameBits atTime:frame / videoFPS delayMs:NULL];
+            frame++;
+        }
+        report([self takeStatistics], reportTime);
+    }
+}
+
+- (double)lossRateOfStatistics:(ZGImpairmentStatistics)statistics {
+    return statistics.offeredFrames > 0 ? 1.0 - (double)statistics.deliveredFrames / statistics.offeredFrames : 0;
+}
+
+- (double)meanDelayOfStatistics:(ZGImpairmentStatistics)statistics atTime:(NSTimeInterval)time {
+    // Nothing got through, the base delay is the best guess of what a probe would see
+    return statistics.deliveredFrames > 0 ? statistics.delaySumMs / statistics.deliveredFrames : [self.profile conditionsAtTime:time].delayMs;
+}
+
+@end
@@ -0,0 +1,73 @@
+//
+//  ZGStandInNetworkProfile.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Conditions of one direction of a network link
+typedef struct ZGNetworkConditions {
+    /// Bottleneck capacity, 0 for unlimited
+    double bandwidthKBPS;
+    /// Random loss probability of a frame, 0 ~ 1
+    double lossRate;
+    /// Base one-way delay
+    double delayMs;
+    /// Standard deviation of the one-way delay
+    double jitterMs;
+} ZGNetworkConditions;
+
+/// A scripted network, the conditions of a link over time
+///
+/// Loaded from JSON, e.g.
+/// {
+///     "name": "congestion",
+///     "seed": 7,
+///     "loop": false,
+///     "duration": 90,
+///     "steps": [
+///         { "at": 0,  "bandwidthKBPS": 2000, "lossRate": 0,    "delayMs": 20,  "jitterMs": 2 },
+///         { "at": 30, "bandwidthKBPS": 300,  "lossRate": 0.05, "delayMs": 150, "jitterMs": 30, "ramp": true },
+///         { "at": 60, "bandwidthKBPS": 2000, "lossRate": 0,    "delayMs": 20,  "jitterMs": 2 }
+///     ]
+/// }
+///
+/// Each step starts at `at` seconds and holds until the next one. With `ramp` the step is reached linearly from
+/// the previous one instead of switching at once. Fields left out keep the value of the previous step. `duration`
+/// defaults to the start of the last step, a looping profile should set it past that.
+@interface ZGStandInNetworkProfile : NSObject
+
+@property (nonatomic, copy, readonly) NSString *name;
+
+/// Seed of the loss and jitter sampling, the same seed reproduces the same frame drops
+@property (nonatomic, assign, readonly) uint64_t seed;
+
+/// Whether the profile starts over after its last step
+@property (nonatomic, assign, readonly) BOOL loop;
+
+/// Length of the profile, the loop period when `loop` is set
+@property (nonatomic, assign, readonly) NSTimeInterval duration;
+
+/// The conditions `time` seconds after the profile started
+- (ZGNetworkConditions)conditionsAtTime:(NSTimeInterval)time;
+
+/// Load a profile file
+///
+/// @param path Path of the profile JSON file
+/// @param error Set when the file cannot be read or a step is invalid
++ (nullable instancetype)profileWithContentsOfFile:(NSString *)path error:(NSError **)error;
+
+/// Build a profile from an already parsed dictionary
++ (nullable instancetype)profileWithDictionary:(NSDictionary *)dictionary error:(NSError **)error;
+
+/// A profile that never changes
++ (instancetype)constantProfileWithConditions:(ZGNetworkConditions)conditions;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,162 @@
+//
+//  ZGStandInNetworkProfile.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGStandInNetworkProfile.h"
+
+static NSString * const ZGStandInNetworkProfileErrorDomain = @"im.zego.standin.network";
+
+/// One step of a profile
+@interface ZGStandInNetworkStep : NSObject
+
+@property (nonatomic, assign) NSTimeInterval at;
+@property (nonatomic, assign) ZGNetworkConditions conditions;
+@property (nonatomic, assign) BOOL ramp;
+
+@end
+
+@implementation ZGStandInNetworkStep
+
+@end
+
+@interface ZGStandInNetworkProfile ()
+
+@property (nonatomic, copy, readwrite) NSString *name;
+@property (nonatomic, assign, readwrite) uint64_t seed;
+@property (nonatomic, assign, readwrite) BOOL loop;
+@property (nonatomic, assign, readwrite) NSTimeInterval duration;
+@property (nonatomic, copy) NSArray<ZGStandInNetworkStep *> *steps;
+
+@end
+
+@implementation ZGStandInNetworkProfile
+
+- (ZGNetworkConditions)conditionsAtTime:(NSTimeInterval)time {
+    if (self.loop && self.duration > 0) {
+        time = fmod(MAX(time, 0), self.duration);
+    }
+    NSArray<ZGStandInNetworkStep *> *steps = self.steps;
+    NSUInteger index = 0;
+    while (index + 1 < steps.count && steps[index + 1].at <= time) {
+        index++;
+    }
+    ZGStandInNetworkStep *current = steps[index];
+    if (index + 1 >= steps.count || !steps[index + 1].ramp) {
+        return current.conditions;
+    }
+
+    // The next step ramps in, interpolate towards it
+    ZGStandInNetworkStep *next = steps[index + 1];
+    double progress = next.at > current.at ? (time - current.at) / (next.at - current.at) : 1;
+    progress = MIN(MAX(progress, 0), 1);
+    ZGNetworkConditions from = current.conditions;
+    ZGNetworkConditions to = next.conditions;
+    ZGNetworkConditions conditions;
+    // Unlimited bandwidth does not interpolate, the limited end is used across the ramp
+    if (from.bandwidthKBPS <= 0 || to.bandwidthKBPS <= 0) {
+        conditions.bandwidthKBPS = MAX(from.bandwidthKBPS, to.bandwidthKBPS);
+    } else {
+        conditions.bandwidthKBPS = from.bandwidthKBPS + (to.bandwidthKBPS - from.bandwidthKBPS) * progress;
+    }
+    conditions.lossRate = from.lossRate + (to.lossRate - from.lossRate) * progress;
+    conditions.delayMs = from.delayMs + (to.delayMs - from.delayMs) * progress;
+    conditions.jitterMs = from.jitterMs + (to.jitterMs - from.jitterMs) * progress;
+    return conditions;
+}
+
+#pragma mark - Loading
+
++ (instancetype)profileWithContentsOfFile:(NSString *)path error:(NSError **)error {
+    NSData *data = [NSData dataWithContentsOfFile:path options:0 error:error];
+    if (!data) {
+        return nil;
+    }
+    id object = [NSJSONSerialization JSONObjectWithData:data options:0 error:error];
+    if (!object) {
+        return nil;
+    }
+    if (![object isKindOfClass:[NSDictionary class]]) {
+        [self fillError:error message:@"The network profile must be a JSON object"];
+        return nil;
+    }
+    return [self profileWithDictionary:object error:error];
+}
+
++ (instancetype)profileWithDictionary:(NSDictionary *)dictionary error:(NSError **)error {
+    NSArray *stepList = [dictionary[@"steps"] isKindOfClass:[NSArray class]] ? dictionary[@"steps"] : nil;
+    if (stepList.count == 0) {
+        [self fillError:error message:@"A network profile needs at least one step"];
+        return nil;
+    }
+
+    NSMutableArray<ZGStandInNetworkStep *> *steps = [NSMutableArray arrayWithCapacity:stepList.count];
+    ZGNetworkConditions conditions = {0, 0, 0, 0};
+    NSTimeInterval previousAt = -1;
+    for (id item in stepList) {
+        if (![item isKindOfClass:[NSDictionary class]]) {
+            [self fillError:error message:@"Every network profile step must be a JSON object"];
+            return nil;
+        }
+        ZGStandInNetworkStep *step = [[ZGStandInNetworkStep alloc] init];
+        step.at = [[self numberIn:item key:@"at"] doubleValue];
+        step.ramp = [[self numberIn:item key:@"ramp"] boolValue];
+        if ([self numberIn:item key:@"bandwidthKBPS"]) conditions.bandwidthKBPS = [[self numberIn:item key:@"bandwidthKBPS"] doubleValue];
+        if ([self numberIn:item key:@"lossRate"]) conditions.lossRate = [[self numberIn:item key:@"lossRate"] doubleValue];
+        if ([self numberIn:item key:@"delayMs"]) conditions.delayMs = [[self numberIn:item key:@"delayMs"] doubleValue];
+        if ([self numberIn:item key:@"jitterMs"]) conditions.jitterMs = [[self numberIn:item key:@"jitterMs"] doubleValue];
+        step.conditions = conditions;
+
+        if (step.at < 0 || step.at <= previousAt) {
+            [self fillError:error message:@"Network profile steps must start at increasing, non-negative times"];
+            return nil;
+        }
+        if (conditions.bandwidthKBPS < 0 || conditions.lossRate < 0 || conditions.lossRate > 1 || conditions.delayMs < 0 || conditions.jitterMs < 0) {
+            [self fillError:error message:@"bandwidthKBPS, delayMs and jitterMs must not be negative, lossRate must be within 0 ~ 1"];
+            return nil;
+        }
+        previousAt = step.at;
+        [steps addObject:step];
+    }
+
+    ZGStandInNetworkProfile *profile = [[ZGStandInNetworkProfile alloc] init];
+    profile.name = [self stringIn:dictionary key:@"name"] ?: @"custom";
+    profile.seed = [self numberIn:dictionary key:@"seed"] ? [[self numberIn:dictionary key:@"seed"] unsignedLongLongValue] : 1;
+    profile.loop = [[self numberIn:dictionary key:@"loop"] boolValue];
+    profile.duration = [[self numberIn:dictionary key:@"duration"] doubleValue] ?: steps.lastObject.at;
+    profile.steps = steps;
+    return profile;
+}
+
++ (instancetype)constantProfileWithConditions:(ZGNetworkConditions)conditions {
+    ZGStandInNetworkStep *step = [[ZGStandInNetworkStep alloc] init];
+    step.conditions = conditions;
+    ZGStandInNetworkProfile *profile = [[ZGStandInNetworkProfile alloc] init];
+    profile.name = @"constant";
+    profile.seed = 1;
+    profile.steps = @[step];
+    return profile;
+}
+
+#pragma mark - Helper Methods
+
++ (NSString *)stringIn:(NSDictionary *)dictionary key:(NSString *)key {
+    id value = dictionary[key];
+    return [value isKindOfClass:[NSString class]] ? value : nil;
+}
+
++ (NSNumber *)numberIn:(NSDictionary *)dictionary key:(NSString *)key {
+    id value = dictionary[key];
+    return [value isKindOfClass:[NSNumber class]] ? value : nil;
+}
+
++ (void)fillError:(NSError **)error message:(NSString *)message {
+    if (error) {
+        *error = [NSError errorWithDomain:ZGStandInNetworkProfileErrorDomain code:-1 userInfo:@{NSLocalizedDescriptionKey: message}];
+    }
+}
+
+@end
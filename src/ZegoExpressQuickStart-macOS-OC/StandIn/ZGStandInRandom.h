@@ -0,0 +1,74 @@
+//
+//  ZGStandInRandom.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#ifndef ZGStandInRandom_h
+#define ZGStandInRandom_h
+
+#include <math.h>
+#include <stdint.h>
+
+/// Seeded pseudo random generator (splitmix64), so that simulated runs are reproducible
+typedef struct {
+    uint64_t state;
+} ZGStandInRandom;
+
+static inline ZGStandInRandom ZGStandInRandomMake(uint64_t seed) {
+    ZGStandInRandom random = { seed };
+    return random;
+}
+
+static inline uint64_t ZGStandInRandomNextUInt64(ZGStandInRandom *random) {
+    uint64_t z = (random->state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/// Uniform in [0, 1)
+static inline double ZGStandInRandomUniform(ZGStandInRandom *random) {
+    return (ZGStandInRandomNextUInt64(random) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/// Uniform integer in [0, bound)
+static inline uint64_t ZGStandInRandomBelow(ZGStandInRandom *random, uint64_t bound) {
+    return bound == 0 ? 0 : ZGStandInRandomNextUInt64(random) % bound;
+}
+
+/// Exponentially distributed with the given mean
+static inline double ZGStandInRandomExponential(ZGStandInRandom *random, double mean) {
+    return -mean * log(1.0 - ZGStandInRandomUniform(random));
+}
+
+/// Normally distributed (Box-Muller)
+static inline double ZGStandInRandomNormal(ZGStandInRandom *random, double mean, double deviation) {
+    double u1 = ZGStandInRandomUniform(random);
+    double u2 = ZGStandInRandomUniform(random);
+    return mean + deviation * sqrt(-2.0 * log(1.0 - u1)) * cos(2.0 * M_PI * u2);
+}
+
+/// Number of events of a Poisson process with the given expectation
+static inline uint64_t ZGStandInRandomPoisson(ZGStandInRandom *random, double lambda) {
+    if (lambda <= 0) {
+        return 0;
+    }
+    if (lambda > 30) {
+        // Normal approximation, exact sampling gets slow and the shape is close enough
+        double sample = round(ZGStandInRandomNormal(random, lambda, sqrt(lambda)));
+        return sample < 0 ? 0 : (uint64_t)sample;
+    }
+    double limit = exp(-lambda);
+    double product = ZGStandInRandomUniform(random);
+    uint64_t count = 0;
+    while (product > limit) {
+        count += 1;
+        product *= ZGStandInRandomUniform(random);
+    }
+    return count;
+}
+
+#endif /* ZGStandInRandom_h */
@@ -0,0 +1,124 @@
+//
+//  ZGStandInRoomService.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <ZegoExpressEngine/ZegoExpressEngine.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ZGStandInEngine;
+@class ZGStandInNetworkProfile;
+@class ZGStandInTokenService;
+
+/// Error codes reported by the stand-in, shaped like the SDK's common error codes
+typedef NS_ENUM(int, ZGStandInErrorCode) {
+    /// The operation requires a logged in room
+    ZGStandInErrorCodeNotLoggedIn = 1000002,
+    /// The engine is already logged in to a room
+    ZGStandInErrorCodeRepeatedLogin = 1002001,
+    /// The room token is missing, expired or was issued for another room or user
+    ZGStandInErrorCodeTokenInvalid = 1002003,
+    /// Another user with the same userID is in the room
+    ZGStandInErrorCodeUserExists = 1002002,
+    /// The stream ID is already published by someone else
+    ZGStandInErrorCodeStreamExists = 1003001,
+    /// The channel is already publishing a different stream
+    ZGStandInErrorCodePublishChannelBusy = 1003002
+};
+
+/// In-process stand-in for the Zego room, publish and play services
+///
+/// Every ZGStandInEngine of the process talks to one room service. The service keeps the room membership and
+/// the stream list, forwards custom-captured frames from publishers to players, and emits the room, publisher,
+/// player, quality and IM callbacks the real service would. All state lives on one private serial queue.
+@interface ZGStandInRoomService : NSObject
+
+/// Login latency range in milliseconds, default 80 ~ 250
+@property (nonatomic, assign) double loginLatencyMinMs;
+@property (nonatomic, assign) double loginLatencyMaxMs;
+
+/// Latency from startPublishing/startPlayingStream to the Publishing/Playing state, default 60 ms
+@property (nonatomic, assign) double publishLatencyMs;
+@property (nonatomic, assign) double playLatencyMs;
+
+/// One-way latency of signaling messages (IM, stream updates, extra info), default 30 ms
+@property (nonatomic, assign) double signalingLatencyMs;
+
+/// End-to-end latency of a video frame from publisher to player, default 120 ms
+@property (nonatomic, assign) double frameLatencyMs;
+
+/// Interval of the publisher/player quality callbacks in seconds, default 3 like the SDK
+@property (nonatomic, assign) NSTimeInterval qualityInterval;
+
+/// Nominal publish video bitrate and frame rate used to derive reported kbps, default 600 kbps at 15 fps
+@property (nonatomic, assign) double nominalVideoKBPS;
+@property (nonatomic, assign) double nominalVideoFPS;
+
+/// When set, logins must carry a token issued by this service, nil (default) accepts any login
+@property (nonatomic, strong, nullable) ZGStandInTokenService *tokenService;
+
+/// Number of rooms, users and streams currently known to the service
+- (NSUInteger)roomCount;
+- (NSUInteger)userCountInRoom:(NSString *)roomID;
+- (NSUInteger)streamCountInRoom:(NSString *)roomID;
+
+#pragma mark Engine requests
+
+- (void)engine:(ZGStandInEngine *)engine loginRoom:(NSString *)roomID user:(ZegoUser *)user config:(ZegoRoomConfig *)config;
+- (void)engine:(ZGStandInEngine *)engine logoutRoom:(NSString *)roomID;
+- (void)engineDidDestroy:(NSString *)engineID;
+
+- (void)engine:(ZGStandInEngine *)engine startPublishing:(NSString *)streamID channel:(ZegoPublishChannel)channel;
+- (void)engine:(ZGStandInEngine *)engine stopPublishing:(ZegoPublishChannel)channel;
+- (void)engine:(ZGStandInEngine *)engine setStreamExtraInfo:(NSString *)extraInfo channel:(ZegoPublishChannel)channel callback:(nullable ZegoPublisherSetStreamExtraInfoCallback)callback;
+- (void)engine:(ZGStandInEngine *)engine mutePublishStreamAudio:(BOOL)mute;
+- (void)engine:(ZGStandInEngine *)engine mutePublishStreamVideo:(BOOL)mute;
+- (void)engine:(ZGStandInEngine *)engine sendVideoFrame:(CVPixelBufferRef)buffer timeStamp:(CMTime)timeStamp channel:(ZegoPublishChannel)channel;
+
+- (void)engine:(ZGStandInEngine *)engine startPlayingStream:(NSString *)streamID config:(ZegoPlayerConfig *)config;
+- (void)engine:(ZGStandInEngine *)engine stopPlayingStream:(NSString *)streamID;
+- (void)engine:(ZGStandInEngine *)engine setPlayVolume:(int)volume streamID:(NSString *)streamID;
+- (void)engine:(ZGStandInEngine *)engine mutePlayStreamAudio:(BOOL)mute streamID:(NSString *)streamID;
+- (void)engine:(ZGStandInEngine *)engine mutePlayStreamVideo:(BOOL)mute streamID:(NSString *)streamID;
+
+- (void)engine:(ZGStandInEngine *)engine sendBroadcastMessage:(NSString *)message roomID:(NSString *)roomID callback:(nullable ZegoIMSendBroadcastMessageCallback)callback;
+- (void)engine:(ZGStandInEngine *)engine sendBarrageMessage:(NSString *)message roomID:(NSString *)roomID callback:(nullable ZegoIMSendBarrageMessageCallback)callback;
+- (void)engine:(ZGStandInEngine *)engine sendCustomCommand:(NSString *)command toUserList:(nullable NSArray<ZegoUser *> *)toUserList roomID:(NSString *)roomID callback:(nullable ZegoIMSendCustomCommandCallback)callback;
+
+- (void)engine:(ZGStandInEngine *)engine startMixerTask:(ZegoMixerTask *)task callback:(nullable ZegoMixerStartCallback)callback;
+- (void)engine:(ZGStandInEngine *)engine stopMixerTask:(ZegoMixerTask *)task callback:(nullable ZegoMixerStopCallback)callback;
+
+/// Adding and removing a CDN URL cost the same round trip
+- (void)engine:(ZGStandInEngine *)engine updatePublishCDNURL:(NSString *)targetURL streamID:(NSString *)streamID callback:(nullable ZegoPublisherUpdateCDNURLCallback)callback;
+
+#pragma mark Network impairment
+
+/// Put an engine behind a scripted network, nil for an ideal one
+///
+/// The profile drives both directions of the engine's link from the moment it is set: published frames cross
+/// the uplink, played frames the publisher's uplink and then this downlink. Frame drops, delays and the
+/// reported publish and play qualities follow from it.
+- (void)engine:(ZGStandInEngine *)engine setNetworkProfile:(nullable ZGStandInNetworkProfile *)profile;
+
+#pragma mark Synthetic traffic
+
+/// Members that exist only in the service, used by ZGStandInSignalingSimulator
+///
+/// Each call is delivered to the connected engines of the room as one callback, the way the server batches updates.
+- (void)addSyntheticUsers:(NSArray<ZegoUser *> *)users toRoom:(NSString *)roomID;
+- (void)removeSyntheticUsers:(NSArray<ZegoUser *> *)users fromRoom:(NSString *)roomID;
+- (void)addSyntheticStreams:(NSArray<ZegoStream *> *)streams toRoom:(NSString *)roomID;
+- (void)removeSyntheticStreams:(NSArray<NSString *> *)streamIDs fromRoom:(NSString *)roomID;
+- (void)updateSyntheticStreamExtraInfo:(NSDictionary<NSString *, NSString *> *)extraInfos inRoom:(NSString *)roomID;
+- (void)sendSyntheticBroadcastMessages:(NSArray<ZegoBroadcastMessageInfo *> *)messages toRoom:(NSString *)roomID;
+- (void)sendSyntheticBarrageMessages:(NSArray<ZegoBarrageMessageInfo *> *)messages toRoom:(NSString *)roomID;
+- (void)sendSyntheticCustomCommand:(NSString *)command fromUser:(ZegoUser *)fromUser toRoom:(NSString *)roomID;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,1110 @@
+//
+//  ZGStandInRoomService.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGStandInRoomService.h"
+#import "ZGStandInEngine.h"
+#import "ZGStandInImpairmentModel.h"
+#import "ZGStandInTokenService.h"
+#import "ZGClock.h"
+
+#pragma mark - Model
+
+/// A stream that is playing, or waiting for the stream to appear
+@interface ZGStandInPlay : NSObject
+
+@property (nonatomic, copy) NSString *streamID;
+@property (nonatomic, assign) BOOL playing;
+@property (nonatomic, assign) BOOL firstFrameDelivered;
+@property (nonatomic, assign) BOOL audioMuted;
+@property (nonatomic, assign) BOOL videoMuted;
+@property (nonatomic, assign) int volume;
+@property (nonatomic, assign) ZegoPlayerVideoLayer videoLayer;
+@property (nonatomic, assign) NSUInteger recvFramesSinceReport;
+@property (nonatomic, assign) NSUInteger renderFramesSinceReport;
+/// When the last frame is due at the player, later frames never overtake it
+@property (nonatomic, assign) double lastFrameDueTime;
+
+@end
+
+@implementation ZGStandInPlay
+
+@end
+
+/// A published stream in a room
+@interface ZGStandInStream : NSObject
+
+/// Handed to event handlers on other queues, so never mutated: an update replaces it
+@property (nonatomic, strong) ZegoStream *stream;
+/// nil for streams that do not belong to a stand-in engine
+@property (nonatomic, copy, nullable) NSString *publisherEngineID;
+@property (nonatomic, assign) ZegoPublishChannel channel;
+@property (nonatomic, strong) NSMutableSet<NSString *> *playerEngineIDs;
+@property (nonatomic, assign) NSUInteger framesSinceReport;
+/// Frames that made it through the publisher's uplink
+@property (nonatomic, assign) NSUInteger sentFramesSinceReport;
+
+@end
+
+@implementation ZGStandInStream
+
+@end
+
+/// The state of one stand-in engine in the service
+@interface ZGStandInSession : NSObject
+
+@property (nonatomic, weak) ZGStandInEngine *engine;
+@property (nonatomic, copy) NSString *engineID;
+@property (nonatomic, strong) ZegoUser *user;
+@property (nonatomic, copy) NSString *roomID;
+@property (nonatomic, assign) BOOL isUserStatusNotify;
+@property (nonatomic, assign) BOOL connected;
+@property (nonatomic, assign) BOOL audioMuted;
+@property (nonatomic, assign) BOOL videoMuted;
+/// Requested publish stream ID per channel, published once the room is connected
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSString *> *publishStreamIDs;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZGStandInPlay *> *plays;
+
+@end
+
+@implementation ZGStandInSession
+
+@end
+
+/// The impaired network link of one engine
+@interface ZGStandInLink : NSObject
+
+@property (nonatomic, strong) ZGStandInImpairmentModel *uplink;
+@property (nonatomic, strong) ZGStandInImpairmentModel *downlink;
+@property (nonatomic, assign) double startTime;
+/// Link figures of the last quality interval
+@property (nonatomic, assign) double uplinkLossRate;
+@property (nonatomic, assign) double uplinkDelayMs;
+@property (nonatomic, assign) double downlinkLossRate;
+@property (nonatomic, assign) double downlinkDelayMs;
+
+@end
+
+@implementation ZGStandInLink
+
+- (NSTimeInterval)profileTimeAt:(double)time {
+    return time - self.startTime;
+}
+
+- (void)takeStatisticsAt:(double)time {
+    NSTimeInterval profileTime = [self profileTimeAt:time];
+    ZGImpairmentStatistics uplink = [self.uplink takeStatistics];
+    ZGImpairmentStatistics downlink = [self.downlink takeStatistics];
+    self.uplinkLossRate = [self.uplink lossRateOfStatistics:uplink];
+    self.uplinkDelayMs = [self.uplink meanDelayOfStatistics:uplink atTime:profileTime];
+    self.downlinkLossRate = [self.downlink lossRateOfStatistics:downlink];
+    self.downlinkDelayMs = [self.downlink meanDelayOfStatistics:downlink atTime:profileTime];
+}
+
+@end
+
+/// A room and its members
+@interface ZGStandInRoom : NSObject
+
+@property (nonatomic, copy) NSString *roomID;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZegoUser *> *users;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZGStandInStream *> *streams;
+/// Connected stand-in engines in the room
+@property (nonatomic, strong) NSMutableSet<NSString *> *engineIDs;
+
+@end
+
+@implementation ZGStandInRoom
+
+@end
+
+#pragma mark - Service
+
+@interface ZGStandInRoomService ()
+
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) dispatch_source_t qualityTimer;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZGStandInRoom *> *rooms;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZGStandInSession *> *sessions;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZGStandInLink *> *links;
+@property (nonatomic, assign) uint64_t nextLinkSalt;
+@property (nonatomic, assign) unsigned long long nextMessageID;
+
+@end
+
+@implementation ZGStandInRoomService
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _queue = dispatch_queue_create("im.zego.standin.room", DISPATCH_QUEUE_SERIAL);
+        _rooms = [NSMutableDictionary dictionary];
+        _sessions = [NSMutableDictionary dictionary];
+        _links = [NSMutableDictionary dictionary];
+        _nextMessageID = 1;
+        _loginLatencyMinMs = 80;
+        _loginLatencyMaxMs = 250;
+        _publishLatencyMs = 60;
+        _playLatencyMs = 60;
+        _signalingLatencyMs = 30;
+        _frameLatencyMs = 120;
+        _qualityInterval = 3.0;
+        _nominalVideoKBPS = 600;
+        _nominalVideoFPS = 15;
+        [self startQualityTimer];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    dispatch_source_cancel(_qualityTimer);
+}
+
+#pragma mark - Statistics
+
+- (NSUInteger)roomCount {
+    __block NSUInteger count = 0;
+    dispatch_sync(self.queue, ^{
+        count = self.rooms.count;
+    });
+    return count;
+}
+
+- (NSUInteger)userCountInRoom:(NSString *)roomID {
+    __block NSUInteger count = 0;
+    dispatch_sync(self.queue, ^{
+        count = self.rooms[roomID].users.count;
+    });
+    return count;
+}
+
+- (NSUInteger)streamCountInRoom:(NSString *)roomID {
+    __block NSUInteger count = 0;
+    dispatch_sync(self.queue, ^{
+        count = self.rooms[roomID].streams.count;
+    });
+    return count;
+}
+
+#pragma mark - Room
+
+- (void)engine:(ZGStandInEngine *)engine loginRoom:(NSString *)roomID user:(ZegoUser *)user config:(ZegoRoomConfig *)config {
+    NSString *engineID = engine.engineID;
+    BOOL isUserStatusNotify = config.isUserStatusNotify;
+    NSString *token = config.token;
+    dispatch_async(self.queue, ^{
+        if (self.sessions[engineID]) {
+            [self deliverRoomState:ZegoRoomStateDisconnected errorCode:ZGStandInErrorCodeRepeatedLogin roomID:roomID toEngine:engine delay:0];
+            return;
+        }
+        if (self.tokenService && ![self.tokenService isValidToken:token roomID:roomID userID:user.userID]) {
+            [self deliverRoomState:ZegoRoomStateDisconnected errorCode:ZGStandInErrorCodeTokenInvalid roomID:roomID toEngine:engine delay:0];
+            return;
+        }
+        ZGStandInRoom *room = [self roomWithID:roomID create:YES];
+        if (room.users[user.userID]) {
+            [self deliverRoomState:ZegoRoomStateDisconnected errorCode:ZGStandInErrorCodeUserExists roomID:roomID toEngine:engine delay:0];
+            return;
+        }
+        ZGStandInSession *session = [[ZGStandInSession alloc] init];
+        session.engine = engine;
+        session.engineID = engineID;
+        session.user = user;
+        session.roomID = roomID;
+        session.isUserStatusNotify = isUserStatusNotify;
+        session.publishStreamIDs = [NSMutableDictionary dictionary];
+        session.plays = [NSMutableDictionary dictionary];
+        self.sessions[engineID] = session;
+
+        [self deliverRoomState:ZegoRoomStateConnecting errorCode:0 roomID:roomID toEngine:engine delay:0];
+
+        NSTimeInterval latency = [self randomLatencyMinMs:self.loginLatencyMinMs maxMs:self.loginLatencyMaxMs];
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(latency * NSEC_PER_SEC)), self.queue, ^{
+            [self completeLoginOfSession:session];
+        });
+    });
+}
+
+- (void)completeLoginOfSession:(ZGStandInSession *)session {
+    // Logged out (or destroyed) before the login completed
+    if (self.sessions[session.engineID] != session) {
+        return;
+    }
+    ZGStandInRoom *room = [self roomWithID:session.roomID create:YES];
+    if (room.users[session.user.userID]) {
+        [self.sessions removeObjectForKey:session.engineID];
+        [self deliverRoomState:ZegoRoomStateDisconnected errorCode:ZGStandInErrorCodeUserExists roomID:session.roomID toEngine:session.engine delay:0];
+        return;
+    }
+
+    NSArray<ZegoUser *> *existingUsers = room.users.allValues;
+    NSMutableArray<ZegoStream *> *existingStreams = [NSMutableArray array];
+    for (ZGStandInStream *stream in room.streams.allValues) {
+        [existingStreams addObject:stream.stream];
+    }
+
+    session.connected = YES;
+    room.users[session.user.userID] = session.user;
+    [room.engineIDs addObject:session.engineID];
+
+    NSString *roomID = room.roomID;
+    [self deliverRoomState:ZegoRoomStateConnected errorCode:0 roomID:roomID toEngine:session.engine delay:0];
+
+    if (session.isUserStatusNotify && existingUsers.count > 0) {
+        [session.engine deliverEvent:^(id<ZegoEventHandler> handler) {
+            if ([handler respondsToSelector:@selector(onRoomUserUpdate:userList:roomID:)]) {
+                [handler onRoomUserUpdate:ZegoUpdateTypeAdd userList:existingUsers roomID:roomID];
+            }
+        } afterDelay:0];
+    }
+    if (existingStreams.count > 0) {
+        [session.engine deliverEvent:^(id<ZegoEventHandler> handler) {
+            if ([handler respondsToSelector:@selector(onRoomStreamUpdate:streamList:roomID:)]) {
+                [handler onRoomStreamUpdate:ZegoUpdateTypeAdd streamList:existingStreams roomID:roomID];
+            }
+        } afterDelay:0];
+    }
+    [self notifyRoom:room usersAdded:@[session.user] exceptEngineID:session.engineID];
+
+    // Requests issued while the login was still in flight
+    for (NSNumber *channel in session.publishStreamIDs.allKeys) {
+        [self activatePublishOfSession:session channel:(ZegoPublishChannel)channel.unsignedIntegerValue];
+    }
+    for (ZGStandInPlay *play in session.plays.allValues) {
+        [self activatePlay:play ofSession:session];
+    }
+}
+
+- (void)engine:(ZGStandInEngine *)engine logoutRoom:(NSString *)roomID {
+    NSString *engineID = engine.engineID;
+    dispatch_async(self.queue, ^{
+        ZGStandInSession *session = self.sessions[engineID];
+        if (!session || ![session.roomID isEqualToString:roomID]) {
+            return;
+        }
+        [self teardownSession:session];
+        [self deliverRoomState:ZegoRoomStateDisconnected errorCode:0 roomID:roomID toEngine:engine delay:0];
+    });
+}
+
+- (void)engineDidDestroy:(NSString *)engineID {
+    dispatch_async(self.queue, ^{
+        [self.links removeObjectForKey:engineID];
+        ZGStandInSession *session = self.sessions[engineID];
+        if (session) {
+            [self teardownSession:session];
+        }
+    });
+}
+
+/// Drop every stream, play and membership of a session
+- (void)teardownSession:(ZGStandInSession *)session {
+    [self.sessions removeObjectForKey:session.engineID];
+    ZGStandInRoom *room = self.rooms[session.roomID];
+    if (!room) {
+        return;
+    }
+
+    for (ZGStandInPlay *play in session.plays.allValues) {
+        [room.streams[play.streamID].playerEngineIDs removeObject:session.engineID];
+    }
+    [session.plays removeAllObjects];
+
+    NSMutableArray<ZGStandInStream *> *ownStreams = [NSMutableArray array];
+    for (ZGStandInStream *stream in room.streams.allValues) {
+        if ([stream.publisherEngineID isEqualToString:session.engineID]) {
+            [ownStreams addObject:stream];
+        }
+    }
+    [self removeStreams:ownStreams fromRoom:room];
+    [session.publishStreamIDs removeAllObjects];
+
+    if (session.connected) {
+        [room.engineIDs removeObject:session.engineID];
+        [room.users removeObjectForKey:session.user.userID];
+        [self notifyRoom:room usersDeleted:@[session.user] exceptEngineID:session.engineID];
+    }
+
+    if (room.users.count == 0 && room.engineIDs.count == 0) {
+        [self.rooms removeObjectForKey:room.roomID];
+    }
+}
+
+#pragma mark - Publisher
+
+- (void)engine:(ZGStandInEngine *)engine startPublishing:(NSString *)streamID channel:(ZegoPublishChannel)channel {
+    NSString *engineID = engine.engineID;
+    dispatch_async(self.queue, ^{
+        ZGStandInSession *session = self.sessions[engineID];
+        if (!session) {
+            [self deliverPublisherState:ZegoPublisherStateNoPublish errorCode:ZGStandInErrorCodeNotLoggedIn streamID:streamID toEngine:engine delay:0];
+            return;
+        }
+        NSString *current = session.publishStreamIDs[@(channel)];
+        if (current) {
+            if (![current isEqualToString:streamID]) {
+                [self deliverPublisherState:ZegoPublisherStateNoPublish errorCode:ZGStandInErrorCodePublishChannelBusy streamID:streamID toEngine:engine delay:0];
+            }
+            return;
+        }
+        session.publishStreamIDs[@(channel)] = streamID;
+        [self deliverPublisherState:ZegoPublisherStatePublishRequesting errorCode:0 streamID:streamID toEngine:engine delay:0];
+        if (session.connected) {
+            [self activatePublishOfSession:session channel:channel];
+        }
+    });
+}
+
+- (void)activatePublishOfSession:(ZGStandInSession *)session channel:(ZegoPublishChannel)channel {
+    NSString *streamID = session.publishStreamIDs[@(channel)];
+    NSTimeInterval latency = self.publishLatencyMs / 1000.0;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(latency * NSEC_PER_SEC)), self.queue, ^{
+        // Stopped, re-targeted or logged out in the meantime
+        if (self.sessions[session.engineID] != session || ![session.publishStreamIDs[@(channel)] isEqualToString:streamID]) {
+            return;
+        }
+        ZGStandInRoom *room = self.rooms[session.roomID];
+        if (room.streams[streamID]) {
+            [session.publishStreamIDs removeObjectForKey:@(channel)];
+            [self deliverPublisherState:ZegoPublisherStateNoPublish errorCode:ZGStandInErrorCodeStreamExists streamID:streamID toEngine:session.engine delay:0];
+            return;
+        }
+
+        ZGStandInStream *standInStream = [[ZGStandInStream alloc] init];
+        standInStream.stream = [ZGStandInRoomService streamWithUser:session.user streamID:streamID extraInfo:@""];
+        standInStream.publisherEngineID = session.engineID;
+        standInStream.channel = channel;
+
+        [self deliverPublisherState:ZegoPublisherStatePublishing errorCode:0 streamID:streamID toEngine:session.engine delay:0];
+        [self addStreams:@[standInStream] toRoom:room];
+    });
+}
+
+- (void)engine:(ZGStandInEngine *)engine stopPublishing:(ZegoPublishChannel)channel {
+    NSString *engineID = engine.engineID;
+    dispatch_async(self.queue, ^{
+        ZGStandInSession *session = self.sessions[engineID];
+        NSString *streamID = session.publishStreamIDs[@(channel)];
+        if (!streamID) {
+            return;
+        }
+        [session.publishStreamIDs removeObjectForKey:@(channel)];
+        ZGStandInRoom *room = self.rooms[session.roomID];
+        ZGStandInStream *stream = room.streams[streamID];
+        if ([stream.publisherEngineID isEqualToString:engineID]) {
+            [self removeStreams:@[stream] fromRoom:room];
+        }
+        [self deliverPublisherState:ZegoPublisherStateNoPublish errorCode:0 streamID:streamID toEngine:engine delay:0];
+    });
+}
+
+- (void)engine:(ZGStandInEngine *)engine setStreamExtraInfo:(NSString *)extraInfo channel:(ZegoPublishChannel)channel callback:(ZegoPublisherSetStreamExtraInfoCallback)callback {
+    NSString *engineID = engine.engineID;
+    dispatch_async(self.queue, ^{
+        ZGStandInSession *session = self.sessions[engineID];
+        ZGStandInStream *stream = self.rooms[session.roomID].streams[session.publishStreamIDs[@(channel)] ?: @""];
+        if (!session.connected || !stream) {
+            if (callback) {
+                [engine deliverBlock:^{ callback(ZGStandInErrorCodeNotLoggedIn); } afterDelay:0];
+            }
+            return;
+        }
+        stream.stream = [ZGStandInRoomService streamWithUser:stream.stream.user streamID:stream.stream.streamID extraInfo:extraInfo];
+        NSTimeInterval latency = self.signalingLatencyMs / 1000.0;
+        if (callback) {
+            [engine deliverBlock:^{ callback(0); } afterDelay:latency * 2];
+        }
+        [self notifyRoom:self.rooms[session.roomID] extraInfoUpdated:@[stream.stream] exceptEngineID:engineID];
+    });
+}
+
+- (void)engine:(ZGStandInEngine *)engine mutePublishStreamAudio:(BOOL)mute {
+    NSString *engineID = engine.engineID;
+    dispatch_async(self.queue, ^{
+        self.sessions[engineID].audioMuted = mute;
+    });
+}
+
+- (void)engine:(ZGStandInEngine *)engine mutePublishStreamVideo:(BOOL)mute {
+    NSString *engineID = engine.engineID;
+    dispatch_async(self.queue, ^{
+        self.sessions[engineID].videoMuted = mute;
+    });
+}
+
+- (void)engine:(ZGStandInEngine *)engine sendVideoFrame:(CVPixelBufferRef)buffer timeStamp:(CMTime)timeStamp channel:(ZegoPublishChannel)channel {
+    NSString *engineID = engine.engineID;
+    CVPixelBufferRetain(buffer);
+    dispatch_async(self.queue, ^{
+        [self forwardVideoFrame:buffer fromEngineID:engineID channel:channel];
+        CVPixelBufferRelease(buffer);
+    });
+}
+
+- (void)forwardVideoFrame:(CVPixelBufferRef)buffer fromEngineID:(NSString *)engineID channel:(ZegoPublishChannel)channel {
+    ZGStandInSession *publisher = self.sessions[engineID];
+    if (!publisher || publisher.videoMuted) {
+        return;
+    }
+    ZGStandInRoom *room = self.rooms[publisher.roomID];
+    ZGStandInStream *stream = room.streams[publisher.publishStreamIDs[@(channel)] ?: @""];
+    if (![stream.publisherEngineID isEqualToString:engineID]) {
+        return;
+    }
+    stream.framesSinceReport += 1;
+
+    double now = ZGClockNow();
+    double frameBits = self.nominalVideoKBPS * 1000 / self.nominalVideoFPS;
+    double uplinkDelayMs = 0;
+    ZGStandInLink *publisherLink = self.links[engineID];
+    if (publisherLink && ![publisherLink.uplink transmitFrameOfBits:frameBits atTime:[publisherLink profileTimeAt:now] delayMs:&uplinkDelayMs]) {
+        return;
+    }
+    stream.sentFramesSinceReport += 1;
+
+    NSString *streamID = stream.stream.streamID;
+    for (NSString *playerEngineID in stream.playerEngineIDs) {
+        ZGStandInSession *player = self.sessions[playerEngineID];
+        ZGStandInPlay *play = player.plays[streamID];
+        if (!play.playing) {
+            continue;
+        }
+        if (play.videoMuted) {
+            play.recvFramesSinceReport += 1;
+            continue;
+        }
+        double downlinkDelayMs = 0;
+        ZGStandInLink *playerLink = self.links[playerEngineID];
+        if (playerLink && ![playerLink.downlink transmitFrameOfBits:frameBits atTime:[playerLink profileTimeAt:now] delayMs:&downlinkDelayMs]) {
+            continue;
+        }
+        play.recvFramesSinceReport += 1;
+        play.renderFramesSinceReport += 1;
+
+        // Jitter must not reorder frames, the player's jitter buffer holds an early frame back instead
+        double dueTime = MAX(now + (self.frameLatencyMs + uplinkDelayMs + downlinkDelayMs) / 1000.0, play.lastFrameDueTime);
+        play.lastFrameDueTime = dueTime;
+        NSTimeInterval latency = dueTime - now;
+
+        ZGStandInEngine *playerEngine = player.engine;
+        if (!play.firstFrameDelivered) {
+            play.firstFrameDelivered = YES;
+            [playerEngine deliverEvent:^(id<ZegoEventHandler> handler) {
+                if ([handler respondsToSelector:@selector(onPlayerRecvVideoFirstFrame:)]) {
+                    [handler onPlayerRecvVideoFirstFrame:streamID];
+                }
+                if ([handler respondsToSelector:@selector(onPlayerRenderVideoFirstFrame:)]) {
+                    [handler onPlayerRenderVideoFirstFrame:streamID];
+                }
+            } afterDelay:latency];
+        }
+        [playerEngine deliverRemoteVideoFrame:buffer streamID:streamID afterDelay:latency];
+    }
+}
+
+#pragma mark - Player
+
+- (void)engine:(ZGStandInEngine *)engine startPlayingStream:(NSString *)streamID config:(ZegoPlayerConfig *)config {
+    NSString *engineID = engine.engineID;
+    ZegoPlayerVideoLayer videoLayer = config.videoLayer;
+    dispatch_async(self.queue, ^{
+        ZGStandInSession *session = self.sessions[engineID];
+        if (!session) {
+            [self deliverPlayerState:ZegoPlayerStateNoPlay errorCode:ZGStandInErrorCodeNotLoggedIn streamID:streamID toEngine:engine delay:0];
+            return;
+        }
+        ZGStandInPlay *play = session.plays[streamID];
+        if (play) {
+            play.videoLayer = videoLayer;
+            return;
+        }
+        play = [[ZGStandInPlay alloc] init];
+        play.streamID = streamID;
+        play.volume = 100;
+        play.videoLayer = videoLayer;
+        session.plays[streamID] = play;
+        [self deliverPlayerState:ZegoPlayerStatePlayRequesting errorCode:0 streamID:streamID toEngine:engine delay:0];
+        if (session.connected) {
+            [self activatePlay:play ofSession:session];
+        }
+    });
+}
+
+/// Move a requested play to Playing once its stream exists
+- (void)activatePlay:(ZGStandInPlay *)play ofSession:(ZGStandInSession *)session {
+    ZGStandInRoom *room = self.rooms[session.roomID];
+    if (play.playing || !room.streams[play.streamID]) {
+        return;
+    }
+    NSTimeInterval latency = self.playLatencyMs / 1000.0;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(latency * NSEC_PER_SEC)), self.queue, ^{
+        ZGStandInStream *stream = self.rooms[session.roomID].streams[play.streamID];
+        if (self.sessions[session.engineID] != session || session.plays[play.streamID] != play || play.playing || !stream) {
+            return;
+        }
+        play.playing = YES;
+        play.firstFrameDelivered = NO;
+        [stream.playerEngineIDs addObject:session.engineID];
+        [self deliverPlayerState:ZegoPlayerStatePlaying errorCode:0 streamID:play.streamID toEngine:session.engine delay:0];
+    });
+}
+
+- (void)engine:(ZGStandInEngine *)engine stopPlayingStream:(NSString *)streamID {
+    NSString *engineID = engine.engineID;
+    dispatch_async(self.queue, ^{
+        ZGStandInSession *session = self.sessions[engineID];
+        if (!session.plays[streamID]) {
+            return;
+        }
+        [session.plays removeObjectForKey:streamID];
+        [self.rooms[session.roomID].streams[streamID].playerEngineIDs removeObject:engineID];
+        [self deliverPlayerState:ZegoPlayerStateNoPlay errorCode:0 streamID:streamID toEngine:engine delay:0];
+    });
+}
+
+- (void)engine:(ZGStandInEngine *)engine setPlayVolume:(int)volume streamID:(NSString *)streamID {
+    NSString *engineID = engine.engineID;
+    dispatch_async(self.queue, ^{
+        self.sessions[engineID].plays[streamID].volume = volume;
+    });
+}
+
+- (void)engine:(ZGStandInEngine *)engine mutePlayStreamAudio:(BOOL)mute streamID:(NSString *)streamID {
+    NSString *engineID = engine.engineID;
+    dispatch_async(self.queue, ^{
+        self.sessions[engineID].plays[streamID].audioMuted = mute;
+    });
+}
+
+- (void)engine:(ZGStandInEngine *)engine mutePlayStreamVideo:(BOOL)mute streamID:(NSString *)streamID {
+    NSString *engineID = engine.engineID;
+    dispatch_async(self.queue, ^{
+        self.sessions[engineID].plays[streamID].videoMuted = mute;
+    });
+}
+
+#pragma mark - IM
+
+- (void)engine:(ZGStandInEngine *)engine sendBroadcastMessage:(NSString *)message roomID:(NSString *)roomID callback:(ZegoIMSendBroadcastMessageCallback)callback {
+    NSString *engineID = engine.engineID;
+    dispatch_async(self.queue, ^{
+        ZGStandInSession *session = self.sessions[engineID];
+        if (!session.connected || ![session.roomID isEqualToString:roomID]) {
+            if (callback) {
+                [engine deliverBlock:^{ callback(ZGStandInErrorCodeNotLoggedIn, 0); } afterDelay:0];
+            }
+            return;
+        }
+        unsigned long long messageID = self.nextMessageID++;
+        ZegoBroadcastMessageInfo *info = [[ZegoBroadcastMessageInfo alloc] init];
+        info.message = message;
+        info.messageID = messageID;
+        info.sendTime = (unsigned long long)([[NSDate date] timeIntervalSince1970] * 1000);
+        info.fromUser = session.user;
+
+        NSTimeInterval latency = self.signalingLatencyMs / 1000.0;
+        if (callback) {
+            [engine deliverBlock:^{ callback(0, messageID); } afterDelay:latency * 2];
+        }
+        [self deliverToRoom:self.rooms[roomID] exceptEngineID:engineID event:^(id<ZegoEventHandler> handler) {
+            if ([handler respondsToSelector:@selector(onIMRecvBroadcastMessage:roomID:)]) {
+                [handler onIMRecvBroadcastMessage:@[info] roomID:roomID];
+            }
+        }];
+    });
+}
+
+- (void)engine:(ZGStandInEngine *)engine sendBarrageMessage:(NSString *)message roomID:(NSString *)roomID callback:(ZegoIMSendBarrageMessageCallback)callback {
+    NSString *engineID = engine.engineID;
+    dispatch_async(self.queue, ^{
+        ZGStandInSession *session = self.sessions[engineID];
+        if (!session.connected || ![session.roomID isEqualToString:roomID]) {
+            if (callback) {
+                [engine deliverBlock:^{ callback(ZGStandInErrorCodeNotLoggedIn, @""); } afterDelay:0];
+            }
+            return;
+        }
+        NSString *messageID = [NSString stringWithFormat:@"%llu", self.nextMessageID++];
+        // `messageID` of ZegoBarrageMessageInfo is declared assign in the SDK header and cannot hold a string safely
+        ZegoBarrageMessageInfo *info = [[ZegoBarrageMessageInfo alloc] init];
+        info.message = message;
+        info.sendTime = (unsigned long long)([[NSDate date] timeIntervalSince1970] * 1000);
+        info.fromUser = session.user;
+
+        NSTimeInterval latency = self.signalingLatencyMs / 1000.0;
+        if (callback) {
+            [engine deliverBlock:^{ callback(0, messageID); } afterDelay:latency * 2];
+        }
+        [self deliverToRoom:self.rooms[roomID] exceptEngineID:engineID event:^(id<ZegoEventHandler> handler) {
+            if ([handler respondsToSelector:@selector(onIMRecvBarrageMessage:roomID:)]) {
+                [handler onIMRecvBarrageMessage:@[info] roomID:roomID];
+            }
+        }];
+    });
+}
+
+- (void)engine:(ZGStandInEngine *)engine sendCustomCommand:(NSString *)command toUserList:(NSArray<ZegoUser *> *)toUserList roomID:(NSString *)roomID callback:(ZegoIMSendCustomCommandCallback)callback {
+    NSString *engineID = engine.engineID;
+    dispatch_async(self.queue, ^{
+        ZGStandInSession *session = self.sessions[engineID];
+        if (!session.connected || ![session.roomID isEqualToString:roomID]) {
+            if (callback) {
+                [engine deliverBlock:^{ callback(ZGStandInErrorCodeNotLoggedIn); } afterDelay:0];
+            }
+            return;
+        }
+        NSMutableSet<NSString *> *targetUserIDs = nil;
+        if (toUserList.count > 0) {
+            targetUserIDs = [NSMutableSet set];
+            for (ZegoUser *user in toUserList) {
+                [targetUserIDs addObject:user.userID];
+            }
+        }
+        ZegoUser *fromUser = session.user;
+        NSTimeInterval latency = self.signalingLatencyMs / 1000.0;
+        if (callback) {
+            [engine deliverBlock:^{ callback(0); } afterDelay:latency * 2];
+        }
+        for (NSString *targetEngineID in self.rooms[roomID].engineIDs) {
+            ZGStandInSession *target = self.sessions[targetEngineID];
+            if ([targetEngineID isEqualToString:engineID] || (targetUserIDs && ![targetUserIDs containsObject:target.user.userID])) {
+                continue;
+            }
+            [target.engine deliverEvent:^(id<ZegoEventHandler> handler) {
+                if ([handler respondsToSelector:@selector(onIMRecvCustomCommand:fromUser:roomID:)]) {
+                    [handler onIMRecvCustomCommand:command fromUser:fromUser roomID:roomID];
+                }
+            } afterDelay:latency];
+        }
+    });
+}
+
+#pragma mark - Mixer
+
+- (void)engine:(ZGStandInEngine *)engine startMixerTask:(ZegoMixerTask *)task callback:(ZegoMixerStartCallback)callback {
+    // Mixing itself is not simulated, only the signaling round trip
+    if (callback) {
+        [engine deliverBlock:^{ callback(0, nil); } afterDelay:self.signalingLatencyMs * 2 / 1000.0];
+    }
+}
+
+- (void)engine:(ZGStandInEngine *)engine stopMixerTask:(ZegoMixerTask *)task callback:(ZegoMixerStopCallback)callback {
+    if (callback) {
+        [engine deliverBlock:^{ callback(0); } afterDelay:self.signalingLatencyMs * 2 / 1000.0];
+    }
+}
+
+- (void)engine:(ZGStandInEngine *)engine updatePublishCDNURL:(NSString *)targetURL streamID:(NSString *)streamID callback:(ZegoPublisherUpdateCDNURLCallback)callback {
+    // CDN relaying is not simulated either
+    if (callback) {
+        [engine deliverBlock:^{ callback(0); } afterDelay:self.signalingLatencyMs * 2 / 1000.0];
+    }
+}
+
+#pragma mark - Network impairment
+
+- (void)engine:(ZGStandInEngine *)engine setNetworkProfile:(ZGStandInNetworkProfile *)profile {
+    NSString *engineID = engine.engineID;
+    dispatch_async(self.queue, ^{
+        if (!profile) {
+            [self.links removeObjectForKey:engineID];
+            return;
+        }
+        // Salts follow the order profiles are set in, so a scripted run replays the same drops
+        uint64_t salt = ++self.nextLinkSalt;
+        ZGStandInLink *link = [[ZGStandInLink alloc] init];
+        link.uplink = [[ZGStandInImpairmentModel alloc] initWithProfile:profile salt:salt * 2];
+        link.downlink = [[ZGStandInImpairmentModel alloc] initWithProfile:profile salt:salt * 2 + 1];
+        link.startTime = ZGClockNow();
+        self.links[engineID] = link;
+    });
+}
+
+#pragma mark - Synthetic traffic
+
+- (void)addSyntheticUsers:(NSArray<ZegoUser *> *)users toRoom:(NSString *)roomID {
+    dispatch_async(self.queue, ^{
+        ZGStandInRoom *room = [self roomWithID:roomID create:YES];
+        NSMutableArray<ZegoUser *> *added = [NSMutableArray arrayWithCapacity:users.count];
+        for (ZegoUser *user in users) {
+            if (!room.users[user.userID]) {
+                room.users[user.userID] = user;
+                [added addObject:user];
+            }
+        }
+        if (added.count > 0) {
+            [self notifyRoom:room usersAdded:added exceptEngineID:nil];
+        }
+    });
+}
+
+- (void)removeSyntheticUsers:(NSArray<ZegoUser *> *)users fromRoom:(NSString *)roomID {
+    dispatch_async(self.queue, ^{
+        ZGStandInRoom *room = self.rooms[roomID];
+        NSMutableArray<ZegoUser *> *removed = [NSMutableArray arrayWithCapacity:users.count];
+        NSMutableSet<NSString *> *removedUserIDs = [NSMutableSet setWithCapacity:users.count];
+        for (ZegoUser *user in users) {
+            ZegoUser *member = room.users[user.userID];
+            // Never evict a user that belongs to a stand-in engine
+            if (member && ![self isEngineUser:member.userID inRoom:room]) {
+                [room.users removeObjectForKey:user.userID];
+                [removed addObject:member];
+                [removedUserIDs addObject:member.userID];
+            }
+        }
+        // Streams of a leaving user go away with the user
+        NSMutableArray<ZGStandInStream *> *orphans = [NSMutableArray array];
+        for (ZGStandInStream *stream in room.streams.allValues) {
+            if (!stream.publisherEngineID && [removedUserIDs containsObject:stream.stream.user.userID]) {
+                [orphans addObject:stream];
+            }
+        }
+        [self removeStreams:orphans fromRoom:room];
+        if (removed.count > 0) {
+            [self notifyRoom:room usersDeleted:removed exceptEngineID:nil];
+        }
+        if (room && room.users.count == 0 && room.engineIDs.count == 0) {
+            [self.rooms removeObjectForKey:room.roomID];
+        }
+    });
+}
+
+- (void)addSyntheticStreams:(NSArray<ZegoStream *> *)streams toRoom:(NSString *)roomID {
+    dispatch_async(self.queue, ^{
+        ZGStandInRoom *room = [self roomWithID:roomID create:YES];
+        NSMutableArray<ZGStandInStream *> *added = [NSMutableArray arrayWithCapacity:streams.count];
+        for (ZegoStream *stream in streams) {
+            if (room.streams[stream.streamID]) {
+                continue;
+            }
+            // Our own copy, the caller's object may still change
+            ZGStandInStream *standInStream = [[ZGStandInStream alloc] init];
+            standInStream.stream = [ZGStandInRoomService streamWithUser:stream.user streamID:stream.streamID extraInfo:stream.extraInfo ?: @""];
+            [added addObject:standInStream];
+        }
+        if (added.count > 0) {
+            [self addStreams:added toRoom:room];
+        }
+    });
+}
+
+- (void)removeSyntheticStreams:(NSArray<NSString *> *)streamIDs fromRoom:(NSString *)roomID {
+    dispatch_async(self.queue, ^{
+        ZGStandInRoom *room = self.rooms[roomID];
+        NSMutableArray<ZGStandInStream *> *removed = [NSMutableArray arrayWithCapacity:streamIDs.count];
+        for (NSString *streamID in streamIDs) {
+            ZGStandInStream *stream = room.streams[streamID];
+            if (stream && !stream.publisherEngineID) {
+                [removed addObject:stream];
+            }
+        }
+        [self removeStreams:removed fromRoom:room];
+    });
+}
+
+- (void)updateSyntheticStreamExtraInfo:(NSDictionary<NSString *, NSString *> *)extraInfos inRoom:(NSString *)roomID {
+    dispatch_async(self.queue, ^{
+        ZGStandInRoom *room = self.rooms[roomID];
+        NSMutableArray<ZegoStream *> *updated = [NSMutableArray arrayWithCapacity:extraInfos.count];
+        [extraInfos enumerateKeysAndObjectsUsingBlock:^(NSString *streamID, NSString *extraInfo, BOOL *stop) {
+            ZGStandInStream *stream = room.streams[streamID];
+            if (stream && !stream.publisherEngineID) {
+                stream.stream = [ZGStandInRoomService streamWithUser:stream.stream.user streamID:streamID extraInfo:extraInfo];
+                [updated addObject:stream.stream];
+            }
+        }];
+        if (updated.count > 0) {
+            [self notifyRoom:room extraInfoUpdated:updated exceptEngineID:nil];
+        }
+    });
+}
+
+- (void)sendSyntheticBroadcastMessages:(NSArray<ZegoBroadcastMessageInfo *> *)messages toRoom:(NSString *)roomID {
+    dispatch_async(self.queue, ^{
+        for (ZegoBroadcastMessageInfo *message in messages) {
+            message.messageID = self.nextMessageID++;
+        }
+        [self deliverToRoom:self.rooms[roomID] exceptEngineID:nil event:^(id<ZegoEventHandler> handler) {
+            if ([handler respondsToSelector:@selector(onIMRecvBroadcastMessage:roomID:)]) {
+                [handler onIMRecvBroadcastMessage:messages roomID:roomID];
+            }
+        }];
+    });
+}
+
+- (void)sendSyntheticBarrageMessages:(NSArray<ZegoBarrageMessageInfo *> *)messages toRoom:(NSString *)roomID {
+    dispatch_async(self.queue, ^{
+        [self deliverToRoom:self.rooms[roomID] exceptEngineID:nil event:^(id<ZegoEventHandler> handler) {
+            if ([handler respondsToSelector:@selector(onIMRecvBarrageMessage:roomID:)]) {
+                [handler onIMRecvBarrageMessage:messages roomID:roomID];
+            }
+        }];
+    });
+}
+
+- (void)sendSyntheticCustomCommand:(NSString *)command fromUser:(ZegoUser *)fromUser toRoom:(NSString *)roomID {
+    dispatch_async(self.queue, ^{
+        [self deliverToRoom:self.rooms[roomID] exceptEngineID:nil event:^(id<ZegoEventHandler> handler) {
+            if ([handler respondsToSelector:@selector(onIMRecvCustomCommand:fromUser:roomID:)]) {
+                [handler onIMRecvCustomCommand:command fromUser:fromUser roomID:roomID];
+            }
+        }];
+    });
+}
+
+- (BOOL)isEngineUser:(NSString *)userID inRoom:(ZGStandInRoom *)room {
+    for (NSString *engineID in room.engineIDs) {
+        if ([self.sessions[engineID].user.userID isEqualToString:userID]) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+#pragma mark - Quality
+
+- (void)setQualityInterval:(NSTimeInterval)qualityInterval {
+    _qualityInterval = qualityInterval;
+    if (_qualityTimer) {
+        dispatch_source_cancel(_qualityTimer);
+        [self startQualityTimer];
+    }
+}
+
+- (void)startQualityTimer {
+    __weak typeof(self) weakSelf = self;
+    self.qualityTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.queue);
+    uint64_t interval = (uint64_t)(self.qualityInterval * NSEC_PER_SEC);
+    dispatch_source_set_timer(self.qualityTimer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)interval), interval, interval / 20);
+    dispatch_source_set_event_handler(self.qualityTimer, ^{
+        [weakSelf reportQuality];
+    });
+    dispatch_resume(self.qualityTimer);
+}
+
+- (void)reportQuality {
+    NSTimeInterval interval = self.qualityInterval;
+    double now = ZGClockNow();
+    for (ZGStandInLink *link in self.links.allValues) {
+        [link takeStatisticsAt:now];
+    }
+
+    for (ZGStandInSession *session in self.sessions.allValues) {
+        if (!session.connected) {
+            continue;
+        }
+        ZGStandInRoom *room = self.rooms[session.roomID];
+        ZGStandInEngine *engine = session.engine;
+
+        for (NSString *streamID in session.publishStreamIDs.allValues) {
+            ZGStandInStream *stream = room.streams[streamID];
+            if (![stream.publisherEngineID isEqualToString:session.engineID]) {
+                continue;
+            }
+            ZegoPublishStreamQuality *quality = [self publishQualityOfStream:stream session:session interval:interval];
+            stream.framesSinceReport = 0;
+            stream.sentFramesSinceReport = 0;
+            [engine deliverEvent:^(id<ZegoEventHandler> handler) {
+                if ([handler respondsToSelector:@selector(onPublisherQualityUpdate:streamID:)]) {
+                    [handler onPublisherQualityUpdate:quality streamID:streamID];
+                }
+            } afterDelay:0];
+        }
+
+        for (ZGStandInPlay *play in session.plays.allValues) {
+            if (!play.playing) {
+                continue;
+            }
+            ZegoPlayStreamQuality *quality = [self playQualityOfPlay:play session:session interval:interval];
+            play.recvFramesSinceReport = 0;
+            play.renderFramesSinceReport = 0;
+            NSString *streamID = play.streamID;
+            [engine deliverEvent:^(id<ZegoEventHandler> handler) {
+                if ([handler respondsToSelector:@selector(onPlayerQualityUpdate:streamID:)]) {
+                    [handler onPlayerQualityUpdate:quality streamID:streamID];
+                }
+            } afterDelay:0];
+        }
+    }
+}
+
+- (ZegoPublishStreamQuality *)publishQualityOfStream:(ZGStandInStream *)stream session:(ZGStandInSession *)session interval:(NSTimeInterval)interval {
+    ZGStandInLink *link = self.links[session.engineID];
+    double sendFPS = stream.sentFramesSinceReport / interval;
+    double videoKBPS = self.nominalVideoKBPS * MIN(1.0, sendFPS / self.nominalVideoFPS);
+    double rtt = (self.signalingLatencyMs + link.uplinkDelayMs) * 2;
+    return [ZGStandInImpairmentModel publishQualityWithCaptureFPS:stream.framesSinceReport / interval sendFPS:sendFPS videoKBPS:videoKBPS rtt:rtt lossRate:link.uplinkLossRate audioMuted:session.audioMuted];
+}
+
+- (ZegoPlayStreamQuality *)playQualityOfPlay:(ZGStandInPlay *)play session:(ZGStandInSession *)session interval:(NSTimeInterval)interval {
+    // The frames crossed the publisher's uplink first, then this player's downlink
+    ZGStandInStream *stream = self.rooms[session.roomID].streams[play.streamID];
+    ZGStandInLink *uplink = stream.publisherEngineID ? self.links[stream.publisherEngineID] : nil;
+    ZGStandInLink *downlink = self.links[session.engineID];
+    double recvFPS = play.recvFramesSinceReport / interval;
+    double videoKBPS = self.nominalVideoKBPS * MIN(1.0, recvFPS / self.nominalVideoFPS);
+    double rtt = (self.signalingLatencyMs + downlink.downlinkDelayMs) * 2;
+    double lossRate = 1.0 - (1.0 - uplink.uplinkLossRate) * (1.0 - downlink.downlinkLossRate);
+    double delay = self.frameLatencyMs + uplink.uplinkDelayMs + downlink.downlinkDelayMs;
+    return [ZGStandInImpairmentModel playQualityWithRecvFPS:recvFPS renderFPS:play.renderFramesSinceReport / interval videoKBPS:videoKBPS rtt:rtt lossRate:lossRate delay:delay audioMuted:play.audioMuted];
+}
+
+#pragma mark - Room helpers
+
++ (ZegoStream *)streamWithUser:(ZegoUser *)user streamID:(NSString *)streamID extraInfo:(NSString *)extraInfo {
+    ZegoStream *stream = [[ZegoStream alloc] init];
+    stream.user = user;
+    stream.streamID = streamID;
+    stream.extraInfo = extraInfo;
+    return stream;
+}
+
+- (ZGStandInRoom *)roomWithID:(NSString *)roomID create:(BOOL)create {
+    ZGStandInRoom *room = self.rooms[roomID];
+    if (!room && create) {
+        room = [[ZGStandInRoom alloc] init];
+        room.roomID = roomID;
+        room.users = [NSMutableDictionary dictionary];
+        room.streams = [NSMutableDictionary dictionary];
+        room.engineIDs = [NSMutableSet set];
+        self.rooms[roomID] = room;
+    }
+    return room;
+}
+
+- (void)addStreams:(NSArray<ZGStandInStream *> *)streams toRoom:(ZGStandInRoom *)room {
+    NSMutableArray<ZegoStream *> *streamList = [NSMutableArray arrayWithCapacity:streams.count];
+    for (ZGStandInStream *stream in streams) {
+        stream.playerEngineIDs = [NSMutableSet set];
+        room.streams[stream.stream.streamID] = stream;
+        [streamList addObject:stream.stream];
+    }
+    NSString *exceptEngineID = streams.count == 1 ? streams.firstObject.publisherEngineID : nil;
+    [self notifyRoom:room streamsUpdated:streamList updateType:ZegoUpdateTypeAdd exceptEngineID:exceptEngineID];
+
+    // Players that asked for these streams before they were published
+    for (NSString *engineID in room.engineIDs) {
+        ZGStandInSession *session = self.sessions[engineID];
+        for (ZGStandInStream *stream in streams) {
+            ZGStandInPlay *play = session.plays[stream.stream.streamID];
+            if (play) {
+                [self activatePlay:play ofSession:session];
+            }
+        }
+    }
+}
+
+- (void)removeStreams:(NSArray<ZGStandInStream *> *)streams fromRoom:(ZGStandInRoom *)room {
+    if (streams.count == 0) {
+        return;
+    }
+    NSMutableArray<ZegoStream *> *streamList = [NSMutableArray arrayWithCapacity:streams.count];
+    for (ZGStandInStream *stream in streams) {
+        NSString *streamID = stream.stream.streamID;
+        [room.streams removeObjectForKey:streamID];
+        [streamList addObject:stream.stream];
+
+        // Like the SDK, players keep retrying until the stream comes back or they stop
+        for (NSString *playerEngineID in stream.playerEngineIDs) {
+            ZGStandInSession *player = self.sessions[playerEngineID];
+            ZGStandInPlay *play = player.plays[streamID];
+            if (play.playing) {
+                play.playing = NO;
+                [self deliverPlayerState:ZegoPlayerStatePlayRequesting errorCode:0 streamID:streamID toEngine:player.engine delay:0];
+            }
+        }
+        [stream.playerEngineIDs removeAllObjects];
+    }
+    NSString *exceptEngineID = streams.count == 1 ? streams.firstObject.publisherEngineID : nil;
+    [self notifyRoom:room streamsUpdated:streamList updateType:ZegoUpdateTypeDelete exceptEngineID:exceptEngineID];
+}
+
+- (void)notifyRoom:(ZGStandInRoom *)room usersAdded:(NSArray<ZegoUser *> *)users exceptEngineID:(NSString *)exceptEngineID {
+    [self notifyRoom:room users:users updateType:ZegoUpdateTypeAdd exceptEngineID:exceptEngineID];
+}
+
+- (void)notifyRoom:(ZGStandInRoom *)room usersDeleted:(NSArray<ZegoUser *> *)users exceptEngineID:(NSString *)exceptEngineID {
+    [self notifyRoom:room users:users updateType:ZegoUpdateTypeDelete exceptEngineID:exceptEngineID];
+}
+
+- (void)notifyRoom:(ZGStandInRoom *)room users:(NSArray<ZegoUser *> *)users updateType:(ZegoUpdateType)updateType exceptEngineID:(NSString *)exceptEngineID {
+    NSString *roomID = room.roomID;
+    NSTimeInterval latency = self.signalingLatencyMs / 1000.0;
+    for (NSString *engineID in room.engineIDs) {
+        ZGStandInSession *session = self.sessions[engineID];
+        if (!session.isUserStatusNotify || [engineID isEqualToString:exceptEngineID]) {
+            continue;
+        }
+        [session.engine deliverEvent:^(id<ZegoEventHandler> handler) {
+            if ([handler respondsToSelector:@selector(onRoomUserUpdate:userList:roomID:)]) {
+                [handler onRoomUserUpdate:updateType userList:users roomID:roomID];
+            }
+        } afterDelay:latency];
+    }
+}
+
+- (void)notifyRoom:(ZGStandInRoom *)room streamsUpdated:(NSArray<ZegoStream *> *)streams updateType:(ZegoUpdateType)updateType exceptEngineID:(NSString *)exceptEngineID {
+    NSString *roomID = room.roomID;
+    [self deliverToRoom:room exceptEngineID:exceptEngineID event:^(id<ZegoEventHandler> handler) {
+        if ([handler respondsToSelector:@selector(onRoomStreamUpdate:streamList:roomID:)]) {
+            [handler onRoomStreamUpdate:updateType streamList:streams roomID:roomID];
+        }
+    }];
+}
+
+- (void)notifyRoom:(ZGStandInRoom *)room extraInfoUpdated:(NSArray<ZegoStream *> *)streams exceptEngineID:(NSString *)exceptEngineID {
+    NSString *roomID = room.roomID;
+    [self deliverToRoom:room exceptEngineID:exceptEngineID event:^(id<ZegoEventHandler> handler) {
+        if ([handler respondsToSelector:@selector(onRoomStreamExtraInfoUpdate:roomID:)]) {
+            [handler onRoomStreamExtraInfoUpdate:streams roomID:roomID];
+        }
+    }];
+}
+
+- (void)deliverToRoom:(ZGStandInRoom *)room exceptEngineID:(NSString *)exceptEngineID event:(void (^)(id<ZegoEventHandler> handler))event {
+    NSTimeInterval latency = self.signalingLatencyMs / 1000.0;
+    for (NSString *engineID in room.engineIDs) {
+        if ([engineID isEqualToString:exceptEngineID]) {
+            continue;
+        }
+        [self.sessions[engineID].engine deliverEvent:event afterDelay:latency];
+    }
+}
+
+#pragma mark - Delivery helpers
+
+- (void)deliverRoomState:(ZegoRoomState)state errorCode:(int)errorCode roomID:(NSString *)roomID toEngine:(ZGStandInEngine *)engine delay:(NSTimeInterval)delay {
+    [engine deliverEvent:^(id<ZegoEventHandler> handler) {
+        if ([handler respondsToSelector:@selector(onRoomStateUpdate:errorCode:extendedData:roomID:)]) {
+            [handler onRoomStateUpdate:state errorCode:errorCode extendedData:@{} roomID:roomID];
+        }
+    } afterDelay:delay];
+}
+
+- (void)deliverPublisherState:(ZegoPublisherState)state errorCode:(int)errorCode streamID:(NSString *)streamID toEngine:(ZGStandInEngine *)engine delay:(NSTimeInterval)delay {
+    [engine deliverEvent:^(id<ZegoEventHandler> handler) {
+        if ([handler respondsToSelector:@selector(onPublisherStateUpdate:errorCode:extendedData:streamID:)]) {
+            [handler onPublisherStateUpdate:state errorCode:errorCode extendedData:@{} streamID:streamID];
+        }
+    } afterDelay:delay];
+}
+
+- (void)deliverPlayerState:(ZegoPlayerState)state errorCode:(int)errorCode streamID:(NSString *)streamID toEngine:(ZGStandInEngine *)engine delay:(NSTimeInterval)delay {
+    [engine deliverEvent:^(id<ZegoEventHandler> handler) {
+        if ([handler respondsToSelector:@selector(onPlayerStateUpdate:errorCode:extendedData:streamID:)]) {
+            [handler onPlayerStateUpdate:state errorCode:errorCode extendedData:@{} streamID:streamID];
+        }
+    } afterDelay:delay];
+}
+
+- (NSTimeInterval)randomLatencyMinMs:(double)minMs maxMs:(double)maxMs {
+    double span = MAX(0, maxMs - minMs);
+    double ms = minMs + span * (arc4random_uniform(UINT32_MAX) / (double)UINT32_MAX);
+    return ms / 1000.0;
+}
+
+@end
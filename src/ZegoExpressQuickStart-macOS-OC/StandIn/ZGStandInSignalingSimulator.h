@@ -0,0 +1,101 @@
+//
+//  ZGStandInSignalingSimulator.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ZGStandInRoomService;
+
+/// Traffic model of the signaling simulator
+///
+/// Arrivals are Poisson processes modulated by a two-state (calm / burst) Markov chain, departures follow
+/// exponential lifetimes. Rates are per second of the calm state; during a burst every rate is multiplied
+/// by `burstRateMultiplier`.
+@interface ZGSignalingSimulatorConfig : NSObject
+
+/// Seed of the random generator, the same seed replays the same traffic
+@property (nonatomic, assign) uint64_t seed;
+
+/// Population the user arrivals grow the room to, e.g. 10000
+@property (nonatomic, assign) NSUInteger targetUserCount;
+@property (nonatomic, assign) double userArrivalsPerSecond;
+/// Mean time a synthetic user stays, 0 keeps users forever
+@property (nonatomic, assign) NSTimeInterval meanUserLifetimeSeconds;
+
+/// Number of streams published by synthetic users, e.g. 500
+@property (nonatomic, assign) NSUInteger targetStreamCount;
+@property (nonatomic, assign) double streamArrivalsPerSecond;
+/// Mean time a synthetic stream stays, 0 keeps streams until their user leaves
+@property (nonatomic, assign) NSTimeInterval meanStreamLifetimeSeconds;
+
+/// Stream extra info updates per second over all synthetic streams
+@property (nonatomic, assign) double extraInfoUpdatesPerSecond;
+
+/// IM traffic per second
+@property (nonatomic, assign) double broadcastMessagesPerSecond;
+@property (nonatomic, assign) double barrageMessagesPerSecond;
+@property (nonatomic, assign) double customCommandsPerSecond;
+
+/// Burstiness, 1 disables bursts
+@property (nonatomic, assign) double burstRateMultiplier;
+@property (nonatomic, assign) NSTimeInterval meanBurstSeconds;
+@property (nonatomic, assign) NSTimeInterval meanCalmSeconds;
+
+/// Updates produced within one window are delivered as one callback, like the server does, default 100 ms
+@property (nonatomic, assign) double batchWindowMs;
+
+/// Read the config from a dictionary with the same keys as the properties
++ (instancetype)configWithDictionary:(NSDictionary *)dictionary;
+
+@end
+
+
+/// Counters of the generated traffic
+@interface ZGSignalingSimulatorStatistics : NSObject
+
+@property (nonatomic, assign) NSUInteger usersAdded;
+@property (nonatomic, assign) NSUInteger usersDeleted;
+@property (nonatomic, assign) NSUInteger streamsAdded;
+@property (nonatomic, assign) NSUInteger streamsDeleted;
+@property (nonatomic, assign) NSUInteger extraInfoUpdates;
+@property (nonatomic, assign) NSUInteger broadcastMessages;
+@property (nonatomic, assign) NSUInteger barrageMessages;
+@property (nonatomic, assign) NSUInteger customCommands;
+/// Number of callbacks the events were batched into
+@property (nonatomic, assign) NSUInteger batches;
+@property (nonatomic, assign) NSUInteger currentUsers;
+@property (nonatomic, assign) NSUInteger currentStreams;
+
+@end
+
+
+/// Generates realistic room traffic into a ZGStandInRoomService
+///
+/// Synthetic users and streams have no engine behind them, so a room can be scaled to tens of thousands of
+/// members while only the engines under test pay for callbacks. Every engine logged in to the room receives
+/// the resulting onRoomUserUpdate, onRoomStreamUpdate, onRoomStreamExtraInfoUpdate and IM callbacks.
+@interface ZGStandInSignalingSimulator : NSObject
+
+- (instancetype)initWithRoomService:(ZGStandInRoomService *)roomService roomID:(NSString *)roomID config:(ZGSignalingSimulatorConfig *)config;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, strong, readonly) ZGSignalingSimulatorConfig *config;
+
+- (void)start;
+
+/// Stop generating traffic, the synthetic members stay in the room unless `removeMembers` is YES
+- (void)stopRemovingMembers:(BOOL)removeMembers;
+
+/// Snapshot of the counters
+- (ZGSignalingSimulatorStatistics *)statistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,416 @@
+//
+//  ZGStandInSignalingSimulator.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGStandInSignalingSimulator.h"
+#import "ZGStandInRoomService.h"
+#import "ZGStandInRandom.h"
+
+/// Simulation step, every rate is integrated over this fixed step so a seed always replays the same traffic
+static const double ZGSignalingSimulatorTickSeconds = 0.01;
+
+@implementation ZGSignalingSimulatorConfig
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _seed = 1;
+        _burstRateMultiplier = 1;
+        _batchWindowMs = 100;
+    }
+    return self;
+}
+
++ (instancetype)configWithDictionary:(NSDictionary *)dictionary {
+    ZGSignalingSimulatorConfig *config = [[ZGSignalingSimulatorConfig alloc] init];
+    NSNumber * (^number)(NSString *) = ^NSNumber *(NSString *key) {
+        id value = dictionary[key];
+        return [value isKindOfClass:[NSNumber class]] ? value : nil;
+    };
+    if (number(@"seed")) config.seed = number(@"seed").unsignedLongLongValue;
+    config.targetUserCount = number(@"targetUserCount").unsignedIntegerValue;
+    config.userArrivalsPerSecond = number(@"userArrivalsPerSecond").doubleValue;
+    config.meanUserLifetimeSeconds = number(@"meanUserLifetimeSeconds").doubleValue;
+    config.targetStreamCount = number(@"targetStreamCount").unsignedIntegerValue;
+    config.streamArrivalsPerSecond = number(@"streamArrivalsPerSecond").doubleValue;
+    config.meanStreamLifetimeSeconds = number(@"meanStreamLifetimeSeconds").doubleValue;
+    config.extraInfoUpdatesPerSecond = number(@"extraInfoUpdatesPerSecond").doubleValue;
+    config.broadcastMessagesPerSecond = number(@"broadcastMessagesPerSecond").doubleValue;
+    config.barrageMessagesPerSecond = number(@"barrageMessagesPerSecond").doubleValue;
+    config.customCommandsPerSecond = number(@"customCommandsPerSecond").doubleValue;
+    if (number(@"burstRateMultiplier")) config.burstRateMultiplier = number(@"burstRateMultiplier").doubleValue;
+    config.meanBurstSeconds = number(@"meanBurstSeconds").doubleValue;
+    config.meanCalmSeconds = number(@"meanCalmSeconds").doubleValue;
+    if (number(@"batchWindowMs")) config.batchWindowMs = number(@"batchWindowMs").doubleValue;
+    return config;
+}
+
+@end
+
+@implementation ZGSignalingSimulatorStatistics
+
+@end
+
+@interface ZGStandInSignalingSimulator ()
+
+@property (nonatomic, strong) ZGStandInRoomService *roomService;
+@property (nonatomic, copy) NSString *roomID;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) dispatch_source_t timer;
+@property (nonatomic, strong) ZGSignalingSimulatorStatistics *counters;
+
+// Population, arrays allow O(1) random picks and swap-removal
+@property (nonatomic, strong) NSMutableArray<ZegoUser *> *users;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *userIndexes;
+@property (nonatomic, strong) NSMutableArray<ZegoStream *> *streams;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *streamIndexes;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZegoStream *> *streamByUserID;
+
+// Updates of the current batch window
+@property (nonatomic, strong) NSMutableArray<ZegoUser *> *pendingUserAdds;
+@property (nonatomic, strong) NSMutableArray<ZegoUser *> *pendingUserDeletes;
+@property (nonatomic, strong) NSMutableArray<ZegoStream *> *pendingStreamAdds;
+@property (nonatomic, strong) NSMutableArray<NSString *> *pendingStreamDeletes;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSString *> *pendingExtraInfos;
+@property (nonatomic, strong) NSMutableArray<ZegoBroadcastMessageInfo *> *pendingBroadcasts;
+@property (nonatomic, strong) NSMutableArray<ZegoBarrageMessageInfo *> *pendingBarrages;
+
+@property (nonatomic, assign) double simulatedTime;
+@property (nonatomic, assign) double lastFlushTime;
+@property (nonatomic, assign) BOOL inBurst;
+@property (nonatomic, assign) double nextBurstSwitchTime;
+@property (nonatomic, assign) unsigned long long nextSerial;
+
+@end
+
+@implementation ZGStandInSignalingSimulator {
+    ZGStandInRandom _random;
+}
+
+- (instancetype)initWithRoomService:(ZGStandInRoomService *)roomService roomID:(NSString *)roomID config:(ZGSignalingSimulatorConfig *)config {
+    self = [super init];
+    if (self) {
+        _roomService = roomService;
+        _roomID = [roomID copy];
+        _config = config;
+        _random = ZGStandInRandomMake(config.seed);
+        _queue = dispatch_queue_create("im.zego.standin.signaling", DISPATCH_QUEUE_SERIAL);
+        _counters = [[ZGSignalingSimulatorStatistics alloc] init];
+        _users = [NSMutableArray array];
+        _userIndexes = [NSMutableDictionary dictionary];
+        _streams = [NSMutableArray array];
+        _streamIndexes = [NSMutableDictionary dictionary];
+        _streamByUserID = [NSMutableDictionary dictionary];
+        _pendingUserAdds = [NSMutableArray array];
+        _pendingUserDeletes = [NSMutableArray array];
+        _pendingStreamAdds = [NSMutableArray array];
+        _pendingStreamDeletes = [NSMutableArray array];
+        _pendingExtraInfos = [NSMutableDictionary dictionary];
+        _pendingBroadcasts = [NSMutableArray array];
+        _pendingBarrages = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_timer) {
+        dispatch_source_cancel(_timer);
+    }
+}
+
+#pragma mark - Lifecycle
+
+- (void)start {
+    if (self.timer) {
+        return;
+    }
+    __weak typeof(self) weakSelf = self;
+    uint64_t interval = (uint64_t)(ZGSignalingSimulatorTickSeconds * NSEC_PER_SEC);
+    self.timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.queue);
+    dispatch_source_set_timer(self.timer, dispatch_time(DISPATCH_TIME_NOW, 0), interval, interval / 10);
+    dispatch_source_set_event_handler(self.timer, ^{
+        [weakSelf tick];
+    });
+    dispatch_async(self.queue, ^{
+        self.nextBurstSwitchTime = [self calmDuration];
+    });
+    dispatch_resume(self.timer);
+}
+
+- (void)stopRemovingMembers:(BOOL)removeMembers {
+    if (self.timer) {
+        dispatch_source_cancel(self.timer);
+        self.timer = nil;
+    }
+    dispatch_async(self.queue, ^{
+        if (removeMembers) {
+            while (self.users.count > 0) {
+                [self removeUser:self.users.lastObject];
+            }
+        }
+        [self flush];
+    });
+}
+
+- (ZGSignalingSimulatorStatistics *)statistics {
+    ZGSignalingSimulatorStatistics *snapshot = [[ZGSignalingSimulatorStatistics alloc] init];
+    dispatch_sync(self.queue, ^{
+        ZGSignalingSimulatorStatistics *counters = self.counters;
+        snapshot.usersAdded = counters.usersAdded;
+        snapshot.usersDeleted = counters.usersDeleted;
+        snapshot.streamsAdded = counters.streamsAdded;
+        snapshot.streamsDeleted = counters.streamsDeleted;
+        snapshot.extraInfoUpdates = counters.extraInfoUpdates;
+        snapshot.broadcastMessages = counters.broadcastMessages;
+        snapshot.barrageMessages = counters.barrageMessages;
+        snapshot.customCommands = counters.customCommands;
+        snapshot.batches = counters.batches;
+        snapshot.currentUsers = self.users.count;
+        snapshot.currentStreams = self.streams.count;
+    });
+    return snapshot;
+}
+
+#pragma mark - Simulation
+
+- (void)tick {
+    ZGSignalingSimulatorConfig *config = self.config;
+    double dt = ZGSignalingSimulatorTickSeconds;
+    self.simulatedTime += dt;
+    [self updateBurstState];
+    double multiplier = self.inBurst ? config.burstRateMultiplier : 1.0;
+
+    // Users
+    if (self.users.count < config.targetUserCount) {
+        uint64_t arrivals = MIN(ZGStandInRandomPoisson(&_random, config.userArrivalsPerSecond * multiplier * dt), config.targetUserCount - self.users.count);
+        for (uint64_t i = 0; i < arrivals; i++) {
+            [self addUser];
+        }
+    }
+    if (config.meanUserLifetimeSeconds > 0 && self.users.count > 0) {
+        uint64_t departures = MIN(ZGStandInRandomPoisson(&_random, self.users.count * dt / config.meanUserLifetimeSeconds), self.users.count);
+        for (uint64_t i = 0; i < departures; i++) {
+            [self removeUser:self.users[ZGStandInRandomBelow(&_random, self.users.count)]];
+        }
+    }
+
+    // Streams
+    if (self.streams.count < config.targetStreamCount && self.streamByUserID.count < self.users.count) {
+        uint64_t arrivals = MIN(ZGStandInRandomPoisson(&_random, config.streamArrivalsPerSecond * multiplier * dt), config.targetStreamCount - self.streams.count);
+        for (uint64_t i = 0; i < arrivals; i++) {
+            [self addStream];
+        }
+    }
+    if (config.meanStreamLifetimeSeconds > 0 && self.streams.count > 0) {
+        uint64_t departures = MIN(ZGStandInRandomPoisson(&_random, self.streams.count * dt / config.meanStreamLifetimeSeconds), self.streams.count);
+        for (uint64_t i = 0; i < departures; i++) {
+            [self removeStream:self.streams[ZGStandInRandomBelow(&_random, self.streams.count)]];
+        }
+    }
+
+    // Extra info and IM
+    if (self.streams.count > 0) {
+        uint64_t updates = ZGStandInRandomPoisson(&_random, config.extraInfoUpdatesPerSecond * multiplier * dt);
+        for (uint64_t i = 0; i < updates; i++) {
+            ZegoStream *stream = self.streams[ZGStandInRandomBelow(&_random, self.streams.count)];
+            [self updateExtraInfoOfStream:stream];
+        }
+    }
+    if (self.users.count > 0) {
+        uint64_t broadcasts = ZGStandInRandomPoisson(&_random, config.broadcastMessagesPerSecond * multiplier * dt);
+        for (uint64_t i = 0; i < broadcasts; i++) {
+            ZegoBroadcastMessageInfo *message = [[ZegoBroadcastMessageInfo alloc] init];
+            message.message = [NSString stringWithFormat:@"broadcast %llu", self.nextSerial++];
+            message.sendTime = [self sendTime];
+            message.fromUser = [self randomUser];
+            [self.pendingBroadcasts addObject:message];
+        }
+        uint64_t barrages = ZGStandInRandomPoisson(&_random, config.barrageMessagesPerSecond * multiplier * dt);
+        for (uint64_t i = 0; i < barrages; i++) {
+            ZegoBarrageMessageInfo *message = [[ZegoBarrageMessageInfo alloc] init];
+            message.message = [NSString stringWithFormat:@"barrage %llu", self.nextSerial++];
+            message.sendTime = [self sendTime];
+            message.fromUser = [self randomUser];
+            [self.pendingBarrages addObject:message];
+        }
+        // Custom commands are delivered one callback each, no batching
+        uint64_t commands = ZGStandInRandomPoisson(&_random, config.customCommandsPerSecond * multiplier * dt);
+        for (uint64_t i = 0; i < commands; i++) {
+            NSString *command = [NSString stringWithFormat:@"{\"cmd\":\"sim\",\"seq\":%llu}", self.nextSerial++];
+            [self.roomService sendSyntheticCustomCommand:command fromUser:[self randomUser] toRoom:self.roomID];
+            self.counters.customCommands += 1;
+            self.counters.batches += 1;
+        }
+    }
+
+    if ((self.simulatedTime - self.lastFlushTime) * 1000.0 >= config.batchWindowMs) {
+        [self flush];
+    }
+}
+
+- (void)updateBurstState {
+    ZGSignalingSimulatorConfig *config = self.config;
+    if (config.burstRateMultiplier == 1.0 || config.meanBurstSeconds <= 0) {
+        return;
+    }
+    if (self.simulatedTime < self.nextBurstSwitchTime) {
+        return;
+    }
+    self.inBurst = !self.inBurst;
+    double duration = self.inBurst ? ZGStandInRandomExponential(&_random, config.meanBurstSeconds) : [self calmDuration];
+    self.nextBurstSwitchTime = self.simulatedTime + duration;
+}
+
+- (double)calmDuration {
+    double mean = self.config.meanCalmSeconds > 0 ? self.config.meanCalmSeconds : 10;
+    return ZGStandInRandomExponential(&_random, mean);
+}
+
+#pragma mark - Population
+
+- (void)addUser {
+    NSString *userID = [NSString stringWithFormat:@"sim-%llu", self.nextSerial++];
+    ZegoUser *user = [ZegoUser userWithUserID:userID];
+    self.userIndexes[userID] = @(self.users.count);
+    [self.users addObject:user];
+    [self.pendingUserAdds addObject:user];
+    self.counters.usersAdded += 1;
+}
+
+- (void)removeUser:(ZegoUser *)user {
+    ZegoStream *stream = self.streamByUserID[user.userID];
+    if (stream) {
+        [self removeStream:stream];
+    }
+    [self swapRemove:user.userID from:self.users indexes:self.userIndexes keyBlock:^NSString *(id object) {
+        return ((ZegoUser *)object).userID;
+    }];
+    // Added and removed within one window: the room never hears about it
+    NSUInteger pending = [self.pendingUserAdds indexOfObjectIdenticalTo:user];
+    if (pending != NSNotFound) {
+        [self.pendingUserAdds removeObjectAtIndex:pending];
+    } else {
+        [self.pendingUserDeletes addObject:user];
+    }
+    self.counters.usersDeleted += 1;
+}
+
+- (void)addStream {
+    // A few attempts to find a user that is not publishing yet
+    for (int attempt = 0; attempt < 8; attempt++) {
+        ZegoUser *user = [self randomUser];
+        if (self.streamByUserID[user.userID]) {
+            continue;
+        }
+        ZegoStream *stream = [[ZegoStream alloc] init];
+        stream.user = user;
+        stream.streamID = [NSString stringWithFormat:@"sim-stream-%llu", self.nextSerial++];
+        stream.extraInfo = @"";
+        self.streamIndexes[stream.streamID] = @(self.streams.count);
+        [self.streams addObject:stream];
+        self.streamByUserID[user.userID] = stream;
+        [self.pendingStreamAdds addObject:stream];
+        self.counters.streamsAdded += 1;
+        return;
+    }
+}
+
+- (void)removeStream:(ZegoStream *)stream {
+    [self swapRemove:stream.streamID from:self.streams indexes:self.streamIndexes keyBlock:^NSString *(id object) {
+        return ((ZegoStream *)object).streamID;
+    }];
+    [self.streamByUserID removeObjectForKey:stream.user.userID];
+    [self.pendingExtraInfos removeObjectForKey:stream.streamID];
+    NSUInteger pending = [self.pendingStreamAdds indexOfObjectIdenticalTo:stream];
+    if (pending != NSNotFound) {
+        [self.pendingStreamAdds removeObjectAtIndex:pending];
+    } else {
+        [self.pendingStreamDeletes addObject:stream.streamID];
+    }
+    self.counters.streamsDeleted += 1;
+}
+
+- (void)updateExtraInfoOfStream:(ZegoStream *)stream {
+    NSString *extraInfo = [NSString stringWithFormat:@"{\"seq\":%llu,\"t\":%llu}", self.nextSerial++, [self sendTime]];
+    if ([self.pendingStreamAdds indexOfObjectIdenticalTo:stream] != NSNotFound) {
+        // Not handed to the room yet, the add carries the latest extra info
+        stream.extraInfo = extraInfo;
+    } else {
+        self.pendingExtraInfos[stream.streamID] = extraInfo;
+    }
+    self.counters.extraInfoUpdates += 1;
+}
+
+- (void)swapRemove:(NSString *)key from:(NSMutableArray *)array indexes:(NSMutableDictionary<NSString *, NSNumber *> *)indexes keyBlock:(NSString * (^)(id object))keyBlock {
+    NSNumber *index = indexes[key];
+    if (!index) {
+        return;
+    }
+    NSUInteger position = index.unsignedIntegerValue;
+    id last = array.lastObject;
+    array[position] = last;
+    indexes[keyBlock(last)] = @(position);
+    [array removeLastObject];
+    [indexes removeObjectForKey:key];
+}
+
+- (ZegoUser *)randomUser {
+    return self.users[ZGStandInRandomBelow(&_random, self.users.count)];
+}
+
+- (unsigned long long)sendTime {
+    return (unsigned long long)([[NSDate date] timeIntervalSince1970] * 1000);
+}
+
+#pragma mark - Batching
+
+- (void)flush {
+    self.lastFlushTime = self.simulatedTime;
+    ZGStandInRoomService *service = self.roomService;
+    NSString *roomID = self.roomID;
+
+    // Ordered so that a stream never refers to a user the room has not seen
+    if (self.pendingUserAdds.count > 0) {
+        [service addSyntheticUsers:[self.pendingUserAdds copy] toRoom:roomID];
+        [self.pendingUserAdds removeAllObjects];
+        self.counters.batches += 1;
+    }
+    if (self.pendingStreamAdds.count > 0) {
+        [service addSyntheticStreams:[self.pendingStreamAdds copy] toRoom:roomID];
+        [self.pendingStreamAdds removeAllObjects];
+        self.counters.batches += 1;
+    }
+    if (self.pendingExtraInfos.count > 0) {
+        [service updateSyntheticStreamExtraInfo:[self.pendingExtraInfos copy] inRoom:roomID];
+        [self.pendingExtraInfos removeAllObjects];
+        self.counters.batches += 1;
+    }
+    if (self.pendingStreamDeletes.count > 0) {
+        [service removeSyntheticStreams:[self.pendingStreamDeletes copy] fromRoom:roomID];
+        [self.pendingStreamDeletes removeAllObjects];
+        self.counters.batches += 1;
+    }
+    if (self.pendingUserDeletes.count > 0) {
+        [service removeSyntheticUsers:[self.pendingUserDeletes copy] fromRoom:roomID];
+        [self.pendingUserDeletes removeAllObjects];
+        self.counters.batches += 1;
+    }
+    if (self.pendingBroadcasts.count > 0) {
+        self.counters.broadcastMessages += self.pendingBroadcasts.count;
+        [service sendSyntheticBroadcastMessages:[self.pendingBroadcasts copy] toRoom:roomID];
+        [self.pendingBroadcasts removeAllObjects];
+        self.counters.batches += 1;
+    }
+    if (self.pendingBarrages.count > 0) {
+        self.counters.barrageMessages += self.pendingBarrages.count;
+        [service sendSyntheticBarrageMessages:[self.pendingBarrages copy] toRoom:roomID];
+        [self.pendingBarrages removeAllObjects];
+        self.counters.batches += 1;
+    }
+}
+
+@end
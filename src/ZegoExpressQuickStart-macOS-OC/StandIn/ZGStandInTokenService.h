@@ -0,0 +1,47 @@
+//
+//  ZGStandInTokenService.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ZGRoomTokenManager.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+FOUNDATION_EXPORT NSString * const ZGStandInTokenErrorDomain;
+
+typedef NS_ENUM(NSInteger, ZGStandInTokenErrorCode) {
+    /// A failure injected by `failureRate`
+    ZGStandInTokenErrorCodeUnavailable = 1
+};
+
+/// In-process stand-in for the business server that issues room tokens
+///
+/// Issues tokens after a random latency, fails a seeded share of the requests, and remembers what it issued so
+/// the stand-in room service can reject a login with a missing, foreign or expired token.
+@interface ZGStandInTokenService : NSObject <ZGRoomTokenProvider>
+
+- (instancetype)initWithSeed:(uint64_t)seed;
+
+/// Request latency range in milliseconds, default 50 ~ 300
+@property (nonatomic, assign) double latencyMinMs;
+@property (nonatomic, assign) double latencyMaxMs;
+
+/// Share of requests that fail, 0.0 ~ 1.0, default 0
+@property (nonatomic, assign) double failureRate;
+
+/// Validity of issued tokens, default 600 s
+@property (nonatomic, assign) NSTimeInterval tokenLifetime;
+
+/// Tokens issued so far
+@property (nonatomic, assign, readonly) NSUInteger issuedCount;
+
+/// Whether the token was issued for this room and user and has not expired
+- (BOOL)isValidToken:(nullable NSString *)token roomID:(NSString *)roomID userID:(NSString *)userID;
+
+@end
+
+NS_ASSUME_NONNULL_END
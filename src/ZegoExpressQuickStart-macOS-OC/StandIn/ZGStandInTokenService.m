@@ -0,0 +1,91 @@
+//
+//  ZGStandInTokenService.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGStandInTokenService.h"
+#import "ZGStandInRandom.h"
+#import "ZGClock.h"
+
+NSString * const ZGStandInTokenErrorDomain = @"im.zego.standin.token";
+
+/// What a token was issued for
+@interface ZGStandInIssuedToken : NSObject
+
+@property (nonatomic, copy) NSString *roomID;
+@property (nonatomic, copy) NSString *userID;
+@property (nonatomic, assign) double expiryTime;
+
+@end
+
+@implementation ZGStandInIssuedToken
+
+@end
+
+@interface ZGStandInTokenService ()
+
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, assign) ZGStandInRandom random;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZGStandInIssuedToken *> *issuedTokens;
+@property (nonatomic, assign, readwrite) NSUInteger issuedCount;
+
+@end
+
+@implementation ZGStandInTokenService
+
+- (instancetype)initWithSeed:(uint64_t)seed {
+    self = [super init];
+    if (self) {
+        _latencyMinMs = 50;
+        _latencyMaxMs = 300;
+        _tokenLifetime = 600;
+        _random = ZGStandInRandomMake(seed);
+        _queue = dispatch_queue_create("im.zego.standin.token", DISPATCH_QUEUE_SERIAL);
+        _issuedTokens = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (ZGFuture<ZGRoomToken *> *)fetchTokenForRoomID:(NSString *)roomID userID:(NSString *)userID {
+    ZGFuture<ZGRoomToken *> *future = [ZGFuture future];
+    dispatch_async(self.queue, ^{
+        ZGStandInRandom random = self.random;
+        double latencyMs = self.latencyMinMs + ZGStandInRandomUniform(&random) * MAX(0, self.latencyMaxMs - self.latencyMinMs);
+        BOOL fails = ZGStandInRandomUniform(&random) < self.failureRate;
+        uint64_t serial = ZGStandInRandomNextUInt64(&random);
+        self.random = random;
+
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(latencyMs / 1000.0 * NSEC_PER_SEC)), self.queue, ^{
+            if (fails) {
+                [future rejectWithError:[NSError errorWithDomain:ZGStandInTokenErrorDomain code:ZGStandInTokenErrorCodeUnavailable userInfo:@{NSLocalizedDescriptionKey: @"Token service unavailable"}]];
+                return;
+            }
+            NSString *token = [NSString stringWithFormat:@"standin-%016llx", serial];
+            ZGStandInIssuedToken *issued = [[ZGStandInIssuedToken alloc] init];
+            issued.roomID = roomID;
+            issued.userID = userID;
+            issued.expiryTime = ZGClockNow() + self.tokenLifetime;
+            self.issuedTokens[token] = issued;
+            self.issuedCount += 1;
+            [future fulfillWithValue:[ZGRoomToken tokenWithString:token expiresIn:self.tokenLifetime]];
+        });
+    });
+    return future;
+}
+
+- (BOOL)isValidToken:(NSString *)token roomID:(NSString *)roomID userID:(NSString *)userID {
+    if (token.length == 0) {
+        return NO;
+    }
+    __block BOOL valid = NO;
+    dispatch_sync(self.queue, ^{
+        ZGStandInIssuedToken *issued = self.issuedTokens[token];
+        valid = issued && [issued.roomID isEqualToString:roomID] && [issued.userID isEqualToString:userID] && issued.expiryTime > ZGClockNow();
+    });
+    return valid;
+}
+
+@end
@@ -0,0 +1,75 @@
+//
+//  ZGBackgroundBlur.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <Accelerate/Accelerate.h>
+#import <CoreVideo/CoreVideo.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// A person segmentation model the blur can run
+@protocol ZGSegmentationModel <NSObject>
+
+/// The BGRA32 input the model takes, also the size of the mask it writes
+@property (nonatomic, assign, readonly) CGSize inputSize;
+
+/// Write one byte per input pixel, 255 for person and 0 for background
+///
+/// @param input BGRA32 of exactly `inputSize`
+- (BOOL)predictPersonMask:(uint8_t *)mask fromBGRA:(const vImage_Buffer *)input;
+
+@end
+
+@interface ZGBackgroundBlurStatistics : NSObject
+
+@property (nonatomic, assign) NSUInteger frames;
+@property (nonatomic, assign) NSUInteger segmentations;
+/// Smoothed cost of a frame, segmentation amortised over the interval
+@property (nonatomic, assign) double averageMs;
+@property (nonatomic, assign) NSUInteger overBudgetFrames;
+/// Frames per segmentation at the moment
+@property (nonatomic, assign) NSUInteger segmentationInterval;
+
+@end
+
+/// Blurs the background of BGRA32 custom capture frames on the CPU, keeping the person sharp
+///
+/// The model runs on the frame stretched to its input size, and its mask is smoothed over time so the edge does
+/// not flicker. The background is blurred at a quarter of the frame size, two box passes approximating a
+/// gaussian, and scaled back up; the mask is upsampled bilinearly, once per segmentation, which softens its
+/// edge, and picks per pixel between the sharp frame and the blurred one.
+///
+/// To stay within `budgetMs` per frame on one core, segmentation is run every few frames when needed, up to
+/// `maxSegmentationInterval`; the mask in between is the last one. Call from one thread at a time, usually
+/// the capture thread.
+@interface ZGBackgroundBlur : NSObject
+
+- (instancetype)initWithModel:(id<ZGSegmentationModel>)model;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Box radius at quarter resolution, default 6
+@property (nonatomic, assign) NSUInteger blurRadius;
+
+/// Weight of a new mask against the smoothed one, 0 ~ 1, default 0.6
+@property (nonatomic, assign) double maskSmoothing;
+
+/// Default 12, a 720p frame at 30 fps on one core with room to spare
+@property (nonatomic, assign) double budgetMs;
+
+/// Default 4
+@property (nonatomic, assign) NSUInteger maxSegmentationInterval;
+
+/// A blurred copy of `source`, from a pool; NULL if `source` is not BGRA32 or memory ran out
+- (nullable CVPixelBufferRef)createBlurredFrom:(CVPixelBufferRef)source CF_RETURNS_RETAINED;
+
+- (ZGBackgroundBlurStatistics *)statistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
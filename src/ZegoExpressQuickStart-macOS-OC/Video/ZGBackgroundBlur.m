@@ -0,0 +1,287 @@
+//
+//  ZGBackgroundBlur.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGBackgroundBlur.h"
+#import <pthread.h>
+#import "ZGMemoryAccountant.h"
+#import "ZGPixelKernels.h"
+#import "ZGClock.h"
+
+/// Output buffers in the pool, enough for the encoder to hold a couple
+static const int ZGBackgroundBlurPoolSize = 3;
+
+/// Weight of a new sample in the cost averages
+static const double ZGBackgroundBlurCostSmoothing = 0.1;
+
+/// A shorter segmentation interval must fit in this share of the budget, so the interval does not flap
+static const double ZGBackgroundBlurHeadroom = 0.85;
+
+@implementation ZGBackgroundBlurStatistics
+
+@end
+
+@interface ZGBackgroundBlur () {
+    pthread_mutex_t _statisticsLock;
+    vImage_Buffer _modelInput;
+    vImage_Buffer _smallFrame;
+    vImage_Buffer _smallBlurred;
+}
+
+@property (nonatomic, strong) id<ZGSegmentationModel> model;
+
+// Only touched by the calling thread
+@property (nonatomic, assign) size_t width;
+@property (nonatomic, assign) size_t height;
+@property (nonatomic, strong, nullable) id pool;
+@property (nonatomic, strong) NSMutableData *mask;
+@property (nonatomic, strong) NSMutableData *smoothedMask;
+/// The smoothed mask upsampled to the frame, all person until the first segmentation
+@property (nonatomic, strong) NSMutableData *frameMask;
+@property (nonatomic, strong) NSMutableData *boxTemp;
+@property (nonatomic, assign) uint32_t boxKernel;
+@property (nonatomic, assign) BOOL hasMask;
+@property (nonatomic, assign) NSUInteger framesSinceSegmentation;
+@property (nonatomic, assign) double segmentationMs;
+@property (nonatomic, assign) double blurMs;
+@property (nonatomic, strong, nullable) ZGMemoryAllocation *allocation;
+
+// Guarded by _statisticsLock
+@property (nonatomic, strong) ZGBackgroundBlurStatistics *counters;
+
+@end
+
+@implementation ZGBackgroundBlur
+
+- (instancetype)initWithModel:(id<ZGSegmentationModel>)model {
+    self = [super init];
+    if (self) {
+        _model = model;
+        _blurRadius = 6;
+        _maskSmoothing = 0.6;
+        _budgetMs = 12;
+        _maxSegmentationInterval = 4;
+        pthread_mutex_init(&_statisticsLock, NULL);
+        size_t modelWidth = (size_t)model.inputSize.width;
+        size_t modelHeight = (size_t)model.inputSize.height;
+        _modelInput.width = modelWidth;
+        _modelInput.height = modelHeight;
+        _modelInput.rowBytes = modelWidth * 4;
+        _modelInput.data = malloc(_modelInput.rowBytes * modelHeight);
+        _mask = [NSMutableData dataWithLength:modelWidth * modelHeight];
+        _smoothedMask = [NSMutableData dataWithLength:modelWidth * modelHeight];
+        _frameMask = [NSMutableData data];
+        _boxTemp = [NSMutableData data];
+        _counters = [[ZGBackgroundBlurStatistics alloc] init];
+        _counters.segmentationInterval = 1;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_modelInput.data);
+    free(_smallFrame.data);
+    free(_smallBlurred.data);
+    if (_allocation) {
+        [[ZGMemoryAccountant sharedAccountant] releaseAllocation:_allocation];
+    }
+    pthread_mutex_destroy(&_statisticsLock);
+}
+
+- (ZGBackgroundBlurStatistics *)statistics {
+    ZGBackgroundBlurStatistics *snapshot = [[ZGBackgroundBlurStatistics alloc] init];
+    pthread_mutex_lock(&_statisticsLock);
+    snapshot.frames = self.counters.frames;
+    snapshot.segmentations = self.counters.segmentations;
+    snapshot.averageMs = self.counters.averageMs;
+    snapshot.overBudgetFrames = self.counters.overBudgetFrames;
+    snapshot.segmentationInterval = self.counters.segmentationInterval;
+    pthread_mutex_unlock(&_statisticsLock);
+    return snapshot;
+}
+
+#pragma mark - Blur
+
+- (CVPixelBufferRef)createBlurredFrom:(CVPixelBufferRef)source {
+    if (CVPixelBufferGetPixelFormatType(source) != kCVPixelFormatType_32BGRA) {
+        return NULL;
+    }
+    double startTime = ZGClockNow();
+    size_t width = CVPixelBufferGetWidth(source);
+    size_t height = CVPixelBufferGetHeight(source);
+    if (![self prepareForWidth:width height:height]) {
+        return NULL;
+    }
+    CVPixelBufferRef output = NULL;
+    CVPixelBufferPoolCreatePixelBuffer(kCFAllocatorDefault, (__bridge CVPixelBufferPoolRef)self.pool, &output);
+    if (!output) {
+        return NULL;
+    }
+
+    CVPixelBufferLockBaseAddress(source, kCVPixelBufferLock_ReadOnly);
+    CVPixelBufferLockBaseAddress(output, 0);
+    vImage_Buffer sourceBuffer = {CVPixelBufferGetBaseAddress(source), height, width, CVPixelBufferGetBytesPerRow(source)};
+    vImage_Buffer outputBuffer = {CVPixelBufferGetBaseAddress(output), height, width, CVPixelBufferGetBytesPerRow(output)};
+
+    pthread_mutex_lock(&_statisticsLock);
+    NSUInteger interval = self.counters.segmentationInterval;
+    pthread_mutex_unlock(&_statisticsLock);
+    double segmentationMs = 0;
+    BOOL segmented = NO;
+    if (!self.hasMask || self.framesSinceSegmentation + 1 >= interval) {
+        double segmentationStart = ZGClockNow();
+        segmented = [self segmentFrame:&sourceBuffer];
+        segmentationMs = (ZGClockNow() - segmentationStart) * 1000;
+        self.framesSinceSegmentation = 0;
+    } else {
+        self.framesSinceSegmentation++;
+    }
+
+    // Two box passes at quarter size come close to a gaussian for a fraction of its cost. Not tiled across
+    // threads, so the measured time is the one core the budget is about
+    vImageScale_ARGB8888(&sourceBuffer, &_smallFrame, NULL, kvImageDoNotTile);
+    vImageBoxConvolve_ARGB8888(&_smallFrame, &_smallBlurred, self.boxTemp.mutableBytes, 0, 0, self.boxKernel, self.boxKernel, NULL, kvImageEdgeExtend | kvImageDoNotTile);
+    vImageBoxConvolve_ARGB8888(&_smallBlurred, &_smallFrame, self.boxTemp.mutableBytes, 0, 0, self.boxKernel, self.boxKernel, NULL, kvImageEdgeExtend | kvImageDoNotTile);
+    vImageScale_ARGB8888(&_smallFrame, &outputBuffer, NULL, kvImageDoNotTile);
+
+    const uint8_t *mask = self.frameMask.bytes;
+    for (size_t y = 0; y < height; y++) {
+        ZGBlendRowMask4((uint8_t *)outputBuffer.data + y * outputBuffer.rowBytes, (const uint8_t *)sourceBuffer.data + y * sourceBuffer.rowBytes, mask + y * width, width);
+    }
+
+    CVPixelBufferUnlockBaseAddress(output, 0);
+    CVPixelBufferUnlockBaseAddress(source, kCVPixelBufferLock_ReadOnly);
+
+    double frameMs = (ZGClockNow() - startTime) * 1000;
+    [self updateCostWithFrameMs:frameMs segmentationMs:segmentationMs segmented:segmented];
+    return output;
+}
+
+- (BOOL)segmentFrame:(const vImage_Buffer *)source {
+    if (vImageScale_ARGB8888(source, &_modelInput, NULL, kvImageDoNotTile) != kvImageNoError) {
+        return NO;
+    }
+    uint8_t *mask = self.mask.mutableBytes;
+    if (![self.model predictPersonMask:mask fromBGRA:&_modelInput]) {
+        return NO;
+    }
+    uint8_t *smoothed = self.smoothedMask.mutableBytes;
+    if (self.hasMask) {
+        uint16_t alpha256 = (uint16_t)lrint(MIN(MAX(self.maskSmoothing, 0), 1) * 256);
+        ZGBlendRowConstAlpha(smoothed, mask, self.smoothedMask.length, alpha256);
+    } else {
+        memcpy(smoothed, mask, self.smoothedMask.length);
+        self.hasMask = YES;
+    }
+    [self upsampleMask];
+    return YES;
+}
+
+- (void)upsampleMask {
+    ZGScaleBilinear8(self.smoothedMask.bytes, _modelInput.width, _modelInput.height, _modelInput.width,
+                     self.frameMask.mutableBytes, self.width, self.height, self.width, 1);
+}
+
+- (void)updateCostWithFrameMs:(double)frameMs segmentationMs:(double)segmentationMs segmented:(BOOL)segmented {
+    double blurMs = frameMs - segmentationMs;
+    self.blurMs = self.blurMs > 0 ? self.blurMs + (blurMs - self.blurMs) * ZGBackgroundBlurCostSmoothing : blurMs;
+    if (segmented) {
+        self.segmentationMs = self.segmentationMs > 0 ? self.segmentationMs + (segmentationMs - self.segmentationMs) * ZGBackgroundBlurCostSmoothing : segmentationMs;
+    }
+
+    pthread_mutex_lock(&_statisticsLock);
+    NSUInteger interval = self.counters.segmentationInterval;
+    // The shortest interval whose amortised cost fits
+    NSUInteger maxInterval = MAX(1, self.maxSegmentationInterval);
+    NSUInteger wanted = maxInterval;
+    for (NSUInteger n = 1; n <= maxInterval; n++) {
+        double budget = n < interval ? self.budgetMs * ZGBackgroundBlurHeadroom : self.budgetMs;
+        if (self.blurMs + self.segmentationMs / n <= budget) {
+            wanted = n;
+            break;
+        }
+    }
+    self.counters.segmentationInterval = wanted;
+    self.counters.frames++;
+    if (segmented) {
+        self.counters.segmentations++;
+    }
+    if (frameMs > self.budgetMs) {
+        self.counters.overBudgetFrames++;
+    }
+    self.counters.averageMs = self.blurMs + self.segmentationMs / wanted;
+    pthread_mutex_unlock(&_statisticsLock);
+}
+
+#pragma mark - Helper Methods
+
+- (BOOL)prepareForWidth:(size_t)width height:(size_t)height {
+    if (!_modelInput.data) {
+        return NO;
+    }
+    size_t smallWidth = MAX(1, width / 4);
+    size_t smallHeight = MAX(1, height / 4);
+    uint32_t boxKernel = (uint32_t)MIN(self.blurRadius, MIN(smallWidth, smallHeight) / 2) * 2 + 1;
+
+    if (width != self.width || height != self.height) {
+        NSDictionary *poolAttributes = @{(id)kCVPixelBufferPoolMinimumBufferCountKey: @(ZGBackgroundBlurPoolSize)};
+        NSDictionary *bufferAttributes = @{
+            (id)kCVPixelBufferPixelFormatTypeKey: @(kCVPixelFormatType_32BGRA),
+            (id)kCVPixelBufferWidthKey: @(width),
+            (id)kCVPixelBufferHeightKey: @(height),
+            (id)kCVPixelBufferIOSurfacePropertiesKey: @{}
+        };
+        CVPixelBufferPoolRef pool = NULL;
+        if (CVPixelBufferPoolCreate(kCFAllocatorDefault, (__bridge CFDictionaryRef)poolAttributes, (__bridge CFDictionaryRef)bufferAttributes, &pool) != kCVReturnSuccess) {
+            return NO;
+        }
+        self.pool = CFBridgingRelease(pool);
+        self.width = width;
+        self.height = height;
+
+        free(_smallFrame.data);
+        free(_smallBlurred.data);
+        _smallFrame = (vImage_Buffer){malloc(smallWidth * smallHeight * 4), smallHeight, smallWidth, smallWidth * 4};
+        _smallBlurred = (vImage_Buffer){malloc(smallWidth * smallHeight * 4), smallHeight, smallWidth, smallWidth * 4};
+        if (!_smallFrame.data || !_smallBlurred.data) {
+            free(_smallFrame.data);
+            free(_smallBlurred.data);
+            _smallFrame.data = NULL;
+            _smallBlurred.data = NULL;
+            // Try again with the next frame
+            self.width = 0;
+            self.height = 0;
+            return NO;
+        }
+        self.frameMask.length = width * height;
+        if (self.hasMask) {
+            [self upsampleMask];
+        } else {
+            memset(self.frameMask.mutableBytes, 255, self.frameMask.length);
+        }
+        self.boxKernel = 0;
+    }
+
+    // Scratch sizes only change with the frame size or the radius
+    if (boxKernel == self.boxKernel) {
+        return YES;
+    }
+    vImage_Error tempSize = vImageBoxConvolve_ARGB8888(&_smallFrame, &_smallBlurred, NULL, 0, 0, boxKernel, boxKernel, NULL, kvImageEdgeExtend | kvImageDoNotTile | kvImageGetTempBufferSize);
+    self.boxTemp.length = tempSize > 0 ? (NSUInteger)tempSize : 0;
+    self.boxKernel = boxKernel;
+
+    size_t bytes = width * height * (4 * ZGBackgroundBlurPoolSize + 1) + smallWidth * smallHeight * 8 + self.boxTemp.length
+        + _modelInput.rowBytes * _modelInput.height + self.mask.length * 2;
+    if (self.allocation) {
+        [[ZGMemoryAccountant sharedAccountant] resizeAllocation:self.allocation toBytes:bytes];
+    } else {
+        self.allocation = [[ZGMemoryAccountant sharedAccountant] trackBytes:bytes streamID:nil subsystem:ZGMemorySubsystemCapture label:@"background blur"];
+    }
+    return YES;
+}
+
+@end
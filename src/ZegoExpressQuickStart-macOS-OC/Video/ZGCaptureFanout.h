@@ -0,0 +1,72 @@
+//
+//  ZGCaptureFanout.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreMedia/CoreMedia.h>
+#import <ZegoExpressEngine/ZegoExpressEngine.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// One published rendition of the captured source
+@interface ZGCaptureRendition : NSObject
+
+@property (nonatomic, assign) ZegoPublishChannel channel;
+/// Even width and height
+@property (nonatomic, assign) CGSize size;
+
++ (instancetype)renditionWithChannel:(ZegoPublishChannel)channel size:(CGSize)size;
+
+@end
+
+/// Receives each rendition's frame, on the thread that called processPixelBuffer:timeStamp:
+typedef void(^ZGCaptureFanoutFrameHandler)(CVPixelBufferRef buffer, CMTime timeStamp, ZegoPublishChannel channel);
+
+@interface ZGCaptureFanoutStatistics : NSObject
+
+@property (nonatomic, assign) NSUInteger frames;
+/// Source frames that needed a BGRA to NV12 conversion
+@property (nonatomic, assign) NSUInteger conversions;
+/// 2:1 halvings, the cheap steps of the pyramid
+@property (nonatomic, assign) NSUInteger halvings;
+/// Final bilinear steps onto a rendition size that is no power of two below the previous level
+@property (nonatomic, assign) NSUInteger resamples;
+@property (nonatomic, assign) double averageFrameMs;
+
+@end
+
+/// Feeds several publish channels from one captured frame
+///
+/// Each source frame is converted to NV12 once (BGRA sources go through vImage; NV12 sources are used as
+/// they are), then a pyramid is built from the largest rendition down: every level is either a SIMD 2:1
+/// box halving of the level above, or one bilinear step onto an exact rendition size, so each rendition is
+/// made from the nearest larger one instead of the full source. A rendition equal to the source size sends
+/// the source itself. Levels come from per-size pools accounted to ZGMemorySubsystemCapture.
+///
+/// Without a frameHandler, renditions go to sendCustomVideoCapturePixelBuffer:timeStamp:channel: of the shared
+/// engine. Call from one capture thread at a time.
+@interface ZGCaptureFanout : NSObject
+
+- (instancetype)initWithRenditions:(NSArray<ZGCaptureRendition *> *)renditions;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, copy, readonly) NSArray<ZGCaptureRendition *> *renditions;
+
+@property (nonatomic, copy, nullable) ZGCaptureFanoutFrameHandler frameHandler;
+
+/// Fan one captured frame out to every rendition
+///
+/// @param source BGRA32 or NV12 (video or full range)
+/// @return NO when the source format is not supported or a buffer could not be had
+- (BOOL)processPixelBuffer:(CVPixelBufferRef)source timeStamp:(CMTime)timeStamp;
+
+- (ZGCaptureFanoutStatistics *)statistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
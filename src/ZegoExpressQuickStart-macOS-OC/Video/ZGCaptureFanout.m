@@ -0,0 +1,257 @@
+//
+//  ZGCaptureFanout.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGCaptureFanout.h"
+#import <Accelerate/Accelerate.h>
+#import <pthread.h>
+#import "ZGMemoryAccountant.h"
+#import "ZGPixelKernels.h"
+#import "ZGClock.h"
+
+/// Buffers per pyramid level pool, enough for the encoder to hold a couple
+static const int ZGCaptureFanoutPoolSize = 3;
+
+@implementation ZGCaptureRendition
+
++ (instancetype)renditionWithChannel:(ZegoPublishChannel)channel size:(CGSize)size {
+    ZGCaptureRendition *rendition = [[ZGCaptureRendition alloc] init];
+    rendition.channel = channel;
+    rendition.size = size;
+    return rendition;
+}
+
+@end
+
+@implementation ZGCaptureFanoutStatistics
+
+@end
+
+@interface ZGCaptureFanout () {
+    pthread_mutex_t _statisticsLock;
+    vImage_ARGBToYpCbCr _conversionInfo;
+}
+
+/// CVPixelBufferPool by "<width>x<height>/<format>"
+@property (nonatomic, strong) NSMutableDictionary<NSString *, id> *pools;
+@property (nonatomic, strong) NSMutableArray<ZGMemoryAllocation *> *allocations;
+
+// Guarded by _statisticsLock
+@property (nonatomic, strong) ZGCaptureFanoutStatistics *counters;
+@property (nonatomic, assign) double totalFrameMs;
+
+@end
+
+@implementation ZGCaptureFanout
+
+- (instancetype)initWithRenditions:(NSArray<ZGCaptureRendition *> *)renditions {
+    self = [super init];
+    if (self) {
+        // Largest first, every rendition is made from the one before it
+        _renditions = [renditions sortedArrayUsingComparator:^NSComparisonResult(ZGCaptureRendition *a, ZGCaptureRendition *b) {
+            double areaA = a.size.width * a.size.height;
+            double areaB = b.size.width * b.size.height;
+            return areaA > areaB ? NSOrderedAscending : (areaA < areaB ? NSOrderedDescending : NSOrderedSame);
+        }];
+        _pools = [NSMutableDictionary dictionary];
+        _allocations = [NSMutableArray array];
+        _counters = [[ZGCaptureFanoutStatistics alloc] init];
+        pthread_mutex_init(&_statisticsLock, NULL);
+
+        vImage_YpCbCrPixelRange videoRange = {16, 128, 235, 240, 235, 16, 240, 16};
+        vImageConvert_ARGBToYpCbCr_GenerateConversion(kvImage_ARGBToYpCbCrMatrix_ITU_R_709_2, &videoRange, &_conversionInfo, kvImageARGB8888, kvImage420Yp8_CbCr8, kvImageNoFlags);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    for (ZGMemoryAllocation *allocation in _allocations) {
+        [[ZGMemoryAccountant sharedAccountant] releaseAllocation:allocation];
+    }
+    pthread_mutex_destroy(&_statisticsLock);
+}
+
+- (ZGCaptureFanoutStatistics *)statistics {
+    ZGCaptureFanoutStatistics *snapshot = [[ZGCaptureFanoutStatistics alloc] init];
+    pthread_mutex_lock(&_statisticsLock);
+    snapshot.frames = self.counters.frames;
+    snapshot.conversions = self.counters.conversions;
+    snapshot.halvings = self.counters.halvings;
+    snapshot.resamples = self.counters.resamples;
+    snapshot.averageFrameMs = self.counters.frames > 0 ? self.totalFrameMs / self.counters.frames : 0;
+    pthread_mutex_unlock(&_statisticsLock);
+    return snapshot;
+}
+
+#pragma mark - Fan-out
+
+- (BOOL)processPixelBuffer:(CVPixelBufferRef)source timeStamp:(CMTime)timeStamp {
+    double startTime = ZGClockNow();
+    OSType format = CVPixelBufferGetPixelFormatType(source);
+    CVPixelBufferRef current = NULL;
+    BOOL converted = NO;
+    if (format == kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange || format == kCVPixelFormatType_420YpCbCr8BiPlanarFullRange) {
+        current = CVPixelBufferRetain(source);
+    } else if (format == kCVPixelFormatType_32BGRA) {
+        current = [self createNV12FromBGRA:source];
+        converted = YES;
+    }
+    if (!current) {
+        return NO;
+    }
+
+    NSUInteger halvings = 0;
+    NSUInteger resamples = 0;
+    BOOL succeeded = YES;
+    for (ZGCaptureRendition *rendition in self.renditions) {
+        size_t width = (size_t)rendition.size.width;
+        size_t height = (size_t)rendition.size.height;
+        while (((CVPixelBufferGetWidth(current) / 2) & ~(size_t)1) >= width && ((CVPixelBufferGetHeight(current) / 2) & ~(size_t)1) >= height) {
+            CVPixelBufferRef half = [self createHalfOf:current];
+            CVPixelBufferRelease(current);
+            current = half;
+            if (!current) {
+                break;
+            }
+            halvings += 1;
+        }
+        if (current && (CVPixelBufferGetWidth(current) != width || CVPixelBufferGetHeight(current) != height)) {
+            CVPixelBufferRef resampled = [self createResampledOf:current width:width height:height];
+            CVPixelBufferRelease(current);
+            current = resampled;
+            resamples += 1;
+        }
+        if (!current) {
+            succeeded = NO;
+            break;
+        }
+        [self emitBuffer:current timeStamp:timeStamp channel:rendition.channel];
+    }
+    if (current) {
+        CVPixelBufferRelease(current);
+    }
+
+    pthread_mutex_lock(&_statisticsLock);
+    self.counters.frames += 1;
+    self.counters.conversions += converted;
+    self.counters.halvings += halvings;
+    self.counters.resamples += resamples;
+    self.totalFrameMs += (ZGClockNow() - startTime) * 1000;
+    pthread_mutex_unlock(&_statisticsLock);
+    return succeeded;
+}
+
+- (void)emitBuffer:(CVPixelBufferRef)buffer timeStamp:(CMTime)timeStamp channel:(ZegoPublishChannel)channel {
+    ZGCaptureFanoutFrameHandler handler = self.frameHandler;
+    if (handler) {
+        handler(buffer, timeStamp, channel);
+    } else {
+        [[ZegoExpressEngine sharedEngine] sendCustomVideoCapturePixelBuffer:buffer timeStamp:timeStamp channel:channel];
+    }
+}
+
+#pragma mark - Levels
+
+- (CVPixelBufferRef)createNV12FromBGRA:(CVPixelBufferRef)source {
+    size_t width = CVPixelBufferGetWidth(source) & ~(size_t)1;
+    size_t height = CVPixelBufferGetHeight(source) & ~(size_t)1;
+    CVPixelBufferRef output = [self createBufferWithWidth:width height:height format:kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange];
+    if (!output) {
+        return NULL;
+    }
+    CVPixelBufferLockBaseAddress(source, kCVPixelBufferLock_ReadOnly);
+    CVPixelBufferLockBaseAddress(output, 0);
+    vImage_Buffer bgra = {CVPixelBufferGetBaseAddress(source), height, width, CVPixelBufferGetBytesPerRow(source)};
+    vImage_Buffer luma = {CVPixelBufferGetBaseAddressOfPlane(output, 0), height, width, CVPixelBufferGetBytesPerRowOfPlane(output, 0)};
+    vImage_Buffer chroma = {CVPixelBufferGetBaseAddressOfPlane(output, 1), height / 2, width / 2, CVPixelBufferGetBytesPerRowOfPlane(output, 1)};
+    // BGRA in memory, the converter expects ARGB
+    const uint8_t permuteMap[4] = {3, 2, 1, 0};
+    vImage_Error error = vImageConvert_ARGB8888To420Yp8_CbCr8(&bgra, &luma, &chroma, &_conversionInfo, permuteMap, kvImageNoFlags);
+    CVPixelBufferUnlockBaseAddress(output, 0);
+    CVPixelBufferUnlockBaseAddress(source, kCVPixelBufferLock_ReadOnly);
+    if (error != kvImageNoError) {
+        CVPixelBufferRelease(output);
+        return NULL;
+    }
+    return output;
+}
+
+/// 2:1 box halving, rounded down to even sizes so the chroma plane halves exactly too
+- (CVPixelBufferRef)createHalfOf:(CVPixelBufferRef)source {
+    size_t width = (CVPixelBufferGetWidth(source) / 2) & ~(size_t)1;
+    size_t height = (CVPixelBufferGetHeight(source) / 2) & ~(size_t)1;
+    CVPixelBufferRef output = [self createBufferWithWidth:width height:height format:CVPixelBufferGetPixelFormatType(source)];
+    if (!output) {
+        return NULL;
+    }
+    CVPixelBufferLockBaseAddress(source, kCVPixelBufferLock_ReadOnly);
+    CVPixelBufferLockBaseAddress(output, 0);
+    for (size_t plane = 0; plane < 2; plane++) {
+        const uint8_t *src = CVPixelBufferGetBaseAddressOfPlane(source, plane);
+        size_t srcStride = CVPixelBufferGetBytesPerRowOfPlane(source, plane);
+        uint8_t *dst = CVPixelBufferGetBaseAddressOfPlane(output, plane);
+        size_t dstStride = CVPixelBufferGetBytesPerRowOfPlane(output, plane);
+        size_t rows = plane == 0 ? height : height / 2;
+        for (size_t y = 0; y < rows; y++) {
+            const uint8_t *row0 = src + 2 * y * srcStride;
+            const uint8_t *row1 = row0 + srcStride;
+            if (plane == 0) {
+                ZGHalveRowPlanar8(dst + y * dstStride, row0, row1, width);
+            } else {
+                ZGHalveRowCbCr8(dst + y * dstStride, row0, row1, width / 2);
+            }
+        }
+    }
+    CVPixelBufferUnlockBaseAddress(output, 0);
+    CVPixelBufferUnlockBaseAddress(source, kCVPixelBufferLock_ReadOnly);
+    return output;
+}
+
+- (CVPixelBufferRef)createResampledOf:(CVPixelBufferRef)source width:(size_t)width height:(size_t)height {
+    CVPixelBufferRef output = [self createBufferWithWidth:width height:height format:CVPixelBufferGetPixelFormatType(source)];
+    if (!output) {
+        return NULL;
+    }
+    size_t srcWidth = CVPixelBufferGetWidth(source);
+    size_t srcHeight = CVPixelBufferGetHeight(source);
+    CVPixelBufferLockBaseAddress(source, kCVPixelBufferLock_ReadOnly);
+    CVPixelBufferLockBaseAddress(output, 0);
+    ZGScaleBilinear8(CVPixelBufferGetBaseAddressOfPlane(source, 0), srcWidth, srcHeight, CVPixelBufferGetBytesPerRowOfPlane(source, 0),
+                     CVPixelBufferGetBaseAddressOfPlane(output, 0), width, height, CVPixelBufferGetBytesPerRowOfPlane(output, 0), 1);
+    ZGScaleBilinear8(CVPixelBufferGetBaseAddressOfPlane(source, 1), srcWidth / 2, srcHeight / 2, CVPixelBufferGetBytesPerRowOfPlane(source, 1),
+                     CVPixelBufferGetBaseAddressOfPlane(output, 1), width / 2, height / 2, CVPixelBufferGetBytesPerRowOfPlane(output, 1), 2);
+    CVPixelBufferUnlockBaseAddress(output, 0);
+    CVPixelBufferUnlockBaseAddress(source, kCVPixelBufferLock_ReadOnly);
+    return output;
+}
+
+#pragma mark - Helper Methods
+
+- (CVPixelBufferRef)createBufferWithWidth:(size_t)width height:(size_t)height format:(OSType)format {
+    NSString *key = [NSString stringWithFormat:@"%zux%zu/%u", width, height, (unsigned)format];
+    CVPixelBufferPoolRef pool = (__bridge CVPixelBufferPoolRef)self.pools[key];
+    if (!pool) {
+        NSDictionary *poolAttributes = @{(id)kCVPixelBufferPoolMinimumBufferCountKey: @(ZGCaptureFanoutPoolSize)};
+        NSDictionary *bufferAttributes = @{
+            (id)kCVPixelBufferPixelFormatTypeKey: @(format),
+            (id)kCVPixelBufferWidthKey: @(width),
+            (id)kCVPixelBufferHeightKey: @(height),
+            (id)kCVPixelBufferIOSurfacePropertiesKey: @{}
+        };
+        if (CVPixelBufferPoolCreate(kCFAllocatorDefault, (__bridge CFDictionaryRef)poolAttributes, (__bridge CFDictionaryRef)bufferAttributes, &pool) != kCVReturnSuccess) {
+            return NULL;
+        }
+        self.pools[key] = CFBridgingRelease(pool);
+        size_t bytes = width * height * 3 / 2 * ZGCaptureFanoutPoolSize;
+        [self.allocations addObject:[[ZGMemoryAccountant sharedAccountant] trackBytes:bytes streamID:nil subsystem:ZGMemorySubsystemCapture label:[NSString stringWithFormat:@"capture pyramid %zux%zu", width, height]]];
+    }
+    CVPixelBufferRef buffer = NULL;
+    CVPixelBufferPoolCreatePixelBuffer(kCFAllocatorDefault, pool, &buffer);
+    return buffer;
+}
+
+@end
@@ -0,0 +1,52 @@
+//
+//  ZGGlyphAtlas.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreText/CoreText.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Where a glyph's coverage sits in the atlas
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+    /// Left edge of the bitmap right of the pen, and its top edge above the baseline, in pixels
+    int16_t left;
+    int16_t top;
+} ZGGlyphAtlasEntry;
+
+/// Coverage of rasterised glyphs, packed in shelves into one 8 bit square
+///
+/// Glyphs are rasterised once per font and size at whole pixel positions. When the atlas is full it is cleared
+/// and starts over, which makes every entry handed out before stale, so callers copy coverage out right away.
+/// Not thread safe.
+@interface ZGGlyphAtlas : NSObject
+
+- (instancetype)initWithSize:(size_t)size;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Width and height, also the bytes per row
+@property (nonatomic, assign, readonly) size_t size;
+
+@property (nonatomic, assign, readonly) const uint8_t *bytes;
+
+@property (nonatomic, assign, readonly) NSUInteger rasterizedGlyphs;
+
+@property (nonatomic, assign, readonly) NSUInteger resets;
+
+/// Look a glyph up, rasterising it on a miss; blank glyphs get an empty entry
+///
+/// @return NO if the glyph is larger than the whole atlas
+- (BOOL)entryForGlyph:(CGGlyph)glyph font:(CTFontRef)font entry:(ZGGlyphAtlasEntry *)entry;
+
+@end
+
+NS_ASSUME_NONNULL_END
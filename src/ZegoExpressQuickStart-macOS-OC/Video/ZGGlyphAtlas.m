@@ -0,0 +1,131 @@
+//
+//  ZGGlyphAtlas.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGGlyphAtlas.h"
+#import "ZGMemoryAccountant.h"
+
+@interface ZGGlyphAtlas ()
+
+@property (nonatomic, strong) NSMutableData *storage;
+@property (nonatomic, assign) CGContextRef context;
+/// Entries by font ("<PostScript name>/<size>"), then by glyph
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableDictionary<NSNumber *, NSValue *> *> *entries;
+@property (nonatomic, assign) size_t shelfX;
+@property (nonatomic, assign) size_t shelfY;
+@property (nonatomic, assign) size_t shelfHeight;
+@property (nonatomic, assign, readwrite) NSUInteger rasterizedGlyphs;
+@property (nonatomic, assign, readwrite) NSUInteger resets;
+@property (nonatomic, strong) ZGMemoryAllocation *allocation;
+
+@end
+
+@implementation ZGGlyphAtlas
+
+- (instancetype)initWithSize:(size_t)size {
+    self = [super init];
+    if (self) {
+        _size = size;
+        _storage = [NSMutableData dataWithLength:size * size];
+        _context = CGBitmapContextCreate(_storage.mutableBytes, size, size, 8, size, NULL, (CGBitmapInfo)kCGImageAlphaOnly);
+        CGContextSetAllowsAntialiasing(_context, true);
+        CGContextSetShouldSmoothFonts(_context, false);
+        _entries = [NSMutableDictionary dictionary];
+        _allocation = [[ZGMemoryAccountant sharedAccountant] trackBytes:size * size streamID:nil subsystem:ZGMemorySubsystemCapture label:@"glyph atlas"];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    CGContextRelease(_context);
+    [[ZGMemoryAccountant sharedAccountant] releaseAllocation:_allocation];
+}
+
+- (const uint8_t *)bytes {
+    return self.storage.bytes;
+}
+
+- (BOOL)entryForGlyph:(CGGlyph)glyph font:(CTFontRef)font entry:(ZGGlyphAtlasEntry *)entry {
+    NSString *postScriptName = CFBridgingRelease(CTFontCopyPostScriptName(font));
+    NSString *fontKey = [NSString stringWithFormat:@"%@/%.2f", postScriptName, CTFontGetSize(font)];
+    NSValue *cached = self.entries[fontKey][@(glyph)];
+    if (cached) {
+        [cached getValue:entry];
+        return YES;
+    }
+
+    CGRect bounds;
+    CTFontGetBoundingRectsForGlyphs(font, kCTFontOrientationDefault, &glyph, &bounds, 1);
+    ZGGlyphAtlasEntry result = {0};
+    if (!CGRectIsEmpty(bounds)) {
+        // One pixel of margin so antialiased edges are not clipped
+        long left = (long)floor(CGRectGetMinX(bounds)) - 1;
+        long right = (long)ceil(CGRectGetMaxX(bounds)) + 1;
+        long bottom = (long)floor(CGRectGetMinY(bounds)) - 1;
+        long top = (long)ceil(CGRectGetMaxY(bounds)) + 1;
+        size_t width = (size_t)(right - left);
+        size_t height = (size_t)(top - bottom);
+        size_t x, y;
+        if (![self allocateWidth:width height:height x:&x y:&y]) {
+            [self reset];
+            if (![self allocateWidth:width height:height x:&x y:&y]) {
+                return NO;
+            }
+        }
+
+        // Core Graphics counts rows from the bottom
+        CGContextSaveGState(self.context);
+        CGContextClipToRect(self.context, CGRectMake(x, self.size - y - height, width, height));
+        CGPoint pen = CGPointMake((CGFloat)x - left, (CGFloat)(self.size - y) - top);
+        CTFontDrawGlyphs(font, &glyph, &pen, 1, self.context);
+        CGContextRestoreGState(self.context);
+
+        result = (ZGGlyphAtlasEntry){(uint16_t)x, (uint16_t)y, (uint16_t)width, (uint16_t)height, (int16_t)left, (int16_t)top};
+        self.rasterizedGlyphs++;
+    }
+
+    NSMutableDictionary<NSNumber *, NSValue *> *fontEntries = self.entries[fontKey];
+    if (!fontEntries) {
+        fontEntries = [NSMutableDictionary dictionary];
+        self.entries[fontKey] = fontEntries;
+    }
+    fontEntries[@(glyph)] = [NSValue valueWithBytes:&result objCType:@encode(ZGGlyphAtlasEntry)];
+    *entry = result;
+    return YES;
+}
+
+#pragma mark - Helper Methods
+
+- (BOOL)allocateWidth:(size_t)width height:(size_t)height x:(size_t *)x y:(size_t *)y {
+    if (width > self.size || height > self.size) {
+        return NO;
+    }
+    if (self.shelfX + width > self.size) {
+        self.shelfY += self.shelfHeight;
+        self.shelfX = 0;
+        self.shelfHeight = 0;
+    }
+    if (self.shelfY + height > self.size) {
+        return NO;
+    }
+    *x = self.shelfX;
+    *y = self.shelfY;
+    self.shelfX += width;
+    self.shelfHeight = MAX(self.shelfHeight, height);
+    return YES;
+}
+
+- (void)reset {
+    memset(self.storage.mutableBytes, 0, self.storage.length);
+    [self.entries removeAllObjects];
+    self.shelfX = 0;
+    self.shelfY = 0;
+    self.shelfHeight = 0;
+    self.resets++;
+}
+
+@end
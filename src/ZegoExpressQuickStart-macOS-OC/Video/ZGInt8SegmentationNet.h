@@ -0,0 +1,40 @@
+//
+//  ZGInt8SegmentationNet.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ZGBackgroundBlur.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// A small fully convolutional person segmentation net, run in int8 on the CPU
+///
+/// The model file is little endian:
+///
+///     "ZGSN"  u32 version (1)  u32 input width  u32 input height  u32 layer count  f32 output logit scale
+///     per layer:
+///         u32 type (0 convolution, 1 nearest 2x upsampling)
+///         u32 kernel (1 or 3)  u32 stride (1 or 2)  u32 input channels  u32 output channels  u32 relu
+///         convolutions only: i8 weights [ky][kx][input channel][output channel]
+///                            i32 bias [output channel]  f32 requantisation multiplier [output channel]
+///
+/// The input is the BGR of the frame minus 128, activations are int8, accumulation int32; every convolution
+/// requantises its accumulators with its per-channel multiplier. The last layer must output one channel at the
+/// input size, its logits times the logit scale go through a sigmoid to give the mask.
+@interface ZGInt8SegmentationNet : NSObject <ZGSegmentationModel>
+
++ (nullable instancetype)netWithContentsOfFile:(NSString *)path error:(NSError **)error;
+
++ (nullable instancetype)netWithData:(NSData *)data error:(NSError **)error;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, assign, readonly) NSUInteger layerCount;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,331 @@
+//
+//  ZGInt8SegmentationNet.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGInt8SegmentationNet.h"
+#import "ZGMemoryAccountant.h"
+
+static NSString * const ZGInt8SegmentationNetErrorDomain = @"im.zego.segmentation";
+
+/// Largest activation width or height and channel count a net file may ask for, far beyond a real-time model
+static const int ZGInt8SegmentationNetMaxDimension = 4096;
+static const int ZGInt8SegmentationNetMaxChannels = 1024;
+
+typedef int32_t ZGI32x8 __attribute__((vector_size(32)));
+typedef int8_t ZGI8x8 __attribute__((vector_size(8)));
+
+typedef NS_ENUM(uint32_t, ZGSegmentationLayerType) {
+    ZGSegmentationLayerTypeConvolution = 0,
+    ZGSegmentationLayerTypeUpsample = 1
+};
+
+#pragma mark - Kernels
+
+/// int8 HWC convolution with zero padding, int32 accumulation and per-channel requantisation
+///
+/// Weights are [ky][kx][ic][oc] so the innermost loop runs over output channels, eight at a time.
+static void ZGConvolveInt8(const int8_t *input, int inWidth, int inHeight, int inChannels,
+                           int8_t *output, int outWidth, int outHeight, int outChannels,
+                           const int8_t *weights, const int32_t *bias, const float *multiplier,
+                           int kernel, int stride, int relu, int32_t *accumulators) {
+    int pad = kernel / 2;
+    long lowest = relu ? 0 : -128;
+    int vectorChannels = outChannels & ~7;
+    for (int oy = 0; oy < outHeight; oy++) {
+        for (int ox = 0; ox < outWidth; ox++) {
+            memcpy(accumulators, bias, sizeof(int32_t) * outChannels);
+            for (int ky = 0; ky < kernel; ky++) {
+                int iy = oy * stride + ky - pad;
+                if (iy < 0 || iy >= inHeight) {
+                    continue;
+                }
+                for (int kx = 0; kx < kernel; kx++) {
+                    int ix = ox * stride + kx - pad;
+                    if (ix < 0 || ix >= inWidth) {
+                        continue;
+                    }
+                    const int8_t *x = input + ((size_t)iy * inWidth + ix) * inChannels;
+                    const int8_t *w = weights + (size_t)(ky * kernel + kx) * inChannels * outChannels;
+                    for (int ic = 0; ic < inChannels; ic++, w += outChannels) {
+                        int32_t value = x[ic];
+                        // ReLU leaves many zeros behind
+                        if (value == 0) {
+                            continue;
+                        }
+                        int oc = 0;
+                        for (; oc < vectorChannels; oc += 8) {
+                            ZGI8x8 w8;
+                            ZGI32x8 sum;
+                            memcpy(&w8, w + oc, sizeof(w8));
+                            memcpy(&sum, accumulators + oc, sizeof(sum));
+                            sum += __builtin_convertvector(w8, ZGI32x8) * value;
+                            memcpy(accumulators + oc, &sum, sizeof(sum));
+                        }
+                        for (; oc < outChannels; oc++) {
+                            accumulators[oc] += w[oc] * value;
+                        }
+                    }
+                }
+            }
+            int8_t *y = output + ((size_t)oy * outWidth + ox) * outChannels;
+            for (int oc = 0; oc < outChannels; oc++) {
+                long q = lrintf(accumulators[oc] * multiplier[oc]);
+                q = q > 127 ? 127 : (q < lowest ? lowest : q);
+                y[oc] = (int8_t)q;
+            }
+        }
+    }
+}
+
+static void ZGUpsampleInt8(const int8_t *input, int inWidth, int inHeight, int channels, int8_t *output) {
+    int outWidth = inWidth * 2;
+    for (int oy = 0; oy < inHeight * 2; oy++) {
+        for (int ox = 0; ox < outWidth; ox++) {
+            memcpy(output + ((size_t)oy * outWidth + ox) * channels, input + ((size_t)(oy / 2) * inWidth + ox / 2) * channels, channels);
+        }
+    }
+}
+
+#pragma mark - Layer
+
+@interface ZGSegmentationLayer : NSObject
+
+@property (nonatomic, assign) ZGSegmentationLayerType type;
+@property (nonatomic, assign) int kernel;
+@property (nonatomic, assign) int stride;
+@property (nonatomic, assign) int inChannels;
+@property (nonatomic, assign) int outChannels;
+@property (nonatomic, assign) int relu;
+/// Spatial size of the layer's input and output
+@property (nonatomic, assign) int inWidth;
+@property (nonatomic, assign) int inHeight;
+@property (nonatomic, assign) int outWidth;
+@property (nonatomic, assign) int outHeight;
+/// Copied out of the file so the int32 and float arrays are aligned
+@property (nonatomic, strong, nullable) NSData *weights;
+@property (nonatomic, strong, nullable) NSData *bias;
+@property (nonatomic, strong, nullable) NSData *multiplier;
+
+@end
+
+@implementation ZGSegmentationLayer
+
+@end
+
+#pragma mark - Net
+
+@interface ZGInt8SegmentationNet () {
+    uint8_t _sigmoid[256];
+}
+
+@property (nonatomic, assign, readwrite) CGSize inputSize;
+@property (nonatomic, strong) NSArray<ZGSegmentationLayer *> *layers;
+/// Two activation buffers used in turn, each big enough for the largest layer
+@property (nonatomic, strong) NSMutableData *activations0;
+@property (nonatomic, strong) NSMutableData *activations1;
+@property (nonatomic, strong) NSMutableData *accumulators;
+@property (nonatomic, strong) ZGMemoryAllocation *allocation;
+
+@end
+
+@implementation ZGInt8SegmentationNet
+
++ (instancetype)netWithContentsOfFile:(NSString *)path error:(NSError **)error {
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:error];
+    if (!data) {
+        return nil;
+    }
+    return [self netWithData:data error:error];
+}
+
++ (instancetype)netWithData:(NSData *)data error:(NSError **)error {
+    const uint8_t *bytes = data.bytes;
+    size_t length = data.length;
+    __block size_t offset = 0;
+    BOOL (^read)(void *, size_t) = ^BOOL(void *destination, size_t size) {
+        if (offset + size > length) {
+            return NO;
+        }
+        memcpy(destination, bytes + offset, size);
+        offset += size;
+        return YES;
+    };
+
+    char magic[4];
+    uint32_t header[4];
+    float logitScale;
+    if (!read(magic, 4) || memcmp(magic, "ZGSN", 4) != 0 || !read(header, sizeof(header)) || !read(&logitScale, sizeof(logitScale))) {
+        [self fillError:error message:@"Not a segmentation net file"];
+        return nil;
+    }
+    if (header[0] != 1 || header[1] == 0 || header[2] == 0 || header[3] == 0) {
+        [self fillError:error message:@"Unsupported segmentation net version or empty net"];
+        return nil;
+    }
+    if (header[1] > ZGInt8SegmentationNetMaxDimension || header[2] > ZGInt8SegmentationNetMaxDimension) {
+        [self fillError:error message:[NSString stringWithFormat:@"Segmentation net input %ux%u is too large", header[1], header[2]]];
+        return nil;
+    }
+
+    int width = (int)header[1];
+    int height = (int)header[2];
+    int channels = 3;
+    size_t largestActivation = (size_t)width * height * channels;
+    size_t largestChannels = 0;
+    NSMutableArray<ZGSegmentationLayer *> *layers = [NSMutableArray array];
+    for (uint32_t i = 0; i < header[3]; i++) {
+        uint32_t fields[6];
+        if (!read(fields, sizeof(fields))) {
+            [self fillError:error message:@"Segmentation net file is truncated"];
+            return nil;
+        }
+        ZGSegmentationLayer *layer = [[ZGSegmentationLayer alloc] init];
+        layer.type = fields[0];
+        if (fields[3] > ZGInt8SegmentationNetMaxChannels || fields[4] > ZGInt8SegmentationNetMaxChannels) {
+            [self fillError:error message:[NSString stringWithFormat:@"Layer %u has too many channels", i]];
+            return nil;
+        }
+        layer.kernel = (int)fields[1];
+        layer.stride = (int)fields[2];
+        layer.inChannels = (int)fields[3];
+        layer.outChannels = (int)fields[4];
+        layer.relu = fields[5] != 0;
+        layer.inWidth = width;
+        layer.inHeight = height;
+        if (layer.inChannels != channels || layer.outChannels <= 0) {
+            [self fillError:error message:[NSString stringWithFormat:@"Layer %u expects %d channels but gets %d", i, layer.inChannels, channels]];
+            return nil;
+        }
+
+        if (layer.type == ZGSegmentationLayerTypeConvolution) {
+            if ((layer.kernel != 1 && layer.kernel != 3) || (layer.stride != 1 && layer.stride != 2)) {
+                [self fillError:error message:[NSString stringWithFormat:@"Layer %u has an unsupported kernel or stride", i]];
+                return nil;
+            }
+            size_t weightCount = (size_t)layer.kernel * layer.kernel * layer.inChannels * layer.outChannels;
+            NSMutableData *weights = [NSMutableData dataWithLength:weightCount];
+            NSMutableData *bias = [NSMutableData dataWithLength:sizeof(int32_t) * layer.outChannels];
+            NSMutableData *multiplier = [NSMutableData dataWithLength:sizeof(float) * layer.outChannels];
+            if (!read(weights.mutableBytes, weights.length) || !read(bias.mutableBytes, bias.length) || !read(multiplier.mutableBytes, multiplier.length)) {
+                [self fillError:error message:@"Segmentation net file is truncated"];
+                return nil;
+            }
+            layer.weights = weights;
+            layer.bias = bias;
+            layer.multiplier = multiplier;
+            width = (width + layer.stride - 1) / layer.stride;
+            height = (height + layer.stride - 1) / layer.stride;
+            channels = layer.outChannels;
+        } else if (layer.type == ZGSegmentationLayerTypeUpsample) {
+            if (layer.outChannels != layer.inChannels) {
+                [self fillError:error message:[NSString stringWithFormat:@"Upsampling layer %u changes the channel count", i]];
+                return nil;
+            }
+            // Checked before doubling, repeated upsampling would overflow
+            if (width > ZGInt8SegmentationNetMaxDimension / 2 || height > ZGInt8SegmentationNetMaxDimension / 2) {
+                [self fillError:error message:[NSString stringWithFormat:@"Upsampling layer %u grows the activations too large", i]];
+                return nil;
+            }
+            width *= 2;
+            height *= 2;
+        } else {
+            [self fillError:error message:[NSString stringWithFormat:@"Layer %u has an unknown type", i]];
+            return nil;
+        }
+        layer.outWidth = width;
+        layer.outHeight = height;
+        largestActivation = MAX(largestActivation, (size_t)width * height * channels);
+        largestChannels = MAX(largestChannels, (size_t)channels);
+        [layers addObject:layer];
+    }
+    if (width != (int)header[1] || height != (int)header[2] || channels != 1) {
+        [self fillError:error message:@"The last layer must output one channel at the input size"];
+        return nil;
+    }
+
+    ZGInt8SegmentationNet *net = [[ZGInt8SegmentationNet alloc] initWithLayers:layers width:header[1] height:header[2] largestActivation:largestActivation largestChannels:largestChannels];
+    for (int q = -128; q < 128; q++) {
+        net->_sigmoid[(uint8_t)(int8_t)q] = (uint8_t)lrint(255.0 / (1.0 + exp(-q * logitScale)));
+    }
+    return net;
+}
+
+- (instancetype)initWithLayers:(NSArray<ZGSegmentationLayer *> *)layers width:(uint32_t)width height:(uint32_t)height largestActivation:(size_t)largestActivation largestChannels:(size_t)largestChannels {
+    self = [super init];
+    if (self) {
+        _inputSize = CGSizeMake(width, height);
+        _layers = layers;
+        _activations0 = [NSMutableData dataWithLength:largestActivation];
+        _activations1 = [NSMutableData dataWithLength:largestActivation];
+        _accumulators = [NSMutableData dataWithLength:sizeof(int32_t) * largestChannels];
+        size_t weightBytes = 0;
+        for (ZGSegmentationLayer *layer in layers) {
+            weightBytes += layer.weights.length + layer.bias.length + layer.multiplier.length;
+        }
+        _allocation = [[ZGMemoryAccountant sharedAccountant] trackBytes:largestActivation * 2 + weightBytes streamID:nil subsystem:ZGMemorySubsystemCapture label:@"segmentation net"];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [[ZGMemoryAccountant sharedAccountant] releaseAllocation:_allocation];
+}
+
+- (NSUInteger)layerCount {
+    return self.layers.count;
+}
+
+#pragma mark - ZGSegmentationModel
+
+- (BOOL)predictPersonMask:(uint8_t *)mask fromBGRA:(const vImage_Buffer *)input {
+    int width = (int)self.inputSize.width;
+    int height = (int)self.inputSize.height;
+    if (input->width != (vImagePixelCount)width || input->height != (vImagePixelCount)height) {
+        return NO;
+    }
+
+    int8_t *current = self.activations0.mutableBytes;
+    int8_t *next = self.activations1.mutableBytes;
+    for (int y = 0; y < height; y++) {
+        const uint8_t *row = (const uint8_t *)input->data + y * input->rowBytes;
+        int8_t *out = current + (size_t)y * width * 3;
+        for (int x = 0; x < width; x++) {
+            out[3 * x] = (int8_t)(row[4 * x] - 128);
+            out[3 * x + 1] = (int8_t)(row[4 * x + 1] - 128);
+            out[3 * x + 2] = (int8_t)(row[4 * x + 2] - 128);
+        }
+    }
+
+    for (ZGSegmentationLayer *layer in self.layers) {
+        if (layer.type == ZGSegmentationLayerTypeConvolution) {
+            ZGConvolveInt8(current, layer.inWidth, layer.inHeight, layer.inChannels,
+                           next, layer.outWidth, layer.outHeight, layer.outChannels,
+                           layer.weights.bytes, layer.bias.bytes, layer.multiplier.bytes,
+                           layer.kernel, layer.stride, layer.relu, self.accumulators.mutableBytes);
+        } else {
+            ZGUpsampleInt8(current, layer.inWidth, layer.inHeight, layer.inChannels, next);
+        }
+        int8_t *swap = current;
+        current = next;
+        next = swap;
+    }
+
+    for (size_t i = 0; i < (size_t)width * height; i++) {
+        mask[i] = _sigmoid[(uint8_t)current[i]];
+    }
+    return YES;
+}
+
+#pragma mark - Helper Methods
+
++ (void)fillError:(NSError **)error message:(NSString *)message {
+    if (error) {
+        *error = [NSError errorWithDomain:ZGInt8SegmentationNetErrorDomain code:-1 userInfo:@{NSLocalizedDescriptionKey: message}];
+    }
+}
+
+@end
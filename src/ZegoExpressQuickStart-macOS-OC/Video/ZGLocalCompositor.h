@@ -0,0 +1,72 @@
+//
+//  ZGLocalCompositor.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreMedia/CoreMedia.h>
+#import <ZegoExpressEngine/ZegoExpressEngine.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Receives every composed frame on the compositor queue, retain the buffer to keep it beyond the call
+typedef void(^ZGLocalCompositorOutputHandler)(CVPixelBufferRef buffer, CMTime timeStamp);
+
+@interface ZGLocalCompositorStatistics : NSObject
+
+@property (nonatomic, assign) NSUInteger composedFrames;
+/// Layers drawn with the background because their stream had no frame yet
+@property (nonatomic, assign) NSUInteger missingLayers;
+/// Frames dropped because the output pool was exhausted, i.e. the consumer holds on to frames too long
+@property (nonatomic, assign) NSUInteger droppedFrames;
+@property (nonatomic, assign) double averageComposeMs;
+@property (nonatomic, assign) double maxComposeMs;
+
+@end
+
+/// Composes several played streams into one picture locally, instead of a server-side mixer task
+///
+/// Forward the custom render callbacks of the played streams (CVPixelBuffer in BGRA32) to
+/// `onRemoteVideoFrameCVPixelBuffer:param:streamID:`; only the newest frame of each stream is kept. At a fixed
+/// `frameRate`, the compositor scales every layer of the layout to its rect with vImage (aspect fill, in
+/// parallel across layers), then blends the layers back to front into a pooled BGRA buffer in horizontal
+/// bands, one per core. The result goes to `outputHandler`, e.g. a recorder or sendCustomVideoCapturePixelBuffer:.
+/// Output and scratch buffers are accounted to ZGMemorySubsystemCompositor.
+@interface ZGLocalCompositor : NSObject <ZegoCustomVideoRenderHandler>
+
+/// @return nil when `frameRate` is not a positive number
+- (nullable instancetype)initWithOutputSize:(CGSize)outputSize frameRate:(double)frameRate;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, assign, readonly) CGSize outputSize;
+
+@property (nonatomic, assign, readonly) double frameRate;
+
+/// 0xAARRGGBB, default opaque black
+@property (nonatomic, assign) uint32_t backgroundColor;
+
+@property (nonatomic, copy, nullable) ZGLocalCompositorOutputHandler outputHandler;
+
+/// Layers back to front, in output pixels like ZegoMixerTask; only video inputs are drawn, and a stream that
+/// appears more than once only at its first input
+- (void)setLayout:(NSArray<ZegoMixerInput *> *)inputs;
+
+/// Opacity of a stream's layer, 0.0 ~ 1.0, default 1.0
+- (void)setOpacity:(double)opacity forStreamID:(NSString *)streamID;
+
+- (void)start;
+
+- (void)stop;
+
+/// Drop the kept frame of a stream that stopped playing
+- (void)removeStream:(NSString *)streamID;
+
+- (ZGLocalCompositorStatistics *)statistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,342 @@
+//
+//  ZGLocalCompositor.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGLocalCompositor.h"
+#import <Accelerate/Accelerate.h>
+#import <pthread.h>
+#import "ZGMemoryAccountant.h"
+#import "ZGPixelKernels.h"
+#import "ZGVideoFrameUtilities.h"
+#import "ZGClock.h"
+
+/// Output buffers kept ready in the pool
+static const int ZGLocalCompositorPoolSize = 3;
+
+/// Output buffers the consumer may hold at once before frames are dropped
+static const int ZGLocalCompositorPoolLimit = 6;
+
+/// One layer of the layout with its scaled picture, kept across ticks while the rect keeps its size
+@interface ZGCompositorLayer : NSObject {
+    @public
+    vImage_Buffer _scaled;
+}
+
+@property (nonatomic, copy) NSString *streamID;
+/// In output pixels, clipped to the output
+@property (nonatomic, assign) CGRect rect;
+@property (nonatomic, assign) double opacity;
+/// The stream had a frame this tick
+@property (nonatomic, assign) BOOL hasFrame;
+@property (nonatomic, strong, nullable) ZGMemoryAllocation *allocation;
+
+@end
+
+@implementation ZGCompositorLayer
+
+- (void)dealloc {
+    free(_scaled.data);
+    if (_allocation) {
+        [[ZGMemoryAccountant sharedAccountant] releaseAllocation:_allocation];
+    }
+}
+
+/// Size the scratch buffer to the rect
+- (BOOL)prepareScratch {
+    vImagePixelCount width = (vImagePixelCount)self.rect.size.width;
+    vImagePixelCount height = (vImagePixelCount)self.rect.size.height;
+    if (_scaled.data && _scaled.width == width && _scaled.height == height) {
+        return YES;
+    }
+    free(_scaled.data);
+    _scaled.data = NULL;
+    if (vImageBuffer_Init(&_scaled, height, width, 32, kvImageNoFlags) != kvImageNoError) {
+        _scaled.data = NULL;
+        return NO;
+    }
+    size_t bytes = _scaled.rowBytes * _scaled.height;
+    ZGMemoryAccountant *accountant = [ZGMemoryAccountant sharedAccountant];
+    if (self.allocation) {
+        [accountant resizeAllocation:self.allocation toBytes:bytes];
+    } else {
+        self.allocation = [accountant trackBytes:bytes streamID:self.streamID subsystem:ZGMemorySubsystemCompositor label:@"compositor layer"];
+    }
+    return YES;
+}
+
+@end
+
+@implementation ZGLocalCompositorStatistics
+
+@end
+
+@interface ZGLocalCompositor () {
+    pthread_mutex_t _frameLock;
+    CVPixelBufferPoolRef _pool;
+}
+
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong, nullable) dispatch_source_t timer;
+
+/// Newest CVPixelBuffer of each stream, guarded by _frameLock since render callbacks come from SDK threads
+@property (nonatomic, strong) NSMutableDictionary<NSString *, id> *latestFrames;
+
+// Everything below is only touched on `queue`
+@property (nonatomic, strong) NSArray<ZGCompositorLayer *> *layers;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *opacities;
+@property (nonatomic, strong, nullable) ZGMemoryAllocation *poolAllocation;
+@property (nonatomic, strong) ZGLocalCompositorStatistics *counters;
+@property (nonatomic, assign) double totalComposeMs;
+
+@end
+
+@implementation ZGLocalCompositor
+
+- (instancetype)initWithOutputSize:(CGSize)outputSize frameRate:(double)frameRate {
+    // The tick interval is derived from it
+    if (!isfinite(frameRate) || frameRate <= 0) {
+        return nil;
+    }
+    self = [super init];
+    if (self) {
+        _outputSize = CGSizeMake(floor(outputSize.width), floor(outputSize.height));
+        _frameRate = frameRate;
+        _backgroundColor = 0xFF000000;
+        _queue = dispatch_queue_create("im.zego.compositor", DISPATCH_QUEUE_SERIAL);
+        pthread_mutex_init(&_frameLock, NULL);
+        _latestFrames = [NSMutableDictionary dictionary];
+        _layers = @[];
+        _opacities = [NSMutableDictionary dictionary];
+        _counters = [[ZGLocalCompositorStatistics alloc] init];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_timer) {
+        dispatch_source_cancel(_timer);
+    }
+    if (_pool) {
+        CVPixelBufferPoolRelease(_pool);
+    }
+    if (_poolAllocation) {
+        [[ZGMemoryAccountant sharedAccountant] releaseAllocation:_poolAllocation];
+    }
+    pthread_mutex_destroy(&_frameLock);
+}
+
+#pragma mark - Lifecycle
+
+- (void)start {
+    dispatch_async(self.queue, ^{
+        if (self.timer || ![self preparePool]) {
+            return;
+        }
+        __weak typeof(self) weakSelf = self;
+        uint64_t interval = (uint64_t)(NSEC_PER_SEC / self.frameRate);
+        self.timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.queue);
+        // Strict leeway, the cadence is what the recorder and encoder see
+        dispatch_source_set_timer(self.timer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)interval), interval, interval / 50);
+        dispatch_source_set_event_handler(self.timer, ^{
+            [weakSelf compose];
+        });
+        dispatch_resume(self.timer);
+    });
+}
+
+- (void)stop {
+    dispatch_async(self.queue, ^{
+        if (self.timer) {
+            dispatch_source_cancel(self.timer);
+            self.timer = nil;
+        }
+    });
+}
+
+- (BOOL)preparePool {
+    if (_pool) {
+        return YES;
+    }
+    NSDictionary *poolAttributes = @{(id)kCVPixelBufferPoolMinimumBufferCountKey: @(ZGLocalCompositorPoolSize)};
+    NSDictionary *bufferAttributes = @{
+        (id)kCVPixelBufferPixelFormatTypeKey: @(kCVPixelFormatType_32BGRA),
+        (id)kCVPixelBufferWidthKey: @(self.outputSize.width),
+        (id)kCVPixelBufferHeightKey: @(self.outputSize.height),
+        (id)kCVPixelBufferIOSurfacePropertiesKey: @{}
+    };
+    if (CVPixelBufferPoolCreate(kCFAllocatorDefault, (__bridge CFDictionaryRef)poolAttributes, (__bridge CFDictionaryRef)bufferAttributes, &_pool) != kCVReturnSuccess) {
+        return NO;
+    }
+    size_t bytes = (size_t)(self.outputSize.width * self.outputSize.height * 4) * ZGLocalCompositorPoolSize;
+    self.poolAllocation = [[ZGMemoryAccountant sharedAccountant] trackBytes:bytes streamID:nil subsystem:ZGMemorySubsystemCompositor label:[NSString stringWithFormat:@"compositor output %.0fx%.0f", self.outputSize.width, self.outputSize.height]];
+    return YES;
+}
+
+- (ZGLocalCompositorStatistics *)statistics {
+    ZGLocalCompositorStatistics *snapshot = [[ZGLocalCompositorStatistics alloc] init];
+    dispatch_sync(self.queue, ^{
+        snapshot.composedFrames = self.counters.composedFrames;
+        snapshot.missingLayers = self.counters.missingLayers;
+        snapshot.droppedFrames = self.counters.droppedFrames;
+        snapshot.averageComposeMs = self.counters.composedFrames > 0 ? self.totalComposeMs / self.counters.composedFrames : 0;
+        snapshot.maxComposeMs = self.counters.maxComposeMs;
+    });
+    return snapshot;
+}
+
+#pragma mark - Layout
+
+- (void)setLayout:(NSArray<ZegoMixerInput *> *)inputs {
+    dispatch_async(self.queue, ^{
+        NSMutableDictionary<NSString *, ZGCompositorLayer *> *previous = [NSMutableDictionary dictionary];
+        for (ZGCompositorLayer *layer in self.layers) {
+            previous[layer.streamID] = layer;
+        }
+        CGRect bounds = CGRectMake(0, 0, self.outputSize.width, self.outputSize.height);
+        NSMutableArray<ZGCompositorLayer *> *layers = [NSMutableArray array];
+        NSMutableSet<NSString *> *streamIDs = [NSMutableSet set];
+        for (ZegoMixerInput *input in inputs) {
+            CGRect rect = CGRectIntersection(CGRectIntegral(input.layout), bounds);
+            if (input.contentType != ZegoMixerInputContentTypeVideo || CGRectIsEmpty(rect)) {
+                continue;
+            }
+            // Layers of one stream would share a layer object, scaled into concurrently by compose
+            if (!input.streamID || [streamIDs containsObject:input.streamID]) {
+                continue;
+            }
+            [streamIDs addObject:input.streamID];
+            // Keeping the layer keeps its scratch buffer
+            ZGCompositorLayer *layer = previous[input.streamID] ?: [[ZGCompositorLayer alloc] init];
+            layer.streamID = input.streamID;
+            layer.rect = rect;
+            layer.opacity = self.opacities[input.streamID] ? self.opacities[input.streamID].doubleValue : 1;
+            [layers addObject:layer];
+        }
+        self.layers = layers;
+    });
+}
+
+- (void)setOpacity:(double)opacity forStreamID:(NSString *)streamID {
+    dispatch_async(self.queue, ^{
+        double clamped = MAX(0, MIN(1, opacity));
+        self.opacities[streamID] = @(clamped);
+        for (ZGCompositorLayer *layer in self.layers) {
+            if ([layer.streamID isEqualToString:streamID]) {
+                layer.opacity = clamped;
+            }
+        }
+    });
+}
+
+- (void)removeStream:(NSString *)streamID {
+    pthread_mutex_lock(&_frameLock);
+    [self.latestFrames removeObjectForKey:streamID];
+    pthread_mutex_unlock(&_frameLock);
+}
+
+#pragma mark - ZegoCustomVideoRenderHandler
+
+- (void)onRemoteVideoFrameCVPixelBuffer:(CVPixelBufferRef)buffer param:(ZegoVideoFrameParam *)param streamID:(NSString *)streamID {
+    if (CVPixelBufferGetPixelFormatType(buffer) != kCVPixelFormatType_32BGRA) {
+        return;
+    }
+    pthread_mutex_lock(&_frameLock);
+    self.latestFrames[streamID] = (__bridge id)buffer;
+    pthread_mutex_unlock(&_frameLock);
+}
+
+#pragma mark - Composition
+
+- (void)compose {
+    double startTime = ZGClockNow();
+
+    pthread_mutex_lock(&_frameLock);
+    NSDictionary<NSString *, id> *frames = [self.latestFrames copy];
+    pthread_mutex_unlock(&_frameLock);
+
+    CVPixelBufferRef output = NULL;
+    NSDictionary *auxAttributes = @{(id)kCVPixelBufferPoolAllocationThresholdKey: @(ZGLocalCompositorPoolLimit)};
+    if (CVPixelBufferPoolCreatePixelBufferWithAuxAttributes(kCFAllocatorDefault, _pool, (__bridge CFDictionaryRef)auxAttributes, &output) != kCVReturnSuccess) {
+        self.counters.droppedFrames += 1;
+        return;
+    }
+
+    NSArray<ZGCompositorLayer *> *layers = self.layers;
+    dispatch_queue_t workers = dispatch_get_global_queue(QOS_CLASS_USER_INTERACTIVE, 0);
+
+    // Scale every layer into its own scratch buffer, one layer per worker
+    dispatch_apply(layers.count, workers, ^(size_t index) {
+        ZGCompositorLayer *layer = layers[index];
+        CVPixelBufferRef source = (__bridge CVPixelBufferRef)frames[layer.streamID];
+        layer.hasFrame = source && [layer prepareScratch] && ZGScaleAspectFillBGRA(source, &layer->_scaled, kvImageDoNotTile);
+    });
+
+    CVPixelBufferLockBaseAddress(output, 0);
+    vImage_Buffer destination = {
+        .data = CVPixelBufferGetBaseAddress(output),
+        .height = CVPixelBufferGetHeight(output),
+        .width = CVPixelBufferGetWidth(output),
+        .rowBytes = CVPixelBufferGetBytesPerRow(output)
+    };
+    uint32_t color = self.backgroundColor;
+    Pixel_8888 background = {color & 0xFF, (color >> 8) & 0xFF, (color >> 16) & 0xFF, color >> 24};
+
+    // Blend back to front in horizontal bands, bands never overlap so workers need no locking
+    size_t bandCount = MAX(1, MIN([NSProcessInfo processInfo].activeProcessorCount, destination.height / 16));
+    size_t bandHeight = (destination.height + bandCount - 1) / bandCount;
+    dispatch_apply(bandCount, workers, ^(size_t band) {
+        size_t top = band * bandHeight;
+        size_t bottom = MIN(top + bandHeight, destination.height);
+        if (top >= bottom) {
+            return;
+        }
+        vImage_Buffer rows = destination;
+        rows.data = (uint8_t *)destination.data + top * destination.rowBytes;
+        rows.height = bottom - top;
+        vImageBufferFill_ARGB8888(&rows, background, kvImageDoNotTile);
+
+        for (ZGCompositorLayer *layer in layers) {
+            if (!layer.hasFrame || layer.opacity <= 0) {
+                continue;
+            }
+            size_t layerTop = (size_t)CGRectGetMinY(layer.rect);
+            size_t from = MAX(top, layerTop);
+            size_t to = MIN(bottom, layerTop + layer->_scaled.height);
+            size_t x = (size_t)CGRectGetMinX(layer.rect);
+            size_t rowBytes = layer->_scaled.width * 4;
+            uint16_t alpha256 = (uint16_t)lround(layer.opacity * 256);
+            for (size_t y = from; y < to; y++) {
+                uint8_t *dst = (uint8_t *)destination.data + y * destination.rowBytes + x * 4;
+                const uint8_t *src = (const uint8_t *)layer->_scaled.data + (y - layerTop) * layer->_scaled.rowBytes;
+                if (alpha256 >= 256) {
+                    memcpy(dst, src, rowBytes);
+                } else {
+                    ZGBlendRowConstAlpha(dst, src, rowBytes, alpha256);
+                }
+            }
+        }
+    });
+    CVPixelBufferUnlockBaseAddress(output, 0);
+
+    for (ZGCompositorLayer *layer in layers) {
+        if (!layer.hasFrame) {
+            self.counters.missingLayers += 1;
+        }
+    }
+    double composeMs = (ZGClockNow() - startTime) * 1000;
+    self.counters.composedFrames += 1;
+    self.counters.maxComposeMs = MAX(self.counters.maxComposeMs, composeMs);
+    self.totalComposeMs += composeMs;
+
+    ZGLocalCompositorOutputHandler handler = self.outputHandler;
+    if (handler) {
+        handler(output, CMTimeMakeWithSeconds(startTime, 1000));
+    }
+    CVPixelBufferRelease(output);
+}
+
+@end
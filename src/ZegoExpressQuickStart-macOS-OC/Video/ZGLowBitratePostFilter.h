@@ -0,0 +1,72 @@
+//
+//  ZGLowBitratePostFilter.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <ZegoExpressEngine/ZegoExpressEngine.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface ZGLowBitratePostFilterStatistics : NSObject
+
+@property (nonatomic, assign) NSUInteger frames;
+/// Frames that went through at least deblocking and denoise
+@property (nonatomic, assign) NSUInteger filteredFrames;
+/// Filtered frames that were also upscaled here
+@property (nonatomic, assign) NSUInteger upscaledFrames;
+@property (nonatomic, assign) NSUInteger overBudgetFrames;
+@property (nonatomic, assign) double averageFilterMs;
+
+@end
+
+/// Cleans up small video layers that are shown much larger than they were encoded, on the custom render path
+///
+/// Sits between the engine and the real render handler (e.g. ZGLocalCompositor): register the filter as the
+/// custom video render handler and it forwards every callback to `nextHandler`. Remote BGRA32 frames of a stream
+/// whose display size is more than `activationRatio` times its frame size are filtered first: the 8 x 8 block
+/// edges of the codec are deblocked where they are flat, the picture is denoised against the previous filtered
+/// frame where it did not move, and it is doubled with an edge-directed interpolation (each new pixel is the
+/// average along the direction of least change) before a final scale to the display size.
+///
+/// Each frame must fit in `budgetMs`. A frame over budget drops the stream to the next cheaper step, first
+/// forwarding the filtered frame at its own size for the renderer to scale, then not filtering at all; after
+/// `recoveryFrames` frames well under budget it steps back up. Scratch and output buffers are accounted to
+/// ZGMemorySubsystemRender.
+@interface ZGLowBitratePostFilter : NSObject <ZegoCustomVideoRenderHandler>
+
+- (instancetype)initWithNextHandler:(id<ZegoCustomVideoRenderHandler>)nextHandler;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, strong, readonly) id<ZegoCustomVideoRenderHandler> nextHandler;
+
+/// Display to frame size ratio above which a stream is filtered, default 1.5
+@property (nonatomic, assign) double activationRatio;
+
+/// Default 4, a quarter of a 60 fps frame
+@property (nonatomic, assign) double budgetMs;
+
+/// Default 30
+@property (nonatomic, assign) NSUInteger recoveryFrames;
+
+/// Largest step across a block edge still taken as an artefact, 0 turns deblocking off, default 24
+@property (nonatomic, assign) int deblockThreshold;
+
+/// Largest frame to frame change still taken as noise, 0 turns denoise off, default 6
+@property (nonatomic, assign) int denoiseThreshold;
+
+/// Size in pixels the stream is shown at, CGSizeZero when it is not shown (the filter stays off)
+- (void)setDisplaySize:(CGSize)size forStreamID:(NSString *)streamID;
+
+/// Drop the state of a stream that stopped playing
+- (void)removeStream:(NSString *)streamID;
+
+- (ZGLowBitratePostFilterStatistics *)statistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
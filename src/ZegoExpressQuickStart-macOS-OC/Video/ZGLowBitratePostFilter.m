@@ -0,0 +1,423 @@
+//
+//  ZGLowBitratePostFilter.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGLowBitratePostFilter.h"
+#import <Accelerate/Accelerate.h>
+#import <pthread.h>
+#import "ZGMemoryAccountant.h"
+#import "ZGPixelKernels.h"
+#import "ZGClock.h"
+
+/// Output buffers per pool, enough for the renderer to hold a couple
+static const int ZGLowBitratePostFilterPoolSize = 3;
+
+/// Luma difference below which neither interpolation direction is preferred
+static const int ZGLowBitratePostFilterDirectionThreshold = 8;
+
+/// Cheaper steps a stream drops to when it runs over budget
+typedef NS_ENUM(NSUInteger, ZGPostFilterStep) {
+    ZGPostFilterStepUpscale = 0,
+    ZGPostFilterStepFilterOnly = 1,
+    ZGPostFilterStepOff = 2
+};
+
+#pragma mark - Kernels
+
+static inline uint32_t ZGLoadPixel(const uint8_t *p) {
+    uint32_t pixel;
+    memcpy(&pixel, p, sizeof(pixel));
+    return pixel;
+}
+
+/// Approximate luma of a BGRA pixel
+static inline int ZGPixelLuma(uint32_t pixel) {
+    return (int)(((pixel & 0xFF) + 5 * ((pixel >> 8) & 0xFF) + 2 * ((pixel >> 16) & 0xFF)) >> 3);
+}
+
+/// Per byte average of two pixels
+static inline uint32_t ZGAveragePixels(uint32_t a, uint32_t b) {
+    return (a | b) - (((a ^ b) & 0xFEFEFEFE) >> 1);
+}
+
+/// Average along a-b or along c-d, whichever changes less, or all four when neither is clearly flatter
+static inline uint32_t ZGInterpolateDirected(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+    int first = abs(ZGPixelLuma(a) - ZGPixelLuma(b));
+    int second = abs(ZGPixelLuma(c) - ZGPixelLuma(d));
+    if (first + ZGLowBitratePostFilterDirectionThreshold < second) {
+        return ZGAveragePixels(a, b);
+    }
+    if (second + ZGLowBitratePostFilterDirectionThreshold < first) {
+        return ZGAveragePixels(c, d);
+    }
+    return ZGAveragePixels(ZGAveragePixels(a, b), ZGAveragePixels(c, d));
+}
+
+/// Double a packed BGRA picture with edge-directed interpolation
+///
+/// Pixels at odd rows and columns are interpolated first along the flatter diagonal, then the remaining ones
+/// along the flatter of their horizontal and vertical neighbours, which by then all exist.
+static void ZGDoubleEdgeDirected(const uint8_t *src, size_t width, size_t height, uint8_t *dst) {
+    size_t srcStride = width * 4;
+    size_t dstStride = width * 8;
+    for (size_t y = 0; y < height; y++) {
+        size_t y1 = MIN(y + 1, height - 1);
+        for (size_t x = 0; x < width; x++) {
+            size_t x1 = MIN(x + 1, width - 1);
+            uint32_t a = ZGLoadPixel(src + y * srcStride + x * 4);
+            uint32_t b = ZGLoadPixel(src + y * srcStride + x1 * 4);
+            uint32_t c = ZGLoadPixel(src + y1 * srcStride + x * 4);
+            uint32_t d = ZGLoadPixel(src + y1 * srcStride + x1 * 4);
+            uint32_t centre = ZGInterpolateDirected(a, d, b, c);
+            memcpy(dst + 2 * y * dstStride + 2 * x * 4, &a, 4);
+            memcpy(dst + (2 * y + 1) * dstStride + (2 * x + 1) * 4, &centre, 4);
+        }
+    }
+    for (size_t y = 0; y < height; y++) {
+        size_t y1 = MIN(y + 1, height - 1);
+        for (size_t x = 0; x < width; x++) {
+            size_t x1 = MIN(x + 1, width - 1);
+            uint32_t here = ZGLoadPixel(src + y * srcStride + x * 4);
+            uint32_t centre = ZGLoadPixel(dst + (2 * y + 1) * dstStride + (2 * x + 1) * 4);
+            uint32_t centreAbove = y > 0 ? ZGLoadPixel(dst + (2 * y - 1) * dstStride + (2 * x + 1) * 4) : centre;
+            uint32_t centreLeft = x > 0 ? ZGLoadPixel(dst + (2 * y + 1) * dstStride + (2 * x - 1) * 4) : centre;
+            uint32_t right = ZGInterpolateDirected(here, ZGLoadPixel(src + y * srcStride + x1 * 4), centreAbove, centre);
+            uint32_t below = ZGInterpolateDirected(here, ZGLoadPixel(src + y1 * srcStride + x * 4), centreLeft, centre);
+            memcpy(dst + 2 * y * dstStride + (2 * x + 1) * 4, &right, 4);
+            memcpy(dst + (2 * y + 1) * dstStride + 2 * x * 4, &below, 4);
+        }
+    }
+}
+
+#pragma mark - Stream
+
+@implementation ZGLowBitratePostFilterStatistics
+
+@end
+
+/// Filter state of one stream
+@interface ZGPostFilterStream : NSObject
+
+@property (nonatomic, copy) NSString *streamID;
+/// Guarded by the filter's lock
+@property (nonatomic, assign) CGSize displaySize;
+
+// Only touched by the render thread
+@property (nonatomic, assign) size_t width;
+@property (nonatomic, assign) size_t height;
+/// The frame being filtered, packed
+@property (nonatomic, strong) NSMutableData *work;
+/// The previous filtered frame
+@property (nonatomic, strong) NSMutableData *history;
+@property (nonatomic, assign) BOOL hasHistory;
+/// Pixels either side of a vertical block edge, gathered into rows
+@property (nonatomic, strong) NSMutableData *columns;
+@property (nonatomic, strong) NSMutableData *doubled;
+/// CVPixelBufferPool by "<width>x<height>"
+@property (nonatomic, strong) NSMutableDictionary<NSString *, id> *pools;
+@property (nonatomic, assign) ZGPostFilterStep step;
+@property (nonatomic, assign) NSUInteger calmFrames;
+@property (nonatomic, strong, nullable) ZGMemoryAllocation *allocation;
+@property (nonatomic, assign) size_t poolBytes;
+
+@end
+
+@implementation ZGPostFilterStream
+
+- (void)dealloc {
+    if (_allocation) {
+        [[ZGMemoryAccountant sharedAccountant] releaseAllocation:_allocation];
+    }
+}
+
+@end
+
+#pragma mark - Filter
+
+@interface ZGLowBitratePostFilter () {
+    pthread_mutex_t _lock;
+}
+
+@property (nonatomic, strong, readwrite) id<ZegoCustomVideoRenderHandler> nextHandler;
+
+// Guarded by _lock
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZGPostFilterStream *> *streams;
+@property (nonatomic, strong) ZGLowBitratePostFilterStatistics *counters;
+@property (nonatomic, assign) double totalFilterMs;
+
+@end
+
+@implementation ZGLowBitratePostFilter
+
+- (instancetype)initWithNextHandler:(id<ZegoCustomVideoRenderHandler>)nextHandler {
+    self = [super init];
+    if (self) {
+        _nextHandler = nextHandler;
+        _activationRatio = 1.5;
+        _budgetMs = 4;
+        _recoveryFrames = 30;
+        _deblockThreshold = 24;
+        _denoiseThreshold = 6;
+        pthread_mutex_init(&_lock, NULL);
+        _streams = [NSMutableDictionary dictionary];
+        _counters = [[ZGLowBitratePostFilterStatistics alloc] init];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    pthread_mutex_destroy(&_lock);
+}
+
+- (void)setDisplaySize:(CGSize)size forStreamID:(NSString *)streamID {
+    pthread_mutex_lock(&_lock);
+    ZGPostFilterStream *stream = self.streams[streamID];
+    if (!stream) {
+        stream = [[ZGPostFilterStream alloc] init];
+        stream.streamID = streamID;
+        stream.pools = [NSMutableDictionary dictionary];
+        self.streams[streamID] = stream;
+    }
+    stream.displaySize = CGSizeMake(floor(size.width), floor(size.height));
+    pthread_mutex_unlock(&_lock);
+}
+
+- (void)removeStream:(NSString *)streamID {
+    pthread_mutex_lock(&_lock);
+    [self.streams removeObjectForKey:streamID];
+    pthread_mutex_unlock(&_lock);
+}
+
+- (ZGLowBitratePostFilterStatistics *)statistics {
+    ZGLowBitratePostFilterStatistics *snapshot = [[ZGLowBitratePostFilterStatistics alloc] init];
+    pthread_mutex_lock(&_lock);
+    snapshot.frames = self.counters.frames;
+    snapshot.filteredFrames = self.counters.filteredFrames;
+    snapshot.upscaledFrames = self.counters.upscaledFrames;
+    snapshot.overBudgetFrames = self.counters.overBudgetFrames;
+    snapshot.averageFilterMs = self.counters.filteredFrames > 0 ? self.totalFilterMs / self.counters.filteredFrames : 0;
+    pthread_mutex_unlock(&_lock);
+    return snapshot;
+}
+
+#pragma mark - Forwarding
+
+- (BOOL)respondsToSelector:(SEL)aSelector {
+    return [super respondsToSelector:aSelector] || [self.nextHandler respondsToSelector:aSelector];
+}
+
+- (id)forwardingTargetForSelector:(SEL)aSelector {
+    return [self.nextHandler respondsToSelector:aSelector] ? self.nextHandler : [super forwardingTargetForSelector:aSelector];
+}
+
+#pragma mark - ZegoCustomVideoRenderHandler
+
+- (void)onRemoteVideoFrameCVPixelBuffer:(CVPixelBufferRef)buffer param:(ZegoVideoFrameParam *)param streamID:(NSString *)streamID {
+    if (![self.nextHandler respondsToSelector:_cmd]) {
+        return;
+    }
+    CVPixelBufferRef filtered = CVPixelBufferGetPixelFormatType(buffer) == kCVPixelFormatType_32BGRA ? [self createFilteredFrom:buffer streamID:streamID] : NULL;
+    if (!filtered) {
+        [self.nextHandler onRemoteVideoFrameCVPixelBuffer:buffer param:param streamID:streamID];
+        return;
+    }
+    int strides[4] = {(int)CVPixelBufferGetBytesPerRow(filtered), 0, 0, 0};
+    ZegoVideoFrameParam *filteredParam = [[ZegoVideoFrameParam alloc] init];
+    filteredParam.format = ZegoVideoFrameFormatBGRA32;
+    filteredParam.size = CGSizeMake(CVPixelBufferGetWidth(filtered), CVPixelBufferGetHeight(filtered));
+    filteredParam.strides = strides;
+    [self.nextHandler onRemoteVideoFrameCVPixelBuffer:filtered param:filteredParam streamID:streamID];
+    CVPixelBufferRelease(filtered);
+}
+
+#pragma mark - Filtering
+
+- (nullable CVPixelBufferRef)createFilteredFrom:(CVPixelBufferRef)source streamID:(NSString *)streamID CF_RETURNS_RETAINED {
+    double startTime = ZGClockNow();
+    size_t width = CVPixelBufferGetWidth(source);
+    size_t height = CVPixelBufferGetHeight(source);
+    pthread_mutex_lock(&_lock);
+    self.counters.frames++;
+    ZGPostFilterStream *stream = self.streams[streamID];
+    CGSize displaySize = stream.displaySize;
+    pthread_mutex_unlock(&_lock);
+
+    double ratio = MAX(displaySize.width / width, displaySize.height / height);
+    if (!stream || width < 8 || height < 8 || ratio <= self.activationRatio) {
+        stream.hasHistory = NO;
+        return NULL;
+    }
+    if (stream.step == ZGPostFilterStepOff) {
+        // Probe the cheaper step again once in a while
+        if (++stream.calmFrames >= self.recoveryFrames) {
+            stream.step = ZGPostFilterStepFilterOnly;
+            stream.calmFrames = 0;
+        }
+        stream.hasHistory = NO;
+        return NULL;
+    }
+    [self prepareStream:stream width:width height:height];
+
+    size_t rowBytes = width * 4;
+    uint8_t *work = stream.work.mutableBytes;
+    CVPixelBufferLockBaseAddress(source, kCVPixelBufferLock_ReadOnly);
+    const uint8_t *sourceBytes = CVPixelBufferGetBaseAddress(source);
+    size_t sourceRowBytes = CVPixelBufferGetBytesPerRow(source);
+    for (size_t y = 0; y < height; y++) {
+        memcpy(work + y * rowBytes, sourceBytes + y * sourceRowBytes, rowBytes);
+    }
+    CVPixelBufferUnlockBaseAddress(source, kCVPixelBufferLock_ReadOnly);
+
+    if (self.deblockThreshold > 0) {
+        [self deblock:stream];
+    }
+    if (self.denoiseThreshold > 0) {
+        if (stream.hasHistory) {
+            ZGTemporalDenoiseRow(work, stream.history.mutableBytes, rowBytes * height, (int16_t)self.denoiseThreshold);
+        } else {
+            memcpy(stream.history.mutableBytes, work, rowBytes * height);
+            stream.hasHistory = YES;
+        }
+    }
+
+    // Upscaling is the expensive part, skip it when filtering already took half the budget
+    BOOL upscale = stream.step == ZGPostFilterStepUpscale && (ZGClockNow() - startTime) * 1000 < self.budgetMs / 2;
+    CVPixelBufferRef output = upscale ? [self createBufferForStream:stream width:(size_t)displaySize.width height:(size_t)displaySize.height]
+                                      : [self createBufferForStream:stream width:width height:height];
+    if (!output) {
+        return NULL;
+    }
+    CVPixelBufferLockBaseAddress(output, 0);
+    uint8_t *outputBytes = CVPixelBufferGetBaseAddress(output);
+    size_t outputRowBytes = CVPixelBufferGetBytesPerRow(output);
+    if (upscale) {
+        ZGDoubleEdgeDirected(work, width, height, stream.doubled.mutableBytes);
+        vImage_Buffer doubled = {stream.doubled.mutableBytes, height * 2, width * 2, rowBytes * 2};
+        vImage_Buffer destination = {outputBytes, CVPixelBufferGetHeight(output), CVPixelBufferGetWidth(output), outputRowBytes};
+        vImageScale_ARGB8888(&doubled, &destination, NULL, kvImageNoFlags);
+    } else {
+        for (size_t y = 0; y < height; y++) {
+            memcpy(outputBytes + y * outputRowBytes, work + y * rowBytes, rowBytes);
+        }
+    }
+    CVPixelBufferUnlockBaseAddress(output, 0);
+
+    double filterMs = (ZGClockNow() - startTime) * 1000;
+    BOOL overBudget = filterMs > self.budgetMs;
+    if (overBudget) {
+        stream.step = MIN(stream.step + 1, ZGPostFilterStepOff);
+        stream.calmFrames = 0;
+    } else if (filterMs < self.budgetMs / 2 && stream.step > ZGPostFilterStepUpscale) {
+        if (++stream.calmFrames >= self.recoveryFrames) {
+            stream.step--;
+            stream.calmFrames = 0;
+        }
+    } else {
+        stream.calmFrames = 0;
+    }
+
+    pthread_mutex_lock(&_lock);
+    self.counters.filteredFrames++;
+    self.counters.upscaledFrames += upscale ? 1 : 0;
+    self.counters.overBudgetFrames += overBudget ? 1 : 0;
+    self.totalFilterMs += filterMs;
+    pthread_mutex_unlock(&_lock);
+    return output;
+}
+
+- (void)deblock:(ZGPostFilterStream *)stream {
+    size_t width = stream.width;
+    size_t height = stream.height;
+    size_t rowBytes = width * 4;
+    uint8_t *work = stream.work.mutableBytes;
+    int16_t alpha = (int16_t)self.deblockThreshold;
+    int16_t beta = (int16_t)MAX(1, self.deblockThreshold / 4);
+    int16_t tc = (int16_t)MAX(1, self.deblockThreshold / 6);
+
+    // Horizontal edges: the four rows around the edge are already contiguous
+    for (size_t y = 8; y + 1 < height; y += 8) {
+        ZGDeblockEdge8(work + (y - 2) * rowBytes, work + (y - 1) * rowBytes, work + y * rowBytes, work + (y + 1) * rowBytes, rowBytes, alpha, beta, tc);
+    }
+
+    // Vertical edges: gather the two pixels either side of the edge into rows, filter, scatter back
+    uint8_t *p1 = stream.columns.mutableBytes;
+    uint8_t *p0 = p1 + height * 4;
+    uint8_t *q0 = p0 + height * 4;
+    uint8_t *q1 = q0 + height * 4;
+    for (size_t x = 8; x + 1 < width; x += 8) {
+        for (size_t y = 0; y < height; y++) {
+            const uint8_t *edge = work + y * rowBytes + (x - 2) * 4;
+            memcpy(p1 + y * 4, edge, 4);
+            memcpy(p0 + y * 4, edge + 4, 4);
+            memcpy(q0 + y * 4, edge + 8, 4);
+            memcpy(q1 + y * 4, edge + 12, 4);
+        }
+        ZGDeblockEdge8(p1, p0, q0, q1, height * 4, alpha, beta, tc);
+        for (size_t y = 0; y < height; y++) {
+            uint8_t *edge = work + y * rowBytes + (x - 2) * 4;
+            memcpy(edge + 4, p0 + y * 4, 4);
+            memcpy(edge + 8, q0 + y * 4, 4);
+        }
+    }
+}
+
+#pragma mark - Helper Methods
+
+- (void)prepareStream:(ZGPostFilterStream *)stream width:(size_t)width height:(size_t)height {
+    if (stream.width == width && stream.height == height) {
+        return;
+    }
+    stream.width = width;
+    stream.height = height;
+    stream.work = [NSMutableData dataWithLength:width * height * 4];
+    stream.history = [NSMutableData dataWithLength:width * height * 4];
+    stream.hasHistory = NO;
+    stream.columns = [NSMutableData dataWithLength:height * 16];
+    stream.doubled = [NSMutableData dataWithLength:width * height * 16];
+    [stream.pools removeAllObjects];
+    stream.poolBytes = 0;
+    [self updateAllocationOfStream:stream];
+}
+
+- (CVPixelBufferRef)createBufferForStream:(ZGPostFilterStream *)stream width:(size_t)width height:(size_t)height {
+    NSString *key = [NSString stringWithFormat:@"%zux%zu", width, height];
+    CVPixelBufferPoolRef pool = (__bridge CVPixelBufferPoolRef)stream.pools[key];
+    if (!pool) {
+        // One pool for the frame size and one for the display size, older display sizes are let go
+        if (stream.pools.count >= 2) {
+            [stream.pools removeAllObjects];
+            stream.poolBytes = 0;
+        }
+        NSDictionary *poolAttributes = @{(id)kCVPixelBufferPoolMinimumBufferCountKey: @(ZGLowBitratePostFilterPoolSize)};
+        NSDictionary *bufferAttributes = @{
+            (id)kCVPixelBufferPixelFormatTypeKey: @(kCVPixelFormatType_32BGRA),
+            (id)kCVPixelBufferWidthKey: @(width),
+            (id)kCVPixelBufferHeightKey: @(height),
+            (id)kCVPixelBufferIOSurfacePropertiesKey: @{}
+        };
+        if (CVPixelBufferPoolCreate(kCFAllocatorDefault, (__bridge CFDictionaryRef)poolAttributes, (__bridge CFDictionaryRef)bufferAttributes, &pool) != kCVReturnSuccess) {
+            return NULL;
+        }
+        stream.pools[key] = CFBridgingRelease(pool);
+        stream.poolBytes += width * height * 4 * ZGLowBitratePostFilterPoolSize;
+        [self updateAllocationOfStream:stream];
+    }
+    CVPixelBufferRef buffer = NULL;
+    CVPixelBufferPoolCreatePixelBuffer(kCFAllocatorDefault, pool, &buffer);
+    return buffer;
+}
+
+- (void)updateAllocationOfStream:(ZGPostFilterStream *)stream {
+    size_t bytes = stream.work.length + stream.history.length + stream.columns.length + stream.doubled.length + stream.poolBytes;
+    if (stream.allocation) {
+        [[ZGMemoryAccountant sharedAccountant] resizeAllocation:stream.allocation toBytes:bytes];
+    } else {
+        stream.allocation = [[ZGMemoryAccountant sharedAccountant] trackBytes:bytes streamID:stream.streamID subsystem:ZGMemorySubsystemRender label:@"post filter"];
+    }
+}
+
+@end
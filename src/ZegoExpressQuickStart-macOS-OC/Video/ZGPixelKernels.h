@@ -0,0 +1,281 @@
+//
+//  ZGPixelKernels.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#ifndef ZGPixelKernels_h
+#define ZGPixelKernels_h
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// Row kernels shared by the video stages, written on 16 byte vectors the compiler maps to SSE / NEON
+
+typedef uint8_t ZGU8x16 __attribute__((vector_size(16)));
+typedef uint8_t ZGU8x8 __attribute__((vector_size(8)));
+typedef uint16_t ZGU16x16 __attribute__((vector_size(32)));
+typedef uint16_t ZGU16x4 __attribute__((vector_size(8)));
+typedef uint32_t ZGU32x8 __attribute__((vector_size(32)));
+typedef uint64_t ZGU64x4 __attribute__((vector_size(32)));
+typedef int16_t ZGS16x16 __attribute__((vector_size(32)));
+
+static inline ZGU16x16 ZGWiden16(const uint8_t *p) {
+    ZGU8x16 v;
+    memcpy(&v, p, sizeof(v));
+    return __builtin_convertvector(v, ZGU16x16);
+}
+
+static inline void ZGNarrow16(uint8_t *p, ZGU16x16 v) {
+    ZGU8x16 n = __builtin_convertvector(v, ZGU8x16);
+    memcpy(p, &n, sizeof(n));
+}
+
+static inline ZGS16x16 ZGWidenSigned16(const uint8_t *p) {
+    return __builtin_convertvector(ZGWiden16(p), ZGS16x16);
+}
+
+/// Lanes are masks of all ones or zeros, as vector comparisons yield
+static inline ZGS16x16 ZGSelect16(ZGS16x16 mask, ZGS16x16 a, ZGS16x16 b) {
+    return (a & mask) | (b & ~mask);
+}
+
+static inline ZGS16x16 ZGAbs16(ZGS16x16 v) {
+    ZGS16x16 sign = v >> 15;
+    return (v ^ sign) - sign;
+}
+
+static inline ZGS16x16 ZGClamp16(ZGS16x16 v, int16_t low, int16_t high) {
+    ZGS16x16 lows = (ZGS16x16){0} + low;
+    ZGS16x16 highs = (ZGS16x16){0} + high;
+    v = ZGSelect16(v < lows, lows, v);
+    return ZGSelect16(v > highs, highs, v);
+}
+
+/// dst = src * alpha + dst * (1 - alpha) over `bytes` bytes of any interleaving
+///
+/// @param alpha256 Weight of `src`, 0 ~ 256
+static inline void ZGBlendRowConstAlpha(uint8_t *dst, const uint8_t *src, size_t bytes, uint16_t alpha256) {
+    uint16_t inverse = 256 - alpha256;
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        ZGU16x16 s = ZGWiden16(src + i);
+        ZGU16x16 d = ZGWiden16(dst + i);
+        ZGNarrow16(dst + i, (s * alpha256 + d * inverse) >> 8);
+    }
+    for (; i < bytes; i++) {
+        dst[i] = (uint8_t)((src[i] * alpha256 + dst[i] * inverse) >> 8);
+    }
+}
+
+/// dst = src * mask + dst * (1 - mask) over `pixels` 4 byte pixels, one mask byte (0 ~ 255) per pixel
+static inline void ZGBlendRowMask4(uint8_t *dst, const uint8_t *src, const uint8_t *mask, size_t pixels) {
+    size_t i = 0;
+    for (; i + 4 <= pixels; i += 4) {
+        uint32_t m;
+        memcpy(&m, mask + i, sizeof(m));
+        if (m == 0) {
+            continue;
+        }
+        if (m == 0xFFFFFFFF) {
+            memcpy(dst + 4 * i, src + 4 * i, 16);
+            continue;
+        }
+        ZGU16x16 alpha;
+        for (int lane = 0; lane < 16; lane++) {
+            // 255 maps to 256 so an opaque mask copies exactly
+            uint16_t a = mask[i + lane / 4];
+            alpha[lane] = a + (a >> 7);
+        }
+        ZGU16x16 s = ZGWiden16(src + 4 * i);
+        ZGU16x16 d = ZGWiden16(dst + 4 * i);
+        ZGNarrow16(dst + 4 * i, (s * alpha + d * (256 - alpha)) >> 8);
+    }
+    for (; i < pixels; i++) {
+        uint16_t a = mask[i] + (mask[i] >> 7);
+        for (int c = 0; c < 4; c++) {
+            dst[4 * i + c] = (uint8_t)((src[4 * i + c] * a + dst[4 * i + c] * (256 - a)) >> 8);
+        }
+    }
+}
+
+/// Largest premultiplied value ZGBlendRowPremultiplied8 can take at `alpha` without overflowing
+static inline uint8_t ZGPremultipliedLimit(uint8_t alpha) {
+    uint16_t a = alpha + (alpha >> 7);
+    return (uint8_t)(255 - ((255 * (256 - a)) >> 8));
+}
+
+/// dst = premultiplied + dst * (1 - alpha) over `bytes` bytes, one alpha byte per byte of dst
+///
+/// Spans of 16 transparent bytes are skipped; `premultiplied` must not exceed ZGPremultipliedLimit(alpha).
+static inline void ZGBlendRowPremultiplied8(uint8_t *dst, const uint8_t *premultiplied, const uint8_t *alpha, size_t bytes) {
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        uint64_t halves[2];
+        memcpy(halves, alpha + i, sizeof(halves));
+        if ((halves[0] | halves[1]) == 0) {
+            continue;
+        }
+        ZGU16x16 a = ZGWiden16(alpha + i);
+        a = a + (a >> 7);
+        ZGNarrow16(dst + i, ZGWiden16(premultiplied + i) + ((ZGWiden16(dst + i) * (256 - a)) >> 8));
+    }
+    for (; i < bytes; i++) {
+        uint16_t a = alpha[i] + (alpha[i] >> 7);
+        dst[i] = (uint8_t)(premultiplied[i] + ((dst[i] * (256 - a)) >> 8));
+    }
+}
+
+/// Smooth a block edge between p0 and q0 across `bytes` bytes, in the manner of the H.264 normal filter
+///
+/// p1 p0 | q0 q1 are the two samples either side of the edge. Where the step across the edge is below `alpha`
+/// and each side is flat within `beta`, so it is a blocking artefact rather than a real edge, p0 and q0 move
+/// toward each other by at most `tc`.
+static inline void ZGDeblockEdge8(const uint8_t *p1, uint8_t *p0, uint8_t *q0, const uint8_t *q1, size_t bytes, int16_t alpha, int16_t beta, int16_t tc) {
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        ZGS16x16 P1 = ZGWidenSigned16(p1 + i);
+        ZGS16x16 P0 = ZGWidenSigned16(p0 + i);
+        ZGS16x16 Q0 = ZGWidenSigned16(q0 + i);
+        ZGS16x16 Q1 = ZGWidenSigned16(q1 + i);
+        ZGS16x16 mask = (ZGAbs16(P0 - Q0) < alpha) & (ZGAbs16(P1 - P0) < beta) & (ZGAbs16(Q1 - Q0) < beta);
+        uint64_t lanes[4];
+        memcpy(lanes, &mask, sizeof(lanes));
+        if ((lanes[0] | lanes[1] | lanes[2] | lanes[3]) == 0) {
+            continue;
+        }
+        ZGS16x16 delta = ZGClamp16((((Q0 - P0) * 4) + (P1 - Q1) + 4) >> 3, -tc, tc) & mask;
+        ZGNarrow16(p0 + i, __builtin_convertvector(ZGClamp16(P0 + delta, 0, 255), ZGU16x16));
+        ZGNarrow16(q0 + i, __builtin_convertvector(ZGClamp16(Q0 - delta, 0, 255), ZGU16x16));
+    }
+    for (; i < bytes; i++) {
+        int P1 = p1[i], P0 = p0[i], Q0 = q0[i], Q1 = q1[i];
+        if (abs(P0 - Q0) >= alpha || abs(P1 - P0) >= beta || abs(Q1 - Q0) >= beta) {
+            continue;
+        }
+        int delta = (((Q0 - P0) * 4) + (P1 - Q1) + 4) >> 3;
+        delta = delta < -tc ? -tc : (delta > tc ? tc : delta);
+        p0[i] = (uint8_t)(P0 + delta < 0 ? 0 : (P0 + delta > 255 ? 255 : P0 + delta));
+        q0[i] = (uint8_t)(Q0 - delta < 0 ? 0 : (Q0 - delta > 255 ? 255 : Q0 - delta));
+    }
+}
+
+/// Recursive temporal denoise: bytes within `threshold` of `history` are averaged with it, larger changes are
+/// taken as motion and kept; `history` becomes the result
+static inline void ZGTemporalDenoiseRow(uint8_t *row, uint8_t *history, size_t bytes, int16_t threshold) {
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        ZGS16x16 current = ZGWidenSigned16(row + i);
+        ZGS16x16 previous = ZGWidenSigned16(history + i);
+        ZGS16x16 average = (current + previous + 1) >> 1;
+        ZGS16x16 result = ZGSelect16(ZGAbs16(current - previous) <= threshold, average, current);
+        ZGNarrow16(row + i, __builtin_convertvector(result, ZGU16x16));
+        memcpy(history + i, row + i, 16);
+    }
+    for (; i < bytes; i++) {
+        if (abs(row[i] - history[i]) <= threshold) {
+            row[i] = (uint8_t)((row[i] + history[i] + 1) >> 1);
+        }
+        history[i] = row[i];
+    }
+}
+
+/// dst = a - b per byte, wrapping, so unchanged bytes become zero
+static inline void ZGSubtractBytes(uint8_t *dst, const uint8_t *a, const uint8_t *b, size_t bytes) {
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        ZGU8x16 va, vb;
+        memcpy(&va, a + i, sizeof(va));
+        memcpy(&vb, b + i, sizeof(vb));
+        va -= vb;
+        memcpy(dst + i, &va, sizeof(va));
+    }
+    for (; i < bytes; i++) {
+        dst[i] = (uint8_t)(a[i] - b[i]);
+    }
+}
+
+/// dst += delta per byte, wrapping, undoing ZGSubtractBytes
+static inline void ZGAddBytes(uint8_t *dst, const uint8_t *delta, size_t bytes) {
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        ZGU8x16 vd, vs;
+        memcpy(&vd, dst + i, sizeof(vd));
+        memcpy(&vs, delta + i, sizeof(vs));
+        vd += vs;
+        memcpy(dst + i, &vd, sizeof(vd));
+    }
+    for (; i < bytes; i++) {
+        dst[i] = (uint8_t)(dst[i] + delta[i]);
+    }
+}
+
+/// Halve a row of an 8 bit plane, averaging 2 x 2 blocks of `row0` and `row1` into `dstWidth` pixels
+static inline void ZGHalveRowPlanar8(uint8_t *dst, const uint8_t *row0, const uint8_t *row1, size_t dstWidth) {
+    size_t i = 0;
+    for (; i + 8 <= dstWidth; i += 8) {
+        ZGU16x16 sum = ZGWiden16(row0 + 2 * i) + ZGWiden16(row1 + 2 * i);
+        // Neighbouring 16 bit lanes seen as one 32 bit lane (little endian): add them pairwise
+        ZGU32x8 pairs;
+        memcpy(&pairs, &sum, sizeof(pairs));
+        pairs = ((pairs & 0xFFFF) + (pairs >> 16) + 2) >> 2;
+        ZGU8x8 out = __builtin_convertvector(pairs, ZGU8x8);
+        memcpy(dst + i, &out, sizeof(out));
+    }
+    for (; i < dstWidth; i++) {
+        dst[i] = (uint8_t)((row0[2 * i] + row0[2 * i + 1] + row1[2 * i] + row1[2 * i + 1] + 2) >> 2);
+    }
+}
+
+/// Halve a row of an interleaved CbCr plane (NV12), `dstWidth` counts CbCr pairs
+static inline void ZGHalveRowCbCr8(uint8_t *dst, const uint8_t *row0, const uint8_t *row1, size_t dstWidth) {
+    size_t i = 0;
+    for (; i + 4 <= dstWidth; i += 4) {
+        ZGU16x16 sum = ZGWiden16(row0 + 4 * i) + ZGWiden16(row1 + 4 * i);
+        // Each 64 bit lane holds Cb0 Cr0 Cb1 Cr1; adding its halves yields Cb and Cr sums in two 16 bit lanes
+        ZGU64x4 quads;
+        memcpy(&quads, &sum, sizeof(quads));
+        quads = (((quads & 0xFFFFFFFF) + (quads >> 32) + 0x00020002) >> 2) & 0x3FFF3FFF;
+        quads = (quads & 0xFF) | ((quads >> 8) & 0xFF00);
+        ZGU16x4 out = __builtin_convertvector(quads, ZGU16x4);
+        memcpy(dst + 2 * i, &out, sizeof(out));
+    }
+    for (; i < dstWidth; i++) {
+        for (size_t c = 0; c < 2; c++) {
+            dst[2 * i + c] = (uint8_t)((row0[4 * i + c] + row0[4 * i + 2 + c] + row1[4 * i + c] + row1[4 * i + 2 + c] + 2) >> 2);
+        }
+    }
+}
+
+/// Bilinear resample of an 8 bit plane with `channels` interleaved channels; any upscale, downscales beyond 2:1 alias
+static inline void ZGScaleBilinear8(const uint8_t *src, size_t srcWidth, size_t srcHeight, size_t srcStride,
+                                    uint8_t *dst, size_t dstWidth, size_t dstHeight, size_t dstStride, size_t channels) {
+    // 16.16 fixed point, sampling at pixel centres
+    uint32_t stepX = (uint32_t)((srcWidth << 16) / dstWidth);
+    uint32_t stepY = (uint32_t)((srcHeight << 16) / dstHeight);
+    for (size_t y = 0; y < dstHeight; y++) {
+        int64_t fy = (int64_t)(y * stepY + stepY / 2) - 0x8000;
+        size_t y0 = fy < 0 ? 0 : (size_t)(fy >> 16);
+        size_t y1 = y0 + 1 < srcHeight ? y0 + 1 : srcHeight - 1;
+        uint32_t wy = fy < 0 ? 0 : (uint32_t)(fy & 0xFFFF) >> 8;
+        const uint8_t *r0 = src + y0 * srcStride;
+        const uint8_t *r1 = src + y1 * srcStride;
+        uint8_t *out = dst + y * dstStride;
+        for (size_t x = 0; x < dstWidth; x++) {
+            int64_t fx = (int64_t)(x * stepX + stepX / 2) - 0x8000;
+            size_t x0 = fx < 0 ? 0 : (size_t)(fx >> 16);
+            size_t x1 = x0 + 1 < srcWidth ? x0 + 1 : srcWidth - 1;
+            uint32_t wx = fx < 0 ? 0 : (uint32_t)(fx & 0xFFFF) >> 8;
+            for (size_t c = 0; c < channels; c++) {
+                uint32_t top = r0[x0 * channels + c] * (256 - wx) + r0[x1 * channels + c] * wx;
+                uint32_t bottom = r1[x0 * channels + c] * (256 - wx) + r1[x1 * channels + c] * wx;
+                out[x * channels + c] = (uint8_t)((top * (256 - wy) + bottom * wy + 32768) >> 16);
+            }
+        }
+    }
+}
+
+#endif /* ZGPixelKernels_h */
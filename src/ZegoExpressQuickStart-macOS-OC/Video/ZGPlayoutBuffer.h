@@ -0,0 +1,75 @@
+//
+//  ZGPlayoutBuffer.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreMedia/CoreMedia.h>
+#import <ZegoExpressEngine/ZegoExpressEngine.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface ZGPlayoutBufferStatistics : NSObject
+
+/// Occupancy: frames waiting, and the media time they span
+@property (nonatomic, assign) NSUInteger bufferedFrames;
+@property (nonatomic, assign) double bufferedMs;
+/// Delay the buffer aims for, and the one it plays at while slewing toward it
+@property (nonatomic, assign) double targetDelayMs;
+@property (nonatomic, assign) double currentDelayMs;
+/// Arrival jitter at the percentile `smoothness` asks for
+@property (nonatomic, assign) double jitterMs;
+@property (nonatomic, assign) NSUInteger presentedFrames;
+/// Frames skipped because a newer one was already due, or the buffer was full
+@property (nonatomic, assign) NSUInteger droppedFrames;
+/// Frames that arrived after their presentation time
+@property (nonatomic, assign) NSUInteger lateFrames;
+
+@end
+
+/// Smooths out bursty arrival of remote frames before they reach the renderer
+///
+/// Register the buffer as the custom video render handler; it forwards every callback to `nextHandler`, remote
+/// CVPixelBuffer frames after holding them in a per-stream queue. Each frame is presented at its media time plus
+/// the stream's clock offset (the earliest arrival seen, following slow drift) plus a target delay. The target
+/// delay is a percentile of the measured arrival jitter, chosen by `smoothness`, and the delay actually applied
+/// moves toward it at no more than 10% of real time, so playback speeds up or slows down rather than jumps.
+/// When several frames are due at once only the newest is presented.
+///
+/// The render callback carries no timestamps in this SDK, so media times of frames from it are rebuilt from the
+/// long-run average frame interval; sources that know their timestamps use enqueueFrame:param:timeStamp:streamID:.
+/// Frames are forwarded on a private queue. Held frames are accounted to ZGMemorySubsystemPlayout.
+@interface ZGPlayoutBuffer : NSObject <ZegoCustomVideoRenderHandler>
+
+- (instancetype)initWithNextHandler:(id<ZegoCustomVideoRenderHandler>)nextHandler;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, strong, readonly) id<ZegoCustomVideoRenderHandler> nextHandler;
+
+/// Latency against smoothness, 0 ~ 1, default 0.5
+///
+/// 0 covers the median jitter and keeps latency lowest, 1 covers 99% of it plus a frame interval.
+@property (nonatomic, assign) double smoothness;
+
+/// Bounds of the target delay, default 0 and 500 ms
+@property (nonatomic, assign) double minDelayMs;
+@property (nonatomic, assign) double maxDelayMs;
+
+/// Per stream, the oldest frame is dropped beyond this, default 30
+@property (nonatomic, assign) NSUInteger maxBufferedFrames;
+
+/// Buffer a frame whose media time is known
+- (void)enqueueFrame:(CVPixelBufferRef)buffer param:(ZegoVideoFrameParam *)param timeStamp:(CMTime)timeStamp streamID:(NSString *)streamID;
+
+/// Drop the frames and timing of a stream that stopped playing
+- (void)removeStream:(NSString *)streamID;
+
+- (nullable ZGPlayoutBufferStatistics *)statisticsForStreamID:(NSString *)streamID;
+
+@end
+
+NS_ASSUME_NONNULL_END
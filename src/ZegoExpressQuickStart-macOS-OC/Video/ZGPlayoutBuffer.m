@@ -0,0 +1,343 @@
+//
+//  ZGPlayoutBuffer.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGPlayoutBuffer.h"
+#import "ZGMemoryAccountant.h"
+#import "ZGClock.h"
+
+/// Jitter samples the percentile is taken over
+static const NSUInteger ZGPlayoutJitterWindow = 128;
+
+/// The target delay is recomputed every this many frames
+static const NSUInteger ZGPlayoutTargetUpdateInterval = 8;
+
+/// Most the applied delay changes per second of real time, i.e. playback runs at 90% ~ 110% speed
+static const double ZGPlayoutMaxSlewRate = 0.1;
+
+/// How fast the clock offset may creep up to follow a sender clock that runs slow, seconds per second
+static const double ZGPlayoutDriftAllowance = 0.001;
+
+/// Media time jumps beyond this restart the stream's timeline
+static const double ZGPlayoutDiscontinuity = 2.0;
+
+/// Weight of a new inter-arrival time in the frame interval of streams without timestamps
+static const double ZGPlayoutIntervalSmoothing = 0.02;
+
+/// A gap in arrivals of streams without timestamps longer than this many frame intervals means frames were lost
+static const double ZGPlayoutGapIntervals = 3.0;
+
+/// Frames due within this are presented now, the timer's own leeway
+static const double ZGPlayoutLeeway = 0.001;
+
+@implementation ZGPlayoutBufferStatistics
+
+@end
+
+/// A held frame
+@interface ZGPlayoutFrame : NSObject {
+@public
+    int _strides[4];
+}
+
+@property (nonatomic, assign) CVPixelBufferRef buffer;
+@property (nonatomic, strong) ZegoVideoFrameParam *param;
+@property (nonatomic, assign) double mediaTime;
+@property (nonatomic, assign) double arrivalTime;
+@property (nonatomic, assign) size_t bytes;
+
+@end
+
+@implementation ZGPlayoutFrame
+
+- (void)dealloc {
+    CVPixelBufferRelease(_buffer);
+}
+
+@end
+
+/// Queue and timing of one stream
+@interface ZGPlayoutStream : NSObject {
+@public
+    double _jitters[ZGPlayoutJitterWindow];
+}
+
+@property (nonatomic, copy) NSString *streamID;
+@property (nonatomic, strong) NSMutableArray<ZGPlayoutFrame *> *frames;
+/// NAN until the first frame
+@property (nonatomic, assign) double lastMediaTime;
+@property (nonatomic, assign) double lastArrivalTime;
+/// Frame interval of streams without timestamps
+@property (nonatomic, assign) double frameInterval;
+/// Earliest arrival relative to media time, NAN until the first frame
+@property (nonatomic, assign) double clockOffset;
+@property (nonatomic, assign) NSUInteger jitterCount;
+@property (nonatomic, assign) double jitter;
+@property (nonatomic, assign) double targetDelay;
+@property (nonatomic, assign) double delay;
+@property (nonatomic, assign) double lastSlewTime;
+@property (nonatomic, strong) ZGPlayoutBufferStatistics *counters;
+@property (nonatomic, strong) ZGMemoryAllocation *allocation;
+@property (nonatomic, assign) size_t bufferedBytes;
+
+@end
+
+@implementation ZGPlayoutStream
+
+- (void)dealloc {
+    [[ZGMemoryAccountant sharedAccountant] releaseAllocation:_allocation];
+}
+
+@end
+
+@interface ZGPlayoutBuffer ()
+
+@property (nonatomic, strong, readwrite) id<ZegoCustomVideoRenderHandler> nextHandler;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) dispatch_source_t timer;
+
+// Only touched on `queue`
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZGPlayoutStream *> *streams;
+
+@end
+
+@implementation ZGPlayoutBuffer
+
+- (instancetype)initWithNextHandler:(id<ZegoCustomVideoRenderHandler>)nextHandler {
+    self = [super init];
+    if (self) {
+        _nextHandler = nextHandler;
+        _smoothness = 0.5;
+        _minDelayMs = 0;
+        _maxDelayMs = 500;
+        _maxBufferedFrames = 30;
+        _queue = dispatch_queue_create("im.zego.playout", DISPATCH_QUEUE_SERIAL);
+        _streams = [NSMutableDictionary dictionary];
+
+        // One timer for all streams, armed for the earliest due frame
+        __weak typeof(self) weakSelf = self;
+        _timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, _queue);
+        dispatch_source_set_timer(_timer, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+        dispatch_source_set_event_handler(_timer, ^{
+            [weakSelf presentDueFrames];
+        });
+        dispatch_resume(_timer);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    dispatch_source_cancel(_timer);
+}
+
+- (void)removeStream:(NSString *)streamID {
+    dispatch_async(self.queue, ^{
+        [self.streams removeObjectForKey:streamID];
+    });
+}
+
+- (ZGPlayoutBufferStatistics *)statisticsForStreamID:(NSString *)streamID {
+    __block ZGPlayoutBufferStatistics *snapshot = nil;
+    dispatch_sync(self.queue, ^{
+        ZGPlayoutStream *stream = self.streams[streamID];
+        if (!stream) {
+            return;
+        }
+        snapshot = [[ZGPlayoutBufferStatistics alloc] init];
+        snapshot.bufferedFrames = stream.frames.count;
+        snapshot.bufferedMs = stream.frames.count > 0 ? (stream.frames.lastObject.mediaTime - stream.frames.firstObject.mediaTime) * 1000 : 0;
+        snapshot.targetDelayMs = stream.targetDelay * 1000;
+        snapshot.currentDelayMs = stream.delay * 1000;
+        snapshot.jitterMs = stream.jitter * 1000;
+        snapshot.presentedFrames = stream.counters.presentedFrames;
+        snapshot.droppedFrames = stream.counters.droppedFrames;
+        snapshot.lateFrames = stream.counters.lateFrames;
+    });
+    return snapshot;
+}
+
+#pragma mark - Forwarding
+
+- (BOOL)respondsToSelector:(SEL)aSelector {
+    return [super respondsToSelector:aSelector] || [self.nextHandler respondsToSelector:aSelector];
+}
+
+- (id)forwardingTargetForSelector:(SEL)aSelector {
+    return [self.nextHandler respondsToSelector:aSelector] ? self.nextHandler : [super forwardingTargetForSelector:aSelector];
+}
+
+#pragma mark - ZegoCustomVideoRenderHandler
+
+- (void)onRemoteVideoFrameCVPixelBuffer:(CVPixelBufferRef)buffer param:(ZegoVideoFrameParam *)param streamID:(NSString *)streamID {
+    [self enqueueFrame:buffer param:param mediaTime:NAN streamID:streamID];
+}
+
+#pragma mark - Buffering
+
+- (void)enqueueFrame:(CVPixelBufferRef)buffer param:(ZegoVideoFrameParam *)param timeStamp:(CMTime)timeStamp streamID:(NSString *)streamID {
+    [self enqueueFrame:buffer param:param mediaTime:CMTimeGetSeconds(timeStamp) streamID:streamID];
+}
+
+/// @param mediaTime NAN to rebuild it from arrival times
+- (void)enqueueFrame:(CVPixelBufferRef)buffer param:(ZegoVideoFrameParam *)param mediaTime:(double)mediaTime streamID:(NSString *)streamID {
+    ZGPlayoutFrame *frame = [[ZGPlayoutFrame alloc] init];
+    frame.buffer = CVPixelBufferRetain(buffer);
+    frame.arrivalTime = ZGClockNow();
+    frame.bytes = CVPixelBufferGetDataSize(buffer);
+    // The engine's strides only live for the callback
+    ZegoVideoFrameParam *heldParam = [[ZegoVideoFrameParam alloc] init];
+    heldParam.format = param.format;
+    heldParam.size = param.size;
+    size_t planeCount = MIN(MAX(CVPixelBufferGetPlaneCount(buffer), (size_t)1), (size_t)4);
+    for (size_t i = 0; i < planeCount && param.strides; i++) {
+        frame->_strides[i] = param.strides[i];
+    }
+    heldParam.strides = frame->_strides;
+    frame.param = heldParam;
+
+    dispatch_async(self.queue, ^{
+        ZGPlayoutStream *stream = [self streamForID:streamID];
+        [self timeFrame:frame mediaTime:mediaTime stream:stream];
+        [stream.frames addObject:frame];
+        stream.bufferedBytes += frame.bytes;
+        while (stream.frames.count > MAX(1, self.maxBufferedFrames)) {
+            stream.bufferedBytes -= stream.frames.firstObject.bytes;
+            [stream.frames removeObjectAtIndex:0];
+            stream.counters.droppedFrames++;
+        }
+        [[ZGMemoryAccountant sharedAccountant] resizeAllocation:stream.allocation toBytes:stream.bufferedBytes];
+        [self presentDueFrames];
+    });
+}
+
+/// Give the frame a media time and fold its arrival into the stream's clock offset and jitter
+- (void)timeFrame:(ZGPlayoutFrame *)frame mediaTime:(double)mediaTime stream:(ZGPlayoutStream *)stream {
+    double arrival = frame.arrivalTime;
+    BOOL rebuilt = isnan(mediaTime);
+    if (rebuilt && !isnan(stream.lastMediaTime)) {
+        double interArrival = arrival - stream.lastArrivalTime;
+        if (interArrival > ZGPlayoutGapIntervals * stream.frameInterval) {
+            // Frames were lost in a freeze: advance by the frames that would have come, or every later frame
+            // stays late by the gap, which the clock offset only creeps back from at the drift allowance
+            mediaTime = stream.lastMediaTime + floor(interArrival / stream.frameInterval) * stream.frameInterval;
+        } else {
+            stream.frameInterval += (MIN(MAX(interArrival, 0.005), 0.2) - stream.frameInterval) * ZGPlayoutIntervalSmoothing;
+            mediaTime = stream.lastMediaTime + stream.frameInterval;
+        }
+    } else if (rebuilt) {
+        mediaTime = 0;
+    }
+
+    // A discontinuity, or a rebuilt timeline that drifted away from arrivals, starts over
+    double lateness = arrival - mediaTime - stream.clockOffset;
+    if (isnan(stream.clockOffset) || fabs(mediaTime - stream.lastMediaTime) > ZGPlayoutDiscontinuity || lateness > ZGPlayoutDiscontinuity) {
+        stream.clockOffset = arrival - mediaTime;
+    } else {
+        stream.clockOffset = MIN(stream.clockOffset + (arrival - stream.lastArrivalTime) * ZGPlayoutDriftAllowance, arrival - mediaTime);
+    }
+    frame.mediaTime = mediaTime;
+    stream.lastMediaTime = mediaTime;
+    stream.lastArrivalTime = arrival;
+
+    stream->_jitters[stream.jitterCount % ZGPlayoutJitterWindow] = arrival - mediaTime - stream.clockOffset;
+    stream.jitterCount++;
+    if (stream.jitterCount % ZGPlayoutTargetUpdateInterval == 1) {
+        [self updateTargetDelayOfStream:stream];
+    }
+    if (arrival > [self presentationTimeOfFrame:frame stream:stream]) {
+        stream.counters.lateFrames++;
+    }
+}
+
+- (void)updateTargetDelayOfStream:(ZGPlayoutStream *)stream {
+    NSUInteger count = MIN(stream.jitterCount, ZGPlayoutJitterWindow);
+    double sorted[ZGPlayoutJitterWindow];
+    memcpy(sorted, stream->_jitters, sizeof(double) * count);
+    qsort_b(sorted, count, sizeof(double), ^int(const void *a, const void *b) {
+        double difference = *(const double *)a - *(const double *)b;
+        return difference < 0 ? -1 : (difference > 0 ? 1 : 0);
+    });
+    double smoothness = MIN(MAX(self.smoothness, 0), 1);
+    double percentile = 0.5 + 0.49 * smoothness;
+    stream.jitter = sorted[MIN(count - 1, (NSUInteger)(percentile * count))];
+    double interval = stream.frameInterval > 0 ? stream.frameInterval : 1.0 / 30;
+    double target = stream.jitter + smoothness * interval;
+    stream.targetDelay = MIN(MAX(target, self.minDelayMs / 1000), self.maxDelayMs / 1000);
+}
+
+#pragma mark - Presentation
+
+- (void)presentDueFrames {
+    double now = ZGClockNow();
+    double nextDue = INFINITY;
+    BOOL forwards = [self.nextHandler respondsToSelector:@selector(onRemoteVideoFrameCVPixelBuffer:param:streamID:)];
+    for (ZGPlayoutStream *stream in self.streams.allValues) {
+        [self slewDelayOfStream:stream now:now];
+
+        // The newest due frame wins, older due ones are skipped
+        NSUInteger due = 0;
+        while (due < stream.frames.count && [self presentationTimeOfFrame:stream.frames[due] stream:stream] <= now + ZGPlayoutLeeway) {
+            due++;
+        }
+        if (due > 0) {
+            ZGPlayoutFrame *frame = stream.frames[due - 1];
+            for (NSUInteger i = 0; i < due; i++) {
+                stream.bufferedBytes -= stream.frames[i].bytes;
+            }
+            [stream.frames removeObjectsInRange:NSMakeRange(0, due)];
+            stream.counters.droppedFrames += due - 1;
+            stream.counters.presentedFrames++;
+            [[ZGMemoryAccountant sharedAccountant] resizeAllocation:stream.allocation toBytes:stream.bufferedBytes];
+            if (forwards) {
+                [self.nextHandler onRemoteVideoFrameCVPixelBuffer:frame.buffer param:frame.param streamID:stream.streamID];
+            }
+        }
+        if (stream.frames.count > 0) {
+            nextDue = MIN(nextDue, [self presentationTimeOfFrame:stream.frames.firstObject stream:stream]);
+        }
+    }
+
+    if (isinf(nextDue)) {
+        dispatch_source_set_timer(self.timer, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+    } else {
+        int64_t wait = (int64_t)(MAX(nextDue - ZGClockNow(), 0) * NSEC_PER_SEC);
+        dispatch_source_set_timer(self.timer, dispatch_time(DISPATCH_TIME_NOW, wait), DISPATCH_TIME_FOREVER, (uint64_t)(ZGPlayoutLeeway * NSEC_PER_SEC));
+    }
+}
+
+- (double)presentationTimeOfFrame:(ZGPlayoutFrame *)frame stream:(ZGPlayoutStream *)stream {
+    return frame.mediaTime + stream.clockOffset + stream.delay;
+}
+
+- (void)slewDelayOfStream:(ZGPlayoutStream *)stream now:(double)now {
+    double maxStep = (now - stream.lastSlewTime) * ZGPlayoutMaxSlewRate;
+    stream.delay += MIN(MAX(stream.targetDelay - stream.delay, -maxStep), maxStep);
+    stream.lastSlewTime = now;
+}
+
+#pragma mark - Helper Methods
+
+- (ZGPlayoutStream *)streamForID:(NSString *)streamID {
+    ZGPlayoutStream *stream = self.streams[streamID];
+    if (!stream) {
+        stream = [[ZGPlayoutStream alloc] init];
+        stream.streamID = streamID;
+        stream.frames = [NSMutableArray array];
+        stream.lastMediaTime = NAN;
+        stream.clockOffset = NAN;
+        stream.frameInterval = 1.0 / 30;
+        stream.targetDelay = self.minDelayMs / 1000;
+        stream.delay = stream.targetDelay;
+        stream.lastSlewTime = ZGClockNow();
+        stream.counters = [[ZGPlayoutBufferStatistics alloc] init];
+        stream.allocation = [[ZGMemoryAccountant sharedAccountant] trackBytes:0 streamID:streamID subsystem:ZGMemorySubsystemPlayout label:@"playout buffer"];
+        self.streams[streamID] = stream;
+    }
+    return stream;
+}
+
+@end
@@ -0,0 +1,76 @@
+//
+//  ZGPresenterComposer.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreMedia/CoreMedia.h>
+#import <ZegoExpressEngine/ZegoExpressEngine.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Receives every composed frame on the composer queue
+typedef void(^ZGPresenterComposerOutputHandler)(CVPixelBufferRef buffer, CMTime timeStamp);
+
+@interface ZGPresenterComposerStatistics : NSObject
+
+@property (nonatomic, assign) NSUInteger frames;
+/// Ticks skipped because consumers still held every output buffer the pool may allocate
+@property (nonatomic, assign) NSUInteger droppedFrames;
+/// Pixels actually recomposed, against what full redraws would have cost
+@property (nonatomic, assign) double composedPixels;
+@property (nonatomic, assign) double fullFramePixels;
+@property (nonatomic, assign) double averageComposeMs;
+
+@end
+
+/// Puts the camera as a rounded picture-in-picture onto the screen share, locally, for the aux channel
+///
+/// Feed screen frames (BGRA32, ideally with the dirty rects CGDisplayStream reports) and camera frames
+/// (BGRA32). At `frameRate` the composer takes an output buffer from a pool, redrawing only what changed since
+/// that buffer was last written: the screen's dirty rects and, when a camera frame arrived, the
+/// picture-in-picture rect. The camera is scaled once per camera frame and blended through an alpha mask with
+/// anti-aliased rounded corners that is computed when the layout changes; fully opaque and fully transparent
+/// mask spans are plain copies. Screen frames of another size than the output are scaled whole.
+///
+/// Without an outputHandler, frames go to sendCustomVideoCapturePixelBuffer:timeStamp:channel: on the aux
+/// channel of the shared engine. A buffer is only written again once every consumer released it, consumers
+/// may retain them as long as they need.
+@interface ZGPresenterComposer : NSObject
+
+/// @param frameRate Capped at 120
+/// @return nil when `frameRate` is not a positive number
+- (nullable instancetype)initWithOutputSize:(CGSize)outputSize frameRate:(double)frameRate;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, assign, readonly) CGSize outputSize;
+
+/// Output buffers kept ready in the pool, default 4, takes effect on the first `start`
+@property (nonatomic, assign) NSUInteger outputBufferCount;
+
+@property (nonatomic, copy, nullable) ZGPresenterComposerOutputHandler outputHandler;
+
+/// Where the camera goes in output pixels, and how round its corners are
+- (void)setPictureInPictureRect:(CGRect)rect cornerRadius:(CGFloat)cornerRadius;
+
+/// Hide or show the camera
+- (void)setPictureInPictureHidden:(BOOL)hidden;
+
+/// @param dirtyRects Changed areas in screen pixels, nil when unknown (the whole screen is redrawn)
+- (void)updateScreenFrame:(CVPixelBufferRef)buffer dirtyRects:(nullable NSArray<NSValue *> *)dirtyRects;
+
+- (void)updateCameraFrame:(CVPixelBufferRef)buffer;
+
+- (void)start;
+
+- (void)stop;
+
+- (ZGPresenterComposerStatistics *)statistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,478 @@
+//
+//  ZGPresenterComposer.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGPresenterComposer.h"
+#import <pthread.h>
+#import "ZGMemoryAccountant.h"
+#import "ZGPixelKernels.h"
+#import "ZGVideoFrameUtilities.h"
+#import "ZGClock.h"
+
+/// Dirty rects kept per output buffer before they are merged into their bounding box
+static const NSUInteger ZGPresenterComposerMaxDirtyRects = 8;
+
+/// Output buffers the consumers may hold at once before frames are dropped
+static const int ZGPresenterComposerPoolLimit = 8;
+
+/// Highest frame rate composed, beyond what a display or encoder would take
+static const double ZGPresenterComposerMaxFrameRate = 120;
+
+/// Attachment of a pooled output buffer holding its ZGPresenterOutput
+static NSString * const ZGPresenterOutputAttachment = @"ZGPresenterOutput";
+
+/// What changed since a pooled output buffer was last written, attached to the buffer so it lives as long
+@interface ZGPresenterOutput : NSObject
+
+@property (nonatomic, strong) NSMutableArray<NSValue *> *dirtyRects;
+
+@end
+
+@implementation ZGPresenterOutput
+
+@end
+
+@implementation ZGPresenterComposerStatistics
+
+@end
+
+@interface ZGPresenterComposer () {
+    pthread_mutex_t _inputLock;
+    CVPixelBufferPoolRef _pool;
+    /// Sent again while nothing changes
+    CVPixelBufferRef _lastOutput;
+    vImage_Buffer _screenCanvas;
+    vImage_Buffer _camera;
+}
+
+@property (nonatomic, assign) double frameRate;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong, nullable) dispatch_source_t timer;
+
+// Guarded by _inputLock, written by the capture threads
+@property (nonatomic, strong, nullable) id pendingScreen;
+/// nil when the whole screen changed
+@property (nonatomic, strong, nullable) NSMutableArray<NSValue *> *pendingScreenRects;
+@property (nonatomic, strong, nullable) id pendingCamera;
+
+// Everything below is only touched on `queue`
+/// Outputs of the pooled buffers that are still alive, weakly held
+@property (nonatomic, strong) NSHashTable<ZGPresenterOutput *> *outputs;
+/// The current screen frame when it has the output size, otherwise it was scaled into _screenCanvas
+@property (nonatomic, strong, nullable) id screen;
+@property (nonatomic, assign) BOOL hasScreen;
+@property (nonatomic, assign) BOOL hasCamera;
+@property (nonatomic, assign) CGRect pipRect;
+@property (nonatomic, assign) CGFloat cornerRadius;
+@property (nonatomic, assign) BOOL pipHidden;
+@property (nonatomic, strong) NSMutableData *mask;
+/// Layout changes waiting for the next tick
+@property (nonatomic, strong) NSMutableArray<NSValue *> *layoutRects;
+@property (nonatomic, strong) NSMutableArray<ZGMemoryAllocation *> *allocations;
+@property (nonatomic, strong, nullable) ZGMemoryAllocation *cameraAllocation;
+@property (nonatomic, strong) ZGPresenterComposerStatistics *counters;
+@property (nonatomic, assign) double totalComposeMs;
+
+@end
+
+@implementation ZGPresenterComposer
+
+- (instancetype)initWithOutputSize:(CGSize)outputSize frameRate:(double)frameRate {
+    // The tick interval is derived from it
+    if (!isfinite(frameRate) || frameRate <= 0) {
+        return nil;
+    }
+    self = [super init];
+    if (self) {
+        _outputSize = CGSizeMake((size_t)outputSize.width & ~(size_t)1, (size_t)outputSize.height & ~(size_t)1);
+        _frameRate = MIN(frameRate, ZGPresenterComposerMaxFrameRate);
+        _outputBufferCount = 4;
+        _queue = dispatch_queue_create("im.zego.presenter", DISPATCH_QUEUE_SERIAL);
+        pthread_mutex_init(&_inputLock, NULL);
+        _outputs = [NSHashTable weakObjectsHashTable];
+        _mask = [NSMutableData data];
+        _layoutRects = [NSMutableArray array];
+        _allocations = [NSMutableArray array];
+        _counters = [[ZGPresenterComposerStatistics alloc] init];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_timer) {
+        dispatch_source_cancel(_timer);
+    }
+    CVPixelBufferRelease(_lastOutput);
+    CVPixelBufferPoolRelease(_pool);
+    free(_screenCanvas.data);
+    free(_camera.data);
+    for (ZGMemoryAllocation *allocation in _allocations) {
+        [[ZGMemoryAccountant sharedAccountant] releaseAllocation:allocation];
+    }
+    pthread_mutex_destroy(&_inputLock);
+}
+
+#pragma mark - Lifecycle
+
+- (void)start {
+    dispatch_async(self.queue, ^{
+        if (self.timer || ![self preparePool]) {
+            return;
+        }
+        __weak typeof(self) weakSelf = self;
+        uint64_t interval = (uint64_t)(NSEC_PER_SEC / self.frameRate);
+        self.timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.queue);
+        dispatch_source_set_timer(self.timer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)interval), interval, interval / 50);
+        dispatch_source_set_event_handler(self.timer, ^{
+            [weakSelf compose];
+        });
+        dispatch_resume(self.timer);
+    });
+}
+
+- (void)stop {
+    dispatch_async(self.queue, ^{
+        if (self.timer) {
+            dispatch_source_cancel(self.timer);
+            self.timer = nil;
+        }
+    });
+}
+
+- (BOOL)preparePool {
+    if (_pool) {
+        return YES;
+    }
+    int poolSize = (int)MAX(2, self.outputBufferCount);
+    NSDictionary *poolAttributes = @{(id)kCVPixelBufferPoolMinimumBufferCountKey: @(poolSize)};
+    NSDictionary *bufferAttributes = @{
+        (id)kCVPixelBufferPixelFormatTypeKey: @(kCVPixelFormatType_32BGRA),
+        (id)kCVPixelBufferWidthKey: @(self.outputSize.width),
+        (id)kCVPixelBufferHeightKey: @(self.outputSize.height),
+        (id)kCVPixelBufferIOSurfacePropertiesKey: @{}
+    };
+    if (CVPixelBufferPoolCreate(kCFAllocatorDefault, (__bridge CFDictionaryRef)poolAttributes, (__bridge CFDictionaryRef)bufferAttributes, &_pool) != kCVReturnSuccess) {
+        return NO;
+    }
+    [self trackBytes:(size_t)(self.outputSize.width * self.outputSize.height * 4) * poolSize label:@"presenter output"];
+    return YES;
+}
+
+- (ZGPresenterComposerStatistics *)statistics {
+    ZGPresenterComposerStatistics *snapshot = [[ZGPresenterComposerStatistics alloc] init];
+    dispatch_sync(self.queue, ^{
+        snapshot.frames = self.counters.frames;
+        snapshot.droppedFrames = self.counters.droppedFrames;
+        snapshot.composedPixels = self.counters.composedPixels;
+        snapshot.fullFramePixels = self.counters.fullFramePixels;
+        snapshot.averageComposeMs = self.counters.frames > 0 ? self.totalComposeMs / self.counters.frames : 0;
+    });
+    return snapshot;
+}
+
+#pragma mark - Inputs
+
+- (void)setPictureInPictureRect:(CGRect)rect cornerRadius:(CGFloat)cornerRadius {
+    dispatch_async(self.queue, ^{
+        CGRect clipped = CGRectIntersection(CGRectIntegral(rect), [self bounds]);
+        [self.layoutRects addObject:[NSValue valueWithRect:self.pipRect]];
+        [self.layoutRects addObject:[NSValue valueWithRect:clipped]];
+        BOOL resized = !CGSizeEqualToSize(clipped.size, self.pipRect.size);
+        self.pipRect = clipped;
+        self.cornerRadius = cornerRadius;
+        [self rebuildMask];
+        if (resized) {
+            // The scaled camera has the old size, wait for the next camera frame
+            self.hasCamera = NO;
+        }
+    });
+}
+
+- (void)setPictureInPictureHidden:(BOOL)hidden {
+    dispatch_async(self.queue, ^{
+        if (self.pipHidden != hidden) {
+            self.pipHidden = hidden;
+            [self.layoutRects addObject:[NSValue valueWithRect:self.pipRect]];
+        }
+    });
+}
+
+- (void)updateScreenFrame:(CVPixelBufferRef)buffer dirtyRects:(NSArray<NSValue *> *)dirtyRects {
+    if (CVPixelBufferGetPixelFormatType(buffer) != kCVPixelFormatType_32BGRA) {
+        return;
+    }
+    pthread_mutex_lock(&_inputLock);
+    // Rects of a frame that was never composed still count
+    BOOL wholeScreen = !dirtyRects || (self.pendingScreen && !self.pendingScreenRects);
+    if (wholeScreen) {
+        self.pendingScreenRects = nil;
+    } else {
+        if (!self.pendingScreen) {
+            self.pendingScreenRects = [NSMutableArray array];
+        }
+        [self.pendingScreenRects addObjectsFromArray:dirtyRects];
+    }
+    self.pendingScreen = (__bridge id)buffer;
+    pthread_mutex_unlock(&_inputLock);
+}
+
+- (void)updateCameraFrame:(CVPixelBufferRef)buffer {
+    if (CVPixelBufferGetPixelFormatType(buffer) != kCVPixelFormatType_32BGRA) {
+        return;
+    }
+    pthread_mutex_lock(&_inputLock);
+    self.pendingCamera = (__bridge id)buffer;
+    pthread_mutex_unlock(&_inputLock);
+}
+
+#pragma mark - Composition
+
+- (void)compose {
+    double startTime = ZGClockNow();
+
+    pthread_mutex_lock(&_inputLock);
+    id newScreen = self.pendingScreen;
+    NSArray<NSValue *> *newScreenRects = self.pendingScreenRects;
+    id newCamera = self.pendingCamera;
+    self.pendingScreen = nil;
+    self.pendingScreenRects = nil;
+    self.pendingCamera = nil;
+    pthread_mutex_unlock(&_inputLock);
+
+    NSMutableArray<NSValue *> *changed = self.layoutRects;
+    self.layoutRects = [NSMutableArray array];
+    if (newScreen) {
+        [changed addObjectsFromArray:[self acceptScreen:(__bridge CVPixelBufferRef)newScreen dirtyRects:newScreenRects]];
+    }
+    if (newCamera && !CGRectIsEmpty(self.pipRect) && [self prepareCamera]) {
+        self.hasCamera = ZGScaleAspectFillBGRA((__bridge CVPixelBufferRef)newCamera, &_camera, kvImageNoFlags);
+        if (!self.pipHidden) {
+            [changed addObject:[NSValue valueWithRect:self.pipRect]];
+        }
+    }
+
+    // Nothing moved: the last frame is still right, send it again to keep the cadence
+    if (changed.count == 0 && _lastOutput) {
+        [self emitBuffer:_lastOutput timeStamp:startTime];
+        return;
+    }
+
+    for (ZGPresenterOutput *output in self.outputs) {
+        for (NSValue *rect in changed) {
+            [self addRect:rect.rectValue toRects:output.dirtyRects];
+        }
+    }
+
+    // A buffer only comes back from the pool once the SDK and every other holder let go of it
+    CVPixelBufferRef buffer = NULL;
+    NSDictionary *auxAttributes = @{(id)kCVPixelBufferPoolAllocationThresholdKey: @(ZGPresenterComposerPoolLimit)};
+    if (CVPixelBufferPoolCreatePixelBufferWithAuxAttributes(kCFAllocatorDefault, _pool, (__bridge CFDictionaryRef)auxAttributes, &buffer) != kCVReturnSuccess) {
+        self.counters.droppedFrames += 1;
+        return;
+    }
+    ZGPresenterOutput *output = (__bridge ZGPresenterOutput *)CVBufferGetAttachment(buffer, (__bridge CFStringRef)ZGPresenterOutputAttachment, NULL);
+    if (!output) {
+        // A new buffer of the pool, never written yet
+        output = [[ZGPresenterOutput alloc] init];
+        output.dirtyRects = [NSMutableArray arrayWithObject:[NSValue valueWithRect:[self bounds]]];
+        CVBufferSetAttachment(buffer, (__bridge CFStringRef)ZGPresenterOutputAttachment, (__bridge CFTypeRef)output, kCVAttachmentMode_ShouldNotPropagate);
+        [self.outputs addObject:output];
+    }
+
+    CVPixelBufferLockBaseAddress(buffer, 0);
+    CVPixelBufferRef screenBuffer = (__bridge CVPixelBufferRef)self.screen;
+    if (screenBuffer) {
+        CVPixelBufferLockBaseAddress(screenBuffer, kCVPixelBufferLock_ReadOnly);
+    }
+    for (NSValue *value in output.dirtyRects) {
+        CGRect rect = CGRectIntegral(CGRectIntersection(value.rectValue, [self bounds]));
+        if (!CGRectIsEmpty(rect)) {
+            [self drawRect:rect intoBuffer:buffer screen:screenBuffer];
+            self.counters.composedPixels += rect.size.width * rect.size.height;
+        }
+    }
+    if (screenBuffer) {
+        CVPixelBufferUnlockBaseAddress(screenBuffer, kCVPixelBufferLock_ReadOnly);
+    }
+    CVPixelBufferUnlockBaseAddress(buffer, 0);
+    [output.dirtyRects removeAllObjects];
+
+    self.totalComposeMs += (ZGClockNow() - startTime) * 1000;
+    CVPixelBufferRelease(_lastOutput);
+    _lastOutput = buffer;
+    [self emitBuffer:buffer timeStamp:startTime];
+}
+
+/// Take a new screen frame, returns the output area it changed
+- (NSArray<NSValue *> *)acceptScreen:(CVPixelBufferRef)buffer dirtyRects:(nullable NSArray<NSValue *> *)dirtyRects {
+    self.hasScreen = YES;
+    if (CVPixelBufferGetWidth(buffer) == (size_t)self.outputSize.width && CVPixelBufferGetHeight(buffer) == (size_t)self.outputSize.height) {
+        self.screen = (__bridge id)buffer;
+        return dirtyRects ?: @[[NSValue valueWithRect:[self bounds]]];
+    }
+    self.screen = nil;
+    if (!_screenCanvas.data) {
+        if (vImageBuffer_Init(&_screenCanvas, (vImagePixelCount)self.outputSize.height, (vImagePixelCount)self.outputSize.width, 32, kvImageNoFlags) != kvImageNoError) {
+            _screenCanvas.data = NULL;
+            self.hasScreen = NO;
+            return @[];
+        }
+        [self trackBytes:_screenCanvas.rowBytes * _screenCanvas.height label:@"presenter screen canvas"];
+    }
+    ZGScaleAspectFillBGRA(buffer, &_screenCanvas, kvImageNoFlags);
+    return @[[NSValue valueWithRect:[self bounds]]];
+}
+
+- (void)drawRect:(CGRect)rect intoBuffer:(CVPixelBufferRef)buffer screen:(nullable CVPixelBufferRef)screen {
+    uint8_t *base = CVPixelBufferGetBaseAddress(buffer);
+    size_t stride = CVPixelBufferGetBytesPerRow(buffer);
+    size_t x = (size_t)CGRectGetMinX(rect);
+    size_t width = (size_t)rect.size.width;
+
+    const uint8_t *screenBase = NULL;
+    size_t screenStride = 0;
+    if (screen) {
+        screenBase = CVPixelBufferGetBaseAddress(screen);
+        screenStride = CVPixelBufferGetBytesPerRow(screen);
+    } else if (self.hasScreen) {
+        screenBase = _screenCanvas.data;
+        screenStride = _screenCanvas.rowBytes;
+    }
+
+    CGRect pip = (self.pipHidden || !self.hasCamera) ? CGRectNull : CGRectIntersection(rect, self.pipRect);
+    size_t pipX = (size_t)CGRectGetMinX(self.pipRect);
+    size_t pipY = (size_t)CGRectGetMinY(self.pipRect);
+    size_t pipWidth = (size_t)self.pipRect.size.width;
+    const uint8_t *mask = self.mask.bytes;
+
+    for (size_t y = (size_t)CGRectGetMinY(rect); y < (size_t)CGRectGetMaxY(rect); y++) {
+        uint8_t *row = base + y * stride + x * 4;
+        if (screenBase) {
+            memcpy(row, screenBase + y * screenStride + x * 4, width * 4);
+        } else {
+            memset(row, 0, width * 4);
+        }
+        if (CGRectIsNull(pip) || y < (size_t)CGRectGetMinY(pip) || y >= (size_t)CGRectGetMaxY(pip)) {
+            continue;
+        }
+        size_t from = (size_t)CGRectGetMinX(pip);
+        size_t count = (size_t)pip.size.width;
+        const uint8_t *camera = (const uint8_t *)_camera.data + (y - pipY) * _camera.rowBytes + (from - pipX) * 4;
+        ZGBlendRowMask4(base + y * stride + from * 4, camera, mask + (y - pipY) * pipWidth + (from - pipX), count);
+    }
+}
+
+- (void)emitBuffer:(CVPixelBufferRef)buffer timeStamp:(double)timeStamp {
+    self.counters.frames += 1;
+    self.counters.fullFramePixels += self.outputSize.width * self.outputSize.height;
+    CMTime time = CMTimeMakeWithSeconds(timeStamp, 1000);
+    ZGPresenterComposerOutputHandler handler = self.outputHandler;
+    if (handler) {
+        handler(buffer, time);
+    } else {
+        [[ZegoExpressEngine sharedEngine] sendCustomVideoCapturePixelBuffer:buffer timeStamp:time channel:ZegoPublishChannelAux];
+    }
+}
+
+#pragma mark - Picture in picture
+
+- (BOOL)prepareCamera {
+    vImagePixelCount width = (vImagePixelCount)self.pipRect.size.width;
+    vImagePixelCount height = (vImagePixelCount)self.pipRect.size.height;
+    if (_camera.data && _camera.width == width && _camera.height == height) {
+        return YES;
+    }
+    free(_camera.data);
+    if (vImageBuffer_Init(&_camera, height, width, 32, kvImageNoFlags) != kvImageNoError) {
+        _camera.data = NULL;
+        return NO;
+    }
+    size_t bytes = _camera.rowBytes * _camera.height;
+    if (self.cameraAllocation) {
+        [[ZGMemoryAccountant sharedAccountant] resizeAllocation:self.cameraAllocation toBytes:bytes];
+    } else {
+        self.cameraAllocation = [self trackBytes:bytes label:@"presenter camera"];
+    }
+    return YES;
+}
+
+/// Coverage of the rounded rect per pixel, 4 x 4 supersampled in the corners
+- (void)rebuildMask {
+    size_t width = (size_t)self.pipRect.size.width;
+    size_t height = (size_t)self.pipRect.size.height;
+    double radius = MAX(0, MIN(self.cornerRadius, MIN(width, height) / 2.0));
+    self.mask.length = width * height;
+    uint8_t *mask = self.mask.mutableBytes;
+    memset(mask, 0xFF, width * height);
+    size_t cornerSize = (size_t)ceil(radius);
+    for (size_t y = 0; y < height; y++) {
+        BOOL cornerRow = y < cornerSize || y >= height - cornerSize;
+        if (!cornerRow) {
+            continue;
+        }
+        for (size_t x = 0; x < width; x++) {
+            if (x >= cornerSize && x < width - cornerSize) {
+                continue;
+            }
+            double centerX = x < cornerSize ? radius : width - radius;
+            double centerY = y < cornerSize ? radius : height - radius;
+            int inside = 0;
+            for (int sy = 0; sy < 4; sy++) {
+                for (int sx = 0; sx < 4; sx++) {
+                    double px = x + (sx + 0.5) / 4 - centerX;
+                    double py = y + (sy + 0.5) / 4 - centerY;
+                    BOOL pastCenterX = x < cornerSize ? px > 0 : px < 0;
+                    BOOL pastCenterY = y < cornerSize ? py > 0 : py < 0;
+                    inside += pastCenterX || pastCenterY || px * px + py * py <= radius * radius;
+                }
+            }
+            mask[y * width + x] = (uint8_t)(inside * 255 / 16);
+        }
+    }
+}
+
+#pragma mark - Helper Methods
+
+- (CGRect)bounds {
+    return CGRectMake(0, 0, self.outputSize.width, self.outputSize.height);
+}
+
+/// Add a rect, merging it with what it overlaps; too many rects collapse into their bounding box
+- (void)addRect:(CGRect)rect toRects:(NSMutableArray<NSValue *> *)rects {
+    if (CGRectIsEmpty(rect)) {
+        return;
+    }
+    // A merge can make the rect reach others, so repeat until nothing overlaps
+    BOOL merged = YES;
+    while (merged) {
+        merged = NO;
+        for (NSUInteger i = 0; i < rects.count; i++) {
+            if (CGRectIntersectsRect(rects[i].rectValue, rect)) {
+                rect = CGRectUnion(rect, rects[i].rectValue);
+                [rects removeObjectAtIndex:i];
+                merged = YES;
+                break;
+            }
+        }
+    }
+    [rects addObject:[NSValue valueWithRect:rect]];
+    if (rects.count > ZGPresenterComposerMaxDirtyRects) {
+        CGRect bounding = CGRectNull;
+        for (NSValue *value in rects) {
+            bounding = CGRectUnion(bounding, value.rectValue);
+        }
+        [rects setArray:@[[NSValue valueWithRect:bounding]]];
+    }
+}
+
+- (ZGMemoryAllocation *)trackBytes:(size_t)bytes label:(NSString *)label {
+    ZGMemoryAllocation *allocation = [[ZGMemoryAccountant sharedAccountant] trackBytes:bytes streamID:nil subsystem:ZGMemorySubsystemCompositor label:label];
+    [self.allocations addObject:allocation];
+    return allocation;
+}
+
+@end
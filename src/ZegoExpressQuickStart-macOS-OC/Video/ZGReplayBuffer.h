@@ -0,0 +1,95 @@
+//
+//  ZGReplayBuffer.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <ZegoExpressEngine/ZegoExpressEngine.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// A frame read back from the replay buffer, planes packed without row padding
+@interface ZGReplayFrame : NSObject
+
+/// On the ZGClockNow() clock, when the frame arrived
+@property (nonatomic, assign, readonly) double timestamp;
+@property (nonatomic, assign, readonly) ZegoVideoFrameFormat format;
+@property (nonatomic, assign, readonly) CGSize size;
+@property (nonatomic, copy, readonly) NSArray<NSData *> *planes;
+@property (nonatomic, copy, readonly) NSArray<NSNumber *> *strides;
+
+@end
+
+/// Times on the ZGClockNow() clock, both NAN when nothing is kept
+typedef struct {
+    double start;
+    double end;
+} ZGReplayTimeRange;
+
+@interface ZGReplayBufferStatistics : NSObject
+
+@property (nonatomic, assign) NSUInteger receivedFrames;
+/// Frames the callback let go because the background thread was behind, or of an unsupported format
+@property (nonatomic, assign) NSUInteger droppedFrames;
+@property (nonatomic, assign) NSUInteger storedFrames;
+@property (nonatomic, assign) NSUInteger keyFrames;
+/// What is kept, and what it would take uncompressed
+@property (nonatomic, assign) size_t storedBytes;
+@property (nonatomic, assign) size_t rawBytes;
+
+@end
+
+/// Keeps the last seconds of every remote stream for instant replay
+///
+/// Register it as the custom video render handler with the raw data buffer type; every callback is forwarded to
+/// `nextHandler`. onRemoteVideoFrameRawData copies the planes of I420, I422, NV12, NV21 and 32 bit RGB frames
+/// into a staging block and hands it over through a lock-free queue, dropping the frame rather than waiting when
+/// the background thread is `maxPendingFrames` behind. The background thread stores every `keyFrameInterval`th
+/// frame whole and the others as the byte difference to the frame before (zero wherever the picture did not
+/// change), each LZ4 compressed with the Compression framework.
+///
+/// Frames older than `duration` are let go a key frame interval at a time, as is the oldest interval of any
+/// stream when all streams together exceed `memoryBudget`. Reading a frame decodes from the key frame before it,
+/// or carries on from the last frame read when replaying forward. Stored bytes are accounted to
+/// ZGMemorySubsystemCache.
+@interface ZGReplayBuffer : NSObject <ZegoCustomVideoRenderHandler>
+
+- (instancetype)initWithNextHandler:(nullable id<ZegoCustomVideoRenderHandler>)nextHandler;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, strong, readonly, nullable) id<ZegoCustomVideoRenderHandler> nextHandler;
+
+/// Seconds kept per stream, default 30
+@property (nonatomic, assign) double duration;
+
+/// Bytes kept across all streams, default 256 MB
+@property (nonatomic, assign) size_t memoryBudget;
+
+/// Default 30
+@property (nonatomic, assign) NSUInteger keyFrameInterval;
+
+/// Default 8
+@property (nonatomic, assign) NSUInteger maxPendingFrames;
+
+- (ZGReplayTimeRange)availableRangeForStreamID:(NSString *)streamID;
+
+/// The last frame at or before `timestamp`, the first one kept if it is earlier still
+///
+/// @param completion Called on a private queue, with nil when nothing of the stream is kept
+- (void)frameAtTime:(double)timestamp streamID:(NSString *)streamID completion:(void (^)(ZGReplayFrame * _Nullable frame))completion;
+
+/// Forget a stream that stopped playing
+- (void)removeStream:(NSString *)streamID;
+
+/// Stop the background thread, frames arriving afterwards are dropped; kept frames stay readable
+- (void)shutdown;
+
+- (ZGReplayBufferStatistics *)statistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,625 @@
+//
+//  ZGReplayBuffer.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGReplayBuffer.h"
+#import "ZGMPSCQueue.h"
+#import "ZGMemoryAccountant.h"
+#import "ZGPixelKernels.h"
+#import "ZGVideoFrameUtilities.h"
+#import "ZGClock.h"
+#import <compression.h>
+#import <pthread.h>
+#import <sched.h>
+
+/// A copied frame on its way from the render callback to the replay thread, planes packed back to back
+typedef struct {
+    ZGMPSCNode node;
+    double timestamp;
+    ZegoVideoFrameFormat format;
+    int width;
+    int height;
+    /// Retained NSString
+    void *streamID;
+    size_t bytes;
+    uint8_t data[];
+} ZGReplayStagedFrame;
+
+#pragma mark - Frame
+
+@interface ZGReplayFrame ()
+
+@property (nonatomic, assign, readwrite) double timestamp;
+@property (nonatomic, assign, readwrite) ZegoVideoFrameFormat format;
+@property (nonatomic, assign, readwrite) CGSize size;
+@property (nonatomic, copy, readwrite) NSArray<NSData *> *planes;
+@property (nonatomic, copy, readwrite) NSArray<NSNumber *> *strides;
+
+@end
+
+@implementation ZGReplayFrame
+
+@end
+
+@implementation ZGReplayBufferStatistics
+
+@end
+
+#pragma mark - Record
+
+/// One stored frame, never changed once appended
+@interface ZGReplayRecord : NSObject
+
+/// Increasing across all streams, so a stream that is removed and comes back never reuses one
+@property (nonatomic, assign) uint64_t serial;
+@property (nonatomic, assign) double timestamp;
+@property (nonatomic, assign) BOOL key;
+/// NO when LZ4 did not make the payload smaller and it is stored as is
+@property (nonatomic, assign) BOOL compressed;
+@property (nonatomic, assign) ZegoVideoFrameFormat format;
+@property (nonatomic, assign) int width;
+@property (nonatomic, assign) int height;
+@property (nonatomic, assign) size_t rawBytes;
+@property (nonatomic, strong) NSData *payload;
+
+@end
+
+@implementation ZGReplayRecord
+
+@end
+
+@interface ZGReplayStream : NSObject
+
+@property (nonatomic, copy) NSString *streamID;
+/// Starts with a key frame. Guarded by the lock
+@property (nonatomic, strong) NSMutableArray<ZGReplayRecord *> *records;
+@property (nonatomic, assign) size_t storedBytes;
+@property (nonatomic, assign) size_t rawBytes;
+@property (nonatomic, strong) ZGMemoryAllocation *allocation;
+/// Replay thread only: the last frame as received, what the next delta is taken against
+@property (nonatomic, strong, nullable) NSMutableData *reference;
+@property (nonatomic, strong, nullable) ZGReplayRecord *referenceRecord;
+@property (nonatomic, assign) NSUInteger framesSinceKey;
+/// The frames the next delta would build on were evicted
+@property (nonatomic, assign) BOOL forceKey;
+
+@end
+
+@implementation ZGReplayStream
+
+- (void)dealloc {
+    [[ZGMemoryAccountant sharedAccountant] releaseAllocation:_allocation];
+}
+
+@end
+
+#pragma mark - Worker
+
+/// Owns the staging queue and the stored frames, kept apart from the buffer so the thread does not retain it
+@interface ZGReplayWorker : NSObject
+
+@property (atomic, assign) double duration;
+@property (atomic, assign) size_t memoryBudget;
+@property (atomic, assign) NSUInteger keyFrameInterval;
+@property (atomic, assign) NSUInteger maxPendingFrames;
+
+/// Guarded by the lock
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZGReplayStream *> *streams;
+
+@end
+
+@implementation ZGReplayWorker {
+    ZGMPSCQueue _queue;
+    dispatch_semaphore_t _signal;
+    atomic_bool _stopping;
+    atomic_int _producers;
+    atomic_int _pending;
+    atomic_ulong _receivedFrames;
+    atomic_ulong _droppedFrames;
+    pthread_mutex_t _lock;
+    /// Replay thread only
+    NSMutableData *_delta;
+    NSMutableData *_encoded;
+    void *_encodeScratch;
+    uint64_t _nextSerial;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        ZGMPSCQueueInit(&_queue);
+        _signal = dispatch_semaphore_create(0);
+        atomic_init(&_stopping, false);
+        atomic_init(&_producers, 0);
+        atomic_init(&_pending, 0);
+        atomic_init(&_receivedFrames, 0);
+        atomic_init(&_droppedFrames, 0);
+        pthread_mutex_init(&_lock, NULL);
+        _streams = [NSMutableDictionary dictionary];
+        _delta = [NSMutableData data];
+        _encoded = [NSMutableData data];
+        _encodeScratch = malloc(compression_encode_scratch_buffer_size(COMPRESSION_LZ4));
+        _duration = 30;
+        _memoryBudget = 256 * 1024 * 1024;
+        _keyFrameInterval = 30;
+        _maxPendingFrames = 8;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_encodeScratch);
+    pthread_mutex_destroy(&_lock);
+}
+
+- (void)lock {
+    pthread_mutex_lock(&_lock);
+}
+
+- (void)unlock {
+    pthread_mutex_unlock(&_lock);
+}
+
+#pragma mark Producer side
+
+- (void)stageFrame:(unsigned char * _Nonnull *)data dataLength:(unsigned int *)dataLength param:(ZegoVideoFrameParam *)param streamID:(NSString *)streamID {
+    atomic_fetch_add(&_receivedFrames, 1);
+
+    int width = (int)param.size.width;
+    int height = (int)param.size.height;
+    int rowBytes[ZGVideoFrameMaxPlanes], rows[ZGVideoFrameMaxPlanes];
+    int planeCount = width > 0 && height > 0 ? ZGVideoFramePlaneLayout(param.format, width, height, rowBytes, rows) : 0;
+    size_t bytes = 0;
+    for (int plane = 0; plane < planeCount; plane++) {
+        int stride = param.strides ? param.strides[plane] : 0;
+        // A plane shorter than its geometry says is not something to store
+        if (!data[plane] || stride < rowBytes[plane] || dataLength[plane] < (size_t)stride * (rows[plane] - 1) + rowBytes[plane]) {
+            planeCount = 0;
+            break;
+        }
+        bytes += (size_t)rowBytes[plane] * rows[plane];
+    }
+    if (planeCount == 0) {
+        atomic_fetch_add(&_droppedFrames, 1);
+        return;
+    }
+
+    // Counted across the staging copy below, so the replay thread's last drain after a stop waits for the
+    // frame instead of leaving it, and the stream ID it retains, in the queue
+    atomic_fetch_add(&_producers, 1);
+    if (atomic_load(&_stopping)) {
+        atomic_fetch_sub(&_producers, 1);
+        atomic_fetch_add(&_droppedFrames, 1);
+        return;
+    }
+    // Never wait for the replay thread, the engine's render thread is waiting on us
+    if (atomic_fetch_add(&_pending, 1) >= (int)self.maxPendingFrames) {
+        atomic_fetch_sub(&_pending, 1);
+        atomic_fetch_sub(&_producers, 1);
+        atomic_fetch_add(&_droppedFrames, 1);
+        return;
+    }
+
+    ZGReplayStagedFrame *frame = malloc(sizeof(ZGReplayStagedFrame) + bytes);
+    frame->timestamp = ZGClockNow();
+    frame->format = param.format;
+    frame->width = width;
+    frame->height = height;
+    frame->streamID = (void *)CFBridgingRetain([streamID copy]);
+    frame->bytes = bytes;
+    uint8_t *dst = frame->data;
+    for (int plane = 0; plane < planeCount; plane++) {
+        const uint8_t *src = data[plane];
+        for (int y = 0; y < rows[plane]; y++) {
+            memcpy(dst, src + (size_t)y * param.strides[plane], rowBytes[plane]);
+            dst += rowBytes[plane];
+        }
+    }
+    frame->node.value = frame;
+    ZGMPSCQueuePush(&_queue, &frame->node);
+    atomic_fetch_sub(&_producers, 1);
+    dispatch_semaphore_signal(_signal);
+}
+
+- (void)stop {
+    atomic_store(&_stopping, true);
+    dispatch_semaphore_signal(_signal);
+}
+
+#pragma mark Consumer side
+
+- (void)run {
+    while (YES) {
+        dispatch_semaphore_wait(_signal, DISPATCH_TIME_FOREVER);
+        [self drain];
+        if (atomic_load(&_stopping)) {
+            break;
+        }
+    }
+    // Frames staged before the stop are still stored
+    while (atomic_load(&_producers) > 0) {
+        sched_yield();
+    }
+    [self drain];
+}
+
+- (void)drain {
+    ZGMPSCNode *node = NULL;
+    while ((node = ZGMPSCQueuePop(&_queue))) {
+        ZGReplayStagedFrame *frame = node->value;
+        @autoreleasepool {
+            [self storeFrame:frame];
+        }
+        CFRelease(frame->streamID);
+        free(frame);
+        atomic_fetch_sub(&_pending, 1);
+    }
+}
+
+- (void)storeFrame:(ZGReplayStagedFrame *)frame {
+    NSString *streamID = (__bridge NSString *)frame->streamID;
+    [self lock];
+    ZGReplayStream *stream = self.streams[streamID];
+    if (!stream) {
+        stream = [[ZGReplayStream alloc] init];
+        stream.streamID = streamID;
+        stream.records = [NSMutableArray array];
+        stream.allocation = [[ZGMemoryAccountant sharedAccountant] trackBytes:0 streamID:streamID subsystem:ZGMemorySubsystemCache label:@"replay buffer"];
+        self.streams[streamID] = stream;
+    }
+    BOOL forceKey = stream.forceKey;
+    [self unlock];
+
+    ZGReplayRecord *reference = stream.referenceRecord;
+    BOOL sameGeometry = reference && reference.format == frame->format && reference.width == frame->width && reference.height == frame->height;
+    BOOL key = !sameGeometry || forceKey || stream.framesSinceKey + 1 >= MAX(self.keyFrameInterval, 1);
+
+    const uint8_t *source = frame->data;
+    if (!key) {
+        // Unchanged pixels turn into runs of zeros, which is what LZ4 is good at
+        _delta.length = frame->bytes;
+        ZGSubtractBytes(_delta.mutableBytes, frame->data, stream.reference.bytes, frame->bytes);
+        source = _delta.bytes;
+    }
+
+    ZGReplayRecord *record = [[ZGReplayRecord alloc] init];
+    record.serial = ++_nextSerial;
+    record.timestamp = frame->timestamp;
+    record.key = key;
+    record.format = frame->format;
+    record.width = frame->width;
+    record.height = frame->height;
+    record.rawBytes = frame->bytes;
+    _encoded.length = frame->bytes;
+    size_t encodedBytes = compression_encode_buffer(_encoded.mutableBytes, frame->bytes, source, frame->bytes, _encodeScratch, COMPRESSION_LZ4);
+    if (encodedBytes > 0 && encodedBytes < frame->bytes) {
+        record.compressed = YES;
+        record.payload = [NSData dataWithBytes:_encoded.bytes length:encodedBytes];
+    } else {
+        record.payload = [NSData dataWithBytes:source length:frame->bytes];
+    }
+
+    stream.framesSinceKey = key ? 0 : stream.framesSinceKey + 1;
+    if (!stream.reference) {
+        stream.reference = [NSMutableData data];
+    }
+    stream.reference.length = frame->bytes;
+    memcpy(stream.reference.mutableBytes, frame->data, frame->bytes);
+    stream.referenceRecord = record;
+
+    [self lock];
+    stream.forceKey = NO;
+    if (self.streams[streamID] == stream) {
+        [stream.records addObject:record];
+        stream.storedBytes += record.payload.length;
+        stream.rawBytes += record.rawBytes;
+    }
+    NSSet<ZGReplayStream *> *changed = [self evictBefore:frame->timestamp - self.duration];
+    [self unlock];
+
+    for (ZGReplayStream *each in [changed setByAddingObject:stream]) {
+        [[ZGMemoryAccountant sharedAccountant] resizeAllocation:each.allocation toBytes:each.storedBytes];
+    }
+}
+
+#pragma mark Eviction
+
+/// Drop key frame intervals that are entirely older than `cutoff`, then the oldest ones over the budget
+///
+/// Called with the lock held. @return The streams that lost frames
+- (NSSet<ZGReplayStream *> *)evictBefore:(double)cutoff {
+    NSMutableSet<ZGReplayStream *> *changed = [NSMutableSet set];
+    size_t total = 0;
+    for (ZGReplayStream *stream in self.streams.allValues) {
+        while (stream.records.count > 0) {
+            NSUInteger end = [self endOfFirstGroupInStream:stream];
+            double newest = end < stream.records.count ? stream.records[end].timestamp : stream.records.lastObject.timestamp;
+            if (newest > cutoff) {
+                break;
+            }
+            [self removeFirstGroupOfStream:stream];
+            [changed addObject:stream];
+        }
+        total += stream.storedBytes;
+    }
+
+    while (total > self.memoryBudget) {
+        ZGReplayStream *oldest = nil;
+        for (ZGReplayStream *stream in self.streams.allValues) {
+            if (stream.records.count > 0 && (!oldest || stream.records[0].timestamp < oldest.records[0].timestamp)) {
+                oldest = stream;
+            }
+        }
+        if (!oldest) {
+            break;
+        }
+        size_t before = oldest.storedBytes;
+        [self removeFirstGroupOfStream:oldest];
+        total -= before - oldest.storedBytes;
+        [changed addObject:oldest];
+    }
+    return changed;
+}
+
+/// Index of the second key frame, or the count when the first interval is still open
+- (NSUInteger)endOfFirstGroupInStream:(ZGReplayStream *)stream {
+    NSUInteger end = 1;
+    while (end < stream.records.count && !stream.records[end].key) {
+        end++;
+    }
+    return end;
+}
+
+- (void)removeFirstGroupOfStream:(ZGReplayStream *)stream {
+    NSUInteger end = [self endOfFirstGroupInStream:stream];
+    for (NSUInteger i = 0; i < end; i++) {
+        stream.storedBytes -= stream.records[i].payload.length;
+        stream.rawBytes -= stream.records[i].rawBytes;
+    }
+    [stream.records removeObjectsInRange:NSMakeRange(0, end)];
+    if (stream.records.count == 0) {
+        stream.forceKey = YES;
+    }
+}
+
+#pragma mark Statistics
+
+- (ZGReplayBufferStatistics *)statisticsSnapshot {
+    ZGReplayBufferStatistics *statistics = [[ZGReplayBufferStatistics alloc] init];
+    statistics.receivedFrames = atomic_load(&_receivedFrames);
+    statistics.droppedFrames = atomic_load(&_droppedFrames);
+    [self lock];
+    for (ZGReplayStream *stream in self.streams.allValues) {
+        statistics.storedFrames += stream.records.count;
+        for (ZGReplayRecord *record in stream.records) {
+            statistics.keyFrames += record.key ? 1 : 0;
+        }
+        statistics.storedBytes += stream.storedBytes;
+        statistics.rawBytes += stream.rawBytes;
+    }
+    [self unlock];
+    return statistics;
+}
+
+@end
+
+#pragma mark - Buffer
+
+@interface ZGReplayBuffer ()
+
+@property (nonatomic, strong, readwrite, nullable) id<ZegoCustomVideoRenderHandler> nextHandler;
+@property (nonatomic, strong) ZGReplayWorker *worker;
+@property (nonatomic, strong) NSThread *thread;
+@property (nonatomic, strong) dispatch_queue_t readQueue;
+
+/// Read queue only: the last frame decoded, so replaying forward decodes one delta per frame
+@property (nonatomic, copy, nullable) NSString *decodedStreamID;
+@property (nonatomic, assign) uint64_t decodedSerial;
+@property (nonatomic, strong, nullable) NSMutableData *decoded;
+@property (nonatomic, strong) NSMutableData *decodeScratch;
+
+@end
+
+@implementation ZGReplayBuffer
+
+- (instancetype)initWithNextHandler:(id<ZegoCustomVideoRenderHandler>)nextHandler {
+    self = [super init];
+    if (self) {
+        _nextHandler = nextHandler;
+        _worker = [[ZGReplayWorker alloc] init];
+        _readQueue = dispatch_queue_create("im.zego.replay.read", DISPATCH_QUEUE_SERIAL);
+        _decodeScratch = [NSMutableData data];
+        _thread = [[NSThread alloc] initWithTarget:_worker selector:@selector(run) object:nil];
+        _thread.name = @"im.zego.replay";
+        _thread.qualityOfService = NSQualityOfServiceUtility;
+        [_thread start];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_worker stop];
+}
+
+- (void)shutdown {
+    [self.worker stop];
+}
+
+#pragma mark - Tunables
+
+- (double)duration {
+    return self.worker.duration;
+}
+
+- (void)setDuration:(double)duration {
+    self.worker.duration = MAX(duration, 0);
+}
+
+- (size_t)memoryBudget {
+    return self.worker.memoryBudget;
+}
+
+- (void)setMemoryBudget:(size_t)memoryBudget {
+    self.worker.memoryBudget = memoryBudget;
+}
+
+- (NSUInteger)keyFrameInterval {
+    return self.worker.keyFrameInterval;
+}
+
+- (void)setKeyFrameInterval:(NSUInteger)keyFrameInterval {
+    self.worker.keyFrameInterval = MAX(keyFrameInterval, 1);
+}
+
+- (NSUInteger)maxPendingFrames {
+    return self.worker.maxPendingFrames;
+}
+
+- (void)setMaxPendingFrames:(NSUInteger)maxPendingFrames {
+    self.worker.maxPendingFrames = MAX(maxPendingFrames, 1);
+}
+
+#pragma mark - Forwarding
+
+- (BOOL)respondsToSelector:(SEL)aSelector {
+    return [super respondsToSelector:aSelector] || [self.nextHandler respondsToSelector:aSelector];
+}
+
+- (id)forwardingTargetForSelector:(SEL)aSelector {
+    return [self.nextHandler respondsToSelector:aSelector] ? self.nextHandler : [super forwardingTargetForSelector:aSelector];
+}
+
+#pragma mark - ZegoCustomVideoRenderHandler
+
+- (void)onRemoteVideoFrameRawData:(unsigned char * _Nonnull *)data dataLength:(unsigned int *)dataLength param:(ZegoVideoFrameParam *)param streamID:(NSString *)streamID {
+    [self.worker stageFrame:data dataLength:dataLength param:param streamID:streamID];
+    if ([self.nextHandler respondsToSelector:_cmd]) {
+        [self.nextHandler onRemoteVideoFrameRawData:data dataLength:dataLength param:param streamID:streamID];
+    }
+}
+
+#pragma mark - Reading
+
+- (ZGReplayTimeRange)availableRangeForStreamID:(NSString *)streamID {
+    ZGReplayTimeRange range = {NAN, NAN};
+    [self.worker lock];
+    NSArray<ZGReplayRecord *> *records = self.worker.streams[streamID].records;
+    if (records.count > 0) {
+        range.start = records.firstObject.timestamp;
+        range.end = records.lastObject.timestamp;
+    }
+    [self.worker unlock];
+    return range;
+}
+
+- (void)frameAtTime:(double)timestamp streamID:(NSString *)streamID completion:(void (^)(ZGReplayFrame * _Nullable))completion {
+    NSString *key = [streamID copy];
+    dispatch_async(self.readQueue, ^{
+        NSArray<ZGReplayRecord *> *slice = [self recordsToDecodeForTime:timestamp streamID:key];
+        completion(slice.count > 0 ? [self decodeRecords:slice streamID:key] : nil);
+    });
+}
+
+/// The records from where decoding has to start up to the wanted frame, empty when nothing is kept
+- (NSArray<ZGReplayRecord *> *)recordsToDecodeForTime:(double)timestamp streamID:(NSString *)streamID {
+    [self.worker lock];
+    NSArray<ZGReplayRecord *> *records = [self.worker.streams[streamID].records copy];
+    [self.worker unlock];
+    if (records.count == 0) {
+        return @[];
+    }
+
+    // Last record at or before the time, the first one when the time is earlier
+    NSUInteger low = 0, high = records.count;
+    while (low < high) {
+        NSUInteger middle = (low + high) / 2;
+        if (records[middle].timestamp <= timestamp) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    NSUInteger index = low > 0 ? low - 1 : 0;
+
+    NSUInteger start = index;
+    while (start > 0 && !records[start].key) {
+        start--;
+    }
+    // Carry on from the frame decoded last when it lies between the key frame and the wanted one
+    if (self.decoded && [self.decodedStreamID isEqualToString:streamID]) {
+        for (NSUInteger i = index + 1; i > start; i--) {
+            if (records[i - 1].serial == self.decodedSerial) {
+                start = MIN(i, index);
+                break;
+            }
+        }
+    }
+    return [records subarrayWithRange:NSMakeRange(start, index - start + 1)];
+}
+
+- (nullable ZGReplayFrame *)decodeRecords:(NSArray<ZGReplayRecord *> *)records streamID:(NSString *)streamID {
+    ZGReplayRecord *last = records.lastObject;
+    BOOL upToDate = self.decoded && [self.decodedStreamID isEqualToString:streamID] && self.decodedSerial == last.serial;
+    if (!upToDate) {
+        for (ZGReplayRecord *record in records) {
+            const uint8_t *bytes = record.payload.bytes;
+            if (record.compressed) {
+                self.decodeScratch.length = record.rawBytes;
+                size_t decodedBytes = compression_decode_buffer(self.decodeScratch.mutableBytes, record.rawBytes, record.payload.bytes, record.payload.length, NULL, COMPRESSION_LZ4);
+                if (decodedBytes != record.rawBytes) {
+                    self.decoded = nil;
+                    return nil;
+                }
+                bytes = self.decodeScratch.bytes;
+            }
+            if (record.key) {
+                self.decoded = [NSMutableData dataWithBytes:bytes length:record.rawBytes];
+            } else if (self.decoded.length == record.rawBytes) {
+                ZGAddBytes(self.decoded.mutableBytes, bytes, record.rawBytes);
+            } else {
+                self.decoded = nil;
+                return nil;
+            }
+            self.decodedStreamID = streamID;
+            self.decodedSerial = record.serial;
+        }
+    }
+
+    int rowBytes[ZGVideoFrameMaxPlanes], rows[ZGVideoFrameMaxPlanes];
+    int planeCount = ZGVideoFramePlaneLayout(last.format, last.width, last.height, rowBytes, rows);
+    NSMutableArray<NSData *> *planes = [NSMutableArray arrayWithCapacity:planeCount];
+    NSMutableArray<NSNumber *> *strides = [NSMutableArray arrayWithCapacity:planeCount];
+    size_t offset = 0;
+    for (int plane = 0; plane < planeCount; plane++) {
+        size_t bytes = (size_t)rowBytes[plane] * rows[plane];
+        [planes addObject:[self.decoded subdataWithRange:NSMakeRange(offset, bytes)]];
+        [strides addObject:@(rowBytes[plane])];
+        offset += bytes;
+    }
+
+    ZGReplayFrame *frame = [[ZGReplayFrame alloc] init];
+    frame.timestamp = last.timestamp;
+    frame.format = last.format;
+    frame.size = CGSizeMake(last.width, last.height);
+    frame.planes = planes;
+    frame.strides = strides;
+    return frame;
+}
+
+#pragma mark - Streams
+
+- (void)removeStream:(NSString *)streamID {
+    [self.worker lock];
+    [self.worker.streams removeObjectForKey:streamID];
+    [self.worker unlock];
+}
+
+- (ZGReplayBufferStatistics *)statistics {
+    return [self.worker statisticsSnapshot];
+}
+
+@end
@@ -0,0 +1,78 @@
+//
+//  ZGTextOverlayRenderer.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreVideo/CoreVideo.h>
+#import <ZegoExpressEngine/ZegoExpressEngine.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface ZGTextOverlayStyle : NSObject <NSCopying>
+
++ (instancetype)defaultStyle;
+
+/// PostScript name, nil for the system font
+@property (nonatomic, copy, nullable) NSString *fontName;
+
+/// In frame pixels, default 36
+@property (nonatomic, assign) CGFloat fontSize;
+
+/// 0xAARRGGBB, default opaque white
+@property (nonatomic, assign) uint32_t textColor;
+
+/// 0xAARRGGBB of the box behind the text, default 60% black
+@property (nonatomic, assign) uint32_t backgroundColor;
+
+/// Between the text and the edge of its box, default 12
+@property (nonatomic, assign) CGFloat padding;
+
+/// Lines wrap at this width in pixels, 0 (the default) never wraps
+@property (nonatomic, assign) CGFloat maxWidth;
+
+/// Where the box sits, 0 ~ 1 of the room left around it: (0, 0) top left, default (0.5, 0.9) for captions
+@property (nonatomic, assign) CGPoint anchor;
+
+@end
+
+@interface ZGTextOverlayStatistics : NSObject
+
+@property (nonatomic, assign) NSUInteger layouts;
+@property (nonatomic, assign) NSUInteger rasterizedGlyphs;
+@property (nonatomic, assign) NSUInteger atlasResets;
+@property (nonatomic, assign) NSUInteger frames;
+@property (nonatomic, assign) double averageDrawMs;
+
+@end
+
+/// Burns captions and labels into YUV frames before they are sent as custom capture
+///
+/// Setting a text shapes it with Core Text on a private queue and copies its glyphs out of a glyph atlas, where
+/// each glyph of a font is rasterised once, into a coverage mask. The mask and the text and box colours are
+/// then baked into premultiplied luma and chroma planes (BT.709 video range), so a frame only costs a vector
+/// blend of the overlay's rows into the frame's planes. Nothing is laid out again until the text or style of a
+/// key changes. Boxes are placed on even pixels so chroma lines up, and clipped at the frame's edges.
+///
+/// Draw from one thread at a time, usually the capture thread; texts can be set from any thread.
+@interface ZGTextOverlayRenderer : NSObject
+
+/// Show `text` under `key`, replacing what was there; nil removes it. Keys set first are drawn first
+- (void)setText:(nullable NSString *)text style:(ZGTextOverlayStyle *)style forKey:(NSString *)key;
+
+/// Draw into the planes of a raw frame, I420, I422, NV12 or NV21, honouring `param.strides`
+///
+/// @return NO for other formats
+- (BOOL)drawIntoPlanes:(uint8_t * _Nonnull const * _Nonnull)planes param:(ZegoVideoFrameParam *)param;
+
+/// Draw into a 420v, 420f or y420 pixel buffer
+- (BOOL)drawIntoPixelBuffer:(CVPixelBufferRef)buffer;
+
+- (ZGTextOverlayStatistics *)statistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
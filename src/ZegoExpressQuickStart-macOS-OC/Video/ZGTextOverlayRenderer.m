@@ -0,0 +1,530 @@
+//
+//  ZGTextOverlayRenderer.m
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#import "ZGTextOverlayRenderer.h"
+#import <pthread.h>
+#import <CoreText/CoreText.h>
+#import "ZGGlyphAtlas.h"
+#import "ZGMemoryAccountant.h"
+#import "ZGPixelKernels.h"
+#import "ZGClock.h"
+
+/// Side of the glyph atlas, room for a few hundred caption sized glyphs
+static const size_t ZGTextOverlayAtlasSize = 1024;
+
+/// Height of the frame Core Text lays lines out in, more than any caption needs
+static const CGFloat ZGTextOverlayFrameExtent = 100000;
+
+/// How a frame format stores chroma
+typedef NS_ENUM(NSUInteger, ZGTextOverlayChromaLayout) {
+    ZGTextOverlayChromaLayoutPlanar420,
+    ZGTextOverlayChromaLayoutPlanar422,
+    ZGTextOverlayChromaLayoutCbCr420,
+    ZGTextOverlayChromaLayoutCrCb420
+};
+
+#pragma mark - Kernels
+
+static inline long ZGEvenFloor(long value) {
+    return value - (value & 1);
+}
+
+/// BT.709 video range
+static void ZGColorToYCbCr(uint32_t argb, double *y, double *cb, double *cr) {
+    double r = (argb >> 16) & 0xFF;
+    double g = (argb >> 8) & 0xFF;
+    double b = argb & 0xFF;
+    double luma = 0.2126 * r + 0.7152 * g + 0.0722 * b;
+    *y = 16 + luma * 219 / 255;
+    *cb = 128 + (b - luma) / 1.8556 * 224 / 255;
+    *cr = 128 + (r - luma) / 1.5748 * 224 / 255;
+}
+
+static inline void ZGQuantizePremultiplied(double alpha, double premultiplied, uint8_t *alphaOut, uint8_t *premultipliedOut) {
+    uint8_t a = (uint8_t)lround(alpha * 255);
+    *alphaOut = a;
+    *premultipliedOut = (uint8_t)MIN(lround(premultiplied), (long)ZGPremultipliedLimit(a));
+}
+
+/// Copy a glyph's coverage into the mask at (x, y), keeping the larger coverage where glyphs overlap
+static void ZGCopyCoverage(uint8_t *mask, long maskWidth, long maskHeight, const uint8_t *atlas, size_t atlasStride, ZGGlyphAtlasEntry entry, long x, long y) {
+    for (long row = MAX(0, -y); row < entry.height && y + row < maskHeight; row++) {
+        const uint8_t *src = atlas + (entry.y + row) * atlasStride + entry.x;
+        uint8_t *dst = mask + (y + row) * maskWidth + x;
+        for (long column = MAX(0, -x); column < entry.width && x + column < maskWidth; column++) {
+            dst[column] = MAX(dst[column], src[column]);
+        }
+    }
+}
+
+/// Blend an overlay of `width` x `height` samples into a plane at (x, y), clipped to the plane
+static void ZGBlendOverlayPlane(uint8_t *plane, size_t stride, long planeWidth, long planeHeight,
+                                const uint8_t *premultiplied, const uint8_t *alpha, long width, long height,
+                                long x, long y, long bytesPerSample) {
+    long left = MAX(0, -x);
+    long top = MAX(0, -y);
+    long right = MIN(width, planeWidth - x);
+    long bottom = MIN(height, planeHeight - y);
+    if (left >= right || top >= bottom) {
+        return;
+    }
+    for (long row = top; row < bottom; row++) {
+        size_t offset = (size_t)(row * width + left) * bytesPerSample;
+        ZGBlendRowPremultiplied8(plane + (y + row) * stride + (x + left) * bytesPerSample, premultiplied + offset, alpha + offset, (size_t)(right - left) * bytesPerSample);
+    }
+}
+
+#pragma mark - Style
+
+@implementation ZGTextOverlayStyle
+
++ (instancetype)defaultStyle {
+    ZGTextOverlayStyle *style = [[ZGTextOverlayStyle alloc] init];
+    style.fontSize = 36;
+    style.textColor = 0xFFFFFFFF;
+    style.backgroundColor = 0x99000000;
+    style.padding = 12;
+    style.anchor = CGPointMake(0.5, 0.9);
+    return style;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    ZGTextOverlayStyle *copy = [[ZGTextOverlayStyle alloc] init];
+    copy.fontName = self.fontName;
+    copy.fontSize = self.fontSize;
+    copy.textColor = self.textColor;
+    copy.backgroundColor = self.backgroundColor;
+    copy.padding = self.padding;
+    copy.maxWidth = self.maxWidth;
+    copy.anchor = self.anchor;
+    return copy;
+}
+
+- (BOOL)isEqual:(id)object {
+    if (![object isKindOfClass:[ZGTextOverlayStyle class]]) {
+        return NO;
+    }
+    ZGTextOverlayStyle *other = object;
+    return (self.fontName == other.fontName || [self.fontName isEqualToString:other.fontName])
+        && self.fontSize == other.fontSize && self.textColor == other.textColor && self.backgroundColor == other.backgroundColor
+        && self.padding == other.padding && self.maxWidth == other.maxWidth && CGPointEqualToPoint(self.anchor, other.anchor);
+}
+
+- (NSUInteger)hash {
+    return self.fontName.hash ^ (NSUInteger)self.fontSize ^ self.textColor;
+}
+
+@end
+
+@implementation ZGTextOverlayStatistics
+
+@end
+
+#pragma mark - Layout
+
+/// Chroma of a layout the way one family of formats stores it
+@interface ZGTextOverlayChroma : NSObject
+
+@property (nonatomic, strong) NSData *alpha;
+/// Cb, or interleaved chroma
+@property (nonatomic, strong) NSData *premultiplied0;
+/// Cr, nil when interleaved
+@property (nonatomic, strong, nullable) NSData *premultiplied1;
+/// In samples, a sample being a CbCr pair when interleaved
+@property (nonatomic, assign) size_t width;
+@property (nonatomic, assign) size_t height;
+@property (nonatomic, assign) long bytesPerSample;
+
+@end
+
+@implementation ZGTextOverlayChroma
+
+@end
+
+/// A text baked into premultiplied planes, immutable once published except for its chroma cache
+@interface ZGTextOverlayLayout : NSObject
+
+@property (nonatomic, copy) NSString *text;
+@property (nonatomic, copy) ZGTextOverlayStyle *style;
+/// Even
+@property (nonatomic, assign) size_t width;
+@property (nonatomic, assign) size_t height;
+@property (nonatomic, strong) NSData *lumaAlpha;
+@property (nonatomic, strong) NSData *lumaPremultiplied;
+/// Chroma at half width and full height, what the other chroma layouts are derived from
+@property (nonatomic, strong) ZGTextOverlayChroma *chroma422;
+/// Derived on the drawing thread the first time a format needs it
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, ZGTextOverlayChroma *> *chromaLayouts;
+@property (nonatomic, strong) ZGMemoryAllocation *allocation;
+@property (nonatomic, assign) size_t bytes;
+
+@end
+
+@implementation ZGTextOverlayLayout
+
+- (void)dealloc {
+    [[ZGMemoryAccountant sharedAccountant] releaseAllocation:_allocation];
+}
+
+- (ZGTextOverlayChroma *)chromaForLayout:(ZGTextOverlayChromaLayout)chromaLayout {
+    if (chromaLayout == ZGTextOverlayChromaLayoutPlanar422) {
+        return self.chroma422;
+    }
+    ZGTextOverlayChroma *chroma = self.chromaLayouts[@(chromaLayout)];
+    if (chroma) {
+        return chroma;
+    }
+
+    if (chromaLayout == ZGTextOverlayChromaLayoutPlanar420) {
+        ZGTextOverlayChroma *source = self.chroma422;
+        size_t width = source.width;
+        size_t height = source.height / 2;
+        NSMutableData *alpha = [NSMutableData dataWithLength:width * height];
+        NSMutableData *cb = [NSMutableData dataWithLength:width * height];
+        NSMutableData *cr = [NSMutableData dataWithLength:width * height];
+        const uint8_t *sourceAlpha = source.alpha.bytes;
+        const uint8_t *sourceCb = source.premultiplied0.bytes;
+        const uint8_t *sourceCr = source.premultiplied1.bytes;
+        uint8_t *a = alpha.mutableBytes;
+        uint8_t *b = cb.mutableBytes;
+        uint8_t *r = cr.mutableBytes;
+        for (size_t y = 0; y < height; y++) {
+            for (size_t x = 0; x < width; x++) {
+                size_t top = 2 * y * width + x;
+                size_t bottom = top + width;
+                size_t i = y * width + x;
+                a[i] = (uint8_t)((sourceAlpha[top] + sourceAlpha[bottom] + 1) >> 1);
+                uint8_t limit = ZGPremultipliedLimit(a[i]);
+                b[i] = (uint8_t)MIN((sourceCb[top] + sourceCb[bottom] + 1) >> 1, limit);
+                r[i] = (uint8_t)MIN((sourceCr[top] + sourceCr[bottom] + 1) >> 1, limit);
+            }
+        }
+        chroma = [[ZGTextOverlayChroma alloc] init];
+        chroma.alpha = alpha;
+        chroma.premultiplied0 = cb;
+        chroma.premultiplied1 = cr;
+        chroma.width = width;
+        chroma.height = height;
+        chroma.bytesPerSample = 1;
+    } else {
+        ZGTextOverlayChroma *planar = [self chromaForLayout:ZGTextOverlayChromaLayoutPlanar420];
+        size_t samples = planar.width * planar.height;
+        NSMutableData *alpha = [NSMutableData dataWithLength:samples * 2];
+        NSMutableData *interleaved = [NSMutableData dataWithLength:samples * 2];
+        const uint8_t *planarAlpha = planar.alpha.bytes;
+        const uint8_t *first = chromaLayout == ZGTextOverlayChromaLayoutCbCr420 ? planar.premultiplied0.bytes : planar.premultiplied1.bytes;
+        const uint8_t *second = chromaLayout == ZGTextOverlayChromaLayoutCbCr420 ? planar.premultiplied1.bytes : planar.premultiplied0.bytes;
+        uint8_t *a = alpha.mutableBytes;
+        uint8_t *p = interleaved.mutableBytes;
+        for (size_t i = 0; i < samples; i++) {
+            a[2 * i] = a[2 * i + 1] = planarAlpha[i];
+            p[2 * i] = first[i];
+            p[2 * i + 1] = second[i];
+        }
+        chroma = [[ZGTextOverlayChroma alloc] init];
+        chroma.alpha = alpha;
+        chroma.premultiplied0 = interleaved;
+        chroma.width = planar.width;
+        chroma.height = planar.height;
+        chroma.bytesPerSample = 2;
+    }
+    self.chromaLayouts[@(chromaLayout)] = chroma;
+    self.bytes += chroma.alpha.length + chroma.premultiplied0.length + chroma.premultiplied1.length;
+    [[ZGMemoryAccountant sharedAccountant] resizeAllocation:self.allocation toBytes:self.bytes];
+    return chroma;
+}
+
+@end
+
+#pragma mark - Renderer
+
+@interface ZGTextOverlayRenderer () {
+    pthread_mutex_t _lock;
+}
+
+@property (nonatomic, strong) dispatch_queue_t queue;
+
+// Only touched on `queue`
+@property (nonatomic, strong) ZGGlyphAtlas *atlas;
+@property (nonatomic, strong) NSMutableArray<NSString *> *keys;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ZGTextOverlayLayout *> *layoutsByKey;
+
+// Guarded by _lock
+/// What the drawing thread draws, in key order
+@property (nonatomic, strong) NSArray<ZGTextOverlayLayout *> *layouts;
+@property (nonatomic, strong) ZGTextOverlayStatistics *counters;
+@property (nonatomic, assign) double totalDrawMs;
+
+@end
+
+@implementation ZGTextOverlayRenderer
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _queue = dispatch_queue_create("im.zego.textoverlay", DISPATCH_QUEUE_SERIAL);
+        pthread_mutex_init(&_lock, NULL);
+        _keys = [NSMutableArray array];
+        _layoutsByKey = [NSMutableDictionary dictionary];
+        _layouts = @[];
+        _counters = [[ZGTextOverlayStatistics alloc] init];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    pthread_mutex_destroy(&_lock);
+}
+
+- (ZGTextOverlayStatistics *)statistics {
+    ZGTextOverlayStatistics *snapshot = [[ZGTextOverlayStatistics alloc] init];
+    pthread_mutex_lock(&_lock);
+    snapshot.layouts = self.counters.layouts;
+    snapshot.rasterizedGlyphs = self.counters.rasterizedGlyphs;
+    snapshot.atlasResets = self.counters.atlasResets;
+    snapshot.frames = self.counters.frames;
+    snapshot.averageDrawMs = self.counters.frames > 0 ? self.totalDrawMs / self.counters.frames : 0;
+    pthread_mutex_unlock(&_lock);
+    return snapshot;
+}
+
+#pragma mark - Texts
+
+- (void)setText:(NSString *)text style:(ZGTextOverlayStyle *)style forKey:(NSString *)key {
+    ZGTextOverlayStyle *styleCopy = [style copy];
+    dispatch_async(self.queue, ^{
+        ZGTextOverlayLayout *current = self.layoutsByKey[key];
+        if (text.length > 0 && [current.text isEqualToString:text] && [current.style isEqual:styleCopy]) {
+            return;
+        }
+        ZGTextOverlayLayout *layout = text.length > 0 ? [self layoutText:text style:styleCopy] : nil;
+        if (layout) {
+            if (!current) {
+                [self.keys addObject:key];
+            }
+            self.layoutsByKey[key] = layout;
+        } else {
+            [self.keys removeObject:key];
+            [self.layoutsByKey removeObjectForKey:key];
+        }
+
+        NSMutableArray<ZGTextOverlayLayout *> *layouts = [NSMutableArray array];
+        for (NSString *orderedKey in self.keys) {
+            [layouts addObject:self.layoutsByKey[orderedKey]];
+        }
+        pthread_mutex_lock(&self->_lock);
+        self.layouts = layouts;
+        self.counters.layouts += layout ? 1 : 0;
+        self.counters.rasterizedGlyphs = self.atlas.rasterizedGlyphs;
+        self.counters.atlasResets = self.atlas.resets;
+        pthread_mutex_unlock(&self->_lock);
+    });
+}
+
+- (nullable ZGTextOverlayLayout *)layoutText:(NSString *)text style:(ZGTextOverlayStyle *)style {
+    CTFontRef font = style.fontName ? CTFontCreateWithName((__bridge CFStringRef)style.fontName, style.fontSize, NULL) : CTFontCreateUIFontForLanguage(kCTFontUIFontSystem, style.fontSize, NULL);
+    if (!font) {
+        return nil;
+    }
+    NSAttributedString *string = [[NSAttributedString alloc] initWithString:text attributes:@{(id)kCTFontAttributeName: (__bridge id)font}];
+    CFRelease(font);
+    CTFramesetterRef framesetter = CTFramesetterCreateWithAttributedString((__bridge CFAttributedStringRef)string);
+    CGPathRef path = CGPathCreateWithRect(CGRectMake(0, 0, style.maxWidth > 0 ? style.maxWidth : ZGTextOverlayFrameExtent, ZGTextOverlayFrameExtent), NULL);
+    CTFrameRef frame = CTFramesetterCreateFrame(framesetter, CFRangeMake(0, 0), path, NULL);
+    CGPathRelease(path);
+    CFRelease(framesetter);
+    NSArray *lines = (__bridge NSArray *)CTFrameGetLines(frame);
+    if (lines.count == 0) {
+        CFRelease(frame);
+        return nil;
+    }
+
+    CGFloat contentWidth = 0;
+    CGFloat contentHeight = 0;
+    for (id line in lines) {
+        CGFloat ascent, descent, leading;
+        double lineWidth = CTLineGetTypographicBounds((__bridge CTLineRef)line, &ascent, &descent, &leading) - CTLineGetTrailingWhitespaceWidth((__bridge CTLineRef)line);
+        contentWidth = MAX(contentWidth, lineWidth);
+        contentHeight += ascent + descent + leading;
+    }
+    long width = ZGEvenFloor((long)ceil(contentWidth + 2 * style.padding) + 1);
+    long height = ZGEvenFloor((long)ceil(contentHeight + 2 * style.padding) + 1);
+
+    // Shape once, copying each glyph's coverage out of the atlas
+    if (!self.atlas) {
+        self.atlas = [[ZGGlyphAtlas alloc] initWithSize:ZGTextOverlayAtlasSize];
+    }
+    NSMutableData *coverage = [NSMutableData dataWithLength:(size_t)(width * height)];
+    CGFloat baseline = style.padding;
+    for (id line in lines) {
+        CGFloat ascent, descent, leading;
+        double lineWidth = CTLineGetTypographicBounds((__bridge CTLineRef)line, &ascent, &descent, &leading) - CTLineGetTrailingWhitespaceWidth((__bridge CTLineRef)line);
+        baseline += ascent;
+        CGFloat lineX = style.padding + (contentWidth - lineWidth) / 2;
+        for (id run in (__bridge NSArray *)CTLineGetGlyphRuns((__bridge CTLineRef)line)) {
+            CTRunRef glyphRun = (__bridge CTRunRef)run;
+            CTFontRef runFont = CFDictionaryGetValue(CTRunGetAttributes(glyphRun), kCTFontAttributeName);
+            CFIndex count = CTRunGetGlyphCount(glyphRun);
+            if (!runFont || count == 0) {
+                continue;
+            }
+            NSMutableData *glyphs = [NSMutableData dataWithLength:sizeof(CGGlyph) * count];
+            NSMutableData *positions = [NSMutableData dataWithLength:sizeof(CGPoint) * count];
+            CTRunGetGlyphs(glyphRun, CFRangeMake(0, 0), glyphs.mutableBytes);
+            CTRunGetPositions(glyphRun, CFRangeMake(0, 0), positions.mutableBytes);
+            const CGGlyph *glyphIDs = glyphs.bytes;
+            const CGPoint *points = positions.bytes;
+            for (CFIndex i = 0; i < count; i++) {
+                ZGGlyphAtlasEntry entry;
+                if (![self.atlas entryForGlyph:glyphIDs[i] font:runFont entry:&entry] || entry.width == 0) {
+                    continue;
+                }
+                long penX = lround(lineX + points[i].x);
+                long baselineRow = lround(baseline - points[i].y);
+                ZGCopyCoverage(coverage.mutableBytes, width, height, self.atlas.bytes, self.atlas.size, entry, penX + entry.left, baselineRow - entry.top);
+            }
+        }
+        baseline += descent + leading;
+    }
+    CFRelease(frame);
+
+    // Text over its box, premultiplied
+    double textY, textCb, textCr, boxY, boxCb, boxCr;
+    ZGColorToYCbCr(style.textColor, &textY, &textCb, &textCr);
+    ZGColorToYCbCr(style.backgroundColor, &boxY, &boxCb, &boxCr);
+    double textAlpha = (style.textColor >> 24) / 255.0;
+    double boxAlpha = (style.backgroundColor >> 24) / 255.0;
+    size_t chromaWidth = (size_t)width / 2;
+    NSMutableData *lumaAlpha = [NSMutableData dataWithLength:(size_t)(width * height)];
+    NSMutableData *lumaPremultiplied = [NSMutableData dataWithLength:(size_t)(width * height)];
+    NSMutableData *chromaAlpha = [NSMutableData dataWithLength:chromaWidth * height];
+    NSMutableData *cbPremultiplied = [NSMutableData dataWithLength:chromaWidth * height];
+    NSMutableData *crPremultiplied = [NSMutableData dataWithLength:chromaWidth * height];
+    const uint8_t *mask = coverage.bytes;
+    for (size_t i = 0; i < (size_t)(width * height); i += 2) {
+        double alphaSum = 0, cbSum = 0, crSum = 0;
+        for (size_t j = i; j < i + 2; j++) {
+            double text = mask[j] / 255.0 * textAlpha;
+            double box = boxAlpha * (1 - text);
+            double alpha = text + box;
+            ZGQuantizePremultiplied(alpha, textY * text + boxY * box, (uint8_t *)lumaAlpha.mutableBytes + j, (uint8_t *)lumaPremultiplied.mutableBytes + j);
+            alphaSum += alpha;
+            cbSum += textCb * text + boxCb * box;
+            crSum += textCr * text + boxCr * box;
+        }
+        uint8_t unused;
+        ZGQuantizePremultiplied(alphaSum / 2, cbSum / 2, (uint8_t *)chromaAlpha.mutableBytes + i / 2, (uint8_t *)cbPremultiplied.mutableBytes + i / 2);
+        ZGQuantizePremultiplied(alphaSum / 2, crSum / 2, &unused, (uint8_t *)crPremultiplied.mutableBytes + i / 2);
+    }
+
+    ZGTextOverlayLayout *layout = [[ZGTextOverlayLayout alloc] init];
+    layout.text = text;
+    layout.style = style;
+    layout.width = (size_t)width;
+    layout.height = (size_t)height;
+    layout.lumaAlpha = lumaAlpha;
+    layout.lumaPremultiplied = lumaPremultiplied;
+    layout.chroma422 = [[ZGTextOverlayChroma alloc] init];
+    layout.chroma422.alpha = chromaAlpha;
+    layout.chroma422.premultiplied0 = cbPremultiplied;
+    layout.chroma422.premultiplied1 = crPremultiplied;
+    layout.chroma422.width = chromaWidth;
+    layout.chroma422.height = (size_t)height;
+    layout.chroma422.bytesPerSample = 1;
+    layout.chromaLayouts = [NSMutableDictionary dictionary];
+    layout.bytes = (size_t)(width * height) * 2 + chromaWidth * height * 3;
+    layout.allocation = [[ZGMemoryAccountant sharedAccountant] trackBytes:layout.bytes streamID:nil subsystem:ZGMemorySubsystemCapture label:@"text overlay"];
+    return layout;
+}
+
+#pragma mark - Drawing
+
+- (BOOL)drawIntoPlanes:(uint8_t * const *)planes param:(ZegoVideoFrameParam *)param {
+    size_t strides[3] = {0};
+    int planeCount = param.format == ZegoVideoFrameFormatI420 || param.format == ZegoVideoFrameFormatI422 ? 3 : 2;
+    for (int i = 0; i < planeCount; i++) {
+        strides[i] = (size_t)param.strides[i];
+    }
+    return [self drawIntoPlanes:planes strides:strides format:param.format width:(size_t)param.size.width height:(size_t)param.size.height];
+}
+
+- (BOOL)drawIntoPixelBuffer:(CVPixelBufferRef)buffer {
+    OSType pixelFormat = CVPixelBufferGetPixelFormatType(buffer);
+    ZegoVideoFrameFormat format;
+    if (pixelFormat == kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange || pixelFormat == kCVPixelFormatType_420YpCbCr8BiPlanarFullRange) {
+        format = ZegoVideoFrameFormatNV12;
+    } else if (pixelFormat == kCVPixelFormatType_420YpCbCr8Planar) {
+        format = ZegoVideoFrameFormatI420;
+    } else {
+        return NO;
+    }
+    if (CVPixelBufferLockBaseAddress(buffer, 0) != kCVReturnSuccess) {
+        return NO;
+    }
+    uint8_t *planes[3] = {NULL};
+    size_t strides[3] = {0};
+    for (size_t i = 0; i < CVPixelBufferGetPlaneCount(buffer) && i < 3; i++) {
+        planes[i] = CVPixelBufferGetBaseAddressOfPlane(buffer, i);
+        strides[i] = CVPixelBufferGetBytesPerRowOfPlane(buffer, i);
+    }
+    BOOL drawn = [self drawIntoPlanes:planes strides:strides format:format width:CVPixelBufferGetWidth(buffer) height:CVPixelBufferGetHeight(buffer)];
+    CVPixelBufferUnlockBaseAddress(buffer, 0);
+    return drawn;
+}
+
+- (BOOL)drawIntoPlanes:(uint8_t * const *)planes strides:(const size_t *)strides format:(ZegoVideoFrameFormat)format width:(size_t)width height:(size_t)height {
+    ZGTextOverlayChromaLayout chromaLayout;
+    switch (format) {
+        case ZegoVideoFrameFormatI420:
+            chromaLayout = ZGTextOverlayChromaLayoutPlanar420;
+            break;
+        case ZegoVideoFrameFormatI422:
+            chromaLayout = ZGTextOverlayChromaLayoutPlanar422;
+            break;
+        case ZegoVideoFrameFormatNV12:
+            chromaLayout = ZGTextOverlayChromaLayoutCbCr420;
+            break;
+        case ZegoVideoFrameFormatNV21:
+            chromaLayout = ZGTextOverlayChromaLayoutCrCb420;
+            break;
+        default:
+            return NO;
+    }
+    double startTime = ZGClockNow();
+    pthread_mutex_lock(&_lock);
+    NSArray<ZGTextOverlayLayout *> *layouts = self.layouts;
+    pthread_mutex_unlock(&_lock);
+
+    BOOL verticallySubsampled = chromaLayout != ZGTextOverlayChromaLayoutPlanar422;
+    long chromaPlaneWidth = (long)(width + 1) / 2;
+    long chromaPlaneHeight = verticallySubsampled ? (long)(height + 1) / 2 : (long)height;
+    for (ZGTextOverlayLayout *layout in layouts) {
+        // Even so the box starts on a chroma sample
+        long x = ZGEvenFloor(lround(layout.style.anchor.x * ((double)width - layout.width)));
+        long y = ZGEvenFloor(lround(layout.style.anchor.y * ((double)height - layout.height)));
+        ZGBlendOverlayPlane(planes[0], strides[0], (long)width, (long)height, layout.lumaPremultiplied.bytes, layout.lumaAlpha.bytes,
+                            (long)layout.width, (long)layout.height, x, y, 1);
+
+        ZGTextOverlayChroma *chroma = [layout chromaForLayout:chromaLayout];
+        long chromaY = verticallySubsampled ? y / 2 : y;
+        ZGBlendOverlayPlane(planes[1], strides[1], chromaPlaneWidth, chromaPlaneHeight, chroma.premultiplied0.bytes, chroma.alpha.bytes,
+                            (long)chroma.width, (long)chroma.height, x / 2, chromaY, chroma.bytesPerSample);
+        if (chroma.premultiplied1) {
+            ZGBlendOverlayPlane(planes[2], strides[2], chromaPlaneWidth, chromaPlaneHeight, chroma.premultiplied1.bytes, chroma.alpha.bytes,
+                                (long)chroma.width, (long)chroma.height, x / 2, chromaY, 1);
+        }
+    }
+
+    pthread_mutex_lock(&_lock);
+    self.counters.frames++;
+    self.totalDrawMs += (ZGClockNow() - startTime) * 1000;
+    pthread_mutex_unlock(&_lock);
+    return YES;
+}
+
+@end
@@ -0,0 +1,86 @@
+//
+//  ZGVideoFrameUtilities.h
+//  ZegoExpressQuickStart-macOS-OC
+//
+//  Created by agent on 2026/10/18.
+//  Copyright © 2026 Zego. All rights reserved.
+//
+
+#ifndef ZGVideoFrameUtilities_h
+#define ZGVideoFrameUtilities_h
+
+#import <Accelerate/Accelerate.h>
+#import <CoreVideo/CoreVideo.h>
+#import <ZegoExpressEngine/ZegoExpressDefines.h>
+
+#define ZGVideoFrameMaxPlanes 4
+
+/// Rows and bytes per row of each plane of a raw frame, packed without row padding
+///
+/// Covers I420, I422, NV12, NV21 and the 32 bit RGB formats; chroma of odd sizes rounds up.
+///
+/// @return The number of planes, 0 for any other format
+static inline int ZGVideoFramePlaneLayout(ZegoVideoFrameFormat format, int width, int height, int rowBytes[ZGVideoFrameMaxPlanes], int rows[ZGVideoFrameMaxPlanes]) {
+    int chromaWidth = (width + 1) / 2;
+    int chromaHeight = (height + 1) / 2;
+    switch (format) {
+        case ZegoVideoFrameFormatI420:
+        case ZegoVideoFrameFormatI422:
+            rowBytes[0] = width;
+            rows[0] = height;
+            rowBytes[1] = rowBytes[2] = chromaWidth;
+            rows[1] = rows[2] = format == ZegoVideoFrameFormatI420 ? chromaHeight : height;
+            return 3;
+        case ZegoVideoFrameFormatNV12:
+        case ZegoVideoFrameFormatNV21:
+            rowBytes[0] = width;
+            rows[0] = height;
+            rowBytes[1] = chromaWidth * 2;
+            rows[1] = chromaHeight;
+            return 2;
+        case ZegoVideoFrameFormatBGRA32:
+        case ZegoVideoFrameFormatRGBA32:
+        case ZegoVideoFrameFormatARGB32:
+        case ZegoVideoFrameFormatABGR32:
+            rowBytes[0] = width * 4;
+            rows[0] = height;
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/// The centred part of a width x height picture that has the aspect ratio of `targetSize`
+static inline CGRect ZGAspectFillCropRect(size_t width, size_t height, CGSize targetSize) {
+    double targetAspect = targetSize.width / targetSize.height;
+    size_t cropWidth = width;
+    size_t cropHeight = height;
+    if ((double)width / height > targetAspect) {
+        cropWidth = MAX(1, (size_t)(height * targetAspect));
+    } else {
+        cropHeight = MAX(1, (size_t)(width / targetAspect));
+    }
+    return CGRectMake((width - cropWidth) / 2, (height - cropHeight) / 2, cropWidth, cropHeight);
+}
+
+/// Scale a BGRA32 pixel buffer to fill `destination`, cropping what does not fit
+///
+/// @param flags Extra vImage flags, e.g. kvImageDoNotTile when the caller already runs in parallel
+static inline BOOL ZGScaleAspectFillBGRA(CVPixelBufferRef source, const vImage_Buffer *destination, vImage_Flags flags) {
+    if (CVPixelBufferLockBaseAddress(source, kCVPixelBufferLock_ReadOnly) != kCVReturnSuccess) {
+        return NO;
+    }
+    CGRect crop = ZGAspectFillCropRect(CVPixelBufferGetWidth(source), CVPixelBufferGetHeight(source), CGSizeMake(destination->width, destination->height));
+    size_t rowBytes = CVPixelBufferGetBytesPerRow(source);
+    vImage_Buffer region = {
+        .data = (uint8_t *)CVPixelBufferGetBaseAddress(source) + (size_t)crop.origin.y * rowBytes + (size_t)crop.origin.x * 4,
+        .height = (vImagePixelCount)crop.size.height,
+        .width = (vImagePixelCount)crop.size.width,
+        .rowBytes = rowBytes
+    };
+    vImage_Error error = vImageScale_ARGB8888(&region, destination, NULL, flags);
+    CVPixelBufferUnlockBaseAddress(source, kCVPixelBufferLock_ReadOnly);
+    return error == kvImageNoError;
+}
+
+#endif /* ZGVideoFrameUtilities_h */
@@ -9,6 +9,9 @@
 #import "ViewController.h"
 
 #import <ZegoExpressEngine/ZegoExpressEngine.h>
+#import "ZGEngineCommandProxy.h"
+#import "ZGAsyncEngine.h"
+#import "ZGEngineProfile.h"
 
 /// Apply AppID and AppSign from Zego
 ///
@@ -20,6 +23,10 @@ static NSString *appSign = <#Fill in your appSign#>;
 
 @interface ViewController () <ZegoEventHandler>
 
+// Every SDK control call runs on the proxy's command thread, never on the main thread
+@property (nonatomic, strong) ZGEngineCommandProxy *commandProxy;
+@property (nonatomic, strong) ZGAsyncEngine *asyncEngine;
+
 // Log View
 @property (unsafe_unretained) IBOutlet NSTextView *logView;
 
@@ -64,6 +71,11 @@ static NSString *appSign = <#Fill in your appSign#>;
     srand((unsigned)time(0));
     self.userID = [NSString stringWithFormat:@"%u", (unsigned)rand()];
     
+    self.commandProxy = [[ZGEngineCommandProxy alloc] initWithEngineProvider:^id<ZGExpressEngine> _Nullable{
+        return [ZegoExpressEngine sharedEngine];
+    }];
+    self.asyncEngine = [[ZGAsyncEngine alloc] initWithCommandProxy:self.commandProxy];
+    
     [self setupUI];
 }
 
@@ -82,7 +94,16 @@ static NSString *appSign = <#Fill in your appSign#>;
 - (IBAction)createEngineButtonClick:(NSButton *)sender {
     
     // Create ZegoExpressEngine and add self as a delegate (ZegoEventHandler)
-    [ZegoExpressEngine createEngineWithAppID:appID appSign:appSign isTestEnv:self.isTestEnv scenario:ZegoScenarioGeneral eventHandler:self];
+    BOOL isTestEnv = self.isTestEnv;
+    __weak typeof(self) weakSelf = self;
+    [self.commandProxy submitCommand:@"createEngine" block:^(id<ZGExpressEngine> _Nullable engine) {
+        // Launch settings from the compiled profile, if the app bundles one
+        ZegoEngineConfig *engineConfig = [ZGEngineProfile bundledProfile].engineConfig;
+        if (engineConfig) {
+            [ZegoExpressEngine setEngineConfig:engineConfig];
+        }
+        [ZegoExpressEngine createEngineWithAppID:appID appSign:appSign isTestEnv:isTestEnv scenario:ZegoScenarioGeneral eventHandler:weakSelf];
+    }];
     
     // Print log
     [self appendLog:@" 🚀 Create ZegoExpressEngine"];
@@ -97,8 +118,13 @@ static NSString *appSign = <#Fill in your appSign#>;
     // Instantiate a ZegoUser object
     ZegoUser *user = [ZegoUser userWithUserID:self.userID];
     
-    // Login room
-    [[ZegoExpressEngine sharedEngine] loginRoom:self.roomID user:user];
+    // Login room, give up (and log out again) if it is not connected within 10 seconds
+    __weak typeof(self) weakSelf = self;
+    [[[self.asyncEngine loginRoom:self.roomID user:user config:nil] withTimeout:10] whenCompleteOnQueue:dispatch_get_main_queue() block:^(id _Nullable value, NSError * _Nullable error) {
+        if ([error.domain isEqualToString:ZGFutureErrorDomain] && error.code == ZGFutureErrorCodeTimedOut) {
+            [weakSelf appendLog:@" 🚩 ❌ 🚪 Login room timed out"];
+        }
+    }];
     
     // Print log
     [self appendLog:@" 🚪 Start login room"];
@@ -112,12 +138,12 @@ static NSString *appSign = <#Fill in your appSign#>;
     previewCanvas.viewMode = ZegoViewModeAspectFill;
     
     // Start preview
-    [[ZegoExpressEngine sharedEngine] startPreview:previewCanvas];
+    [self.commandProxy startPreview:previewCanvas];
     
     NSString *publishStreamID = self.publishStreamIDTextField.stringValue;
     
     // If streamID is empty @"", SDK will pop up an UIAlertController if "isTestEnv" is set to YES
-    [[ZegoExpressEngine sharedEngine] startPublishing:publishStreamID];
+    [self.commandProxy startPublishing:publishStreamID channel:ZegoPublishChannelMain];
     
     // Print log
     [self appendLog:@" 📤 Start publishing stream"];
@@ -133,7 +159,7 @@ static NSString *appSign = <#Fill in your appSign#>;
     NSString *playStreamID = self.playStreamIDTextField.stringValue;
     
     // If streamID is empty @"", SDK will pop up an UIAlertController if "isTestEnv" is set to YES
-    [[ZegoExpressEngine sharedEngine] startPlayingStream:playStreamID canvas:playCanvas];
+    [self.commandProxy startPlayingStream:playStreamID canvas:playCanvas];
     
     // Print log
     [self appendLog:@" 📥 Strat playing stream"];
@@ -153,7 +179,9 @@ static NSString *appSign = <#Fill in your appSign#>;
         // Can destroy the engine when you don't need audio and video calls
         //
         // Destroy engine will automatically logout room and stop publishing/playing stream.
-        [ZegoExpressEngine destroyEngine:nil];
+        [self.asyncEngine submitResetCommand:@"destroyEngine" block:^(id<ZGExpressEngine> _Nullable engine) {
+            [ZegoExpressEngine destroyEngine:nil];
+        }];
         
         // Print log
         [self appendLog:@" 🏳️ Destroy ZegoExpressEngine"];
@@ -166,7 +194,9 @@ static NSString *appSign = <#Fill in your appSign#>;
         // Can destroy the engine when you don't need audio and video calls
         //
         // Destroy engine will automatically logout room and stop publishing/playing stream.
-        [ZegoExpressEngine destroyEngine:nil];
+        [self.asyncEngine submitResetCommand:@"destroyEngine" block:^(id<ZGExpressEngine> _Nullable engine) {
+            [ZegoExpressEngine destroyEngine:nil];
+        }];
         
         // Print log
         [self appendLog:@" 🏳️ Destroy ZegoExpressEngine"];
@@ -178,6 +208,8 @@ static NSString *appSign = <#Fill in your appSign#>;
 
 /// Room status change notification
 - (void)onRoomStateUpdate:(ZegoRoomState)state errorCode:(int)errorCode extendedData:(NSDictionary *)extendedData roomID:(NSString *)roomID {
+    [self.asyncEngine onRoomStateUpdate:state errorCode:errorCode extendedData:extendedData roomID:roomID];
+    
     if (state == ZegoRoomStateConnected && errorCode == 0) {
         [self appendLog:@" 🚩 🚪 Login room success"];
         
@@ -194,6 +226,8 @@ static NSString *appSign = <#Fill in your appSign#>;
 
 /// Publish stream state callback
 - (void)onPublisherStateUpdate:(ZegoPublisherState)state errorCode:(int)errorCode extendedData:(NSDictionary *)extendedData streamID:(NSString *)streamID {
+    [self.asyncEngine onPublisherStateUpdate:state errorCode:errorCode extendedData:extendedData streamID:streamID];
+    
     if (state == ZegoPublisherStatePublishing && errorCode == 0) {
         [self appendLog:@" 🚩 📤 Publishing stream success"];
         
@@ -210,6 +244,8 @@ static NSString *appSign = <#Fill in your appSign#>;
 
 /// Play stream state callback
 - (void)onPlayerStateUpdate:(ZegoPlayerState)state errorCode:(int)errorCode extendedData:(NSDictionary *)extendedData streamID:(NSString *)streamID {
+    [self.asyncEngine onPlayerStateUpdate:state errorCode:errorCode extendedData:extendedData streamID:streamID];
+    
     if (state == ZegoPlayerStatePlaying && errorCode == 0) {
         [self appendLog:@" 🚩 📥 Playing stream success"];
         
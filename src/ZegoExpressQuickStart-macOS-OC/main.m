@@ -7,10 +7,22 @@
 //
 
 #import <Cocoa/Cocoa.h>
+#import "ZGLoadTestDriver.h"
+#import "ZGEngineProfileCompiler.h"
 
 int main(int argc, const char * argv[]) {
     @autoreleasepool {
         // Setup code that might create autoreleased objects goes here.
+        
+        // Headless load test against the local stand-in engine, no window is created
+        NSArray<NSString *> *arguments = [[NSProcessInfo processInfo] arguments];
+        if ([arguments containsObject:ZGLoadTestScenarioArgument]) {
+            return [ZGLoadTestDriver runHeadlessWithArguments:arguments];
+        }
+        // Build tool: turn an engine profile JSON file into the binary form the app maps at launch
+        if ([arguments containsObject:ZGEngineProfileCompileArgument]) {
+            return [ZGEngineProfileCompiler runWithArguments:arguments];
+        }
     }
     return NSApplicationMain(argc, argv);
 }